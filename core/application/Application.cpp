@@ -22,6 +22,7 @@
 
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
+#include "collection_pipeline/limiter/MemoryGovernor.h"
 #include "collection_pipeline/plugin/PluginRegistry.h"
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 #include "collection_pipeline/queue/SenderQueueManager.h"
@@ -261,6 +262,7 @@ void Application::Start() { // GCOVR_EXCL_START
 #endif
 
     // runner
+    MemoryGovernor::GetInstance()->Init();
     BoundedSenderQueueInterface::SetFeedback(ProcessQueueManager::GetInstance());
     HttpSink::GetInstance()->Init();
     FlusherRunner::GetInstance()->Init();
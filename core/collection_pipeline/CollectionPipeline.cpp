@@ -26,6 +26,7 @@
 
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
+#include "collection_pipeline/limiter/MemoryGovernor.h"
 #include "collection_pipeline/plugin/PluginRegistry.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
@@ -322,6 +323,8 @@ bool CollectionPipeline::Init(CollectionConfig&& config) {
                                    mContext.GetRegion());
             }
         }
+        MemoryGovernor::GetInstance()->UpdatePipelineQuota(
+            mName, static_cast<int64_t>(mContext.GetGlobalConfig().mMaxMemoryMB) * 1024 * 1024);
         if (isInputSupportAck) {
             ProcessQueueManager::GetInstance()->CreateOrUpdateBoundedQueue(
                 mContext.GetProcessQueueKey(), mContext.GetGlobalConfig().mPriority, mContext);
@@ -22,6 +22,7 @@
 #include <type_traits>
 #include <unordered_map>
 
+#include "collection_pipeline/limiter/MemoryGovernor.h"
 #include "common/http/AsynCurlRunner.h"
 #include "common/timer/Timer.h"
 #include "config/feedbacker/ConfigFeedbackReceiver.h"
@@ -64,6 +65,7 @@ void CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& diff) {
             unique_lock<shared_mutex> lock(mPipelineNameEntityMapMutex);
             mPipelineNameEntityMap.erase(name);
         }
+        MemoryGovernor::GetInstance()->RemovePipelineQuota(name);
         ConfigFeedbackReceiver::GetInstance().FeedbackContinuousPipelineConfigStatus(name,
                                                                                      ConfigFeedbackStatus::DELETED);
     }
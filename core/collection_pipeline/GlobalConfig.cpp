@@ -27,6 +27,7 @@ namespace logtail {
 const unordered_set<string> GlobalConfig::sNativeParam = {"TopicType",
                                                           "TopicFormat",
                                                           "Priority",
+                                                          "MaxMemoryMB",
                                                           "EnableTimestampNanosecond",
                                                           "UsingOldContentTag",
                                                           "PipelineMetaTagKey",
@@ -127,6 +128,19 @@ bool GlobalConfig::Init(const Json::Value& config, const CollectionPipelineConte
         mPriority = priority;
     }
 
+    // MaxMemoryMB
+    if (!GetOptionalUIntParam(config, "MaxMemoryMB", mMaxMemoryMB, errorMsg)) {
+        PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                              ctx.GetAlarm(),
+                              errorMsg,
+                              mMaxMemoryMB,
+                              moduleName,
+                              ctx.GetConfigName(),
+                              ctx.GetProjectName(),
+                              ctx.GetLogstoreName(),
+                              ctx.GetRegion());
+    }
+
     // EnableTimestampNanosecond
     if (!GetOptionalBoolParam(config, "EnableTimestampNanosecond", mEnableTimestampNanosecond, errorMsg)) {
         PARAM_WARNING_DEFAULT(ctx.GetLogger(),
@@ -37,6 +37,7 @@ struct GlobalConfig {
     TopicType mTopicType = TopicType::NONE;
     std::string mTopicFormat;
     uint32_t mPriority = 1U; // highest priority is 0, lowest priority is 2, default is 1
+    uint32_t mMaxMemoryMB = 0U; // memory quota of the data buffered in the pipeline, 0 means unlimited
     bool mEnableTimestampNanosecond = false;
     bool mUsingOldContentTag = false;
 };
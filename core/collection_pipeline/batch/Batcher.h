@@ -18,9 +18,12 @@
 
 #include <cstdint>
 
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "json/json.h"
@@ -30,17 +33,29 @@
 #include "collection_pipeline/batch/BatchStatus.h"
 #include "collection_pipeline/batch/FlushStrategy.h"
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
+#include "collection_pipeline/limiter/MemoryGovernor.h"
 #include "common/Flags.h"
 #include "common/ParamExtractor.h"
 #include "models/PipelineEventGroup.h"
 #include "monitor/MetricManager.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+DECLARE_FLAG_INT32(process_thread_count);
+
 namespace logtail {
 
 template <typename T = EventBatchStatus>
 class Batcher {
 public:
+    Batcher() = default;
+    Batcher(const Batcher&) = delete;
+    Batcher& operator=(const Batcher&) = delete;
+    ~Batcher() {
+        if (mMemoryQuota) {
+            mMemoryQuota->Release(mChargedBytes.load());
+        }
+    }
+
     bool Init(const Json::Value& config,
               Flusher* flusher,
               const DefaultFlushStrategyOptions& strategy,
@@ -87,6 +102,27 @@ public:
                                   ctx.GetRegion());
         }
 
+        bool enableShardedBatch = false;
+        if (!GetOptionalBoolParam(config, "EnableShardedBatch", enableShardedBatch, errorMsg)) {
+            PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                  ctx.GetAlarm(),
+                                  errorMsg,
+                                  enableShardedBatch,
+                                  flusher->Name(),
+                                  ctx.GetConfigName(),
+                                  ctx.GetProjectName(),
+                                  ctx.GetLogstoreName(),
+                                  ctx.GetRegion());
+        }
+        // one shard for each processor thread
+        size_t shardCnt = std::min<size_t>(std::max(INT32_FLAG(process_thread_count), 1), kMaxShardCnt);
+        mShards.clear();
+        if (enableShardedBatch && shardCnt > 1) {
+            for (size_t i = 0; i < shardCnt; ++i) {
+                mShards.emplace_back(std::make_unique<EventQueueShard>());
+            }
+        }
+
         if (enableGroupBatch) {
             uint32_t groupTimeout = timeoutSecs / 2;
             mGroupFlushStrategy = GroupFlushStrategy(minSizeBytes, groupTimeout);
@@ -100,6 +136,7 @@ public:
         mEventFlushStrategy.SetMinCnt(minCnt);
 
         mFlusher = flusher;
+        mMemoryQuota = MemoryGovernor::GetInstance()->GetPipelineQuota(ctx.GetConfigName());
 
         std::vector<std::pair<std::string, std::string>> labels{
             {METRIC_LABEL_KEY_PROJECT, ctx.GetProjectName()},
@@ -130,12 +167,102 @@ public:
     // when group level batch is disabled, there should be only 1 element in BatchedEventsList
     void Add(PipelineEventGroup&& g, std::vector<BatchedEventsList>& res) {
         auto before = std::chrono::system_clock::now();
-        std::lock_guard<std::mutex> lock(mMux);
         size_t key = g.GetTagsHash();
-        EventBatchItem<T>& item = mEventQueueMap[key];
+        if (mShards.empty()) {
+            std::lock_guard<std::mutex> lock(mMux);
+            AddToQueue(std::move(g), mEventQueueMap, key, res);
+        } else {
+            size_t shardIdx = GetThreadShardSeq() % mShards.size();
+            auto& shard = *mShards[shardIdx];
+            std::lock_guard<std::mutex> lock(shard.mMux);
+            AddToQueue(std::move(g), shard.mEventQueueMap, ToShardKey(key, shardIdx), res);
+        }
+        ADD_COUNTER(mTotalAddTimeMs, std::chrono::system_clock::now() - before);
+    }
+
+    // key != 0: event level queue
+    // key = 0: group level queue
+    void FlushQueue(size_t key, BatchedEventsList& res) {
+        if (key == 0) {
+            std::lock_guard<std::mutex> lock(mMux);
+            if (!mGroupQueue) {
+                return;
+            }
+            UpdateMetricsOnFlushingGroupQueue();
+            return mGroupQueue->Flush(res);
+        }
+        if (mShards.empty()) {
+            std::lock_guard<std::mutex> lock(mMux);
+            FlushEventQueue(mEventQueueMap, key, res);
+        } else {
+            size_t shardIdx = (key & kShardKeyMask) - 1;
+            if (shardIdx >= mShards.size()) {
+                return;
+            }
+            auto& shard = *mShards[shardIdx];
+            std::lock_guard<std::mutex> lock(shard.mMux);
+            FlushEventQueue(shard.mEventQueueMap, key, res);
+        }
+    }
+
+    void FlushAll(std::vector<BatchedEventsList>& res) {
+        if (mShards.empty()) {
+            std::lock_guard<std::mutex> lock(mMux);
+            FlushAllEventQueues(mEventQueueMap, res);
+            FlushGroupQueue(res);
+        } else {
+            for (auto& shard : mShards) {
+                std::lock_guard<std::mutex> lock(shard->mMux);
+                FlushAllEventQueues(shard->mEventQueueMap, res);
+            }
+            std::lock_guard<std::mutex> lock(mMux);
+            FlushGroupQueue(res);
+        }
+    }
+
+    bool IsSharded() const { return !mShards.empty(); }
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    EventFlushStrategy<T>& GetEventFlushStrategy() { return mEventFlushStrategy; }
+    std::optional<GroupFlushStrategy>& GetGroupFlushStrategy() { return mGroupFlushStrategy; }
+#endif
+
+private:
+    using EventQueueMap = std::unordered_map<size_t, EventBatchItem<T>>;
+
+    // In sharded mode, each thread adding groups has its own event queues, so that processor threads feeding the same
+    // flusher do not contend for one lock. The event queues of a shard are flushed independently by timeout, for
+    // which the shard index is encoded into the lowest byte of the key. The group queue, if any, is still shared by
+    // all shards and guarded by mMux.
+    struct EventQueueShard {
+        std::mutex mMux;
+        EventQueueMap mEventQueueMap;
+    };
+
+    static constexpr size_t kShardKeyMask = 0xFF;
+    static constexpr size_t kMaxShardCnt = kShardKeyMask - 1;
+
+    static size_t ToShardKey(size_t key, size_t shardIdx) { return (key & ~kShardKeyMask) | (shardIdx + 1); }
+
+    static size_t GetThreadShardSeq() {
+        static std::atomic_size_t sNextSeq{0};
+        thread_local size_t seq = sNextSeq.fetch_add(1);
+        return seq;
+    }
+
+    // in unsharded mode, mMux is held during the whole operation already
+    std::unique_lock<std::mutex> LockGroupQueue() {
+        return mShards.empty() ? std::unique_lock<std::mutex>() : std::unique_lock<std::mutex>(mMux);
+    }
+
+    void AddToQueue(PipelineEventGroup&& g, EventQueueMap& queueMap, size_t key, std::vector<BatchedEventsList>& res) {
+        auto [iter, inserted] = queueMap.try_emplace(key);
+        EventBatchItem<T>& item = iter->second;
         ADD_COUNTER(mInEventsTotal, g.GetEvents().size());
         ADD_COUNTER(mInGroupDataSizeBytes, g.DataSize());
-        SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
+        if (inserted) {
+            ADD_GAUGE(mEventBatchItemsTotal, 1);
+        }
 
         if (g.DataSize() > mEventFlushStrategy.GetMinSizeBytes()) {
             // for group size larger than min batch size, separate group only if size is larger than max batch size
@@ -143,7 +270,8 @@ public:
                 UpdateMetricsOnFlushingEventQueue(item);
                 item.Flush(res);
             }
-            for (auto& e : g.MutableEvents()) {
+            auto events = g.ReleaseEvents();
+            for (auto& e : events) {
                 // should consider time condition here because sls require this
                 if (!item.IsEmpty() && mEventFlushStrategy.NeedFlushByTime(item.GetStatus(), e)) {
                     ADD_COUNTER(mOutEventsTotal, item.EventSize());
@@ -167,14 +295,15 @@ public:
             ADD_COUNTER(mOutEventsTotal, item.EventSize());
             item.Flush(res);
         } else {
-            size_t eventsSize = g.GetEvents().size();
-            for (size_t i = 0; i < eventsSize; ++i) {
-                PipelineEventPtr& e = g.MutableEvents()[i];
+            auto events = g.ReleaseEvents();
+            for (size_t i = 0; i < events.size(); ++i) {
+                PipelineEventPtr& e = events[i];
                 if (!item.IsEmpty() && mEventFlushStrategy.NeedFlushByTime(item.GetStatus(), e)) {
                     if (!mGroupQueue) {
                         UpdateMetricsOnFlushingEventQueue(item);
                         item.Flush(res);
                     } else {
+                        auto groupLock = LockGroupQueue();
                         if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
                             UpdateMetricsOnFlushingGroupQueue();
                             mGroupQueue->Flush(res);
@@ -208,6 +337,7 @@ public:
                                                                      mFlusher);
                     ADD_GAUGE(mBufferedGroupsTotal, 1);
                     ADD_GAUGE(mBufferedDataSizeByte, item.DataSize());
+                    ChargeMemory(item.DataSize());
                 } else if (i == 0) {
                     item.AddSourceBuffer(g.GetSourceBuffer());
                     for (const auto& extraSourceBuffer : g.GetExtraSourceBuffers()) {
@@ -216,6 +346,7 @@ public:
                 }
                 ADD_GAUGE(mBufferedEventsTotal, 1);
                 ADD_GAUGE(mBufferedDataSizeByte, e->DataSize());
+                ChargeMemory(e->DataSize());
                 item.Add(std::move(e));
                 if (mEventFlushStrategy.NeedFlushBySize(item.GetStatus())
                     || mEventFlushStrategy.NeedFlushByCnt(item.GetStatus())) {
@@ -224,34 +355,23 @@ public:
                 }
             }
         }
-        ADD_COUNTER(mTotalAddTimeMs, std::chrono::system_clock::now() - before);
     }
 
-    // key != 0: event level queue
-    // key = 0: group level queue
-    void FlushQueue(size_t key, BatchedEventsList& res) {
-        std::lock_guard<std::mutex> lock(mMux);
-        if (key == 0) {
-            if (!mGroupQueue) {
-                return;
-            }
-            UpdateMetricsOnFlushingGroupQueue();
-            return mGroupQueue->Flush(res);
-        }
-
-        auto iter = mEventQueueMap.find(key);
-        if (iter == mEventQueueMap.end()) {
+    void FlushEventQueue(EventQueueMap& queueMap, size_t key, BatchedEventsList& res) {
+        auto iter = queueMap.find(key);
+        if (iter == queueMap.end()) {
             return;
         }
 
         if (!mGroupQueue) {
             UpdateMetricsOnFlushingEventQueue(iter->second);
             iter->second.Flush(res);
-            mEventQueueMap.erase(iter);
-            SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
+            queueMap.erase(iter);
+            SUB_GAUGE(mEventBatchItemsTotal, 1);
             return;
         }
 
+        auto groupLock = LockGroupQueue();
         if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
             UpdateMetricsOnFlushingGroupQueue();
             mGroupQueue->Flush(res);
@@ -264,21 +384,21 @@ public:
                                                              mFlusher);
         }
         iter->second.Flush(mGroupQueue.value());
-        mEventQueueMap.erase(iter);
-        SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
+        queueMap.erase(iter);
+        SUB_GAUGE(mEventBatchItemsTotal, 1);
         if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
             UpdateMetricsOnFlushingGroupQueue();
             mGroupQueue->Flush(res);
         }
     }
 
-    void FlushAll(std::vector<BatchedEventsList>& res) {
-        std::lock_guard<std::mutex> lock(mMux);
-        for (auto& item : mEventQueueMap) {
+    void FlushAllEventQueues(EventQueueMap& queueMap, std::vector<BatchedEventsList>& res) {
+        for (auto& item : queueMap) {
             if (!mGroupQueue) {
                 UpdateMetricsOnFlushingEventQueue(item.second);
                 item.second.Flush(res);
             } else {
+                auto groupLock = LockGroupQueue();
                 if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
                     UpdateMetricsOnFlushingGroupQueue();
                     mGroupQueue->Flush(res);
@@ -290,20 +410,11 @@ public:
                 }
             }
         }
-        if (mGroupQueue) {
-            UpdateMetricsOnFlushingGroupQueue();
-            mGroupQueue->Flush(res);
-        }
-        SET_GAUGE(mEventBatchItemsTotal, 0);
-        mEventQueueMap.clear();
+        // only the queues flushed here are subtracted, since other shards may add queues concurrently
+        SUB_GAUGE(mEventBatchItemsTotal, queueMap.size());
+        queueMap.clear();
     }
 
-#ifdef APSARA_UNIT_TEST_MAIN
-    EventFlushStrategy<T>& GetEventFlushStrategy() { return mEventFlushStrategy; }
-    std::optional<GroupFlushStrategy>& GetGroupFlushStrategy() { return mGroupFlushStrategy; }
-#endif
-
-private:
     void UpdateMetricsOnFlushingEventQueue(const EventBatchItem<T>& item) {
         ADD_COUNTER(mOutEventsTotal, item.EventSize());
         // ADD_COUNTER(mTotalDelayMs,
@@ -315,6 +426,15 @@ private:
         SUB_GAUGE(mBufferedGroupsTotal, 1);
         SUB_GAUGE(mBufferedEventsTotal, item.EventSize());
         SUB_GAUGE(mBufferedDataSizeByte, item.DataSize());
+        ReleaseMemory(item.DataSize());
+    }
+
+    // mMux should be held by the caller
+    void FlushGroupQueue(std::vector<BatchedEventsList>& res) {
+        if (mGroupQueue) {
+            UpdateMetricsOnFlushingGroupQueue();
+            mGroupQueue->Flush(res);
+        }
     }
 
     void UpdateMetricsOnFlushingGroupQueue() {
@@ -328,10 +448,27 @@ private:
         SUB_GAUGE(mBufferedGroupsTotal, mGroupQueue->GroupSize());
         SUB_GAUGE(mBufferedEventsTotal, mGroupQueue->EventSize());
         SUB_GAUGE(mBufferedDataSizeByte, mGroupQueue->DataSize());
+        ReleaseMemory(mGroupQueue->DataSize());
+    }
+
+    // the bytes buffered are charged to the memory quota of the pipeline along with mBufferedDataSizeByte
+    void ChargeMemory(size_t bytes) {
+        if (mMemoryQuota) {
+            mChargedBytes.fetch_add(bytes);
+            mMemoryQuota->Charge(bytes);
+        }
+    }
+
+    void ReleaseMemory(size_t bytes) {
+        if (mMemoryQuota) {
+            mChargedBytes.fetch_sub(bytes);
+            mMemoryQuota->Release(bytes);
+        }
     }
 
     std::mutex mMux;
-    std::map<size_t, EventBatchItem<T>> mEventQueueMap;
+    EventQueueMap mEventQueueMap;
+    std::vector<std::unique_ptr<EventQueueShard>> mShards;
     EventFlushStrategy<T> mEventFlushStrategy;
 
     std::optional<GroupBatchItem> mGroupQueue;
@@ -339,6 +476,9 @@ private:
 
     Flusher* mFlusher = nullptr;
 
+    std::shared_ptr<MemoryQuota> mMemoryQuota;
+    std::atomic_int64_t mChargedBytes = 0;
+
     mutable MetricsRecordRef mMetricsRecordRef;
     CounterPtr mInEventsTotal;
     CounterPtr mInGroupDataSizeBytes;
@@ -14,37 +14,107 @@
 
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 
+#include <chrono>
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(timeout_flush_tick_ms, "tick of the timing wheel for batch timeout, ms", 100);
+
 using namespace std;
 
 namespace logtail {
 
+static uint64_t GetSteadyTimeInMilliSeconds() {
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TimeoutFlushManager::TimeoutFlushManager()
+    : mTimingWheel(INT32_FLAG(timeout_flush_tick_ms), GetSteadyTimeInMilliSeconds()) {
+}
+
+TimeoutFlushManager::~TimeoutFlushManager() {
+    Stop();
+}
+
+void TimeoutFlushManager::Init() {
+    if (mIsThreadRunning.exchange(true)) {
+        return;
+    }
+    mThreadRes = async(launch::async, &TimeoutFlushManager::Run, this);
+}
+
+void TimeoutFlushManager::Stop() {
+    {
+        lock_guard<mutex> lock(mThreadMux);
+        if (!mIsThreadRunning.exchange(false)) {
+            return;
+        }
+    }
+    mCV.notify_one();
+    if (!mThreadRes.valid()) {
+        return;
+    }
+    future_status s = mThreadRes.wait_for(chrono::seconds(1));
+    if (s == future_status::ready) {
+        LOG_INFO(sLogger, ("timeout flush manager", "stopped successfully"));
+    } else {
+        LOG_WARNING(sLogger, ("timeout flush manager", "forced to stopped"));
+    }
+}
+
+void TimeoutFlushManager::Run() {
+    LOG_INFO(sLogger, ("timeout flush manager", "started"));
+    unique_lock<mutex> lock(mThreadMux);
+    while (mIsThreadRunning.load()) {
+        lock.unlock();
+        FlushTimeoutBatch();
+        lock.lock();
+        mCV.wait_for(lock, chrono::milliseconds(INT32_FLAG(timeout_flush_tick_ms)), [this]() {
+            return !mIsThreadRunning.load();
+        });
+    }
+}
+
 void TimeoutFlushManager::UpdateRecord(
     const string& config, size_t index, size_t key, uint32_t timeoutSecs, Flusher* f) {
+    uint64_t now = GetSteadyTimeInMilliSeconds();
     lock_guard<mutex> lock(mTimeoutRecordsMux);
     auto& item = mTimeoutRecords[config];
     auto it = item.find({index, key});
     if (it == item.end()) {
-        item.try_emplace({index, key}, f, key, timeoutSecs);
+        it = item.try_emplace({index, key}, f, key, timeoutSecs, now, ++mRecordSeq).first;
+        mTimingWheel.Add(it->second.GetDeadlineMs(), WheelEntry{config, {index, key}, it->second.mSeq});
     } else {
-        it->second.Update();
+        // the wheel entry is not moved, but checked against the new deadline when it expires
+        it->second.Update(now);
     }
 }
 
 void TimeoutFlushManager::FlushTimeoutBatch() {
-    multimap<string, pair<Flusher*, size_t>> records;
+    vector<pair<string, pair<Flusher*, size_t>>> records;
     {
+        uint64_t now = GetSteadyTimeInMilliSeconds();
+        vector<WheelEntry> expired;
         lock_guard<mutex> lock(mTimeoutRecordsMux);
-        for (auto& item : mTimeoutRecords) {
-            for (auto it = item.second.begin(); it != item.second.end();) {
-                if (time(nullptr) - it->second.mUpdateTime >= it->second.mTimeoutSecs) {
-                    // cannot flush here, since flush may also update record, which might invalidate map iterator and
-                    // lead to deadlock
-                    records.emplace(item.first, make_pair(it->second.mFlusher, it->second.mKey));
-                    it = item.second.erase(it);
-                } else {
-                    ++it;
-                }
+        mTimingWheel.Advance(now, expired);
+        for (auto& entry : expired) {
+            auto item = mTimeoutRecords.find(entry.mConfig);
+            if (item == mTimeoutRecords.end()) {
+                continue;
+            }
+            auto it = item->second.find(entry.mId);
+            if (it == item->second.end() || it->second.mSeq != entry.mSeq) {
+                continue;
+            }
+            if (it->second.GetDeadlineMs() > now) {
+                mTimingWheel.Add(it->second.GetDeadlineMs(), std::move(entry));
+                continue;
             }
+            // cannot flush here, since flush may also update record, which might invalidate map iterator and lead to
+            // deadlock
+            records.emplace_back(item->first, make_pair(it->second.mFlusher, it->second.mKey));
+            item->second.erase(it);
         }
     }
     {
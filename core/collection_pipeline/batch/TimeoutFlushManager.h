@@ -17,29 +17,42 @@
 #pragma once
 
 #include <cstdint>
-#include <ctime>
 
-#include <map>
+#include <atomic>
+#include <condition_variable>
+#include <future>
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "collection_pipeline/plugin/instance/FlusherInstance.h"
 #include "collection_pipeline/plugin/interface/Flusher.h"
+#include "common/timer/TimingWheel.h"
 
 namespace logtail {
 
 struct TimeoutRecord {
     Flusher* mFlusher = nullptr;
     size_t mKey;
-    time_t mUpdateTime = 0;
+    uint64_t mUpdateTimeMs = 0;
     uint32_t mTimeoutSecs = 0;
+    // identifies the timing wheel entry of the record, since the entries of removed records are left in the wheel
+    uint64_t mSeq = 0;
 
-    TimeoutRecord(Flusher* flusher, size_t key, uint32_t timeoutSecs)
-        : mFlusher(flusher), mKey(key), mUpdateTime(time(nullptr)), mTimeoutSecs(timeoutSecs) {}
+    TimeoutRecord(Flusher* flusher, size_t key, uint32_t timeoutSecs, uint64_t nowMs, uint64_t seq)
+        : mFlusher(flusher), mKey(key), mUpdateTimeMs(nowMs), mTimeoutSecs(timeoutSecs), mSeq(seq) {}
 
-    void Update() { mUpdateTime = time(nullptr); }
+    void Update(uint64_t nowMs) { mUpdateTimeMs = nowMs; }
+    uint64_t GetDeadlineMs() const { return mUpdateTimeMs + mTimeoutSecs * 1000ULL; }
+};
+
+struct TimeoutRecordIdHash {
+    size_t operator()(const std::pair<size_t, size_t>& id) const {
+        return std::hash<size_t>()(id.first) ^ (std::hash<size_t>()(id.second) << 1);
+    }
 };
 
 class TimeoutFlushManager {
@@ -52,23 +65,44 @@ public:
         return &instance;
     }
 
+    // starts the thread which flushes the timeout batches
+    void Init();
+    void Stop();
+
     void UpdateRecord(const std::string& config, size_t index, size_t key, uint32_t timeoutSecs, Flusher* f);
     void FlushTimeoutBatch();
     void UnregisterFlushers(const std::string& config, const std::vector<std::unique_ptr<FlusherInstance>>& flushers);
     void RegisterFlushers(const std::string& config, const std::vector<std::unique_ptr<FlusherInstance>>& flushers);
 
 private:
-    TimeoutFlushManager() = default;
-    ~TimeoutFlushManager() = default;
+    struct WheelEntry {
+        std::string mConfig;
+        std::pair<size_t, size_t> mId;
+        uint64_t mSeq = 0;
+    };
 
-    // visited by all processor runner threads
+    TimeoutFlushManager();
+    ~TimeoutFlushManager();
+
+    void Run();
+
+    // visited by all processor runner threads and the flush thread
     mutable std::mutex mTimeoutRecordsMux;
-    std::map<std::string, std::map<std::pair<size_t, size_t>, TimeoutRecord>> mTimeoutRecords;
+    std::unordered_map<std::string, std::unordered_map<std::pair<size_t, size_t>, TimeoutRecord, TimeoutRecordIdHash>>
+        mTimeoutRecords;
+    // records are only removed from the wheel lazily, i.e., when their entries expire
+    TimingWheel<WheelEntry> mTimingWheel;
+    uint64_t mRecordSeq = 0;
 
-    // visited by main thread and num 0 processor runner thread
+    // visited by main thread and the flush thread
     mutable std::mutex mDeletedFlushersMux;
     std::set<std::pair<std::string, const Flusher*>> mDeletedFlushers;
 
+    std::future<void> mThreadRes;
+    std::atomic_bool mIsThreadRunning = false;
+    mutable std::mutex mThreadMux;
+    std::condition_variable mCV;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PipelineUnittest;
     friend class TimeoutFlushManagerUnittest;
@@ -51,7 +51,10 @@ bool ConcurrencyLimiter::IsInTimeFallback() const {
 
 bool ConcurrencyLimiter::IsValidToPop() {
     lock_guard<mutex> lock(mLimiterMux);
+    return IsValidToPopNoLock();
+}
 
+bool ConcurrencyLimiter::IsValidToPopNoLock() {
     // Check if in time fallback state
     if (mInTimeFallback) {
         auto now = std::chrono::system_clock::now();
@@ -82,6 +85,15 @@ void ConcurrencyLimiter::PostPop() {
     ++mInSendingCnt;
 }
 
+bool ConcurrencyLimiter::TryPop() {
+    lock_guard<mutex> lock(mLimiterMux);
+    if (!IsValidToPopNoLock()) {
+        return false;
+    }
+    ++mInSendingCnt;
+    return true;
+}
+
 void ConcurrencyLimiter::OnSendDone() {
     --mInSendingCnt;
 }
@@ -61,6 +61,8 @@ public:
 
     bool IsValidToPop();
     void PostPop();
+    // IsValidToPop and PostPop in one step, so that concurrent callers cannot exceed the limit
+    bool TryPop();
     void OnSendDone();
 
     void OnSuccess(std::chrono::system_clock::time_point currentTime);
@@ -122,6 +124,7 @@ private:
     uint32_t mStatisticsTotal = 0;
     uint32_t mStatisticsFailTotal = 0;
 
+    bool IsValidToPopNoLock();
     void Increase();
     void Decrease(double fallBackRatio);
     void AdjustConcurrency(bool success, std::chrono::system_clock::time_point currentTime);
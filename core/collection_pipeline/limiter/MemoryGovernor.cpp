@@ -0,0 +1,79 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/limiter/MemoryGovernor.h"
+
+#include "app_config/AppConfig.h"
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_DOUBLE(pipeline_memory_budget_ratio,
+                   "ratio of the memory usage limit that data buffered in all pipelines can take, 0 means unlimited",
+                   0.5);
+
+using namespace std;
+
+namespace logtail {
+
+MemoryGovernor::MemoryGovernor() : mGlobalQuota(make_shared<MemoryQuota>("", 0)) {
+}
+
+void MemoryGovernor::Init() {
+    int64_t limit = 0;
+    if (DOUBLE_FLAG(pipeline_memory_budget_ratio) > 0) {
+        limit = static_cast<int64_t>(AppConfig::GetInstance()->GetMemUsageUpLimit() * 1024 * 1024
+                                     * DOUBLE_FLAG(pipeline_memory_budget_ratio));
+    }
+    mGlobalQuota->SetLimit(limit);
+    LOG_INFO(sLogger, ("pipeline memory budget", "set")("limit bytes", limit));
+}
+
+shared_ptr<MemoryQuota> MemoryGovernor::GetPipelineQuota(const string& config) {
+    lock_guard<mutex> lock(mMux);
+    auto& quota = mPipelineQuotas[config];
+    if (!quota) {
+        auto iter = mRemovedPipelineQuotas.find(config);
+        if (iter != mRemovedPipelineQuotas.end()) {
+            quota = iter->second.lock();
+            mRemovedPipelineQuotas.erase(iter);
+        }
+        if (!quota) {
+            quota = make_shared<MemoryQuota>(config, 0, mGlobalQuota);
+        }
+    }
+    return quota;
+}
+
+void MemoryGovernor::UpdatePipelineQuota(const string& config, int64_t limit) {
+    GetPipelineQuota(config)->SetLimit(limit);
+}
+
+void MemoryGovernor::RemovePipelineQuota(const string& config) {
+    lock_guard<mutex> lock(mMux);
+    auto iter = mPipelineQuotas.find(config);
+    if (iter == mPipelineQuotas.end()) {
+        return;
+    }
+    mRemovedPipelineQuotas[config] = iter->second;
+    mPipelineQuotas.erase(iter);
+    for (auto it = mRemovedPipelineQuotas.begin(); it != mRemovedPipelineQuotas.end();) {
+        if (it->second.expired()) {
+            it = mRemovedPipelineQuotas.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "collection_pipeline/limiter/MemoryQuota.h"
+
+namespace logtail {
+
+// Owns the global memory quota shared by all pipelines, and one child quota for each pipeline. Queues and batchers of
+// a pipeline hold its quota, which is kept by name so that it survives pipeline updates.
+class MemoryGovernor {
+public:
+    MemoryGovernor(const MemoryGovernor&) = delete;
+    MemoryGovernor& operator=(const MemoryGovernor&) = delete;
+
+    static MemoryGovernor* GetInstance() {
+        static MemoryGovernor instance;
+        return &instance;
+    }
+
+    // sets the global limit according to the memory usage limit of the agent
+    void Init();
+
+    std::shared_ptr<MemoryQuota> GetPipelineQuota(const std::string& config);
+    void UpdatePipelineQuota(const std::string& config, int64_t limit);
+    // The quota is released once all queues and batchers of the pipeline are destructed. Until then, it is handed out
+    // again if a pipeline of the same name is added, since sender queues waiting for gc may be reused by the pipeline.
+    void RemovePipelineQuota(const std::string& config);
+
+    MemoryQuota& GetGlobalQuota() const { return *mGlobalQuota; }
+
+private:
+    MemoryGovernor();
+    ~MemoryGovernor() = default;
+
+    std::shared_ptr<MemoryQuota> mGlobalQuota;
+
+    mutable std::mutex mMux;
+    std::unordered_map<std::string, std::shared_ptr<MemoryQuota>> mPipelineQuotas;
+    std::unordered_map<std::string, std::weak_ptr<MemoryQuota>> mRemovedPipelineQuotas;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class MemoryQuotaUnittest;
+#endif
+};
+
+} // namespace logtail
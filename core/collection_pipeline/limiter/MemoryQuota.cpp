@@ -0,0 +1,105 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/limiter/MemoryQuota.h"
+
+#include "monitor/metric_constants/MetricConstants.h"
+
+using namespace std;
+
+namespace logtail {
+
+MemoryQuota::MemoryQuota(const string& name, int64_t limit, const shared_ptr<MemoryQuota>& parent)
+    : mParent(parent), mLimit(limit) {
+    MetricLabels labels{{METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_MEMORY_QUOTA}};
+    if (!name.empty()) {
+        labels.emplace_back(METRIC_LABEL_KEY_PIPELINE_NAME, name);
+    }
+    WriteMetrics::GetInstance()->CreateMetricsRecordRef(
+        mMetricsRecordRef, MetricCategory::METRIC_CATEGORY_COMPONENT, std::move(labels));
+    mUsageBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_MEMORY_QUOTA_USAGE_BYTES);
+    mLimitBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_MEMORY_QUOTA_LIMIT_BYTES);
+    mExceededTimesTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_MEMORY_QUOTA_EXCEEDED_TIMES_TOTAL);
+    WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
+    SET_GAUGE(mLimitBytes, limit);
+}
+
+void MemoryQuota::Charge(int64_t bytes) {
+    SET_GAUGE(mUsageBytes, mUsage.fetch_add(bytes) + bytes);
+    if (mParent) {
+        mParent->Charge(bytes);
+    }
+}
+
+void MemoryQuota::Release(int64_t bytes) {
+    SET_GAUGE(mUsageBytes, mUsage.fetch_sub(bytes) - bytes);
+    // pairs with the store in Wait, so that either the waiter sees the usage or this sees the waiter
+    if (mHasWaiters.load() && IsBelowLowWatermark()) {
+        NotifyWaiters();
+    }
+    if (mParent) {
+        mParent->Release(bytes);
+    }
+}
+
+bool MemoryQuota::IsExceeded() const {
+    return IsSelfExceeded() || (mParent && mParent->IsExceeded());
+}
+
+bool MemoryQuota::Wait(FeedbackInterface* feedback, int64_t key) {
+    if (!IsSelfExceeded()) {
+        return mParent ? mParent->Wait(feedback, key) : false;
+    }
+    {
+        lock_guard<mutex> lock(mWaitersMux);
+        // producers poll the quota on each push attempt, so only the first one after notification is counted
+        if (!mIsExceeded) {
+            mIsExceeded = true;
+            ADD_COUNTER(mExceededTimesTotal, 1);
+        }
+        mWaiters.emplace(feedback, key);
+        mHasWaiters = true;
+    }
+    // the usage may have dropped before the waiter is registered
+    if (IsBelowLowWatermark()) {
+        NotifyWaiters();
+    }
+    return true;
+}
+
+void MemoryQuota::SetLimit(int64_t limit) {
+    mLimit = limit;
+    SET_GAUGE(mLimitBytes, limit);
+    if (mHasWaiters.load() && IsBelowLowWatermark()) {
+        NotifyWaiters();
+    }
+}
+
+void MemoryQuota::NotifyWaiters() {
+    set<pair<FeedbackInterface*, int64_t>> waiters;
+    {
+        lock_guard<mutex> lock(mWaitersMux);
+        waiters.swap(mWaiters);
+        mHasWaiters = false;
+        mIsExceeded = false;
+    }
+    // feedback interfaces are called outside the lock, since they may take locks of their own
+    for (const auto& item : waiters) {
+        if (item.first != nullptr) {
+            item.first->Feedback(item.second);
+        }
+    }
+}
+
+} // namespace logtail
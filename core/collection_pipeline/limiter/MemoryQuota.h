@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "common/FeedbackInterface.h"
+#include "monitor/MetricManager.h"
+
+namespace logtail {
+
+// A byte budget of the data buffered in queues and batchers. Quotas form a hierarchy, i.e., bytes charged to a quota
+// are also charged to its parent, and a quota is exceeded if itself or any of its ancestors is over limit.
+//
+// Producers blocked by an exceeded quota register their feedback interfaces as waiters, which are notified once the
+// usage of the exceeded quota falls below the low watermark.
+class MemoryQuota {
+public:
+    static constexpr double kLowWatermarkRatio = 0.8;
+
+    // limit = 0 means unlimited, and an empty name stands for the global quota
+    MemoryQuota(const std::string& name, int64_t limit, const std::shared_ptr<MemoryQuota>& parent = nullptr);
+    MemoryQuota(const MemoryQuota&) = delete;
+    MemoryQuota& operator=(const MemoryQuota&) = delete;
+
+    void Charge(int64_t bytes);
+    void Release(int64_t bytes);
+    bool IsExceeded() const;
+    // Registers the feedback on the exceeded quota. Returns false if no quota is exceeded, in which case nothing is
+    // registered.
+    bool Wait(FeedbackInterface* feedback, int64_t key);
+
+    void SetLimit(int64_t limit);
+    int64_t GetLimit() const { return mLimit.load(); }
+    int64_t GetUsage() const { return mUsage.load(); }
+
+private:
+    bool IsSelfExceeded() const {
+        int64_t limit = mLimit.load();
+        return limit > 0 && mUsage.load() >= limit;
+    }
+    bool IsBelowLowWatermark() const {
+        int64_t limit = mLimit.load();
+        return limit <= 0 || mUsage.load() < static_cast<int64_t>(limit * kLowWatermarkRatio);
+    }
+    void NotifyWaiters();
+
+    const std::shared_ptr<MemoryQuota> mParent;
+    std::atomic_int64_t mLimit = 0;
+    std::atomic_int64_t mUsage = 0;
+
+    std::atomic_bool mHasWaiters = false;
+    std::mutex mWaitersMux;
+    std::set<std::pair<FeedbackInterface*, int64_t>> mWaiters;
+    // whether the quota has been exceeded since waiters were last notified, guarded by mWaitersMux
+    bool mIsExceeded = false;
+
+    MetricsRecordRef mMetricsRecordRef;
+    IntGaugePtr mUsageBytes;
+    IntGaugePtr mLimitBytes;
+    CounterPtr mExceededTimesTotal;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class MemoryQuotaUnittest;
+#endif
+};
+
+} // namespace logtail
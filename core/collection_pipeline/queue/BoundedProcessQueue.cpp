@@ -31,6 +31,20 @@ BoundedProcessQueue::BoundedProcessQueue(
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 }
 
+bool BoundedProcessQueue::IsValidToPush() const {
+    if (!BoundedQueueInterface::IsValidToPush()) {
+        return false;
+    }
+    if (!mMemoryQuota->IsExceeded()) {
+        return true;
+    }
+    // upstreams are notified once memory is released, since the queue itself may be empty and never popped
+    for (auto& item : mUpStreamFeedbacks) {
+        mMemoryQuota->Wait(item, mKey);
+    }
+    return false;
+}
+
 bool BoundedProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     if (!IsValidToPush()) {
         return false;
@@ -39,12 +53,13 @@ bool BoundedProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     auto size = item->mEventGroup.DataSize();
     mQueue.push_back(std::move(item));
     ChangeStateIfNeededAfterPush();
+    ChargeMemory(size);
 
     ADD_COUNTER(mInItemsTotal, 1);
     ADD_COUNTER(mInItemDataSizeBytes, size);
     SET_GAUGE(mQueueSizeTotal, Size());
     ADD_COUNTER(mQueueDataSizeByte, size);
-    SET_GAUGE(mValidToPushFlag, IsValidToPush());
+    SET_GAUGE(mValidToPushFlag, BoundedQueueInterface::IsValidToPush());
     return true;
 }
 
@@ -59,6 +74,7 @@ bool BoundedProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     }
     item = std::move(mQueue.front());
     mQueue.pop_front();
+    ReleaseMemory(item->mEventGroup.DataSize());
     item->AddPipelineInProcessCnt(GetConfigName());
     if (ChangeStateIfNeededAfterPop()) {
         GiveFeedback();
@@ -68,7 +84,7 @@ bool BoundedProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - item->mEnqueTime);
     SET_GAUGE(mQueueSizeTotal, Size());
     SUB_GAUGE(mQueueDataSizeByte, item->mEventGroup.DataSize());
-    SET_GAUGE(mValidToPushFlag, IsValidToPush());
+    SET_GAUGE(mValidToPushFlag, BoundedQueueInterface::IsValidToPush());
     return true;
 }
 
@@ -38,6 +38,9 @@ public:
     bool Push(std::unique_ptr<ProcessQueueItem>&& item) override;
     bool Pop(std::unique_ptr<ProcessQueueItem>& item) override;
 
+    // also invalid when the memory quota of the pipeline or the global one is exceeded
+    bool IsValidToPush() const;
+
     void SetUpStreamFeedbacks(std::vector<FeedbackInterface*>&& feedbacks);
 
 private:
@@ -39,6 +39,7 @@ bool CircularProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
         auto size = mQueue.front()->mEventGroup.DataSize();
         mEventCnt -= cnt;
         mQueue.pop_front();
+        ReleaseMemory(size);
         SET_GAUGE(mQueueSizeTotal, Size());
         SUB_GAUGE(mQueueDataSizeByte, size);
         ADD_COUNTER(mDiscardedEventsTotal, cnt);
@@ -50,6 +51,7 @@ bool CircularProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     auto size = item->mEventGroup.DataSize();
     mQueue.push_back(std::move(item));
     mEventCnt += newCnt;
+    ChargeMemory(size);
 
     ADD_COUNTER(mInItemsTotal, 1);
     ADD_COUNTER(mInItemDataSizeBytes, size);
@@ -71,6 +73,7 @@ bool CircularProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     item->AddPipelineInProcessCnt(GetConfigName());
     mQueue.pop_front();
     mEventCnt -= item->mEventGroup.GetEvents().size();
+    ReleaseMemory(item->mEventGroup.DataSize());
 
     ADD_COUNTER(mOutItemsTotal, 1);
     ADD_COUNTER(mTotalDelayMs, std::chrono::system_clock::now() - item->mEnqueTime);
@@ -85,6 +88,7 @@ void CircularProcessQueue::Reset(size_t cap) {
     uint32_t cnt = 0;
     while (!mQueue.empty() && mEventCnt > cap) {
         mEventCnt -= mQueue.front()->mEventGroup.GetEvents().size();
+        ReleaseMemory(mQueue.front()->mEventGroup.DataSize());
         mQueue.pop_front();
         ++cnt;
     }
@@ -18,7 +18,9 @@
 
 #include <cstdint>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -48,6 +50,13 @@ public:
 
     void Reset() { mDownStreamQueues.clear(); }
 
+    // When queue manager only holds its lock in shared mode, the queue should be protected by its own lock, so that
+    // different queues can be pushed and popped concurrently.
+    std::mutex& GetMux() const { return mMux; }
+    // can be read without holding any lock, used to skip empty queues quickly
+    bool MayHaveItem() const { return mMayHaveItem.load(std::memory_order_relaxed); }
+    void UpdateMayHaveItem() { mMayHaveItem.store(!Empty(), std::memory_order_relaxed); }
+
 protected:
     bool IsValidToPop() const;
 
@@ -63,6 +72,9 @@ private:
     std::vector<BoundedSenderQueueInterface*> mDownStreamQueues;
     bool mValidToPop = false;
 
+    mutable std::mutex mMux;
+    std::atomic_bool mMayHaveItem = false;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BoundedProcessQueueUnittest;
     friend class CircularProcessQueueUnittest;
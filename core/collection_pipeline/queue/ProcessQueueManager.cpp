@@ -35,7 +35,7 @@ ProcessQueueManager::ProcessQueueManager() : mBoundedQueueParam(INT32_FLAG(bound
 bool ProcessQueueManager::CreateOrUpdateBoundedQueue(QueueKey key,
                                                      uint32_t priority,
                                                      const CollectionPipelineContext& ctx) {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second != QueueType::BOUNDED) {
@@ -62,7 +62,7 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
                                                       uint32_t priority,
                                                       size_t capacity,
                                                       const CollectionPipelineContext& ctx) {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second != QueueType::CIRCULAR) {
@@ -72,6 +72,7 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
             CreateCircularQueue(key, priority, capacity, ctx);
         } else {
             static_cast<CircularProcessQueue*>(iter->second.first->get())->Reset(capacity);
+            (*iter->second.first)->UpdateMayHaveItem();
             if ((*iter->second.first)->GetPriority() == priority) {
                 return false;
             }
@@ -87,7 +88,7 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
 }
 
 bool ProcessQueueManager::DeleteQueue(QueueKey key) {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter == mQueues.end()) {
         return false;
@@ -99,10 +100,11 @@ bool ProcessQueueManager::DeleteQueue(QueueKey key) {
 }
 
 bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
-    lock_guard<mutex> lock(mQueueMux);
+    shared_lock<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second == QueueType::BOUNDED) {
+            lock_guard<mutex> queLock((*iter->second.first)->GetMux());
             return static_cast<BoundedProcessQueue*>(iter->second.first->get())->IsValidToPush();
         } else {
             return true;
@@ -113,12 +115,15 @@ bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
 
 QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueueItem>&& item) {
     {
-        lock_guard<mutex> lock(mQueueMux);
+        shared_lock<shared_mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
-            if (!(*iter->second.first)->Push(std::move(item))) {
+            auto& que = *iter->second.first;
+            lock_guard<mutex> queLock(que->GetMux());
+            if (!que->Push(std::move(item))) {
                 return QueueStatus::QUEUE_FULL;
             }
+            que->UpdateMayHaveItem();
         } else {
             auto res = ExactlyOnceQueueManager::GetInstance()->PushProcessQueue(key, std::move(item));
             if (res != QueueStatus::OK) {
@@ -132,74 +137,103 @@ QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueue
 
 bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>& item, string& configName) {
     configName.clear();
-    lock_guard<mutex> lock(mQueueMux);
-    for (size_t i = 0; i <= sMaxPriority; ++i) {
-        ProcessQueueIterator iter;
-        if (mCurrentQueueIndex.first == i) {
-            for (iter = mCurrentQueueIndex.second; iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
-                    continue;
-                }
-                configName = (*iter)->GetConfigName();
-                break;
+    uint64_t triggerSeq = 0;
+    {
+        lock_guard<mutex> lock(mStateMux);
+        triggerSeq = mTriggerSeq;
+    }
+    {
+        shared_lock<shared_mutex> lock(mQueueMux);
+        for (uint32_t i = 0; i <= sMaxPriority; ++i) {
+            if (PopItemFromPriorityQueue(i, item, configName)) {
+                return true;
             }
-            if (configName.empty()) {
-                for (iter = mPriorityQueue[i].begin(); iter != mCurrentQueueIndex.second; ++iter) {
-                    if (!(*iter)->Pop(item)) {
+            // find exactly once queues next
+            {
+                lock_guard<mutex> lock(ExactlyOnceQueueManager::GetInstance()->mProcessQueueMux);
+                for (auto iter = ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].begin();
+                     iter != ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].end();
+                     ++iter) {
+                    // process queue for exactly once can only be assgined to one specific thread
+                    if (iter->GetKey() % INT32_FLAG(process_thread_count) != threadNo) {
                         continue;
                     }
-                    configName = (*iter)->GetConfigName();
-                    break;
-                }
-            }
-        } else {
-            for (iter = mPriorityQueue[i].begin(); iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
-                    continue;
+                    if (!iter->Pop(item)) {
+                        continue;
+                    }
+                    configName = iter->GetConfigName();
+                    lock_guard<mutex> indexLock(mCurrentQueueIndexMux);
+                    ResetCurrentQueueIndex();
+                    return true;
                 }
-                configName = (*iter)->GetConfigName();
-                break;
             }
         }
-        if (!configName.empty()) {
-            mCurrentQueueIndex.first = i;
-            mCurrentQueueIndex.second = ++iter;
-            if (mCurrentQueueIndex.second == mPriorityQueue[i].end()) {
-                mCurrentQueueIndex.second = mPriorityQueue[i].begin();
-            }
-            return true;
+        lock_guard<mutex> indexLock(mCurrentQueueIndexMux);
+        ResetCurrentQueueIndex();
+    }
+    // Queues skipped for being popped by other threads are not lost, since those threads trigger again if items are
+    // left after popping. The flag is kept if anything is triggered during the scan, otherwise the thread would miss it
+    // and wait for nothing.
+    unique_lock<mutex> lock(mStateMux);
+    if (mTriggerSeq == triggerSeq) {
+        mValidToPop = false;
+    }
+    return false;
+}
+
+bool ProcessQueueManager::PopItemFromPriorityQueue(uint32_t priority,
+                                                   unique_ptr<ProcessQueueItem>& item,
+                                                   string& configName) {
+    auto& queues = mPriorityQueue[priority];
+    if (queues.empty()) {
+        return false;
+    }
+    ProcessQueueIterator begin = queues.begin();
+    {
+        lock_guard<mutex> lock(mCurrentQueueIndexMux);
+        if (mCurrentQueueIndex.first == priority && mCurrentQueueIndex.second != queues.end()) {
+            begin = mCurrentQueueIndex.second;
         }
-        // find exactly once queues next
-        {
-            lock_guard<mutex> lock(ExactlyOnceQueueManager::GetInstance()->mProcessQueueMux);
-            for (auto iter = ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].begin();
-                 iter != ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].end();
-                 ++iter) {
-                // process queue for exactly once can only be assgined to one specific thread
-                if (iter->GetKey() % INT32_FLAG(process_thread_count) != threadNo) {
-                    continue;
+    }
+    // round robin from the current index, empty queues are skipped without locking, and queues being popped by other
+    // threads are skipped so that threads are not blocked by each other
+    auto iter = begin;
+    do {
+        auto& que = *iter;
+        if (que->MayHaveItem()) {
+            unique_lock<mutex> queLock(que->GetMux(), try_to_lock);
+            if (queLock.owns_lock() && que->Pop(item)) {
+                que->UpdateMayHaveItem();
+                bool hasItemLeft = que->MayHaveItem();
+                configName = que->GetConfigName();
+                queLock.unlock();
+                if (++iter == queues.end()) {
+                    iter = queues.begin();
+                }
+                {
+                    lock_guard<mutex> lock(mCurrentQueueIndexMux);
+                    mCurrentQueueIndex.first = priority;
+                    mCurrentQueueIndex.second = iter;
                 }
-                if (!iter->Pop(item)) {
-                    continue;
+                // wake up one idle thread, which may have skipped this queue while it was being popped
+                if (hasItemLeft) {
+                    Trigger();
                 }
-                configName = iter->GetConfigName();
-                ResetCurrentQueueIndex();
                 return true;
             }
         }
-    }
-    ResetCurrentQueueIndex();
-    {
-        unique_lock<mutex> lock(mStateMux);
-        mValidToPop = false;
-    }
+        if (++iter == queues.end()) {
+            iter = queues.begin();
+        }
+    } while (iter != begin);
     return false;
 }
 
 bool ProcessQueueManager::IsAllQueueEmpty() const {
     {
-        lock_guard<mutex> lock(mQueueMux);
+        shared_lock<shared_mutex> lock(mQueueMux);
         for (const auto& q : mQueues) {
+            lock_guard<mutex> queLock((*q.second.first)->GetMux());
             if (!(*q.second.first)->Empty()) {
                 return false;
             }
@@ -209,7 +243,7 @@ bool ProcessQueueManager::IsAllQueueEmpty() const {
 }
 
 bool ProcessQueueManager::SetDownStreamQueues(QueueKey key, vector<BoundedSenderQueueInterface*>&& ques) {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter == mQueues.end()) {
         return false;
@@ -219,7 +253,7 @@ bool ProcessQueueManager::SetDownStreamQueues(QueueKey key, vector<BoundedSender
 }
 
 bool ProcessQueueManager::SetFeedbackInterface(QueueKey key, vector<FeedbackInterface*>&& feedback) {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter == mQueues.end()) {
         return false;
@@ -234,7 +268,7 @@ bool ProcessQueueManager::SetFeedbackInterface(QueueKey key, vector<FeedbackInte
 void ProcessQueueManager::DisablePop(const string& configName, bool isPipelineRemoving) {
     if (QueueKeyManager::GetInstance()->HasKey(configName)) {
         auto key = QueueKeyManager::GetInstance()->GetKey(configName);
-        lock_guard<mutex> lock(mQueueMux);
+        lock_guard<shared_mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
             (*iter->second.first)->DisablePop();
@@ -247,7 +281,7 @@ void ProcessQueueManager::DisablePop(const string& configName, bool isPipelineRe
 void ProcessQueueManager::EnablePop(const string& configName) {
     if (QueueKeyManager::GetInstance()->HasKey(configName)) {
         auto key = QueueKeyManager::GetInstance()->GetKey(configName);
-        lock_guard<mutex> lock(mQueueMux);
+        lock_guard<shared_mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
             (*iter->second.first)->EnablePop();
@@ -272,6 +306,7 @@ void ProcessQueueManager::Trigger() {
     {
         lock_guard<mutex> lock(mStateMux);
         mValidToPop = true;
+        ++mTriggerSeq;
     }
     mCond.notify_one();
 }
@@ -327,7 +362,7 @@ void ProcessQueueManager::ResetCurrentQueueIndex() {
 
 #ifdef APSARA_UNIT_TEST_MAIN
 void ProcessQueueManager::Clear() {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     mQueues.clear();
     for (size_t i = 0; i <= sMaxPriority; ++i) {
         mPriorityQueue[i].clear();
@@ -22,6 +22,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -82,20 +83,30 @@ private:
     void DeleteQueueEntity(const ProcessQueueIterator& iter);
     void ResetCurrentQueueIndex();
 
+    bool PopItemFromPriorityQueue(uint32_t priority,
+                                  std::unique_ptr<ProcessQueueItem>& item,
+                                  std::string& configName);
+
     BoundedQueueParam mBoundedQueueParam;
 
-    mutable std::mutex mQueueMux;
+    // Queue list is only modified with the lock held exclusively. Pushing and popping only hold the lock in shared mode
+    // and lock the queue itself, so that processor threads can pop from different queues concurrently.
+    mutable std::shared_mutex mQueueMux;
     std::unordered_map<QueueKey, std::pair<ProcessQueueIterator, QueueType>> mQueues;
     std::list<std::unique_ptr<ProcessQueueInterface>> mPriorityQueue[sMaxPriority + 1];
+    std::mutex mCurrentQueueIndexMux;
     std::pair<uint32_t, ProcessQueueIterator> mCurrentQueueIndex;
 
     mutable std::mutex mStateMux;
     mutable std::condition_variable mCond;
     bool mValidToPop = false;
+    // increased on each trigger, so that a failed pop does not clear the flag set by triggers during it
+    uint64_t mTriggerSeq = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
     friend class ProcessQueueManagerUnittest;
+    friend class ProcessQueueManagerBenchmark;
     friend class PipelineUnittest;
     friend class PipelineUpdateUnittest;
     friend class HostMonitorInputRunnerUnittest;
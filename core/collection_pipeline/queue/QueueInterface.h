@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include "collection_pipeline/CollectionPipelineContext.h"
+#include "collection_pipeline/limiter/MemoryGovernor.h"
 #include "collection_pipeline/queue/QueueKey.h"
 #include "monitor/MetricManager.h"
 #include "monitor/metric_constants/MetricConstants.h"
@@ -26,7 +29,10 @@ namespace logtail {
 template <typename T>
 class QueueInterface {
 public:
-    QueueInterface(QueueKey key, size_t cap, const CollectionPipelineContext& ctx) : mKey(key), mCapacity(cap) {
+    QueueInterface(QueueKey key, size_t cap, const CollectionPipelineContext& ctx)
+        : mKey(key),
+          mCapacity(cap),
+          mMemoryQuota(MemoryGovernor::GetInstance()->GetPipelineQuota(ctx.GetConfigName())) {
         WriteMetrics::GetInstance()->CreateMetricsRecordRef(mMetricsRecordRef,
                                                             MetricCategory::METRIC_CATEGORY_COMPONENT,
                                                             {
@@ -41,7 +47,7 @@ public:
         mQueueSizeTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_SIZE);
         mQueueDataSizeByte = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_SIZE_BYTES);
     }
-    virtual ~QueueInterface() = default;
+    virtual ~QueueInterface() { mMemoryQuota->Release(mChargedBytes); }
 
     QueueInterface(const QueueInterface& que) = delete;
     QueueInterface& operator=(const QueueInterface&) = delete;
@@ -56,8 +62,20 @@ public:
     void Reset(size_t cap) { mCapacity = cap; }
 
 protected:
+    void ChargeMemory(size_t bytes) {
+        mChargedBytes += bytes;
+        mMemoryQuota->Charge(bytes);
+    }
+    void ReleaseMemory(size_t bytes) {
+        mChargedBytes -= bytes;
+        mMemoryQuota->Release(bytes);
+    }
+
     const QueueKey mKey;
     size_t mCapacity = 0;
+    // bytes of the items in the queue are charged to the memory quota of the pipeline
+    std::shared_ptr<MemoryQuota> mMemoryQuota;
+    int64_t mChargedBytes = 0;
 
     mutable MetricsRecordRef mMetricsRecordRef;
     CounterPtr mInItemsTotal;
@@ -61,6 +61,7 @@ bool SenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
             return false;
         }
         mExtraBuffer.push_back(std::move(item));
+        ChargeMemory(size);
 
         SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
         ADD_GAUGE(mExtraBufferDataSizeBytes, size);
@@ -79,6 +80,7 @@ bool SenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
     }
     ++mSize;
     ChangeStateIfNeededAfterPush();
+    ChargeMemory(size);
 
     SET_GAUGE(mQueueSizeTotal, Size());
     ADD_GAUGE(mQueueDataSizeByte, size);
@@ -109,6 +111,7 @@ bool SenderQueue::Remove(SenderQueueItem* item) {
         ++mRead;
     }
     --mSize;
+    ReleaseMemory(size);
 
     ADD_COUNTER(mOutItemsTotal, 1);
     ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - enQueuTime);
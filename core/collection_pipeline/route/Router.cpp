@@ -65,7 +65,7 @@ vector<pair<size_t, PipelineEventGroup>> Router::Route(PipelineEventGroup& g) co
         if (resSz == 1) {
             res.emplace_back(mAlwaysMatchedFlusherIdx[i], std::move(g));
         } else {
-            res.emplace_back(mAlwaysMatchedFlusherIdx[i], g.Copy());
+            res.emplace_back(mAlwaysMatchedFlusherIdx[i], g.Share());
         }
     }
     for (size_t i = 0; i < dest.size(); ++i, --resSz) {
@@ -73,9 +73,9 @@ vector<pair<size_t, PipelineEventGroup>> Router::Route(PipelineEventGroup& g) co
             mConditions[dest[i]].second.GetResult(g);
             res.emplace_back(dest[i], std::move(g));
         } else {
-            auto copy = g.Copy();
-            mConditions[dest[i]].second.GetResult(copy);
-            res.emplace_back(dest[i], std::move(copy));
+            auto shared = g.Share();
+            mConditions[dest[i]].second.GetResult(shared);
+            res.emplace_back(dest[i], std::move(shared));
         }
     }
     return res;
@@ -15,6 +15,7 @@
 #include "collection_pipeline/serializer/SLSSerializer.h"
 
 #include <array>
+#include <chrono>
 #include <vector>
 
 #include "rapidjson/stringbuffer.h"
@@ -37,6 +38,8 @@ namespace logtail {
 
 // Maximum size threshold for thread_local buffer before reallocation
 constexpr size_t kMaxThreadLocalBufferSize = 1024 * 1024;
+// size of the chunks handed to the compressor when the log group is compressed while being serialized
+constexpr size_t kSerializeChunkSize = 128 * 1024;
 
 void SerializeSpanLinksToString(const SpanEvent& event, std::string& result) {
     if (event.GetLinks().empty()) {
@@ -159,6 +162,42 @@ void SerializeSpanAttributesToString(const SpanEvent& event, std::string& result
 }
 
 bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, string& errorMsg) {
+    size_t rawSize = 0;
+    bool isCompressFailed = false;
+    return SerializeLogGroup(group, nullptr, res, rawSize, isCompressFailed, errorMsg);
+}
+
+bool SLSEventGroupSerializer::DoSerializeAndCompress(BatchedEvents&& group,
+                                                     Compressor& compressor,
+                                                     string& output,
+                                                     size_t& rawSize,
+                                                     bool& isCompressFailed,
+                                                     string& errorMsg) {
+    auto inputSize = GetInputSize(group);
+    ADD_COUNTER(mInItemsTotal, 1);
+    ADD_COUNTER(mInItemSizeBytes, inputSize);
+
+    auto before = chrono::system_clock::now();
+    auto res = SerializeLogGroup(group, &compressor, output, rawSize, isCompressFailed, errorMsg);
+    ADD_COUNTER(mTotalProcessMs, chrono::system_clock::now() - before);
+
+    if (res) {
+        ADD_COUNTER(mOutItemsTotal, 1);
+        ADD_COUNTER(mOutItemSizeBytes, rawSize);
+    } else {
+        ADD_COUNTER(mDiscardedItemsTotal, 1);
+        ADD_COUNTER(mDiscardedItemSizeBytes, inputSize);
+    }
+    return res;
+}
+
+bool SLSEventGroupSerializer::SerializeLogGroup(BatchedEvents& group,
+                                                Compressor* compressor,
+                                                string& res,
+                                                size_t& rawSize,
+                                                bool& isCompressFailed,
+                                                string& errorMsg) {
+    isCompressFailed = false;
     if (group.mEvents.empty()) {
         errorMsg = "empty event group";
         return false;
@@ -217,37 +256,55 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
         return false;
     }
 
-    thread_local LogGroupSerializer serializer;
-    serializer.Prepare(logGroupSZ);
-    switch (eventType) {
-        case PipelineEvent::Type::LOG:
-            SerializeLogEvent(serializer, group, logSZ, enableNs);
-            break;
-        case PipelineEvent::Type::METRIC:
-            SerializeMetricEvent(serializer, group, metricEventContentCache, logSZ);
-            break;
-        case PipelineEvent::Type::SPAN:
-            SerializeSpanEvent(serializer, group, spanEventContentCache, logSZ);
-            break;
-        case PipelineEvent::Type::RAW:
-            SerializeRawEvent(serializer, group, logSZ, enableNs);
-            break;
-        default:
-            break;
-    }
-    for (const auto& tag : group.mTags.mInner) {
-        if (tag.first == LOG_RESERVED_KEY_TOPIC) {
-            serializer.AddTopic(tag.second);
-        } else if (tag.first == LOG_RESERVED_KEY_SOURCE) {
-            serializer.AddSource(tag.second);
-        } else if (tag.first == LOG_RESERVED_KEY_MACHINE_UUID) {
-            serializer.AddMachineUUID(tag.second);
-        } else {
-            serializer.AddLogTag(tag.first, tag.second);
+    rawSize = logGroupSZ;
+
+    auto serializeEvents = [&](LogGroupSerializer& serializer) {
+        switch (eventType) {
+            case PipelineEvent::Type::LOG:
+                SerializeLogEvent(serializer, group, logSZ, enableNs);
+                break;
+            case PipelineEvent::Type::METRIC:
+                SerializeMetricEvent(serializer, group, metricEventContentCache, logSZ);
+                break;
+            case PipelineEvent::Type::SPAN:
+                SerializeSpanEvent(serializer, group, spanEventContentCache, logSZ);
+                break;
+            case PipelineEvent::Type::RAW:
+                SerializeRawEvent(serializer, group, logSZ, enableNs);
+                break;
+            default:
+                break;
+        }
+        for (const auto& tag : group.mTags.mInner) {
+            if (tag.first == LOG_RESERVED_KEY_TOPIC) {
+                serializer.AddTopic(tag.second);
+            } else if (tag.first == LOG_RESERVED_KEY_SOURCE) {
+                serializer.AddSource(tag.second);
+            } else if (tag.first == LOG_RESERVED_KEY_MACHINE_UUID) {
+                serializer.AddMachineUUID(tag.second);
+            } else {
+                serializer.AddLogTag(tag.first, tag.second);
+            }
         }
+    };
+    thread_local LogGroupSerializer serializer;
+    if (compressor == nullptr) {
+        serializer.Prepare(logGroupSZ);
+        serializeEvents(serializer);
+        res = std::move(serializer.GetResult());
+        return true;
     }
-    res = std::move(serializer.GetResult());
-    return true;
+    // the group is valid from here on, so any failure is caused by the compressor
+    isCompressFailed = !compressor->DoCompressStream(
+        logGroupSZ,
+        [&](const Compressor::ChunkWriter& writer) {
+            serializer.PrepareStreaming(writer, kSerializeChunkSize);
+            serializeEvents(serializer);
+            return serializer.Finish();
+        },
+        res,
+        errorMsg);
+    return !isCompressFailed;
 }
 
 void SLSEventGroupSerializer::CalculateLogEventSize(const BatchedEvents& group,
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "collection_pipeline/serializer/Serializer.h"
+#include "common/compression/Compressor.h"
 #include "protobuf/sls/LogGroupSerializer.h"
 
 namespace logtail {
@@ -33,8 +34,24 @@ class SLSEventGroupSerializer : public Serializer<BatchedEvents> {
 public:
     SLSEventGroupSerializer(Flusher* f) : Serializer<BatchedEvents>(f) {}
 
+    // Compresses the log group chunk by chunk while it is being serialized, so that the whole serialized log group is
+    // never held in memory if the compressor supports streaming. @rawSize is set to the size of the log group. On
+    // failure, @isCompressFailed tells whether the group is valid but the compressor fails.
+    bool DoSerializeAndCompress(BatchedEvents&& p,
+                                Compressor& compressor,
+                                std::string& output,
+                                size_t& rawSize,
+                                bool& isCompressFailed,
+                                std::string& errorMsg);
+
 private:
     bool Serialize(BatchedEvents&& p, std::string& res, std::string& errorMsg) override;
+    bool SerializeLogGroup(BatchedEvents& group,
+                           Compressor* compressor,
+                           std::string& res,
+                           size_t& rawSize,
+                           bool& isCompressFailed,
+                           std::string& errorMsg);
 
     void CalculateLogEventSize(const BatchedEvents& group,
                                size_t& logGroupSZ,
@@ -0,0 +1,36 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/Re2Util.h"
+
+using namespace std;
+
+namespace logtail {
+
+const re2::RE2::Options& GetBoostCompatibleRe2Options() {
+    static const re2::RE2::Options sOptions = []() {
+        re2::RE2::Options options;
+        options.set_encoding(re2::RE2::Options::EncodingLatin1);
+        options.set_dot_nl(true);
+        options.set_log_errors(false);
+        return options;
+    }();
+    return sOptions;
+}
+
+string GetBoostCompatibleRe2Pattern(const string& regex) {
+    return "(?m)" + regex;
+}
+
+} // namespace logtail
@@ -0,0 +1,32 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include "re2/re2.h"
+
+namespace logtail {
+
+// RE2 is used in place of boost::regex with perl syntax where the user regex allows. With the options and pattern below,
+// RE2 matches bytes instead of utf-8 characters, '.' matches newline as well, and ^ and $ match at line boundaries, all
+// as boost does. The remaining differences are:
+// 1. \s does not match \v in RE2, while it does in boost;
+// 2. backreferences, lookarounds, possessive quantifiers and atomic groups are not supported by RE2, so patterns using
+//    them fail to compile, and callers must fall back to boost regex when RE2::ok() is false.
+const re2::RE2::Options& GetBoostCompatibleRe2Options();
+std::string GetBoostCompatibleRe2Pattern(const std::string& regex);
+
+} // namespace logtail
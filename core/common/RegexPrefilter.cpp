@@ -0,0 +1,547 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/RegexPrefilter.h"
+
+#include <cstring>
+
+#include "common/StringTools.h"
+#include "common/StringView.h"
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+using CharSet = bitset<256>;
+
+// longer shapes or literals hardly reject more lines
+const size_t kMaxShapeSize = 64;
+const size_t kMaxLiteralSize = 64;
+
+CharSet Range(unsigned char from, unsigned char to) {
+    CharSet res;
+    for (size_t c = from; c <= to; ++c) {
+        res.set(c);
+    }
+    return res;
+}
+
+CharSet Single(unsigned char c) {
+    CharSet res;
+    res.set(c);
+    return res;
+}
+
+const CharSet& HighBytes() {
+    static const CharSet sRes = Range(0x80, 0xff);
+    return sRes;
+}
+
+const CharSet& Digits() {
+    static const CharSet sRes = Range('0', '9');
+    return sRes;
+}
+
+const CharSet& WordChars() {
+    static const CharSet sRes = Range('a', 'z') | Range('A', 'Z') | Range('0', '9') | Single('_');
+    return sRes;
+}
+
+const CharSet& Spaces() {
+    static const CharSet sRes = Range('\t', '\r') | Single(' ');
+    return sRes;
+}
+
+// Which chars are matched by classes like \d depends on the locale, so both an under and an over approximation are
+// kept. Chars outside ASCII are assumed to be matched by positive classes only in the over approximation.
+struct CharClass {
+    CharSet mUnder;
+    CharSet mOver;
+
+    static CharClass Positive(const CharSet& asciiSet) { return CharClass{asciiSet, asciiSet | HighBytes()}; }
+    static CharClass Negative(const CharSet& asciiSet) { return CharClass{~(asciiSet | HighBytes()), ~asciiSet}; }
+    static CharClass Exact(const CharSet& set) { return CharClass{set, set}; }
+};
+
+bool ParseClassEscape(char c, CharClass& res) {
+    switch (c) {
+        case 'd':
+            res = CharClass::Positive(Digits());
+            return true;
+        case 'D':
+            res = CharClass::Negative(Digits());
+            return true;
+        case 'w':
+            res = CharClass::Positive(WordChars());
+            return true;
+        case 'W':
+            res = CharClass::Negative(WordChars());
+            return true;
+        case 's':
+            res = CharClass::Positive(Spaces());
+            return true;
+        case 'S':
+            res = CharClass::Negative(Spaces());
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool IsZeroWidthEscape(char c) {
+    switch (c) {
+        case 'b':
+        case 'B':
+        case 'A':
+        case 'z':
+        case 'Z':
+        case 'G':
+        case '<':
+        case '>':
+        case '`':
+        case '\'':
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool ParseLiteralEscape(char c, char& res) {
+    switch (c) {
+        case 't':
+            res = '\t';
+            return true;
+        case 'n':
+            res = '\n';
+            return true;
+        case 'r':
+            res = '\r';
+            return true;
+        case 'f':
+            res = '\f';
+            return true;
+        case 'v':
+            res = '\v';
+            return true;
+        case 'a':
+            res = '\a';
+            return true;
+        case 'e':
+            res = 0x1b;
+            return true;
+        default:
+            break;
+    }
+    // other escaped letters and digits have special meanings, e.g. \x, \Q and backreferences
+    if (isalnum(static_cast<unsigned char>(c)) || IsZeroWidthEscape(c) || static_cast<unsigned char>(c) >= 0x80) {
+        return false;
+    }
+    res = c;
+    return true;
+}
+
+bool ParsePosixClass(const string& name, CharClass& res) {
+    if (name == "digit" || name == "d") {
+        res = CharClass::Positive(Digits());
+    } else if (name == "alpha") {
+        res = CharClass::Positive(Range('a', 'z') | Range('A', 'Z'));
+    } else if (name == "alnum") {
+        res = CharClass::Positive(Range('a', 'z') | Range('A', 'Z') | Digits());
+    } else if (name == "upper") {
+        res = CharClass::Positive(Range('A', 'Z'));
+    } else if (name == "lower") {
+        res = CharClass::Positive(Range('a', 'z'));
+    } else if (name == "space" || name == "s") {
+        res = CharClass::Positive(Spaces());
+    } else if (name == "word" || name == "w") {
+        res = CharClass::Positive(WordChars());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+class PatternAnalyzer {
+public:
+    explicit PatternAnalyzer(const string& pattern) : mPattern(pattern) {}
+
+    bool Analyze();
+
+    vector<CharSet> mShape;
+    string mLiteral;
+
+private:
+    enum class AtomType { LITERAL, CLASS, OTHER };
+
+    bool ParseAtom(size_t& i, AtomType& type, CharClass& cls, char& literal) const;
+    bool ParseBracket(size_t& i, CharClass& cls) const;
+    bool SkipBracket(size_t& i) const;
+    bool SkipGroup(size_t& i) const;
+    bool ParseQuantifier(size_t& i, size_t& min, bool& isExact) const;
+    void FlushLiteral();
+
+    const string& mPattern;
+    string mCurrentLiteral;
+};
+
+bool PatternAnalyzer::Analyze() {
+    size_t i = 0;
+    bool isShapeOpen = false;
+    if (!mPattern.empty() && mPattern[0] == '^') {
+        isShapeOpen = true;
+        ++i;
+    }
+    while (i < mPattern.size()) {
+        AtomType type = AtomType::OTHER;
+        CharClass cls;
+        char literal = 0;
+        size_t min = 1;
+        bool isExact = true;
+        if (!ParseAtom(i, type, cls, literal) || !ParseQuantifier(i, min, isExact)) {
+            return false;
+        }
+        if (isShapeOpen) {
+            if (type == AtomType::OTHER) {
+                isShapeOpen = false;
+            } else {
+                const CharSet& set = type == AtomType::LITERAL ? Single(literal) : cls.mOver;
+                for (size_t k = 0; k < min && mShape.size() < kMaxShapeSize; ++k) {
+                    mShape.push_back(set);
+                }
+                if (!isExact || mShape.size() >= kMaxShapeSize) {
+                    isShapeOpen = false;
+                }
+            }
+        }
+        if (type == AtomType::LITERAL && min > 0) {
+            mCurrentLiteral.append(std::min(min, kMaxLiteralSize), literal);
+            if (!isExact) {
+                FlushLiteral();
+            }
+        } else {
+            FlushLiteral();
+        }
+    }
+    FlushLiteral();
+    return true;
+}
+
+bool PatternAnalyzer::ParseAtom(size_t& i, AtomType& type, CharClass& cls, char& literal) const {
+    char c = mPattern[i];
+    switch (c) {
+        case '|':
+        case ')':
+        case ']':
+        case '}':
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            return false;
+        case '(':
+            type = AtomType::OTHER;
+            return SkipGroup(i);
+        case '[':
+            type = AtomType::CLASS;
+            return ParseBracket(i, cls);
+        case '.':
+            type = AtomType::CLASS;
+            cls = CharClass::Exact(CharSet().set());
+            ++i;
+            return true;
+        case '^':
+        case '$':
+            type = AtomType::OTHER;
+            ++i;
+            return true;
+        case '\\': {
+            if (i + 1 >= mPattern.size()) {
+                return false;
+            }
+            char e = mPattern[i + 1];
+            i += 2;
+            if (ParseClassEscape(e, cls)) {
+                type = AtomType::CLASS;
+                return true;
+            }
+            if (IsZeroWidthEscape(e)) {
+                type = AtomType::OTHER;
+                return true;
+            }
+            type = AtomType::LITERAL;
+            return ParseLiteralEscape(e, literal);
+        }
+        default:
+            type = AtomType::LITERAL;
+            literal = c;
+            ++i;
+            return true;
+    }
+}
+
+bool PatternAnalyzer::ParseBracket(size_t& i, CharClass& cls) const {
+    size_t k = i + 1;
+    bool isNegative = false;
+    if (k < mPattern.size() && mPattern[k] == '^') {
+        isNegative = true;
+        ++k;
+    }
+    CharSet under, over;
+    bool isFirst = true;
+    while (true) {
+        if (k >= mPattern.size()) {
+            return false;
+        }
+        char c = mPattern[k];
+        if (c == ']' && !isFirst) {
+            break;
+        }
+        isFirst = false;
+
+        CharClass item;
+        bool isChar = false;
+        char ch = 0;
+        if (c == '[' && k + 1 < mPattern.size() && mPattern[k + 1] == ':') {
+            size_t end = mPattern.find(":]", k + 2);
+            if (end == string::npos || !ParsePosixClass(mPattern.substr(k + 2, end - k - 2), item)) {
+                return false;
+            }
+            k = end + 2;
+        } else if (c == '[' && k + 1 < mPattern.size() && (mPattern[k + 1] == '.' || mPattern[k + 1] == '=')) {
+            return false;
+        } else if (c == '\\') {
+            if (k + 1 >= mPattern.size()) {
+                return false;
+            }
+            char e = mPattern[k + 1];
+            k += 2;
+            if (!ParseClassEscape(e, item)) {
+                // \b means backspace in brackets
+                if (e == 'b' || !ParseLiteralEscape(e, ch)) {
+                    return false;
+                }
+                isChar = true;
+            }
+        } else {
+            ch = c;
+            ++k;
+            isChar = true;
+        }
+
+        if (isChar && k + 1 < mPattern.size() && mPattern[k] == '-' && mPattern[k + 1] != ']') {
+            ++k;
+            char to = mPattern[k];
+            if (to == '[') {
+                return false;
+            }
+            if (to == '\\') {
+                if (k + 1 >= mPattern.size() || !ParseLiteralEscape(mPattern[k + 1], to)) {
+                    return false;
+                }
+                ++k;
+            }
+            ++k;
+            unsigned char fromCode = static_cast<unsigned char>(ch), toCode = static_cast<unsigned char>(to);
+            // the order of non-ascii chars depends on the signedness of char and the locale
+            if (fromCode >= 0x80 || toCode >= 0x80 || fromCode > toCode) {
+                return false;
+            }
+            item = CharClass::Exact(Range(fromCode, toCode));
+        } else if (isChar) {
+            item = CharClass::Exact(Single(static_cast<unsigned char>(ch)));
+        }
+        under |= item.mUnder;
+        over |= item.mOver;
+    }
+    i = k + 1;
+    cls = isNegative ? CharClass{~over, ~under} : CharClass{under, over};
+    return true;
+}
+
+bool PatternAnalyzer::SkipBracket(size_t& i) const {
+    size_t k = i + 1;
+    if (k < mPattern.size() && mPattern[k] == '^') {
+        ++k;
+    }
+    if (k < mPattern.size() && mPattern[k] == ']') {
+        ++k;
+    }
+    while (k < mPattern.size()) {
+        char c = mPattern[k];
+        if (c == '\\') {
+            k += 2;
+        } else if (c == '[' && k + 1 < mPattern.size()
+                   && (mPattern[k + 1] == ':' || mPattern[k + 1] == '.' || mPattern[k + 1] == '=')) {
+            size_t end = mPattern.find(string(1, mPattern[k + 1]) + "]", k + 2);
+            if (end == string::npos) {
+                return false;
+            }
+            k = end + 2;
+        } else if (c == ']') {
+            i = k + 1;
+            return true;
+        } else {
+            ++k;
+        }
+    }
+    return false;
+}
+
+bool PatternAnalyzer::SkipGroup(size_t& i) const {
+    size_t k = i + 1;
+    if (k < mPattern.size() && mPattern[k] == '?') {
+        // only non-capturing groups, lookarounds, atomic groups and named groups are allowed, since inline modifiers
+        // like (?i) change the meaning of the rest of the pattern
+        char c = k + 1 < mPattern.size() ? mPattern[k + 1] : '\0';
+        if (c != ':' && c != '=' && c != '!' && c != '<' && c != '>' && c != '\''
+            && !(c == 'P' && k + 2 < mPattern.size() && mPattern[k + 2] == '<')) {
+            return false;
+        }
+    }
+    size_t depth = 1;
+    while (k < mPattern.size()) {
+        char c = mPattern[k];
+        if (c == '\\') {
+            k += 2;
+        } else if (c == '[') {
+            if (!SkipBracket(k)) {
+                return false;
+            }
+        } else if (c == '(') {
+            ++depth;
+            ++k;
+        } else if (c == ')') {
+            ++k;
+            if (--depth == 0) {
+                i = k;
+                return true;
+            }
+        } else {
+            ++k;
+        }
+    }
+    return false;
+}
+
+bool PatternAnalyzer::ParseQuantifier(size_t& i, size_t& min, bool& isExact) const {
+    min = 1;
+    isExact = true;
+    if (i >= mPattern.size()) {
+        return true;
+    }
+    switch (mPattern[i]) {
+        case '*':
+            min = 0;
+            isExact = false;
+            ++i;
+            break;
+        case '+':
+            isExact = false;
+            ++i;
+            break;
+        case '?':
+            min = 0;
+            isExact = false;
+            ++i;
+            break;
+        case '{': {
+            size_t k = i + 1;
+            size_t n = 0;
+            size_t digitCnt = 0;
+            for (; k < mPattern.size() && isdigit(static_cast<unsigned char>(mPattern[k])) && digitCnt < 6;
+                 ++k, ++digitCnt) {
+                n = n * 10 + (mPattern[k] - '0');
+            }
+            if (digitCnt == 0 || k >= mPattern.size()) {
+                return false;
+            }
+            if (mPattern[k] == ',') {
+                isExact = false;
+                for (++k; k < mPattern.size() && isdigit(static_cast<unsigned char>(mPattern[k])); ++k) {
+                }
+            }
+            if (k >= mPattern.size() || mPattern[k] != '}') {
+                return false;
+            }
+            min = n;
+            i = k + 1;
+            break;
+        }
+        default:
+            return true;
+    }
+    // lazy or possessive quantifiers
+    if (i < mPattern.size() && (mPattern[i] == '?' || mPattern[i] == '+')) {
+        ++i;
+    }
+    return true;
+}
+
+void PatternAnalyzer::FlushLiteral() {
+    if (mCurrentLiteral.size() > mLiteral.size()) {
+        mLiteral = mCurrentLiteral.substr(0, kMaxLiteralSize);
+    }
+    mCurrentLiteral.clear();
+}
+
+// ^ also matches after these chars with the default flags of boost regex
+bool HasLineSeparator(const char* buffer, size_t size) {
+    return memchr(buffer, '\n', size) != nullptr || memchr(buffer, '\r', size) != nullptr
+        || memchr(buffer, '\f', size) != nullptr || memchr(buffer, '\x85', size) != nullptr;
+}
+
+} // namespace
+
+shared_ptr<RegexPrefilter> RegexPrefilter::Create(const string& pattern) {
+    PatternAnalyzer analyzer(pattern);
+    if (!analyzer.Analyze() || (analyzer.mShape.empty() && analyzer.mLiteral.empty())) {
+        return nullptr;
+    }
+    auto res = make_shared<RegexPrefilter>();
+    res->mShape = std::move(analyzer.mShape);
+    res->mLiteral = std::move(analyzer.mLiteral);
+    return res;
+}
+
+bool RegexPrefilter::MayMatch(const char* buffer, size_t size) const {
+    // the literal is checked first, since a mismatched shape requires to scan the whole buffer for line separators
+    if (!mLiteral.empty() && StringView(buffer, size).find(mLiteral) == StringView::npos) {
+        return false;
+    }
+    if (!mShape.empty()) {
+        bool isShapeMatched = size >= mShape.size();
+        for (size_t i = 0; isShapeMatched && i < mShape.size(); ++i) {
+            isShapeMatched = mShape[i].test(static_cast<unsigned char>(buffer[i]));
+        }
+        if (!isShapeMatched && !HasLineSeparator(buffer, size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BoostRegexSearch(const char* buffer,
+                      size_t size,
+                      const boost::regex& reg,
+                      const RegexPrefilter* prefilter,
+                      string& exception) {
+    if (prefilter != nullptr && !prefilter->MayMatch(buffer, size)) {
+        return false;
+    }
+    return BoostRegexSearch(buffer, size, reg, exception);
+}
+
+} // namespace logtail
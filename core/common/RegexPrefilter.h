@@ -0,0 +1,58 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "boost/regex.hpp"
+
+namespace logtail {
+
+// RegexPrefilter rejects most unmatched lines of a regex_search with cheap checks, so that the full regex is only run
+// on lines which may match. Two kinds of information are extracted from the pattern:
+// 1. for patterns anchored with ^, the set of acceptable chars at each of the first positions of the line, e.g. digits
+//    for the first 4 chars of ^\d{4}-\d{2}-\d{2};
+// 2. the longest literal that every match must contain, e.g. "Exception" for \w+Exception:.
+// The analysis is conservative: patterns with top-level alternation, inline modifiers or syntax not understood produce
+// no prefilter, and unknown parts of a pattern simply stop the analysis, so a line rejected by the prefilter can never
+// be matched by the regex.
+class RegexPrefilter {
+public:
+    // return nullptr if no useful check can be extracted from the pattern
+    static std::shared_ptr<RegexPrefilter> Create(const std::string& pattern);
+
+    // false means the pattern cannot be found in the buffer
+    bool MayMatch(const char* buffer, size_t size) const;
+
+    size_t GetShapeSize() const { return mShape.size(); }
+    const std::string& GetLiteral() const { return mLiteral; }
+
+private:
+    std::vector<std::bitset<256>> mShape;
+    std::string mLiteral;
+};
+
+// BoostRegexSearch with an optional prefilter built from the same pattern
+bool BoostRegexSearch(const char* buffer,
+                      size_t size,
+                      const boost::regex& reg,
+                      const RegexPrefilter* prefilter,
+                      std::string& exception);
+
+} // namespace logtail
@@ -0,0 +1,131 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/SimdUtil.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LOGTAIL_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace logtail {
+
+SimdLevel GetSimdLevel() {
+#ifdef LOGTAIL_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    // sse2 is part of x86_64
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::NONE;
+#endif
+}
+
+const char* SimdLevelToString(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2:
+            return "sse2";
+        case SimdLevel::AVX2:
+            return "avx2";
+        default:
+            return "none";
+    }
+}
+
+const char* FindCharScalar(const char* begin, const char* end, char c) {
+    for (const char* p = begin; p < end; ++p) {
+        if (*p == c) {
+            return p;
+        }
+    }
+    return end;
+}
+
+// memchr of libc is usually vectorized on other architectures
+static const char* FindCharByMemchr(const char* begin, const char* end, char c) {
+    const void* res = memchr(begin, c, end - begin);
+    return res == nullptr ? end : static_cast<const char*>(res);
+}
+
+#ifdef LOGTAIL_X86_SIMD
+__attribute__((target("sse2"))) const char* FindCharSse2(const char* begin, const char* end, char c) {
+    const __m128i target = _mm_set1_epi8(c);
+    const char* p = begin;
+    for (; p + 16 <= end; p += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, target));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return FindCharScalar(p, end, c);
+}
+
+__attribute__((target("avx2"))) const char* FindCharAvx2(const char* begin, const char* end, char c) {
+    const __m256i target = _mm256_set1_epi8(c);
+    const char* p = begin;
+    // lines are usually longer than 64 bytes, so 2 blocks are checked in each iteration to reduce branches
+    for (; p + 64 <= end; p += 64) {
+        __m256i block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        uint32_t mask0 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block0, target)));
+        uint32_t mask1 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block1, target)));
+        if ((mask0 | mask1) != 0) {
+            uint64_t mask = (static_cast<uint64_t>(mask1) << 32) | mask0;
+            return p + __builtin_ctzll(mask);
+        }
+    }
+    for (; p + 32 <= end; p += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, target)));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return FindCharSse2(p, end, c);
+}
+#else
+const char* FindCharSse2(const char* begin, const char* end, char c) {
+    return FindCharScalar(begin, end, c);
+}
+
+const char* FindCharAvx2(const char* begin, const char* end, char c) {
+    return FindCharScalar(begin, end, c);
+}
+#endif
+
+using FindCharFunc = const char* (*)(const char*, const char*, char);
+
+static FindCharFunc SelectFindChar() {
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX2:
+            return FindCharAvx2;
+        case SimdLevel::SSE2:
+            return FindCharSse2;
+        default:
+            return FindCharByMemchr;
+    }
+}
+
+const char* FindChar(const char* begin, const char* end, char c) {
+    static const FindCharFunc sFindChar = SelectFindChar();
+    return sFindChar(begin, end, c);
+}
+
+} // namespace logtail
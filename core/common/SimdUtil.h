@@ -0,0 +1,36 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+
+namespace logtail {
+
+enum class SimdLevel { NONE, SSE2, AVX2 };
+
+// the best instruction set supported by both the binary and the running cpu
+SimdLevel GetSimdLevel();
+const char* SimdLevelToString(SimdLevel level);
+
+// Return the position of the first c in [begin, end), or end if c is not found. The implementation is picked according
+// to GetSimdLevel() on first use.
+const char* FindChar(const char* begin, const char* end, char c);
+
+// implementations for each level, exposed for test and benchmark only
+const char* FindCharScalar(const char* begin, const char* end, char c);
+const char* FindCharSse2(const char* begin, const char* end, char c);
+const char* FindCharAvx2(const char* begin, const char* end, char c);
+
+} // namespace logtail
@@ -0,0 +1,376 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/TimestampParser.h"
+
+#include <cctype>
+#include <cstring>
+
+#include <limits>
+
+#include "common/StringTools.h"
+
+namespace logtail {
+
+namespace {
+
+const char* const kMonthNames[12] = {"January",
+                                     "February",
+                                     "March",
+                                     "April",
+                                     "May",
+                                     "June",
+                                     "July",
+                                     "August",
+                                     "September",
+                                     "October",
+                                     "November",
+                                     "December"};
+const char* const kMonthAbbrs[12]
+    = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+const uint32_t kPowersOf10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const bool kIsLittleEndian = false;
+#else
+const bool kIsLittleEndian = true;
+#endif
+
+inline bool ParseTwoDigits(const char* p, int32_t& res) {
+    uint32_t high = static_cast<unsigned char>(p[0]) - '0';
+    uint32_t low = static_cast<unsigned char>(p[1]) - '0';
+    if (high > 9 || low > 9) {
+        return false;
+    }
+    res = high * 10 + low;
+    return true;
+}
+
+// Digits are checked and converted as a whole word (SWAR), instead of one by one.
+inline bool ParseFourDigits(const char* p, int32_t& res) {
+    if (!kIsLittleEndian) {
+        int32_t high = 0, low = 0;
+        if (!ParseTwoDigits(p, high) || !ParseTwoDigits(p + 2, low)) {
+            return false;
+        }
+        res = high * 100 + low;
+        return true;
+    }
+    uint32_t v = 0;
+    memcpy(&v, p, sizeof(v));
+    // the high nibble of each byte is 3 for digits, and adding 6 to a digit does not change its high nibble
+    if (((v & 0xF0F0F0F0U) | (((v + 0x06060606U) & 0xF0F0F0F0U) >> 4)) != 0x33333333U) {
+        return false;
+    }
+    v -= 0x30303030U;
+    // byte 0 = d0 * 10 + d1, byte 2 = d2 * 10 + d3
+    v = v * 10 + (v >> 8);
+    res = static_cast<int32_t>((v & 0xFF) * 100 + ((v >> 16) & 0xFF));
+    return true;
+}
+
+inline uint32_t ConvertEightDigits(const char* p) {
+    uint64_t v = 0;
+    memcpy(&v, p, sizeof(v));
+    v -= 0x3030303030303030ULL;
+    v = v * 10 + (v >> 8);
+    v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+         + (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))))
+        >> 32;
+    return static_cast<uint32_t>(v);
+}
+
+const char* ParseMonthName(const char* p, const char* end, int32_t& mon) {
+    // full names are checked first, as Strptime does
+    for (const auto* names : {kMonthNames, kMonthAbbrs}) {
+        for (int32_t i = 0; i < 12; ++i) {
+            size_t len = strlen(names[i]);
+            if (static_cast<size_t>(end - p) >= len && CStringNCaseInsensitiveCmp(names[i], p, len) == 0) {
+                mon = i;
+                return p + len;
+            }
+        }
+    }
+    return nullptr;
+}
+
+const char* ParseNanosecond(const char* p, const char* end, long& nanosecond, int& nanosecondLength) {
+    size_t len = 0;
+    while (p + len < end && isdigit(static_cast<unsigned char>(p[len]))) {
+        ++len;
+    }
+    // more than 9 digits overflow in Strptime, which is left to it
+    if (len == 0 || len > 9) {
+        return nullptr;
+    }
+    uint32_t res = 0;
+    size_t i = 0;
+    if (kIsLittleEndian && len >= 8) {
+        res = ConvertEightDigits(p);
+        i = 8;
+    }
+    for (; i < len; ++i) {
+        res = res * 10 + (p[i] - '0');
+    }
+    nanosecond = static_cast<long>(res) * kPowersOf10[9 - len];
+    nanosecondLength = static_cast<int>(len);
+    return p + len;
+}
+
+// the offset is parsed but not used, as Strptime does
+const char* SkipTimezone(const char* p, const char* end) {
+    while (p < end && isspace(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+    if (p >= end) {
+        return nullptr;
+    }
+    if (*p == 'Z') {
+        return p + 1;
+    }
+    // other forms, e.g. GMT and EST, are left to Strptime
+    if (*p != '+' && *p != '-') {
+        return nullptr;
+    }
+    ++p;
+    int32_t digitCnt = 0;
+    int32_t offset = 0;
+    while (digitCnt < 4 && p < end) {
+        if (isdigit(static_cast<unsigned char>(*p))) {
+            offset = offset * 10 + (*p++ - '0');
+            ++digitCnt;
+        } else if (digitCnt == 2 && *p == ':') {
+            ++p;
+        } else {
+            break;
+        }
+    }
+    if (digitCnt != 2 && (digitCnt != 4 || offset % 100 >= 60)) {
+        return nullptr;
+    }
+    return p;
+}
+
+// days since 1970-01-01 of the proleptic Gregorian calendar, which is linear in mday just like mktime
+int64_t DaysFromCivil(int64_t year, int64_t mon, int64_t mday) {
+    year -= mon <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yoe = year - era * 400;
+    int64_t doy = (153 * (mon > 2 ? mon - 3 : mon + 9) + 2) / 5 + mday - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+} // namespace
+
+bool TimestampParser::Init(const std::string& format) {
+    mOps.clear();
+    bool hasYear = false;
+    for (size_t i = 0; i < format.size(); ++i) {
+        char c = format[i];
+        if (isspace(static_cast<unsigned char>(c))) {
+            if (mOps.empty() || mOps.back().mType != OpType::SPACE) {
+                mOps.emplace_back(OpType::SPACE);
+            }
+            continue;
+        }
+        if (c != '%') {
+            mOps.emplace_back(OpType::LITERAL, c);
+            continue;
+        }
+        if (++i >= format.size()) {
+            mOps.clear();
+            return false;
+        }
+        switch (format[i]) {
+            case '%':
+                mOps.emplace_back(OpType::LITERAL, '%');
+                break;
+            case 'Y':
+                mOps.emplace_back(OpType::YEAR);
+                hasYear = true;
+                break;
+            case 'm':
+                mOps.emplace_back(OpType::MONTH);
+                break;
+            case 'b':
+            case 'B':
+            case 'h':
+                mOps.emplace_back(OpType::MONTH_NAME);
+                break;
+            case 'd':
+                mOps.emplace_back(OpType::DAY);
+                break;
+            case 'H':
+                mOps.emplace_back(OpType::HOUR);
+                break;
+            case 'M':
+                mOps.emplace_back(OpType::MINUTE);
+                break;
+            case 'S':
+                mOps.emplace_back(OpType::SECOND);
+                break;
+            case 'f':
+                mOps.emplace_back(OpType::NANOSECOND);
+                break;
+            case 'z':
+                mOps.emplace_back(OpType::TIMEZONE);
+                break;
+            case 'n':
+            case 't':
+                if (mOps.empty() || mOps.back().mType != OpType::SPACE) {
+                    mOps.emplace_back(OpType::SPACE);
+                }
+                break;
+            case 'F':
+                mOps.emplace_back(OpType::YEAR);
+                mOps.emplace_back(OpType::LITERAL, '-');
+                mOps.emplace_back(OpType::MONTH);
+                mOps.emplace_back(OpType::LITERAL, '-');
+                mOps.emplace_back(OpType::DAY);
+                hasYear = true;
+                break;
+            case 'T':
+                mOps.emplace_back(OpType::HOUR);
+                mOps.emplace_back(OpType::LITERAL, ':');
+                mOps.emplace_back(OpType::MINUTE);
+                mOps.emplace_back(OpType::LITERAL, ':');
+                mOps.emplace_back(OpType::SECOND);
+                break;
+            case 'R':
+                mOps.emplace_back(OpType::HOUR);
+                mOps.emplace_back(OpType::LITERAL, ':');
+                mOps.emplace_back(OpType::MINUTE);
+                break;
+            default:
+                mOps.clear();
+                return false;
+        }
+    }
+    // the year is deduced by Strptime if absent
+    if (!hasYear) {
+        mOps.clear();
+        return false;
+    }
+    return true;
+}
+
+const char* TimestampParser::Parse(const char* buf, size_t size, LogtailTime* ts, int& nanosecondLength) const {
+    const char* p = buf;
+    const char* end = buf + size;
+    int32_t year = 0, mon = 0, mday = 0, hour = 0, min = 0, sec = 0;
+    long nanosecond = 0;
+    for (const auto& op : mOps) {
+        switch (op.mType) {
+            case OpType::LITERAL:
+                if (p >= end || *p != op.mLiteral) {
+                    return nullptr;
+                }
+                ++p;
+                break;
+            case OpType::SPACE:
+                while (p < end && isspace(static_cast<unsigned char>(*p))) {
+                    ++p;
+                }
+                break;
+            case OpType::YEAR:
+                if (end - p < 4 || !ParseFourDigits(p, year)) {
+                    return nullptr;
+                }
+                p += 4;
+                break;
+            case OpType::MONTH:
+                if (end - p < 2 || !ParseTwoDigits(p, mon) || mon < 1 || mon > 12) {
+                    return nullptr;
+                }
+                --mon;
+                p += 2;
+                break;
+            case OpType::MONTH_NAME:
+                if ((p = ParseMonthName(p, end, mon)) == nullptr) {
+                    return nullptr;
+                }
+                break;
+            case OpType::DAY:
+                if (end - p < 2 || !ParseTwoDigits(p, mday) || mday < 1 || mday > 31) {
+                    return nullptr;
+                }
+                p += 2;
+                break;
+            case OpType::HOUR:
+                if (end - p < 2 || !ParseTwoDigits(p, hour) || hour > 23) {
+                    return nullptr;
+                }
+                p += 2;
+                break;
+            case OpType::MINUTE:
+                if (end - p < 2 || !ParseTwoDigits(p, min) || min > 59) {
+                    return nullptr;
+                }
+                p += 2;
+                break;
+            case OpType::SECOND:
+                if (end - p < 2 || !ParseTwoDigits(p, sec) || sec > 61) {
+                    return nullptr;
+                }
+                p += 2;
+                break;
+            case OpType::NANOSECOND:
+                if ((p = ParseNanosecond(p, end, nanosecond, nanosecondLength)) == nullptr) {
+                    return nullptr;
+                }
+                break;
+            case OpType::TIMEZONE:
+                if ((p = SkipTimezone(p, end)) == nullptr) {
+                    return nullptr;
+                }
+                break;
+        }
+    }
+    ts->tv_sec = LocalTimeToEpoch(year, mon, mday, hour, min, sec);
+    ts->tv_nsec = nanosecond;
+    return p;
+}
+
+time_t LocalTimeToEpoch(int32_t year, int32_t mon, int32_t mday, int32_t hour, int32_t min, int32_t sec) {
+    // the offset of local time only changes at the boundaries of hours in practice, so the result of mktime for the
+    // last hour is cached
+    static thread_local int64_t sCachedHour = std::numeric_limits<int64_t>::min();
+    static thread_local int64_t sCachedOffset = 0;
+
+    int64_t hourKey = DaysFromCivil(year, mon + 1, mday) * 24 + hour;
+    if (hourKey != sCachedHour) {
+        struct tm tm = {};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = mon;
+        tm.tm_mday = mday;
+        tm.tm_hour = hour;
+        time_t res = mktime(&tm);
+        if (res == -1) {
+            tm = {};
+            tm.tm_year = year - 1900;
+            tm.tm_mon = mon;
+            tm.tm_mday = mday;
+            tm.tm_hour = hour;
+            tm.tm_min = min;
+            tm.tm_sec = sec;
+            return mktime(&tm);
+        }
+        sCachedOffset = static_cast<int64_t>(res) - hourKey * 3600;
+        sCachedHour = hourKey;
+    }
+    return static_cast<time_t>(hourKey * 3600 + sCachedOffset + min * 60 + sec);
+}
+
+} // namespace logtail
@@ -0,0 +1,60 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+
+namespace logtail {
+
+// TimestampParser compiles a strptime format once into a list of fixed-layout operations, so that the format string
+// need not be interpreted again for each log. Only the layouts commonly used in logs are supported: literals,
+// whitespaces, %Y, %m, %d, %H, %M, %S, %f, %b, %z and their shortcuts %F, %T and %R. Numbers must be zero-padded to
+// their full width, e.g. 4 digits for %Y and 2 digits for %m.
+//
+// The result is the same as Strptime, including the interpretation as local time. Since strings not fitting the
+// layout, e.g. a month without zero padding, may still be accepted by Strptime, callers should fall back to Strptime
+// when parsing fails.
+class TimestampParser {
+public:
+    /// @return false if the format is not supported
+    bool Init(const std::string& format);
+    bool IsInited() const { return !mOps.empty(); }
+
+    /// @return the end of the parsed part of buf, or nullptr if buf does not fit the layout
+    const char* Parse(const char* buf, size_t size, LogtailTime* ts, int& nanosecondLength) const;
+
+private:
+    enum class OpType { LITERAL, SPACE, YEAR, MONTH, MONTH_NAME, DAY, HOUR, MINUTE, SECOND, NANOSECOND, TIMEZONE };
+
+    struct Op {
+        OpType mType;
+        char mLiteral;
+
+        Op(OpType type, char literal = '\0') : mType(type), mLiteral(literal) {}
+    };
+
+    std::vector<Op> mOps;
+};
+
+// Same as mktime with tm_isdst = 0, but mktime is only called once per hour of local time.
+time_t LocalTimeToEpoch(int32_t year, int32_t mon, int32_t mday, int32_t hour, int32_t min, int32_t sec);
+
+} // namespace logtail
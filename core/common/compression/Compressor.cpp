@@ -15,6 +15,7 @@
 #include "common/compression/Compressor.h"
 
 #include <chrono>
+#include <cstring>
 
 #include "monitor/metric_constants/MetricConstants.h"
 
@@ -36,25 +37,84 @@ void Compressor::SetMetricRecordRef(MetricLabels&& labels, DynamicMetricLabels&&
 }
 
 bool Compressor::DoCompress(const string& input, string& output, string& errorMsg) {
-    if (mMetricsRecordRef != nullptr) {
-        ADD_COUNTER(mInItemsTotal, 1);
-        ADD_COUNTER(mInItemSizeBytes, input.size());
-    }
-
     auto before = chrono::system_clock::now();
     auto res = Compress(input, output, errorMsg);
+    RecordMetrics(res, input.size(), output.size(), before);
+    return res;
+}
 
-    if (mMetricsRecordRef != nullptr) {
-        ADD_COUNTER(mTotalProcessMs, chrono::system_clock::now() - before);
-        if (res) {
-            ADD_COUNTER(mOutItemsTotal, 1);
-            ADD_COUNTER(mOutItemSizeBytes, output.size());
-        } else {
-            ADD_COUNTER(mDiscardedItemsTotal, 1);
-            ADD_COUNTER(mDiscardedItemSizeBytes, input.size());
-        }
-    }
+bool Compressor::DoCompress(const char* input, size_t inputSize, char* output, size_t& outputSize, string& errorMsg) {
+    auto before = chrono::system_clock::now();
+    auto res = CompressToBuffer(input, inputSize, output, outputSize, errorMsg);
+    RecordMetrics(res, inputSize, outputSize, before);
     return res;
 }
 
+bool Compressor::DoCompressStream(size_t inputSize,
+                                  const ChunkProducer& producer,
+                                  string& output,
+                                  string& errorMsg) {
+    auto before = chrono::system_clock::now();
+    output.clear();
+    auto res = CompressStream(inputSize, producer, output, errorMsg);
+    RecordMetrics(res, inputSize, output.size(), before);
+    return res;
+}
+
+bool Compressor::CompressToBuffer(const char* input,
+                                  size_t inputSize,
+                                  char* output,
+                                  size_t& outputSize,
+                                  string& errorMsg) {
+    string res;
+    if (!Compress(string(input, inputSize), res, errorMsg)) {
+        return false;
+    }
+    if (res.size() > outputSize) {
+        errorMsg = "output buffer is too small";
+        return false;
+    }
+    memcpy(output, res.data(), res.size());
+    outputSize = res.size();
+    return true;
+}
+
+bool Compressor::CompressStream(size_t inputSize,
+                                const ChunkProducer& producer,
+                                string& output,
+                                string& errorMsg) {
+    string input;
+    input.reserve(inputSize);
+    if (!producer([&input](const char* data, size_t size) {
+            input.append(data, size);
+            return true;
+        })) {
+        errorMsg = "failed to produce input";
+        return false;
+    }
+    size_t outputSize = GetCompressBound(input.size());
+    output.resize(outputSize);
+    if (!CompressToBuffer(input.data(), input.size(), const_cast<char*>(output.data()), outputSize, errorMsg)) {
+        return false;
+    }
+    output.resize(outputSize);
+    return true;
+}
+
+void Compressor::RecordMetrics(bool res, size_t inputSize, size_t outputSize, chrono::system_clock::time_point before) {
+    if (mMetricsRecordRef == nullptr) {
+        return;
+    }
+    ADD_COUNTER(mInItemsTotal, 1);
+    ADD_COUNTER(mInItemSizeBytes, inputSize);
+    ADD_COUNTER(mTotalProcessMs, chrono::system_clock::now() - before);
+    if (res) {
+        ADD_COUNTER(mOutItemsTotal, 1);
+        ADD_COUNTER(mOutItemSizeBytes, outputSize);
+    } else {
+        ADD_COUNTER(mDiscardedItemsTotal, 1);
+        ADD_COUNTER(mDiscardedItemSizeBytes, inputSize);
+    }
+}
+
 } // namespace logtail
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <cstddef>
+
+#include <chrono>
+#include <functional>
 #include <string>
 
 #include "common/compression/CompressType.h"
@@ -29,6 +33,17 @@ public:
     virtual ~Compressor() = default;
 
     bool DoCompress(const std::string& input, std::string& output, std::string& errorMsg);
+    // compress into a buffer allocated by the caller, whose capacity @outputSize should be no less than
+    // GetCompressBound(inputSize), and @outputSize is set to the compressed size on success
+    bool DoCompress(const char* input, size_t inputSize, char* output, size_t& outputSize, std::string& errorMsg);
+    virtual size_t GetCompressBound(size_t inputSize) const { return inputSize; }
+
+    using ChunkWriter = std::function<bool(const char* data, size_t size)>;
+    using ChunkProducer = std::function<bool(const ChunkWriter& writer)>;
+    // compress an input of @inputSize bytes in total, which is fed chunk by chunk by @producer through the writer
+    // given to it, so that the whole uncompressed input need not be held in memory if the compressor supports
+    // streaming. @producer should return false as soon as the writer fails.
+    bool DoCompressStream(size_t inputSize, const ChunkProducer& producer, std::string& output, std::string& errorMsg);
 
 #ifdef APSARA_UNIT_TEST_MAIN
     // buffer shoudl be reserved for output before calling this function
@@ -50,6 +65,15 @@ protected:
 
 private:
     virtual bool Compress(const std::string& input, std::string& output, std::string& errorMsg) = 0;
+    virtual bool CompressToBuffer(
+        const char* input, size_t inputSize, char* output, size_t& outputSize, std::string& errorMsg);
+    // by default, the chunks are gathered and then compressed at once
+    virtual bool CompressStream(size_t inputSize,
+                                const ChunkProducer& producer,
+                                std::string& output,
+                                std::string& errorMsg);
+
+    void RecordMetrics(bool res, size_t inputSize, size_t outputSize, std::chrono::system_clock::time_point before);
 
     CompressType mType = CompressType::NONE;
 
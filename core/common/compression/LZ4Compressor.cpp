@@ -14,6 +14,8 @@
 
 #include "common/compression/LZ4Compressor.h"
 
+#include <memory>
+
 #include "lz4/lz4.h"
 
 #include "common/StringTools.h"
@@ -22,21 +24,50 @@ using namespace std;
 
 namespace logtail {
 
+namespace {
+
+// LZ4 state is reset at the beginning of each compression, so it can be reused by the same thread
+void* GetThreadLocalState() {
+    thread_local unique_ptr<char[]> state(new char[LZ4_sizeofState()]);
+    return state.get();
+}
+
+} // namespace
+
+size_t LZ4Compressor::GetCompressBound(size_t inputSize) const {
+    int bound = LZ4_compressBound(inputSize);
+    return bound <= 0 ? 0 : static_cast<size_t>(bound);
+}
+
 bool LZ4Compressor::Compress(const string& input, string& output, string& errorMsg) {
-    int encodingSize = LZ4_compressBound(input.size());
-    if (encodingSize <= 0) {
+    size_t encodingSize = GetCompressBound(input.size());
+    if (encodingSize == 0) {
+        errorMsg = "input size is incorrect";
+        return false;
+    }
+    output.resize(encodingSize);
+    if (!CompressToBuffer(input.data(), input.size(), const_cast<char*>(output.data()), encodingSize, errorMsg)) {
+        return false;
+    }
+    output.resize(encodingSize);
+    return true;
+}
+
+bool LZ4Compressor::CompressToBuffer(
+    const char* input, size_t inputSize, char* output, size_t& outputSize, string& errorMsg) {
+    if (GetCompressBound(inputSize) == 0) {
         errorMsg = "input size is incorrect";
         return false;
     }
-    output.resize(static_cast<size_t>(encodingSize));
     try {
-        encodingSize = static_cast<size_t>(
-            LZ4_compress_default(input.c_str(), const_cast<char*>(output.c_str()), input.size(), encodingSize));
+        // the state is 8-byte aligned since it is allocated by new
+        int encodingSize = LZ4_compress_fast_extState(
+            GetThreadLocalState(), input, output, static_cast<int>(inputSize), static_cast<int>(outputSize), 1);
         if (encodingSize <= 0) {
             errorMsg = "error code: " + ToString(encodingSize);
             return false;
         }
-        output.resize(static_cast<size_t>(encodingSize));
+        outputSize = static_cast<size_t>(encodingSize);
         return true;
     } catch (...) {
     }
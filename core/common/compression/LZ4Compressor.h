@@ -24,12 +24,16 @@ class LZ4Compressor : public Compressor {
 public:
     explicit LZ4Compressor(CompressType type) : Compressor(type) {}
 
+    size_t GetCompressBound(size_t inputSize) const override;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     bool UnCompress(const std::string& input, std::string& output, std::string& errorMsg) override;
 #endif
 
 private:
     bool Compress(const std::string& input, std::string& output, std::string& errorMsg) override;
+    bool CompressToBuffer(
+        const char* input, size_t inputSize, char* output, size_t& outputSize, std::string& errorMsg) override;
 };
 
 } // namespace logtail
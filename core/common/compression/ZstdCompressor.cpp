@@ -14,29 +14,124 @@
 
 #include "common/compression/ZstdCompressor.h"
 
+#include <algorithm>
+
 #include "zstd/zstd.h"
 
 using namespace std;
 
 namespace logtail {
 
+namespace {
+
+// compression context is expensive to create, so it is created once for each thread and reused
+class ZstdCCtxHolder {
+public:
+    ZstdCCtxHolder() : mCCtx(ZSTD_createCCtx()) {}
+    ~ZstdCCtxHolder() { ZSTD_freeCCtx(mCCtx); }
+
+    ZSTD_CCtx* Get() const { return mCCtx; }
+
+private:
+    ZSTD_CCtx* mCCtx = nullptr;
+};
+
+ZSTD_CCtx* GetThreadLocalCCtx() {
+    thread_local ZstdCCtxHolder holder;
+    return holder.Get();
+}
+
+} // namespace
+
+size_t ZstdCompressor::GetCompressBound(size_t inputSize) const {
+    return ZSTD_compressBound(inputSize);
+}
+
 bool ZstdCompressor::Compress(const string& input, string& output, string& errorMsg) {
     size_t encodingSize = ZSTD_compressBound(input.size());
     output.resize(encodingSize);
+    if (!CompressToBuffer(input.data(), input.size(), const_cast<char*>(output.data()), encodingSize, errorMsg)) {
+        return false;
+    }
+    output.resize(encodingSize);
+    return true;
+}
+
+bool ZstdCompressor::CompressToBuffer(
+    const char* input, size_t inputSize, char* output, size_t& outputSize, string& errorMsg) {
+    auto cctx = GetThreadLocalCCtx();
+    if (cctx == nullptr) {
+        errorMsg = "failed to create zstd compression context";
+        return false;
+    }
     try {
-        encodingSize = ZSTD_compress(
-            const_cast<char*>(output.c_str()), encodingSize, input.c_str(), input.size(), mCompressionLevel);
+        size_t encodingSize = ZSTD_compressCCtx(cctx, output, outputSize, input, inputSize, mCompressionLevel);
         if (ZSTD_isError(encodingSize)) {
             errorMsg = ZSTD_getErrorName(encodingSize);
             return false;
         }
-        output.resize(encodingSize);
+        outputSize = encodingSize;
         return true;
     } catch (...) {
     }
     return false;
 }
 
+bool ZstdCompressor::CompressStream(size_t inputSize,
+                                    const ChunkProducer& producer,
+                                    string& output,
+                                    string& errorMsg) {
+    auto cctx = GetThreadLocalCCtx();
+    if (cctx == nullptr) {
+        errorMsg = "failed to create zstd compression context";
+        return false;
+    }
+    ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
+    size_t ret = ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, mCompressionLevel);
+    if (!ZSTD_isError(ret)) {
+        // the content size is written into the frame header, the same as one-shot compression
+        ret = ZSTD_CCtx_setPledgedSrcSize(cctx, inputSize);
+    }
+    if (ZSTD_isError(ret)) {
+        errorMsg = ZSTD_getErrorName(ret);
+        return false;
+    }
+
+    // the output grows on demand, which starts from a quarter of the input since logs are usually well compressed
+    output.resize(max<size_t>(ZSTD_CStreamOutSize(), inputSize / 4));
+    size_t outputPos = 0;
+    auto compress = [&](const char* data, size_t size, ZSTD_EndDirective mode) {
+        ZSTD_inBuffer in = {data, size, 0};
+        while (true) {
+            if (outputPos == output.size()) {
+                output.resize(output.size() * 2);
+            }
+            ZSTD_outBuffer out = {const_cast<char*>(output.data()), output.size(), outputPos};
+            size_t remaining = ZSTD_compressStream2(cctx, &out, &in, mode);
+            outputPos = out.pos;
+            if (ZSTD_isError(remaining)) {
+                errorMsg = ZSTD_getErrorName(remaining);
+                return false;
+            }
+            // all input is consumed for ZSTD_e_continue, and all data is flushed for ZSTD_e_end
+            if (mode == ZSTD_e_continue ? in.pos == in.size : remaining == 0) {
+                return true;
+            }
+        }
+    };
+    if (!producer([&](const char* data, size_t size) { return compress(data, size, ZSTD_e_continue); })) {
+        if (errorMsg.empty()) {
+            errorMsg = "failed to produce input";
+        }
+        return false;
+    }
+    if (!compress(nullptr, 0, ZSTD_e_end)) {
+        return false;
+    }
+    output.resize(outputPos);
+    return true;
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 bool ZstdCompressor::UnCompress(const string& input, string& output, string& errorMsg) {
     try {
@@ -24,12 +24,20 @@ class ZstdCompressor : public Compressor {
 public:
     explicit ZstdCompressor(CompressType type, int32_t level = 1) : Compressor(type), mCompressionLevel(level) {}
 
+    size_t GetCompressBound(size_t inputSize) const override;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     bool UnCompress(const std::string& input, std::string& output, std::string& errorMsg) override;
 #endif
 
 private:
     bool Compress(const std::string& input, std::string& output, std::string& errorMsg) override;
+    bool CompressToBuffer(
+        const char* input, size_t inputSize, char* output, size_t& outputSize, std::string& errorMsg) override;
+    bool CompressStream(size_t inputSize,
+                        const ChunkProducer& producer,
+                        std::string& output,
+                        std::string& errorMsg) override;
 
     int32_t mCompressionLevel = 1;
 };
@@ -101,7 +101,7 @@ public:
     void SetResponseTime(const std::chrono::milliseconds& time) { mResponseTime = time; }
     std::chrono::milliseconds GetResponseTime() const { return mResponseTime; }
 
-    const NetworkStatus& GetNetworkStatus() { return mNetworkStatus; }
+    const NetworkStatus& GetNetworkStatus() const { return mNetworkStatus; }
     void SetNetworkStatus(NetworkCode code, const std::string& msg) {
         mNetworkStatus.mCode = code;
         mNetworkStatus.mMessage = msg;
@@ -171,8 +171,14 @@ public:
     StringBuffer CopyString(const std::string& s) { return CopyString(s.data(), s.length()); }
     StringBuffer CopyString(StringView s) { return CopyString(s.data(), s.length()); }
 
+    // Keep a buffer allocated elsewhere alive as long as this SourceBuffer, so that strings in it can be referenced
+    // without copying. The buffer may be shared by several SourceBuffers, each of which should only write to its own
+    // part of the buffer.
+    void HoldBuffer(const std::shared_ptr<char>& buffer) { mHeldBuffers.push_back(buffer); }
+
 private:
     BufferAllocator mAllocator;
+    std::vector<std::shared_ptr<char>> mHeldBuffers;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class LogEventUnittest;
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace logtail {
+
+// A hierarchical timing wheel. Time is divided into ticks, and each level has kSlotCnt slots, where a slot of level i
+// spans kSlotCnt^i ticks. An entry is put into the lowest level that can hold its expire tick, and is cascaded down
+// to lower levels as time goes, so both adding and expiring an entry cost O(1).
+//
+// An entry may expire up to one tick before its expire time, and at most kSlotCnt^kLevelCnt ticks later than it is
+// added. Callers needing exact deadlines should check them and add the entry again if necessary.
+//
+// Not thread safe.
+template <typename T>
+class TimingWheel {
+public:
+    TimingWheel(uint64_t tickMs, uint64_t nowMs) : mTickMs(tickMs == 0 ? 1 : tickMs), mCurrentTick(nowMs / mTickMs) {}
+
+    void Add(uint64_t expireTimeMs, T&& value) {
+        ++mSize;
+        AddEntry(Entry{expireTimeMs / mTickMs, std::move(value)});
+    }
+
+    // Advances the wheel to nowMs and appends all expired entries to res.
+    void Advance(uint64_t nowMs, std::vector<T>& res) {
+        for (auto& e : mDue) {
+            res.emplace_back(std::move(e.mValue));
+        }
+        mSize -= mDue.size();
+        mDue.clear();
+
+        uint64_t nowTick = nowMs / mTickMs;
+        while (mCurrentTick < nowTick && mSize > 0) {
+            ++mCurrentTick;
+            // cascade from the highest level, so that entries fall into the right slots of the lower levels
+            for (size_t level = kLevelCnt - 1; level > 0; --level) {
+                if ((mCurrentTick & ((1ULL << (kSlotBits * level)) - 1)) == 0) {
+                    auto entries = std::move(mSlots[level][SlotIndex(mCurrentTick, level)]);
+                    mSlots[level][SlotIndex(mCurrentTick, level)].clear();
+                    for (auto& e : entries) {
+                        AddEntry(std::move(e));
+                    }
+                }
+            }
+            auto& slot = mSlots[0][SlotIndex(mCurrentTick, 0)];
+            for (auto& e : slot) {
+                res.emplace_back(std::move(e.mValue));
+            }
+            mSize -= slot.size();
+            slot.clear();
+            // entries cascaded to the current tick
+            for (auto& e : mDue) {
+                res.emplace_back(std::move(e.mValue));
+            }
+            mSize -= mDue.size();
+            mDue.clear();
+        }
+        if (mCurrentTick < nowTick) {
+            // nothing left, just jump
+            mCurrentTick = nowTick;
+        }
+    }
+
+    size_t Size() const { return mSize; }
+    bool Empty() const { return mSize == 0; }
+
+private:
+    static constexpr size_t kSlotBits = 6;
+    static constexpr size_t kSlotCnt = 1 << kSlotBits;
+    static constexpr size_t kLevelCnt = 4;
+    static constexpr uint64_t kMaxTicks = (1ULL << (kSlotBits * kLevelCnt)) - 1;
+
+    struct Entry {
+        uint64_t mExpireTick;
+        T mValue;
+    };
+
+    static size_t SlotIndex(uint64_t tick, size_t level) { return (tick >> (kSlotBits * level)) & (kSlotCnt - 1); }
+
+    void AddEntry(Entry&& e) {
+        if (e.mExpireTick <= mCurrentTick) {
+            mDue.emplace_back(std::move(e));
+            return;
+        }
+        uint64_t diff = e.mExpireTick - mCurrentTick;
+        if (diff > kMaxTicks) {
+            diff = kMaxTicks;
+            e.mExpireTick = mCurrentTick + kMaxTicks;
+        }
+        size_t level = 0;
+        while (diff >= (1ULL << (kSlotBits * (level + 1)))) {
+            ++level;
+        }
+        mSlots[level][SlotIndex(e.mExpireTick, level)].emplace_back(std::move(e));
+    }
+
+    const uint64_t mTickMs;
+    uint64_t mCurrentTick = 0;
+    size_t mSize = 0;
+    std::array<std::array<std::vector<Entry>, kSlotCnt>, kLevelCnt> mSlots;
+    std::vector<Entry> mDue;
+};
+
+} // namespace logtail
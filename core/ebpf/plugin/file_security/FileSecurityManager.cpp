@@ -153,7 +153,7 @@ int FileSecurityManager::SendEvents() {
 
             for (const auto& commonEvent : group->mInnerEvents) {
                 auto* innerEvent = static_cast<FileEvent*>(commonEvent.get());
-                auto* logEvent = eventGroup.AddLogEvent(true, mEventPool);
+                auto* logEvent = eventGroup.AddLogEvent(true, mEventPool, sharedEvent->Size());
                 // attach process tags
                 for (const auto& it : *sharedEvent) {
                     logEvent->SetContentNoCopy(it.first, it.second);
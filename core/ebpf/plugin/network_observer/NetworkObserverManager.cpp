@@ -563,7 +563,7 @@ bool NetworkObserverManager::ConsumeLogAggregateTree() { // handler
 
                     init = true;
                 }
-                auto* logEvent = eventGroup.AddLogEvent(true, mEventPool);
+                auto* logEvent = eventGroup.AddLogEvent(true, mEventPool, kConnTrackerElementsTableSize);
                 for (size_t i = 0; i < kConnTrackerElementsTableSize; i++) {
                     if (kConnTrackerTable.ColLogKey(i) == "" || ctAttrVal[i] == "") {
                         continue;
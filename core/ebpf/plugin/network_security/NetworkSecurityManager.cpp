@@ -181,7 +181,7 @@ int NetworkSecurityManager::SendEvents() {
             auto netnsSb = sourceBuffer->CopyString(std::to_string(group->mNetns));
 
             for (const auto& innerEvent : group->mInnerEvents) {
-                auto* logEvent = eventGroup.AddLogEvent(true, mEventPool);
+                auto* logEvent = eventGroup.AddLogEvent(true, mEventPool, sharedEvent->Size());
                 for (const auto& it : *sharedEvent) {
                     logEvent->SetContentNoCopy(it.first, it.second);
                 }
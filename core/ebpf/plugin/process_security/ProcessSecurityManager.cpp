@@ -226,7 +226,7 @@ int ProcessSecurityManager::SendEvents() {
             }
 
             for (const auto& innerEvent : group->mInnerEvents) {
-                auto* logEvent = eventGroup.AddLogEvent(true, mEventPool);
+                auto* logEvent = eventGroup.AddLogEvent(true, mEventPool, sharedEvent->Size());
                 for (const auto& it : *sharedEvent) {
                     logEvent->SetContentNoCopy(it.first, it.second);
                 }
@@ -14,8 +14,13 @@
 
 #include "file_server/MultilineOptions.h"
 
+#include "common/Flags.h"
 #include "common/ParamExtractor.h"
 
+DEFINE_FLAG_BOOL(enable_multiline_regex_prefilter,
+                 "reject lines not matching multiline patterns with literal and prefix checks before running regex",
+                 false);
+
 using namespace std;
 
 namespace logtail {
@@ -61,7 +66,7 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
                                  ctx.GetProjectName(),
                                  ctx.GetLogstoreName(),
                                  ctx.GetRegion());
-        } else if (!ParseRegex(pattern, mStartPatternRegPtr)) {
+        } else if (!ParseRegex(pattern, mStartPatternRegPtr, mStartPatternPrefilterPtr)) {
             PARAM_WARNING_IGNORE(ctx.GetLogger(),
                                  ctx.GetAlarm(),
                                  "string param Multiline.StartPattern is not a valid regex",
@@ -85,7 +90,7 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
                                  ctx.GetProjectName(),
                                  ctx.GetLogstoreName(),
                                  ctx.GetRegion());
-        } else if (!ParseRegex(pattern, mContinuePatternRegPtr)) {
+        } else if (!ParseRegex(pattern, mContinuePatternRegPtr, mContinuePatternPrefilterPtr)) {
             PARAM_WARNING_IGNORE(ctx.GetLogger(),
                                  ctx.GetAlarm(),
                                  "string param Multiline.ContinuePattern is not a valid regex",
@@ -109,7 +114,7 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
                                  ctx.GetProjectName(),
                                  ctx.GetLogstoreName(),
                                  ctx.GetRegion());
-        } else if (!ParseRegex(pattern, mEndPatternRegPtr)) {
+        } else if (!ParseRegex(pattern, mEndPatternRegPtr, mEndPatternPrefilterPtr)) {
             PARAM_WARNING_IGNORE(ctx.GetLogger(),
                                  ctx.GetAlarm(),
                                  "string param Multiline.EndPattern is not a valid regex",
@@ -124,6 +129,7 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
 
         if (!mStartPatternRegPtr && !mEndPatternRegPtr && mContinuePatternRegPtr) {
             mContinuePatternRegPtr.reset();
+            mContinuePatternPrefilterPtr.reset();
             LOG_WARNING(ctx.GetLogger(),
                         ("problem encountered in config parsing",
                          "param Multiline.StartPattern and EndPattern are empty but ContinuePattern is not")(
@@ -139,6 +145,7 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
                 ctx.GetLogstoreName());
         } else if (mStartPatternRegPtr && mContinuePatternRegPtr && mEndPatternRegPtr) {
             mContinuePatternRegPtr.reset();
+            mContinuePatternPrefilterPtr.reset();
             LOG_WARNING(
                 ctx.GetLogger(),
                 ("problem encountered in config parsing",
@@ -202,7 +209,9 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
     return true;
 }
 
-bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex>& reg) {
+bool MultilineOptions::ParseRegex(const string& pattern,
+                                  shared_ptr<boost::regex>& reg,
+                                  shared_ptr<RegexPrefilter>& prefilter) {
     string regexPattern = pattern;
     if (!regexPattern.empty() && EndWith(regexPattern, "$")) {
         regexPattern = regexPattern.substr(0, regexPattern.size() - 1);
@@ -218,6 +227,10 @@ bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex
     } catch (...) {
         return false;
     }
+    if (BOOL_FLAG(enable_multiline_regex_prefilter)) {
+        // the prefilter of the trimmed pattern is also valid for the original one, which matches less
+        prefilter = RegexPrefilter::Create(regexPattern);
+    }
     return true;
 }
 
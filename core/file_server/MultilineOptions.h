@@ -23,6 +23,7 @@
 #include "json/json.h"
 
 #include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/RegexPrefilter.h"
 
 namespace logtail {
 
@@ -35,6 +36,10 @@ public:
     const std::shared_ptr<boost::regex>& GetStartPatternReg() const { return mStartPatternRegPtr; }
     const std::shared_ptr<boost::regex>& GetContinuePatternReg() const { return mContinuePatternRegPtr; }
     const std::shared_ptr<boost::regex>& GetEndPatternReg() const { return mEndPatternRegPtr; }
+    // nullptr if prefilter is disabled or no useful check can be extracted from the pattern
+    const std::shared_ptr<RegexPrefilter>& GetStartPatternPrefilter() const { return mStartPatternPrefilterPtr; }
+    const std::shared_ptr<RegexPrefilter>& GetContinuePatternPrefilter() const { return mContinuePatternPrefilterPtr; }
+    const std::shared_ptr<RegexPrefilter>& GetEndPatternPrefilter() const { return mEndPatternPrefilterPtr; }
     bool IsMultiline() const { return mIsMultiline; }
 
     Mode mMode = Mode::CUSTOM;
@@ -45,11 +50,16 @@ public:
     bool mIgnoringUnmatchWarning = false;
 
 private:
-    bool ParseRegex(const std::string& pattern, std::shared_ptr<boost::regex>& reg);
+    bool ParseRegex(const std::string& pattern,
+                    std::shared_ptr<boost::regex>& reg,
+                    std::shared_ptr<RegexPrefilter>& prefilter);
 
     std::shared_ptr<boost::regex> mStartPatternRegPtr;
     std::shared_ptr<boost::regex> mContinuePatternRegPtr;
     std::shared_ptr<boost::regex> mEndPatternRegPtr;
+    std::shared_ptr<RegexPrefilter> mStartPatternPrefilterPtr;
+    std::shared_ptr<RegexPrefilter> mContinuePatternPrefilterPtr;
+    std::shared_ptr<RegexPrefilter> mEndPatternPrefilterPtr;
     bool mIsMultiline = false;
 };
 
@@ -520,6 +520,9 @@ void ModifyHandler::Handle(const Event& event) {
             LogFileReaderPtrArray& readerArray = iter->second;
             // only set when reader array size is 1
             if (readerArray.size() == (size_t)1) {
+                if (LogReaderPool::GetInstance()->ParkIfReading(readerArray[0], event, mConfigName)) {
+                    return;
+                }
                 readerArray[0]->SetFileDeleted(true);
                 if (readerArray[0]->IsReadToEnd() || readerArray[0]->ShouldForceReleaseDeletedFileFd()) {
                     if (readerArray[0]->IsFileOpened()) {
@@ -555,6 +558,16 @@ void ModifyHandler::Handle(const Event& event) {
             }
         }
     } else if (event.IsContainerStopped()) {
+        if (LogReaderPool::GetInstance()->IsEnabled()) {
+            for (auto& pair : mNameReaderMap) {
+                for (auto& reader : pair.second) {
+                    if (reader->GetContainerID() == event.GetContainerID()
+                        && LogReaderPool::GetInstance()->ParkIfReading(reader, event, mConfigName)) {
+                        return;
+                    }
+                }
+            }
+        }
         for (auto& pair : mNameReaderMap) {
             LogFileReaderPtrArray& readerArray = pair.second;
             for (auto& reader : readerArray) {
@@ -700,6 +713,9 @@ void ModifyHandler::Handle(const Event& event) {
                 return;
             }
         } else {
+            if (LogReaderPool::GetInstance()->ParkIfReading(devInodeIter->second, event, mConfigName)) {
+                return;
+            }
             devInodeIter->second->UpdateLogPath(logPath);
             readerArrayPtr = devInodeIter->second->GetReaderArray();
         }
@@ -708,6 +724,18 @@ void ModifyHandler::Handle(const Event& event) {
             return;
         }
         LogFileReaderPtr reader = (*readerArrayPtr)[0];
+        if (LogReaderPool::GetInstance()->IsEnabled()) {
+            // the reader is being read by LogReaderPool, handle the event after reading
+            if (LogReaderPool::GetInstance()->ParkIfReading(reader, event, mConfigName)) {
+                return;
+            }
+            // the event is handed back by LogReaderPool after reading
+            LogReadResult result;
+            if (LogReaderPool::GetInstance()->PopReadResult(reader, result)) {
+                OnReadFinished(reader, readerArrayPtr, event, result);
+                return;
+            }
+        }
         // If file modified, it means the file is existed, then we should set fileDeletedFlag to false
         // NOTE: This may override the correct delete flag, which will cause fd close delay!
         // reader->SetFileDeleted(false);
@@ -807,145 +835,15 @@ void ModifyHandler::Handle(const Event& event) {
             }
         }
 
-        bool hasMoreData;
-        do {
-            if (!ProcessQueueManager::GetInstance()->IsValidToPush(reader->GetQueueKey())) {
-                static int32_t s_lastOutPutTime = 0;
-                int32_t curTime = time(NULL);
-                if (curTime - s_lastOutPutTime > 600) {
-                    s_lastOutPutTime = curTime;
-                    LOG_WARNING(sLogger,
-                                ("logprocess queue is full, put modify event to event queue again",
-                                 reader->GetHostLogPath())(reader->GetProject(), reader->GetLogstore()));
-
-                    AlarmManager::GetInstance()->SendAlarmWarning(
-                        PROCESS_QUEUE_BUSY_ALARM,
-                        string("logprocess queue is full, put modify event to event queue again, file:")
-                            + reader->GetHostLogPath(),
-                        reader->GetRegion(),
-                        reader->GetProject(),
-                        reader->GetConfigName(),
-                        reader->GetLogstore());
-                }
-
-                BlockedEventManager::GetInstance()->UpdateBlockEvent(
-                    reader->GetQueueKey(), mConfigName, event, reader->GetDevInode(), curTime);
-                return;
-            }
-            auto logBuffer = make_unique<LogBuffer>();
-            hasMoreData = reader->ReadLog(*logBuffer, &event);
-            int32_t pushRetry = PushLogToProcessor(reader, logBuffer.get());
-            if (!hasMoreData) {
-                if (reader->IsFileDeleted()) {
-                    LOG_INFO(sLogger,
-                             ("close the file", "current file has been read, and is marked deleted")(
-                                 "project", reader->GetProject())("logstore", reader->GetLogstore())(
-                                 "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
-                                 "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode)(
-                                 "file size", reader->GetFileSize()));
-                    bool isDeleted = false;
-                    reader->CloseFilePtr(isDeleted);
-                    if (isDeleted) {
-                        readerArrayPtr->pop_front();
-                        mDevInodeReaderMap.erase(reader->GetDevInode());
-                    }
-                } else if (reader->IsContainerStopped()) {
-                    // update container info one more time, ensure file is hold by same cotnainer
-                    if (reader->UpdateContainerInfo() && !reader->IsContainerStopped()) {
-                        LOG_INFO(sLogger,
-                                 ("file is reused by a new container", reader->GetContainerID())(
-                                     "project", reader->GetProject())("logstore", reader->GetLogstore())(
-                                     "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
-                                     "file device", reader->GetDevInode().dev)(
-                                     "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
-                    } else {
-                        // release fd as quick as possible
-                        LOG_INFO(sLogger,
-                                 ("close the file",
-                                  "current file has been read, and the relative container has been stopped")(
-                                     "project", reader->GetProject())("logstore", reader->GetLogstore())(
-                                     "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
-                                     "file device", reader->GetDevInode().dev)(
-                                     "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
-                        ForceReadLogAndPush(reader);
-                        bool isDeleted = false;
-                        reader->CloseFilePtr(isDeleted);
-                        if (isDeleted) {
-                            readerArrayPtr->pop_front();
-                            mDevInodeReaderMap.erase(reader->GetDevInode());
-                        }
-                    }
-                }
-                break;
-            }
-            if (pushRetry >= 5 || GetCurrentTimeInMicroSeconds() - beginTime > mReadFileTimeSlice) {
-                LOG_DEBUG(
-                    sLogger,
-                    ("read log breakout", "file io cost 1 time slice (50ms) or push blocked")("pushRetry", pushRetry)(
-                        "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject()));
-                Event* ev = new Event(event);
-                ev->SetConfigName(mConfigName);
-                LogInput::GetInstance()->PushEventQueue(ev);
-                break;
-            }
-
-            // When loginput thread hold on, we should repush this event back.
-            // If we don't repush and this file has no modify event, this reader will never been read.
-            if (LogInput::GetInstance()->IsInterupt()) {
-                if (hasMoreData) {
-                    LOG_INFO(sLogger,
-                             ("read log interupt but has more data, reason",
-                              "log input thread hold on")("action", "repush modify event to event queue")(
-                                 "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject())(
-                                 "inode", reader->GetDevInode().inode)("offset", reader->GetLastFilePos())(
-                                 "size", reader->GetFileSize()));
-                } else {
-                    LOG_DEBUG(sLogger,
-                              ("read log breakout, reason",
-                               "log input thread hold on")("action", "repush modify event to event queue")(
-                                  "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject())(
-                                  "inode", reader->GetDevInode().inode)("offset", reader->GetLastFilePos())(
-                                  "size", reader->GetFileSize()));
-                }
-                Event* ev = new Event(event);
-                ev->SetConfigName(mConfigName);
-                LogInput::GetInstance()->PushEventQueue(ev);
-                break;
-            }
-        } while (true);
-
-        if (!hasMoreData && readerArrayPtr->size() > (size_t)1) {
-            // when a rotated reader finish its reading, it's unlikely that there will be data again
-            // so release file fd as quick as possible (open again if new data coming)
-            LOG_INFO(sLogger,
-                     ("close the file and move the corresponding reader to the rotator reader pool",
-                      "current file has been read and more files are waiting in the log reader queue")(
-                         "project", reader->GetProject())("logstore", reader->GetLogstore())("config", mConfigName)(
-                         "log reader queue name", reader->GetHostLogPath())("log reader queue size",
-                                                                            readerArrayPtr->size() - 1)(
-                         "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode)(
-                         "file size", reader->GetFileSize())("rotator reader pool size", mRotatorReaderMap.size() + 1));
-            ForceReadLogAndPush(reader);
-            readerArrayPtr->pop_front();
-            mDevInodeReaderMap.erase(reader->GetDevInode());
-            // only move reader to rotator reader map when file is not deleted
-            bool isDeleted = false;
-            reader->CloseFilePtr(isDeleted);
-            if (!isDeleted) {
-                mRotatorReaderMap[reader->GetDevInode()] = reader;
-                // need to push modify event again, but without dev inode
-                // use head dev + inode
-                Event* ev = new Event(event.GetSource(),
-                                      event.GetEventObject(),
-                                      event.GetType(),
-                                      event.GetWd(),
-                                      event.GetCookie(),
-                                      (*readerArrayPtr)[0]->GetDevInode().dev,
-                                      (*readerArrayPtr)[0]->GetDevInode().inode);
-                ev->SetConfigName(mConfigName);
-                LogInput::GetInstance()->PushEventQueue(ev);
-            }
+        if (LogReaderPool::GetInstance()->IsEnabled()) {
+            Event ev(event);
+            ev.SetConfigName(mConfigName);
+            LogReaderPool::GetInstance()->Submit(reader, ev, mReadFileTimeSlice);
+            return;
         }
+        uint64_t readSize = 0;
+        LogReadResult result = ReadFile(reader, event, beginTime, mReadFileTimeSlice, readSize);
+        OnReadFinished(reader, readerArrayPtr, event, result);
     }
     // if a file is created, and dev inode cannot found(this means it's a new file), create reader for this file, then
     // insert reader into mDevInodeReaderMap
@@ -1014,7 +912,7 @@ void ModifyHandler::HandleTimeOut() {
         }
         // only close file ptr when readerArray size is 1
         // because when many file is queued, if we close file ptr, maybe we can't find this file again
-        if (readerArray.size() == 1) {
+        if (readerArray.size() == 1 && !LogReaderPool::GetInstance()->IsReading(readerArray[0])) {
             if (readerArray[0]->CloseTimeoutFilePtr(nowTime)) {
                 ++closeFilePtrCount;
                 actioned = true;
@@ -1149,6 +1047,151 @@ void ModifyHandler::DeleteRollbackReader() {
         mRotatorReaderMap.erase(*keyIter);
 }
 
+LogReadResult ModifyHandler::ReadFile(const LogFileReaderPtr& reader,
+                                     const Event& event,
+                                     uint64_t beginTime,
+                                     uint64_t timeSlice,
+                                     uint64_t& readSize) {
+    while (true) {
+        if (!ProcessQueueManager::GetInstance()->IsValidToPush(reader->GetQueueKey())) {
+            static atomic_int32_t s_lastOutPutTime{0};
+            int32_t curTime = time(NULL);
+            if (curTime - s_lastOutPutTime > 600) {
+                s_lastOutPutTime = curTime;
+                LOG_WARNING(sLogger,
+                            ("logprocess queue is full, put modify event to event queue again",
+                             reader->GetHostLogPath())(reader->GetProject(), reader->GetLogstore()));
+
+                AlarmManager::GetInstance()->SendAlarmWarning(
+                    PROCESS_QUEUE_BUSY_ALARM,
+                    string("logprocess queue is full, put modify event to event queue again, file:")
+                        + reader->GetHostLogPath(),
+                    reader->GetRegion(),
+                    reader->GetProject(),
+                    reader->GetConfigName(),
+                    reader->GetLogstore());
+            }
+            return LogReadResult::QUEUE_BLOCKED;
+        }
+        auto logBuffer = make_unique<LogBuffer>();
+        bool hasMoreData = reader->ReadLog(*logBuffer, &event);
+        readSize += logBuffer->readLength;
+        int32_t pushRetry = PushLogToProcessor(reader, logBuffer.get());
+        if (!hasMoreData) {
+            return LogReadResult::NO_MORE_DATA;
+        }
+        if (pushRetry >= 5 || GetCurrentTimeInMicroSeconds() - beginTime > timeSlice) {
+            LOG_DEBUG(sLogger,
+                      ("read log breakout", "file io cost 1 time slice (50ms) or push blocked")("pushRetry", pushRetry)(
+                          "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject()));
+            return LogReadResult::TIME_SLICE_EXHAUSTED;
+        }
+
+        // When loginput thread hold on, we should repush this event back.
+        // If we don't repush and this file has no modify event, this reader will never been read.
+        if (LogInput::GetInstance()->IsInterupt()) {
+            LOG_INFO(sLogger,
+                     ("read log interupt but has more data, reason",
+                      "log input thread hold on")("action", "repush modify event to event queue")(
+                         "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject())(
+                         "inode", reader->GetDevInode().inode)("offset", reader->GetLastFilePos())(
+                         "size", reader->GetFileSize()));
+            return LogReadResult::INTERRUPTED;
+        }
+    }
+}
+
+void ModifyHandler::OnReadFinished(LogFileReaderPtr reader,
+                                   LogFileReaderPtrArray* readerArrayPtr,
+                                   const Event& event,
+                                   LogReadResult result) {
+    switch (result) {
+        case LogReadResult::QUEUE_BLOCKED:
+            BlockedEventManager::GetInstance()->UpdateBlockEvent(
+                reader->GetQueueKey(), mConfigName, event, reader->GetDevInode(), time(NULL));
+            return;
+        case LogReadResult::TIME_SLICE_EXHAUSTED:
+        case LogReadResult::INTERRUPTED: {
+            Event* ev = new Event(event);
+            ev->SetConfigName(mConfigName);
+            LogInput::GetInstance()->PushEventQueue(ev);
+            return;
+        }
+        case LogReadResult::NO_MORE_DATA:
+            break;
+    }
+
+    if (reader->IsFileDeleted()) {
+        LOG_INFO(sLogger,
+                 ("close the file", "current file has been read, and is marked deleted")(
+                     "project", reader->GetProject())("logstore", reader->GetLogstore())("config", mConfigName)(
+                     "log reader queue name", reader->GetHostLogPath())("file device", reader->GetDevInode().dev)(
+                     "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
+        bool isDeleted = false;
+        reader->CloseFilePtr(isDeleted);
+        if (isDeleted) {
+            readerArrayPtr->pop_front();
+            mDevInodeReaderMap.erase(reader->GetDevInode());
+        }
+    } else if (reader->IsContainerStopped()) {
+        // update container info one more time, ensure file is hold by same cotnainer
+        if (reader->UpdateContainerInfo() && !reader->IsContainerStopped()) {
+            LOG_INFO(sLogger,
+                     ("file is reused by a new container", reader->GetContainerID())("project", reader->GetProject())(
+                         "logstore", reader->GetLogstore())("config", mConfigName)(
+                         "log reader queue name", reader->GetHostLogPath())("file device", reader->GetDevInode().dev)(
+                         "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
+        } else {
+            // release fd as quick as possible
+            LOG_INFO(sLogger,
+                     ("close the file", "current file has been read, and the relative container has been stopped")(
+                         "project", reader->GetProject())("logstore", reader->GetLogstore())("config", mConfigName)(
+                         "log reader queue name", reader->GetHostLogPath())("file device", reader->GetDevInode().dev)(
+                         "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
+            ForceReadLogAndPush(reader);
+            bool isDeleted = false;
+            reader->CloseFilePtr(isDeleted);
+            if (isDeleted) {
+                readerArrayPtr->pop_front();
+                mDevInodeReaderMap.erase(reader->GetDevInode());
+            }
+        }
+    }
+
+    if (readerArrayPtr->size() > (size_t)1) {
+        // when a rotated reader finish its reading, it's unlikely that there will be data again
+        // so release file fd as quick as possible (open again if new data coming)
+        LOG_INFO(sLogger,
+                 ("close the file and move the corresponding reader to the rotator reader pool",
+                  "current file has been read and more files are waiting in the log reader queue")(
+                     "project", reader->GetProject())("logstore", reader->GetLogstore())("config", mConfigName)(
+                     "log reader queue name", reader->GetHostLogPath())("log reader queue size",
+                                                                        readerArrayPtr->size() - 1)(
+                     "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode)(
+                     "file size", reader->GetFileSize())("rotator reader pool size", mRotatorReaderMap.size() + 1));
+        ForceReadLogAndPush(reader);
+        readerArrayPtr->pop_front();
+        mDevInodeReaderMap.erase(reader->GetDevInode());
+        // only move reader to rotator reader map when file is not deleted
+        bool isDeleted = false;
+        reader->CloseFilePtr(isDeleted);
+        if (!isDeleted) {
+            mRotatorReaderMap[reader->GetDevInode()] = reader;
+            // need to push modify event again, but without dev inode
+            // use head dev + inode
+            Event* ev = new Event(event.GetSource(),
+                                  event.GetEventObject(),
+                                  event.GetType(),
+                                  event.GetWd(),
+                                  event.GetCookie(),
+                                  (*readerArrayPtr)[0]->GetDevInode().dev,
+                                  (*readerArrayPtr)[0]->GetDevInode().inode);
+            ev->SetConfigName(mConfigName);
+            LogInput::GetInstance()->PushEventQueue(ev);
+        }
+    }
+}
+
 void ModifyHandler::ForceReadLogAndPush(LogFileReaderPtr reader) {
     auto logBuffer = make_unique<LogBuffer>();
     auto pEvent = reader->CreateFlushTimeoutEvent();
@@ -21,6 +21,7 @@
 #include <map>
 #include <unordered_map>
 
+#include "file_server/event_handler/LogReaderPool.h"
 #include "file_server/reader/LogFileReader.h"
 
 namespace logtail {
@@ -98,10 +99,15 @@ private:
                                             uint32_t exactlyonceConcurrency = 0,
                                             bool forceBeginingFlag = false);
 
-    int32_t PushLogToProcessor(LogFileReaderPtr reader, LogBuffer* logBuffer);
+    static int32_t PushLogToProcessor(LogFileReaderPtr reader, LogBuffer* logBuffer);
 
     void ForceReadLogAndPush(LogFileReaderPtr reader);
 
+    void OnReadFinished(LogFileReaderPtr reader,
+                        LogFileReaderPtrArray* readerArrayPtr,
+                        const Event& event,
+                        LogReadResult result);
+
     // no copy
     ModifyHandler(const ModifyHandler&);
     ModifyHandler& operator=(const ModifyHandler&);
@@ -115,6 +121,14 @@ public:
     bool IsAllFileRead() override;
     const std::string& GetConfigName() const { return mConfigName; }
 
+    // read the file until no more data, the time slice is used up or the process queue is blocked.
+    // can be called on LogInput thread or threads in LogReaderPool.
+    static LogReadResult ReadFile(const LogFileReaderPtr& reader,
+                                  const Event& event,
+                                  uint64_t beginTime,
+                                  uint64_t timeSlice,
+                                  uint64_t& readSize);
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConfigUpdatorUnittest;
     friend class EventDispatcherTest;
@@ -31,6 +31,7 @@
 #include "file_server/event/BlockEventManager.h"
 #include "file_server/event_handler/EventHandler.h"
 #include "file_server/event_handler/HistoryFileImporter.h"
+#include "file_server/event_handler/LogReaderPool.h"
 #include "file_server/polling/PollingCache.h"
 #include "file_server/polling/PollingDirFile.h"
 #include "file_server/polling/PollingEventQueue.h"
@@ -91,6 +92,7 @@ void LogInput::Start() {
     mEnableFileIncludedByMultiConfigs = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
         METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG);
 
+    LogReaderPool::GetInstance()->Start();
     mThreadRes = async(launch::async, &LogInput::ProcessLoop, this);
 }
 
@@ -114,12 +116,14 @@ void LogInput::HoldOn() {
         LOG_INFO(sLogger, ("input event handle daemon pause", "starts"));
         mInteruptFlag = true;
         mAccessMainThreadRWL.lock();
+        LogReaderPool::GetInstance()->HoldOn();
         LOG_INFO(sLogger, ("input event handle daemon pause", "succeeded"));
     }
 }
 
 void LogInput::TryReadEvents(bool forceRead) {
-    if (mInteruptFlag)
+    // event queue is only accessed by LogInput thread
+    if (mInteruptFlag || LogReaderPool::IsReaderThread())
         return;
 
     int64_t curMicroSeconds = GetCurrentTimeInMicroSeconds();
@@ -138,6 +142,12 @@ void LogInput::TryReadEvents(bool forceRead) {
         PushEventQueue(feedbackEvents);
     }
 
+    vector<Event*> readFinishedEvents;
+    LogReaderPool::GetInstance()->GetFinishedEvents(readFinishedEvents);
+    if (readFinishedEvents.size() > 0) {
+        PushEventQueue(readFinishedEvents);
+    }
+
     vector<Event*> pollingEvents;
     PollingEventQueue::GetInstance()->PopAllEvents(pollingEvents);
     if (pollingEvents.size() > 0) {
@@ -156,8 +166,9 @@ void LogInput::TryReadEvents(bool forceRead) {
 void LogInput::FlowControl() {
     const static int32_t FLOW_CONTROL_SLEEP_MICROSECONDS = 20 * 1000; // 20ms
     const static int32_t MAX_SLEEP_COUNT = 50; // 1s
-    static int32_t sleepCount = 10;
-    static int32_t lastCheckTime = 0;
+    // may be called by LogReaderPool threads concurrently
+    static atomic_int32_t sleepCount{10};
+    static atomic_int32_t lastCheckTime{0};
     int32_t i = 0;
     while (i < sleepCount) {
         if (mInteruptFlag)
@@ -456,12 +467,15 @@ void LogInput::ProcessLoop() {
         }
 
         if (Application::GetInstance()->IsExiting()
-            && (!BOOL_FLAG(enable_full_drain_mode) || EventDispatcher::GetInstance()->IsAllFileRead())) {
+            && (!BOOL_FLAG(enable_full_drain_mode)
+                || (LogReaderPool::GetInstance()->IsAllTaskFinished()
+                    && EventDispatcher::GetInstance()->IsAllFileRead()))) {
             break;
         }
     }
 
     mInteruptFlag = true;
+    LogReaderPool::GetInstance()->Stop();
 }
 
 void LogInput::PushEventQueue(std::vector<Event*>& eventVec) {
@@ -0,0 +1,231 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/event_handler/LogReaderPool.h"
+
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "common/TimeUtil.h"
+#include "file_server/event_handler/EventHandler.h"
+#include "file_server/event_handler/LogInput.h"
+#include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT32(log_reader_thread_count,
+                  "number of threads to read files, 0 means files are read by LogInput thread",
+                  0);
+
+using namespace std;
+
+namespace logtail {
+
+thread_local bool LogReaderPool::sIsReaderThread = false;
+
+void LogReaderPool::Start() {
+    if (!mShards.empty() || INT32_FLAG(log_reader_thread_count) <= 0) {
+        return;
+    }
+    mIsStopped = false;
+    for (int32_t shardNo = 0; shardNo < INT32_FLAG(log_reader_thread_count); ++shardNo) {
+        auto shard = make_unique<Shard>();
+        WriteMetrics::GetInstance()->CreateMetricsRecordRef(
+            shard->mMetricsRecordRef,
+            MetricCategory::METRIC_CATEGORY_RUNNER,
+            {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_FILE_READER},
+             {METRIC_LABEL_KEY_THREAD_NO, ToString(shardNo)}});
+        shard->mInItemsTotal = shard->mMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_ITEMS_TOTAL);
+        shard->mReadSizeBytes = shard->mMetricsRecordRef.CreateCounter(METRIC_RUNNER_FILE_READ_SIZE_BYTES);
+        shard->mLastRunTime = shard->mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
+        WriteMetrics::GetInstance()->CommitMetricsRecordRef(shard->mMetricsRecordRef);
+        mShards.emplace_back(std::move(shard));
+    }
+    for (uint32_t shardNo = 0; shardNo < mShards.size(); ++shardNo) {
+        mShards[shardNo]->mThreadRes = async(launch::async, &LogReaderPool::Run, this, shardNo);
+    }
+    LOG_INFO(sLogger, ("log reader pool", "started")("thread count", mShards.size()));
+}
+
+void LogReaderPool::Stop() {
+    if (mShards.empty()) {
+        return;
+    }
+    mIsStopped = true;
+    for (auto& shard : mShards) {
+        {
+            lock_guard<mutex> lock(shard->mMux);
+        }
+        shard->mCV.notify_all();
+    }
+    for (auto& shard : mShards) {
+        if (shard->mThreadRes.valid()) {
+            shard->mThreadRes.get();
+        }
+        // unstarted tasks are simply dropped, the data will be read again from checkpoint
+        shard->mTasks.clear();
+    }
+    lock_guard<mutex> lock(mStateMux);
+    for (auto& item : mReadingReaders) {
+        for (auto ev : item.second) {
+            delete ev;
+        }
+    }
+    mReadingReaders.clear();
+    for (auto ev : mFinishedEvents) {
+        delete ev;
+    }
+    mFinishedEvents.clear();
+    mReadResults.clear();
+    LOG_INFO(sLogger, ("log reader pool", "stopped successfully"));
+}
+
+void LogReaderPool::HoldOn() {
+    for (auto& shard : mShards) {
+        unique_lock<mutex> lock(shard->mMux);
+        {
+            lock_guard<mutex> stateLock(mStateMux);
+            for (auto& task : shard->mTasks) {
+                // hand back the event, so that it can be handled again after resume
+                mFinishedEvents.push_back(new Event(task.mEvent));
+                auto iter = mReadingReaders.find(task.mReader.get());
+                if (iter != mReadingReaders.end()) {
+                    mFinishedEvents.insert(mFinishedEvents.end(), iter->second.begin(), iter->second.end());
+                    mReadingReaders.erase(iter);
+                }
+            }
+        }
+        shard->mTasks.clear();
+        shard->mCV.wait(lock, [&shard]() { return !shard->mIsRunning; });
+    }
+    // results not consumed yet are dropped, the handed back events will trigger reading again
+    lock_guard<mutex> lock(mStateMux);
+    mReadResults.clear();
+}
+
+void LogReaderPool::Submit(const LogFileReaderPtr& reader, const Event& event, uint64_t timeSlice) {
+    {
+        lock_guard<mutex> lock(mStateMux);
+        mReadingReaders[reader.get()];
+    }
+    auto& shard = mShards[DevInodeHash()(reader->GetDevInode()) % mShards.size()];
+    {
+        lock_guard<mutex> lock(shard->mMux);
+        shard->mTasks.emplace_back(reader, event, timeSlice);
+    }
+    shard->mCV.notify_one();
+}
+
+bool LogReaderPool::IsReading(const LogFileReaderPtr& reader) const {
+    if (!IsEnabled()) {
+        return false;
+    }
+    lock_guard<mutex> lock(mStateMux);
+    return mReadingReaders.find(reader.get()) != mReadingReaders.end();
+}
+
+bool LogReaderPool::ParkIfReading(const LogFileReaderPtr& reader, const Event& event, const string& configName) {
+    if (!IsEnabled()) {
+        return false;
+    }
+    lock_guard<mutex> lock(mStateMux);
+    auto iter = mReadingReaders.find(reader.get());
+    if (iter == mReadingReaders.end()) {
+        return false;
+    }
+    Event* ev = new Event(event);
+    ev->SetConfigName(configName);
+    iter->second.push_back(ev);
+    return true;
+}
+
+bool LogReaderPool::PopReadResult(const LogFileReaderPtr& reader, LogReadResult& result) {
+    lock_guard<mutex> lock(mStateMux);
+    auto iter = mReadResults.find(reader.get());
+    if (iter == mReadResults.end()) {
+        return false;
+    }
+    result = iter->second.mResult;
+    mReadResults.erase(iter);
+    return true;
+}
+
+void LogReaderPool::GetFinishedEvents(vector<Event*>& eventVec) {
+    if (!IsEnabled()) {
+        return;
+    }
+    lock_guard<mutex> lock(mStateMux);
+    eventVec.swap(mFinishedEvents);
+    // results of removed readers will never be consumed
+    for (auto iter = mReadResults.begin(); iter != mReadResults.end();) {
+        if (iter->second.mReader.expired()) {
+            iter = mReadResults.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+bool LogReaderPool::IsAllTaskFinished() const {
+    if (!IsEnabled()) {
+        return true;
+    }
+    lock_guard<mutex> lock(mStateMux);
+    return mReadingReaders.empty() && mFinishedEvents.empty();
+}
+
+void LogReaderPool::Run(uint32_t shardNo) {
+    LOG_INFO(sLogger, ("log reader thread", "started")("thread no", shardNo));
+    sIsReaderThread = true;
+    auto& shard = mShards[shardNo];
+    while (true) {
+        unique_lock<mutex> lock(shard->mMux);
+        shard->mCV.wait(lock, [this, &shard]() { return mIsStopped || !shard->mTasks.empty(); });
+        if (mIsStopped) {
+            break;
+        }
+        ReadTask task = std::move(shard->mTasks.front());
+        shard->mTasks.pop_front();
+        shard->mIsRunning = true;
+        lock.unlock();
+
+        SET_GAUGE(shard->mLastRunTime, time(nullptr));
+        ADD_COUNTER(shard->mInItemsTotal, 1);
+        uint64_t readSize = 0;
+        LogReadResult result = ModifyHandler::ReadFile(
+            task.mReader, task.mEvent, GetCurrentTimeInMicroSeconds(), task.mTimeSlice, readSize);
+        ADD_COUNTER(shard->mReadSizeBytes, readSize);
+        OnTaskFinished(task, result);
+
+        lock.lock();
+        shard->mIsRunning = false;
+        lock.unlock();
+        shard->mCV.notify_all();
+    }
+    LOG_INFO(sLogger, ("log reader thread", "stopped")("thread no", shardNo));
+}
+
+void LogReaderPool::OnTaskFinished(ReadTask& task, LogReadResult result) {
+    {
+        lock_guard<mutex> lock(mStateMux);
+        mReadResults[task.mReader.get()] = {task.mReader, result};
+        mFinishedEvents.push_back(new Event(task.mEvent));
+        auto iter = mReadingReaders.find(task.mReader.get());
+        if (iter != mReadingReaders.end()) {
+            mFinishedEvents.insert(mFinishedEvents.end(), iter->second.begin(), iter->second.end());
+            mReadingReaders.erase(iter);
+        }
+    }
+    LogInput::GetInstance()->Trigger();
+}
+
+} // namespace logtail
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "file_server/event/Event.h"
+#include "file_server/reader/LogFileReader.h"
+#include "monitor/MetricManager.h"
+
+namespace logtail {
+
+enum class LogReadResult {
+    // the file has been read to end
+    NO_MORE_DATA,
+    // the process queue is not valid to push, the event should be blocked
+    QUEUE_BLOCKED,
+    // time slice is used up or pushing is blocked, the event should be pushed again
+    TIME_SLICE_EXHAUSTED,
+    // LogInput is holding on, the event should be pushed again
+    INTERRUPTED,
+};
+
+// LogReaderPool reads files on a fixed number of worker threads. Each file is bound to one worker by hashing its
+// DevInode, so a file is always read by exactly one thread and in order. All bookkeeping of readers, i.e. the maps in
+// ModifyHandler, the event queue of LogInput and the BlockedEventManager, is still done on LogInput thread:
+// 1. LogInput thread picks the reader, opens the file and submits a read task;
+// 2. the worker reads the file for one time slice and pushes data to the process queue;
+// 3. the result is recorded and the triggering event is handed back to LogInput thread, which finishes the handling
+//    of the event (closing deleted files, rotating readers, blocking events, etc.).
+// Events for a reader which is being read are parked and handed back together with the finished event.
+class LogReaderPool {
+public:
+    LogReaderPool(const LogReaderPool&) = delete;
+    LogReaderPool& operator=(const LogReaderPool&) = delete;
+
+    static LogReaderPool* GetInstance() {
+        static LogReaderPool instance;
+        return &instance;
+    }
+
+    static bool IsReaderThread() { return sIsReaderThread; }
+
+    void Start();
+    void Stop();
+    // wait for all running tasks to finish, and hand back events of all unstarted tasks
+    void HoldOn();
+    bool IsEnabled() const { return !mShards.empty(); }
+
+    // following methods should only be called by LogInput thread
+    void Submit(const LogFileReaderPtr& reader, const Event& event, uint64_t timeSlice);
+    bool IsReading(const LogFileReaderPtr& reader) const;
+    bool ParkIfReading(const LogFileReaderPtr& reader, const Event& event, const std::string& configName);
+    bool PopReadResult(const LogFileReaderPtr& reader, LogReadResult& result);
+    void GetFinishedEvents(std::vector<Event*>& eventVec);
+    bool IsAllTaskFinished() const;
+
+private:
+    struct ReadTask {
+        LogFileReaderPtr mReader;
+        Event mEvent;
+        uint64_t mTimeSlice;
+
+        ReadTask(const LogFileReaderPtr& reader, const Event& event, uint64_t timeSlice)
+            : mReader(reader), mEvent(event), mTimeSlice(timeSlice) {}
+    };
+
+    // readers are held weakly, so that a removed reader is released at once even if its result is never consumed
+    struct ReadResultEntry {
+        std::weak_ptr<LogFileReader> mReader;
+        LogReadResult mResult;
+    };
+
+    struct Shard {
+        std::mutex mMux;
+        std::condition_variable mCV;
+        std::deque<ReadTask> mTasks;
+        bool mIsRunning = false;
+        std::future<void> mThreadRes;
+
+        MetricsRecordRef mMetricsRecordRef;
+        CounterPtr mInItemsTotal;
+        CounterPtr mReadSizeBytes;
+        IntGaugePtr mLastRunTime;
+    };
+
+    LogReaderPool() = default;
+    ~LogReaderPool() = default;
+
+    void Run(uint32_t shardNo);
+    void OnTaskFinished(ReadTask& task, LogReadResult result);
+
+    std::vector<std::unique_ptr<Shard>> mShards;
+    std::atomic_bool mIsStopped = false;
+
+    mutable std::mutex mStateMux;
+    // reader in reading -> events parked during reading
+    std::unordered_map<const LogFileReader*, std::vector<Event*>> mReadingReaders;
+    std::unordered_map<const LogFileReader*, ReadResultEntry> mReadResults;
+    std::vector<Event*> mFinishedEvents;
+
+    thread_local static bool sIsReaderThread;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ModifyHandlerUnittest;
+#endif
+};
+
+} // namespace logtail
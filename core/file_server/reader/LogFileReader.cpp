@@ -78,6 +78,10 @@ DEFINE_FLAG_INT32(max_fix_pos_bytes, "", 128 * 1024);
 DEFINE_FLAG_INT32(force_release_deleted_file_fd_timeout,
                   "force release fd if file is deleted after specified seconds, no matter read to end or not",
                   -1);
+DEFINE_FLAG_BOOL(enable_zero_copy_read,
+                 "keep unfinished log of utf8 file in read buffer instead of copying it to cache, each reader with "
+                 "unfinished log may hold up to twice the read buffer size",
+                 false);
 #if defined(_MSC_VER)
 // On Windows, if Chinese config base path is used, the log path will be converted to GBK,
 // so the __tag__.__path__ have to be converted back to UTF8 to avoid bad display.
@@ -299,7 +303,8 @@ void LogFileReader::DumpMetaToMem(bool checkConfigFlag, int32_t idxInReaderArray
                                                mLastForceRead);
     // use last event time as checkpoint's last update time
     checkPointPtr->mLastUpdateTime = mLastEventTime;
-    checkPointPtr->mCache = mCache;
+    checkPointPtr->mCache
+        = mReadChunkTailSize ? string(mReadChunk.get() + mReadChunkTailOffset, mReadChunkTailSize) : mCache;
     checkPointPtr->mIdxInReaderArray = idxInReaderArray;
     CheckPointManager::Instance()->AddCheckPoint(checkPointPtr);
 }
@@ -576,7 +581,7 @@ void LogFileReader::adjustParametersByRangeCheckpoints() {
                   });
         auto& firstCpt = uncommittedCheckpoints.front()->data;
         mLastFilePos = firstCpt.read_offset();
-        mCache.clear();
+        ClearCache();
         mFirstWatched = false;
 
         // Set skip position if there are comitted checkpoints.
@@ -596,7 +601,7 @@ void LogFileReader::adjustParametersByRangeCheckpoints() {
     else if (maxOffsetIndex != mEOOption->concurrency) {
         auto& cpt = mEOOption->rangeCheckpointPtrs[maxOffsetIndex]->data;
         mLastFilePos = cpt.read_offset() + cpt.read_length();
-        mCache.clear();
+        ClearCache();
         mFirstWatched = false;
         LOG_INFO(sLogger,
                  ("initialize reader", "checkpoint with max offset")COMMON_READER_INFO("max index", maxOffsetIndex)(
@@ -634,7 +639,7 @@ void LogFileReader::SetDockerPath(const std::string& dockerBasePath, size_t dock
 
 void LogFileReader::SetReadFromBeginning() {
     mLastFilePos = 0;
-    mCache.clear();
+    ClearCache();
     LOG_INFO(
         sLogger,
         ("force reading file from the beginning, project", GetProject())("logstore", GetLogstore())(
@@ -670,7 +675,7 @@ bool LogFileReader::CheckForFirstOpen(FileReadPolicy policy) {
     op.Open(mHostLogPath.c_str());
     if (op.IsOpen() == false) {
         mLastFilePos = 0;
-        mCache.clear();
+        ClearCache();
         LOG_INFO(sLogger,
                  ("force reading file from the beginning",
                   "open file failed when trying to find the start position for reading")("project", GetProject())(
@@ -703,7 +708,7 @@ bool LogFileReader::CheckForFirstOpen(FileReadPolicy policy) {
         //     }
     } else if (policy == BACKWARD_TO_BEGINNING) {
         mLastFilePos = 0;
-        mCache.clear();
+        ClearCache();
     } else {
         LOG_ERROR(sLogger, ("invalid file read policy for file", mHostLogPath));
         return false;
@@ -740,7 +745,7 @@ void LogFileReader::SetFilePosBackwardToFixedPos(LogFileOperator& op) {
             SKIP_READ_LOG_ALARM, warningMsg, GetRegion(), GetProject(), GetConfigName(), GetLogstore());
     }
 
-    mCache.clear();
+    ClearCache();
     FixLastFilePos(op, endOffset);
 }
 
@@ -785,7 +790,7 @@ void LogFileReader::FixLastFilePos(LogFileOperator& op, int64_t endOffset) {
         for (size_t i = 0; i < readSizeReal - 1; ++i) {
             if (readBuf[i] == '\n') {
                 mLastFilePos += i + 1;
-                mCache.clear();
+                ClearCache();
                 free(readBuf);
                 return;
             }
@@ -798,7 +803,7 @@ void LogFileReader::FixLastFilePos(LogFileOperator& op, int64_t endOffset) {
                 if (BoostRegexSearch(
                         line.data.data(), line.data.size(), *mMultilineConfig.first->GetStartPatternReg(), exception)) {
                     mLastFilePos += line.lineBegin;
-                    mCache.clear();
+                    ClearCache();
                     free(readBuf);
                     return;
                 }
@@ -1226,6 +1231,12 @@ void LogFileReader::CloseFilePtr() {
 
 void LogFileReader::CloseFilePtr(bool& isDeleted) {
     if (mLogFileOp.IsOpen()) {
+        if (mReadChunkTailSize) {
+            // release the read chunk of inactive reader
+            mCache.assign(mReadChunk.get() + mReadChunkTailOffset, mReadChunkTailSize);
+            mReadChunk.reset();
+            mReadChunkCapacity = mReadChunkTailOffset = mReadChunkTailSize = 0;
+        }
         mCache.shrink_to_fit();
         LOG_DEBUG(sLogger, ("start close LogFileReader", mHostLogPath));
 
@@ -1514,7 +1525,7 @@ bool LogFileReader::GetRawData(LogBuffer& logBuffer, int64_t fileSize, bool tryR
             GetConfigName(),
             GetLogstore());
         mLastFilePos = fileSize;
-        mCache.clear();
+        ClearCache();
     }
 
     if (mContainerStopped) {
@@ -1566,6 +1577,48 @@ void LogFileReader::setExactlyOnceCheckpointAfterRead(size_t readSize) {
     cpt.set_read_length(readSize);
 }
 
+void LogFileReader::ClearCache() {
+    mCache.clear();
+    // the chunk is still held by LogBuffers read from it
+    mReadChunk.reset();
+    mReadChunkCapacity = mReadChunkTailOffset = mReadChunkTailSize = 0;
+}
+
+// Return the buffer to read into, the unfinished tail of the last read is at the beginning of the buffer, and there are
+// at least size + 1 bytes available.
+char* LogFileReader::PrepareReadChunk(size_t size) {
+    if (mReadChunkTailSize && mReadChunkTailOffset + size + 1 <= mReadChunkCapacity) {
+        return mReadChunk.get() + mReadChunkTailOffset;
+    }
+    // reserve room for next reads, so that the tail is moved at most once every few reads
+    size_t capacity = 2 * (size + 1);
+    shared_ptr<char> chunk(new char[capacity], default_delete<char[]>());
+    if (mReadChunkTailSize) {
+        memcpy(chunk.get(), mReadChunk.get() + mReadChunkTailOffset, mReadChunkTailSize);
+    } else if (!mCache.empty()) {
+        // cache may be restored from checkpoint
+        memcpy(chunk.get(), mCache.data(), mCache.size());
+        mReadChunkTailSize = mCache.size();
+        mCache.clear();
+    }
+    mReadChunk = std::move(chunk);
+    mReadChunkCapacity = capacity;
+    mReadChunkTailOffset = 0;
+    return mReadChunk.get();
+}
+
+void LogFileReader::SetCache(const char* data, size_t size, bool inReadChunk) {
+    if (!inReadChunk || size == 0) {
+        string cache(data, size);
+        ClearCache();
+        mCache.swap(cache);
+        return;
+    }
+    mCache.clear();
+    mReadChunkTailOffset = data - mReadChunk.get();
+    mReadChunkTailSize = size;
+}
+
 void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData, bool tryRollback) {
     char* stringBuffer = nullptr;
     size_t nbytes = 0;
@@ -1573,10 +1626,16 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
     logBuffer.readOffset = mLastFilePos;
     if (!mLogFileOp.IsOpen()) {
         // read flush timeout
-        nbytes = mCache.size();
-        StringBuffer stringMemory = logBuffer.sourcebuffer->AllocateStringBuffer(nbytes);
-        stringBuffer = stringMemory.data;
-        memcpy(stringBuffer, mCache.data(), nbytes);
+        nbytes = GetCacheSize();
+        if (mReadChunkTailSize) {
+            // there is always one more byte after the tail for '\0'
+            logBuffer.sourcebuffer->HoldBuffer(mReadChunk);
+            stringBuffer = mReadChunk.get() + mReadChunkTailOffset;
+        } else {
+            StringBuffer stringMemory = logBuffer.sourcebuffer->AllocateStringBuffer(nbytes);
+            stringBuffer = stringMemory.data;
+            memcpy(stringBuffer, mCache.data(), nbytes);
+        }
         // Ignore \n if last is force read
         if (stringBuffer[0] == '\n' && mLastForceRead) {
             ++stringBuffer;
@@ -1585,7 +1644,7 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
             --nbytes;
         }
         mLastForceRead = true;
-        mCache.clear();
+        ClearCache();
         moreData = false;
     } else {
         bool fromCpt = false;
@@ -1597,21 +1656,27 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
             && !mHasReadContainerBom) {
             checkContainerType(mLogFileOp);
         }
-        const size_t lastCacheSize = mCache.size();
+        const size_t lastCacheSize = GetCacheSize();
         if (READ_BYTE < lastCacheSize) {
             READ_BYTE = lastCacheSize; // this should not happen, just avoid READ_BYTE >= 0 theoratically
         }
-        StringBuffer stringMemory
-            = logBuffer.sourcebuffer->AllocateStringBuffer(READ_BYTE); // allocate modifiable buffer
+        const bool zeroCopy = BOOL_FLAG(enable_zero_copy_read);
+        if (zeroCopy) {
+            // the tail of last read is already at the beginning of the chunk
+            stringBuffer = PrepareReadChunk(READ_BYTE);
+            logBuffer.sourcebuffer->HoldBuffer(mReadChunk);
+        } else {
+            StringBuffer stringMemory
+                = logBuffer.sourcebuffer->AllocateStringBuffer(READ_BYTE); // allocate modifiable buffer
+            stringBuffer = stringMemory.data;
+        }
         if (lastCacheSize) {
             READ_BYTE -= lastCacheSize; // reserve space to copy from cache if needed
         }
         TruncateInfo* truncateInfo = nullptr;
         int64_t lastReadPos = GetLastReadPos();
-        nbytes = READ_BYTE
-            ? ReadFile(mLogFileOp, stringMemory.data + lastCacheSize, READ_BYTE, lastReadPos, &truncateInfo)
-            : (size_t)0;
-        stringBuffer = stringMemory.data;
+        nbytes = READ_BYTE ? ReadFile(mLogFileOp, stringBuffer + lastCacheSize, READ_BYTE, lastReadPos, &truncateInfo)
+                           : (size_t)0;
         bool allowRollback = true;
         // Only when there is no new log and not try rollback, then force read
         if (!tryRollback && nbytes == 0) {
@@ -1619,10 +1684,15 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
         }
         if (nbytes == 0 && (!lastCacheSize || allowRollback)) { // read nothing, if no cached data or allow rollback the
             // reader's state cannot be changed
+            if (!lastCacheSize) {
+                ClearCache(); // release the empty read chunk
+            }
             return;
         }
         if (lastCacheSize) {
-            memcpy(stringBuffer, mCache.data(), lastCacheSize); // copy from cache
+            if (!zeroCopy) {
+                memcpy(stringBuffer, mCache.data(), lastCacheSize); // copy from cache
+            }
             nbytes += lastCacheSize;
         }
         // Ignore \n if last is force read
@@ -1666,15 +1736,18 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
                     SPLIT_LOG_FAIL_ALARM, oss.str(), GetRegion(), GetProject(), GetConfigName(), GetLogstore());
             } else {
                 // line is not finished yet nor more data, put all data in cache
-                mCache.assign(stringBuffer, stringBufferLen);
+                SetCache(stringBuffer, stringBufferLen, zeroCopy);
                 return;
             }
         }
         if (nbytes < stringBufferLen) {
-            // rollback happend, put rollbacked part in cache
-            mCache.assign(stringBuffer + nbytes, stringBufferLen - nbytes);
+            // rollback happend, put rollbacked part in cache. The tail can be kept in place only if it is not
+            // overwritten by the '\0' appended below.
+            SetCache(stringBuffer + nbytes,
+                     stringBufferLen - nbytes,
+                     zeroCopy && (stringBuffer[nbytes - 1] == '\n' || stringBuffer[nbytes - 1] == '\0'));
         } else {
-            mCache.clear();
+            ClearCache();
         }
         if (!moreData && fromCpt && lastReadPos < end) {
             moreData = true;
@@ -359,7 +359,7 @@ public:
 
     bool IsReadToEnd() const { return GetLastReadPos() == mLastFileSize; }
 
-    bool HasDataInCache() const { return mCache.size(); }
+    bool HasDataInCache() const { return GetCacheSize(); }
 
     LogFileReaderPtrArray* GetReaderArray();
 
@@ -480,8 +480,12 @@ protected:
     bool CheckForFirstOpen(FileReadPolicy policy = BACKWARD_TO_FIXED_POS);
     void FixLastFilePos(LogFileOperator& logFileOp, int64_t endOffset);
     inline int64_t GetLastReadPos() const { // pos read but may not consumed, used for read needed
-        return mLastFilePos + mCache.size();
+        return mLastFilePos + GetCacheSize();
     }
+    inline size_t GetCacheSize() const { return mCache.size() + mReadChunkTailSize; }
+    void ClearCache();
+    char* PrepareReadChunk(size_t size);
+    void SetCache(const char* data, size_t size, bool inReadChunk);
     void ResolveHostLogPath();
 
     // std::string mRegion;
@@ -502,6 +506,13 @@ protected:
     int64_t mLastFileSize = 0;
     time_t mLastMTime = 0;
     std::string mCache;
+    // When zero copy read is enabled, data is read into a chunk shared by the reader and the LogBuffers read from it.
+    // The unfinished tail of the last read is kept in place instead of in mCache, and new data is read right after it,
+    // so that a log spanning two reads is stitched without any copy.
+    std::shared_ptr<char> mReadChunk;
+    size_t mReadChunkCapacity = 0;
+    size_t mReadChunkTailOffset = 0;
+    size_t mReadChunkTailSize = 0;
     // >= 0: index of reader array, -1: new reader, -2: not in reader array, -3: not found
     int32_t mIdxInReaderArrayFromLastCpt = CHECKPOINT_IDX_OF_NEW_READER_IN_ARRAY;
     // std::string mProjectName;
@@ -726,6 +737,7 @@ private:
     friend class CreateModifyHandlerUnittest;
     friend class LogFileReaderHoleUnittest;
     friend class LogFileReaderResolvedPathUnittest;
+    friend class LogFileReaderBenchmark;
 
 protected:
     void UpdateReaderManual();
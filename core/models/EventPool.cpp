@@ -20,11 +20,19 @@
 #include "logger/Logger.h"
 
 DEFINE_FLAG_INT32(event_pool_gc_interval_sec, "", 60);
+DEFINE_FLAG_INT32(event_pool_max_pending_returned_events,
+                  "max events returned by other threads and not taken by the owner yet for each threaded event pool",
+                  100000);
 
 using namespace std;
 
 namespace logtail {
 
+// log events whose contents capacity is larger are kept in the large pool
+static constexpr size_t kSmallLogEventContentsCapacity = 16;
+// log events whose contents capacity is larger have their contents freed before being pooled
+static constexpr size_t kMaxPooledLogEventContentsCapacity = 256;
+
 EventPool::~EventPool() {
     if (mEnableLock) {
         {
@@ -40,13 +48,18 @@ EventPool::~EventPool() {
     }
 }
 
-LogEvent* EventPool::AcquireLogEvent(PipelineEventGroup* ptr) {
+LogEvent* EventPool::AcquireLogEvent(PipelineEventGroup* ptr, size_t contentsCntHint) {
+    bool preferLarge = contentsCntHint > kSmallLogEventContentsCapacity;
     if (mEnableLock) {
         TransferPoolIfEmpty(mLogEventPool, mLogEventPoolBak);
+        TransferPoolIfEmpty(mLargeLogEventPool, mLargeLogEventPoolBak);
         lock_guard<mutex> lock(mPoolMux);
-        return AcquireEventNoLock(ptr, mLogEventPool, mMinUnusedLogEventsCnt);
+        return AcquireLogEventNoLock(ptr, preferLarge);
     }
-    return AcquireEventNoLock(ptr, mLogEventPool, mMinUnusedLogEventsCnt);
+    if (mLogEventPool.empty() && mLargeLogEventPool.empty()) {
+        DrainLogEventReturnList();
+    }
+    return AcquireLogEventNoLock(ptr, preferLarge);
 }
 
 MetricEvent* EventPool::AcquireMetricEvent(PipelineEventGroup* ptr) {
@@ -55,6 +68,9 @@ MetricEvent* EventPool::AcquireMetricEvent(PipelineEventGroup* ptr) {
         lock_guard<mutex> lock(mPoolMux);
         return AcquireEventNoLock(ptr, mMetricEventPool, mMinUnusedMetricEventsCnt);
     }
+    if (mMetricEventPool.empty()) {
+        DrainReturnList(mMetricEventPool);
+    }
     return AcquireEventNoLock(ptr, mMetricEventPool, mMinUnusedMetricEventsCnt);
 }
 
@@ -64,6 +80,9 @@ SpanEvent* EventPool::AcquireSpanEvent(PipelineEventGroup* ptr) {
         lock_guard<mutex> lock(mPoolMux);
         return AcquireEventNoLock(ptr, mSpanEventPool, mMinUnusedSpanEventsCnt);
     }
+    if (mSpanEventPool.empty()) {
+        DrainReturnList(mSpanEventPool);
+    }
     return AcquireEventNoLock(ptr, mSpanEventPool, mMinUnusedSpanEventsCnt);
 }
 
@@ -73,15 +92,19 @@ RawEvent* EventPool::AcquireRawEvent(PipelineEventGroup* ptr) {
         lock_guard<mutex> lock(mPoolMux);
         return AcquireEventNoLock(ptr, mRawEventPool, mMinUnusedRawEventsCnt);
     }
+    if (mRawEventPool.empty()) {
+        DrainReturnList(mRawEventPool);
+    }
     return AcquireEventNoLock(ptr, mRawEventPool, mMinUnusedRawEventsCnt);
 }
 
 void EventPool::Release(vector<LogEvent*>&& obj) {
     if (mEnableLock) {
         lock_guard<mutex> lock(mPoolBakMux);
-        mLogEventPoolBak.insert(mLogEventPoolBak.end(), obj.begin(), obj.end());
+        PutLogEvents(obj, mLogEventPoolBak, mLargeLogEventPoolBak);
     } else {
-        mLogEventPool.insert(mLogEventPool.end(), obj.begin(), obj.end());
+        ReturnToOwners(obj);
+        PutLogEvents(obj, mLogEventPool, mLargeLogEventPool);
     }
 }
 
@@ -90,6 +113,7 @@ void EventPool::Release(vector<MetricEvent*>&& obj) {
         lock_guard<mutex> lock(mPoolBakMux);
         mMetricEventPoolBak.insert(mMetricEventPoolBak.end(), obj.begin(), obj.end());
     } else {
+        ReturnToOwners(obj);
         mMetricEventPool.insert(mMetricEventPool.end(), obj.begin(), obj.end());
     }
 }
@@ -99,6 +123,7 @@ void EventPool::Release(vector<SpanEvent*>&& obj) {
         lock_guard<mutex> lock(mPoolBakMux);
         mSpanEventPoolBak.insert(mSpanEventPoolBak.end(), obj.begin(), obj.end());
     } else {
+        ReturnToOwners(obj);
         mSpanEventPool.insert(mSpanEventPool.end(), obj.begin(), obj.end());
     }
 }
@@ -108,10 +133,91 @@ void EventPool::Release(vector<RawEvent*>&& obj) {
         lock_guard<mutex> lock(mPoolBakMux);
         mRawEventPoolBak.insert(mRawEventPoolBak.end(), obj.begin(), obj.end());
     } else {
+        ReturnToOwners(obj);
         mRawEventPool.insert(mRawEventPool.end(), obj.begin(), obj.end());
     }
 }
 
+void EventPool::FetchStatistics(uint64_t& acquireCnt, uint64_t& hitCnt, uint64_t& returnedCnt) {
+    acquireCnt = mAcquireCnt.exchange(0, memory_order_relaxed);
+    hitCnt = mAcquireHitCnt.exchange(0, memory_order_relaxed);
+    returnedCnt = mReturnedCnt.exchange(0, memory_order_relaxed);
+}
+
+LogEvent* EventPool::AcquireLogEventNoLock(PipelineEventGroup* ptr, bool preferLarge) {
+    if ((preferLarge || mLogEventPool.empty()) && !mLargeLogEventPool.empty()) {
+        return AcquireEventNoLock(ptr, mLargeLogEventPool, mMinUnusedLargeLogEventsCnt);
+    }
+    return AcquireEventNoLock(ptr, mLogEventPool, mMinUnusedLogEventsCnt);
+}
+
+void EventPool::PutLogEvents(vector<LogEvent*>& obj, vector<LogEvent*>& pool, vector<LogEvent*>& largePool) {
+    for (auto* e : obj) {
+        size_t capacity = e->mContents.capacity();
+        if (capacity <= kSmallLogEventContentsCapacity) {
+            pool.push_back(e);
+        } else if (capacity <= kMaxPooledLogEventContentsCapacity) {
+            largePool.push_back(e);
+        } else {
+            ContentsContainer().swap(e->mContents);
+            pool.push_back(e);
+        }
+    }
+}
+
+template <class T>
+void EventPool::ReturnToOwners(vector<T*>& obj) {
+    size_t wIdx = 0;
+    for (size_t rIdx = 0; rIdx < obj.size();) {
+        EventPool* owner = obj[rIdx]->mOwnerEventPool;
+        // events of a group mostly come from the same pool
+        size_t end = rIdx + 1;
+        while (end < obj.size() && obj[end]->mOwnerEventPool == owner) {
+            ++end;
+        }
+        if (owner == nullptr || owner == this || !owner->TryReturn(obj.data() + rIdx, obj.data() + end)) {
+            // the owner has not taken its events for long, e.g. the thread has stopped creating events, so they are
+            // kept here instead
+            for (; rIdx < end; ++rIdx, ++wIdx) {
+                obj[wIdx] = obj[rIdx];
+            }
+        }
+        rIdx = end;
+    }
+    obj.resize(wIdx);
+}
+
+template <class T>
+bool EventPool::TryReturn(T* const* begin, T* const* end) {
+    size_t cnt = end - begin;
+    size_t limit = static_cast<size_t>(INT32_FLAG(event_pool_max_pending_returned_events));
+    if (mPendingReturnedCnt.fetch_add(cnt, memory_order_relaxed) + cnt > limit) {
+        mPendingReturnedCnt.fetch_sub(cnt, memory_order_relaxed);
+        return false;
+    }
+    GetReturnList(static_cast<T*>(nullptr)).Push(vector<T*>(begin, end));
+    mReturnedCnt.fetch_add(cnt, memory_order_relaxed);
+    return true;
+}
+
+template <class T>
+void EventPool::DrainReturnList(vector<T*>& pool) {
+    size_t cnt = GetReturnList(static_cast<T*>(nullptr)).PopAll(pool);
+    if (cnt > 0) {
+        mPendingReturnedCnt.fetch_sub(cnt, memory_order_relaxed);
+    }
+}
+
+void EventPool::DrainLogEventReturnList() {
+    thread_local vector<LogEvent*> sReturned;
+    size_t cnt = mReturnedLogEvents.PopAll(sReturned);
+    if (cnt > 0) {
+        mPendingReturnedCnt.fetch_sub(cnt, memory_order_relaxed);
+        PutLogEvents(sReturned, mLogEventPool, mLargeLogEventPool);
+        sReturned.clear();
+    }
+}
+
 template <class T>
 void DoGC(vector<T*>& pool, vector<T*>& poolBak, size_t& minUnusedCnt, mutex* mux, const string& type) {
     if (minUnusedCnt <= pool.size() || minUnusedCnt == numeric_limits<size_t>::max()) {
@@ -147,11 +253,18 @@ void EventPool::CheckGC() {
         if (mEnableLock) {
             lock_guard<mutex> lock(mPoolMux);
             DoGC(mLogEventPool, mLogEventPoolBak, mMinUnusedLogEventsCnt, &mPoolBakMux, "log");
+            DoGC(mLargeLogEventPool, mLargeLogEventPoolBak, mMinUnusedLargeLogEventsCnt, &mPoolBakMux, "large log");
             DoGC(mMetricEventPool, mMetricEventPoolBak, mMinUnusedMetricEventsCnt, &mPoolBakMux, "metric");
             DoGC(mSpanEventPool, mSpanEventPoolBak, mMinUnusedSpanEventsCnt, &mPoolBakMux, "span");
             DoGC(mRawEventPool, mRawEventPoolBak, mMinUnusedRawEventsCnt, &mPoolBakMux, "raw");
         } else {
+            // events returned by other threads are not in use either
+            DrainLogEventReturnList();
+            DrainReturnList(mMetricEventPool);
+            DrainReturnList(mSpanEventPool);
+            DrainReturnList(mRawEventPool);
             DoGC(mLogEventPool, mLogEventPoolBak, mMinUnusedLogEventsCnt, nullptr, "log");
+            DoGC(mLargeLogEventPool, mLargeLogEventPoolBak, mMinUnusedLargeLogEventsCnt, nullptr, "large log");
             DoGC(mMetricEventPool, mMetricEventPoolBak, mMinUnusedMetricEventsCnt, nullptr, "metric");
             DoGC(mSpanEventPool, mSpanEventPoolBak, mMinUnusedSpanEventsCnt, nullptr, "span");
             DoGC(mRawEventPool, mRawEventPoolBak, mMinUnusedRawEventsCnt, nullptr, "raw");
@@ -164,6 +277,9 @@ void EventPool::DestroyAllEventPool() {
     for (auto& item : mLogEventPool) {
         delete item;
     }
+    for (auto& item : mLargeLogEventPool) {
+        delete item;
+    }
     for (auto& item : mMetricEventPool) {
         delete item;
     }
@@ -179,6 +295,9 @@ void EventPool::DestroyAllEventPoolBak() {
     for (auto& item : mLogEventPoolBak) {
         delete item;
     }
+    for (auto& item : mLargeLogEventPoolBak) {
+        delete item;
+    }
     for (auto& item : mMetricEventPoolBak) {
         delete item;
     }
@@ -194,20 +313,32 @@ void EventPool::DestroyAllEventPoolBak() {
 void EventPool::Clear() {
     {
         lock_guard<mutex> lock(mPoolMux);
+        if (!mEnableLock) {
+            DrainLogEventReturnList();
+            DrainReturnList(mMetricEventPool);
+            DrainReturnList(mSpanEventPool);
+            DrainReturnList(mRawEventPool);
+        }
         DestroyAllEventPool();
         mLogEventPool.clear();
+        mLargeLogEventPool.clear();
         mMetricEventPool.clear();
         mSpanEventPool.clear();
         mRawEventPool.clear();
         mMinUnusedLogEventsCnt = numeric_limits<size_t>::max();
+        mMinUnusedLargeLogEventsCnt = numeric_limits<size_t>::max();
         mMinUnusedMetricEventsCnt = numeric_limits<size_t>::max();
         mMinUnusedSpanEventsCnt = numeric_limits<size_t>::max();
         mMinUnusedRawEventsCnt = numeric_limits<size_t>::max();
+        mAcquireCnt = 0;
+        mAcquireHitCnt = 0;
+        mReturnedCnt = 0;
     }
     {
         lock_guard<mutex> lock(mPoolBakMux);
         DestroyAllEventPoolBak();
         mLogEventPoolBak.clear();
+        mLargeLogEventPoolBak.clear();
         mMetricEventPoolBak.clear();
         mSpanEventPoolBak.clear();
         mRawEventPoolBak.clear();
@@ -216,6 +347,62 @@ void EventPool::Clear() {
 }
 #endif
 
-thread_local EventPool gThreadedEventPool(false);
+namespace {
+
+// Threaded pools are never destroyed, since events may still be returned to them after their threads exit. Instead,
+// the pool of an exited thread is taken over by the next new thread.
+class ThreadedEventPoolRegistry {
+public:
+    static ThreadedEventPoolRegistry* GetInstance() {
+        static auto* sInstance = new ThreadedEventPoolRegistry();
+        return sInstance;
+    }
+
+    EventPool* Acquire() {
+        lock_guard<mutex> lock(mMux);
+        if (mIdlePools.empty()) {
+            mPools.push_back(new EventPool(false));
+            return mPools.back();
+        }
+        auto* pool = mIdlePools.back();
+        mIdlePools.pop_back();
+        return pool;
+    }
+
+    void Release(EventPool* pool) {
+        lock_guard<mutex> lock(mMux);
+        mIdlePools.push_back(pool);
+    }
+
+    void FetchStatistics(vector<EventPoolStatistics>& res) {
+        lock_guard<mutex> lock(mMux);
+        res.resize(mPools.size());
+        for (size_t i = 0; i < mPools.size(); ++i) {
+            mPools[i]->FetchStatistics(res[i].mAcquireCnt, res[i].mHitCnt, res[i].mReturnedCnt);
+        }
+    }
+
+private:
+    mutex mMux;
+    vector<EventPool*> mPools;
+    vector<EventPool*> mIdlePools;
+};
+
+struct ThreadedEventPoolHolder {
+    ThreadedEventPoolHolder() : mPool(ThreadedEventPoolRegistry::GetInstance()->Acquire()) {}
+    ~ThreadedEventPoolHolder() { ThreadedEventPoolRegistry::GetInstance()->Release(mPool); }
+
+    EventPool* mPool;
+};
+
+thread_local ThreadedEventPoolHolder sThreadedEventPoolHolder;
+
+} // namespace
+
+thread_local EventPool& gThreadedEventPool = *sThreadedEventPoolHolder.mPool;
+
+void FetchThreadedEventPoolStatistics(vector<EventPoolStatistics>& res) {
+    ThreadedEventPoolRegistry::GetInstance()->FetchStatistics(res);
+}
 
 } // namespace logtail
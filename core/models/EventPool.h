@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <atomic>
 #include <limits>
 #include <mutex>
 #include <optional>
@@ -31,6 +32,54 @@
 namespace logtail {
 class PipelineEventGroup;
 
+// A lock free list, to which any thread can push events, while only the owner pops all of them at once.
+template <class T>
+class EventReturnList {
+public:
+    EventReturnList() = default;
+    EventReturnList(const EventReturnList&) = delete;
+    EventReturnList& operator=(const EventReturnList&) = delete;
+    ~EventReturnList() {
+        std::vector<T*> events;
+        PopAll(events);
+        for (auto* e : events) {
+            delete e;
+        }
+    }
+
+    void Push(std::vector<T*>&& events) {
+        auto* node = new Node{std::move(events), mHead.load(std::memory_order_relaxed)};
+        while (!mHead.compare_exchange_weak(node->mNext, node, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+
+    size_t PopAll(std::vector<T*>& res) {
+        auto* node = mHead.exchange(nullptr, std::memory_order_acquire);
+        size_t cnt = 0;
+        while (node != nullptr) {
+            cnt += node->mEvents.size();
+            res.insert(res.end(), node->mEvents.begin(), node->mEvents.end());
+            auto* next = node->mNext;
+            delete node;
+            node = next;
+        }
+        return cnt;
+    }
+
+private:
+    struct Node {
+        std::vector<T*> mEvents;
+        Node* mNext = nullptr;
+    };
+
+    std::atomic<Node*> mHead = nullptr;
+};
+
+// With lock, the pool can be shared by threads. Without lock, the pool is owned by one thread, and events released by
+// other threads are handed back to it through the return lists, which are drained when the pool runs out.
+//
+// Log events are kept in size classes by the capacity of their contents, so that events with many contents are reused
+// for such logs first, and the contents of huge events are freed before they are pooled.
 class EventPool {
 public:
     explicit EventPool(bool enableLock = true) : mEnableLock(enableLock) {}
@@ -38,7 +87,7 @@ public:
     EventPool(const EventPool&) = delete;
     EventPool& operator=(const EventPool&) = delete;
 
-    LogEvent* AcquireLogEvent(PipelineEventGroup* ptr);
+    LogEvent* AcquireLogEvent(PipelineEventGroup* ptr, size_t contentsCntHint = 0);
     MetricEvent* AcquireMetricEvent(PipelineEventGroup* ptr);
     SpanEvent* AcquireSpanEvent(PipelineEventGroup* ptr);
     RawEvent* AcquireRawEvent(PipelineEventGroup* ptr);
@@ -48,6 +97,9 @@ public:
     void Release(std::vector<RawEvent*>&& obj);
     void CheckGC();
 
+    // Returns the counts since the last call, for self monitoring.
+    void FetchStatistics(uint64_t& acquireCnt, uint64_t& hitCnt, uint64_t& returnedCnt);
+
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
 #endif
@@ -64,17 +116,39 @@ private:
 
     template <class T>
     T* AcquireEventNoLock(PipelineEventGroup* ptr, std::vector<T*>& pool, size_t& minUnusedCnt) {
+        mAcquireCnt.fetch_add(1, std::memory_order_relaxed);
         if (pool.empty()) {
-            return new T(ptr);
+            auto* obj = new T(ptr);
+            obj->mOwnerEventPool = mEnableLock ? nullptr : this;
+            return obj;
         }
 
+        mAcquireHitCnt.fetch_add(1, std::memory_order_relaxed);
         auto obj = pool.back();
         obj->ResetPipelineEventGroup(ptr);
+        obj->mOwnerEventPool = mEnableLock ? nullptr : this;
         pool.pop_back();
         minUnusedCnt = std::min(minUnusedCnt, pool.size());
         return obj;
     }
 
+    LogEvent* AcquireLogEventNoLock(PipelineEventGroup* ptr, bool preferLarge);
+    void PutLogEvents(std::vector<LogEvent*>& obj, std::vector<LogEvent*>& pool, std::vector<LogEvent*>& largePool);
+
+    // only called by the owner of a pool without lock
+    template <class T>
+    void ReturnToOwners(std::vector<T*>& obj);
+    template <class T>
+    bool TryReturn(T* const* begin, T* const* end);
+    template <class T>
+    void DrainReturnList(std::vector<T*>& pool);
+    void DrainLogEventReturnList();
+
+    EventReturnList<LogEvent>& GetReturnList(LogEvent*) { return mReturnedLogEvents; }
+    EventReturnList<MetricEvent>& GetReturnList(MetricEvent*) { return mReturnedMetricEvents; }
+    EventReturnList<SpanEvent>& GetReturnList(SpanEvent*) { return mReturnedSpanEvents; }
+    EventReturnList<RawEvent>& GetReturnList(RawEvent*) { return mReturnedRawEvents; }
+
     void DestroyAllEventPool();
     void DestroyAllEventPoolBak();
 
@@ -82,6 +156,7 @@ private:
 
     std::mutex mPoolMux;
     std::vector<LogEvent*> mLogEventPool;
+    std::vector<LogEvent*> mLargeLogEventPool;
     std::vector<MetricEvent*> mMetricEventPool;
     std::vector<SpanEvent*> mSpanEventPool;
     std::vector<RawEvent*> mRawEventPool;
@@ -89,15 +164,29 @@ private:
     // only meaningful when mEnableLock is true
     std::mutex mPoolBakMux;
     std::vector<LogEvent*> mLogEventPoolBak;
+    std::vector<LogEvent*> mLargeLogEventPoolBak;
     std::vector<MetricEvent*> mMetricEventPoolBak;
     std::vector<SpanEvent*> mSpanEventPoolBak;
     std::vector<RawEvent*> mRawEventPoolBak;
 
+    // only meaningful when mEnableLock is false
+    EventReturnList<LogEvent> mReturnedLogEvents;
+    EventReturnList<MetricEvent> mReturnedMetricEvents;
+    EventReturnList<SpanEvent> mReturnedSpanEvents;
+    EventReturnList<RawEvent> mReturnedRawEvents;
+    std::atomic_size_t mPendingReturnedCnt = 0;
+
     size_t mMinUnusedLogEventsCnt = std::numeric_limits<size_t>::max();
+    size_t mMinUnusedLargeLogEventsCnt = std::numeric_limits<size_t>::max();
     size_t mMinUnusedMetricEventsCnt = std::numeric_limits<size_t>::max();
     size_t mMinUnusedSpanEventsCnt = std::numeric_limits<size_t>::max();
     size_t mMinUnusedRawEventsCnt = std::numeric_limits<size_t>::max();
 
+    // atomic, since statistics of threaded pools are fetched by the monitor thread
+    std::atomic_uint64_t mAcquireCnt = 0;
+    std::atomic_uint64_t mAcquireHitCnt = 0;
+    std::atomic_uint64_t mReturnedCnt = 0;
+
     time_t mLastGCTime = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -107,6 +196,16 @@ private:
 #endif
 };
 
-extern thread_local EventPool gThreadedEventPool;
+// Each thread owns a pool, which is taken over by a new thread after the owner exits.
+extern thread_local EventPool& gThreadedEventPool;
+
+struct EventPoolStatistics {
+    uint64_t mAcquireCnt = 0;
+    uint64_t mHitCnt = 0;
+    uint64_t mReturnedCnt = 0;
+};
+
+// Fetches the statistics of all threaded pools since the last call, indexed by the creation order of the pools.
+void FetchThreadedEventPoolStatistics(std::vector<EventPoolStatistics>& res);
 
 } // namespace logtail
@@ -65,6 +65,7 @@ void LogEvent::SetContentNoCopy(const StringBuffer& key, const StringBuffer& val
 }
 
 void LogEvent::SetContentNoCopy(StringView key, StringView val) {
+    size_t oldSize = mAllocatedContentSize;
     auto rst = mIndex.insert(make_pair(key, mContents.size()));
     if (!rst.second) {
         auto& it = rst.first;
@@ -75,15 +76,18 @@ void LogEvent::SetContentNoCopy(StringView key, StringView val) {
         mAllocatedContentSize += key.size() + val.size();
         mContents.emplace_back(make_pair(key, val), true);
     }
+    OnDataSizeChanged(oldSize, mAllocatedContentSize);
 }
 
 void LogEvent::DelContent(StringView key) {
     auto it = mIndex.find(key);
     if (it != mIndex.end()) {
         auto& field = mContents[it->second].first;
+        size_t oldSize = mAllocatedContentSize;
         mAllocatedContentSize -= field.first.size() + field.second.size();
         mContents[it->second].second = false;
         mIndex.erase(it);
+        OnDataSizeChanged(oldSize, mAllocatedContentSize);
     }
 }
 
@@ -145,6 +149,7 @@ void LogEvent::AppendContentNoCopy(StringView key, StringView val) {
     mAllocatedContentSize += key.size() + val.size();
     mContents.emplace_back(make_pair(key, val), true);
     mIndex[key] = mContents.size() - 1;
+    OnDataSizeChanged(0, key.size() + val.size());
 }
 
 size_t LogEvent::DataSize() const {
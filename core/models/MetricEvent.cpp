@@ -16,6 +16,8 @@
 
 #include "models/MetricEvent.h"
 
+#include <xxhash/xxhash.h>
+
 #include <algorithm>
 
 using namespace std;
@@ -39,15 +41,18 @@ void MetricEvent::Reset() {
     mValue = MetricValue();
     mTags.Clear();
     mMetadata.Clear();
+    mSeriesHash.reset();
 }
 
 void MetricEvent::SetName(const string& name) {
     const StringBuffer& b = GetSourceBuffer()->CopyString(name);
     mName = StringView(b.data, b.size);
+    mSeriesHash.reset();
 }
 
 void MetricEvent::SetNameNoCopy(StringView name) {
     mName = name;
+    mSeriesHash.reset();
 }
 
 StringView MetricEvent::GetTag(StringView key) const {
@@ -77,10 +82,30 @@ void MetricEvent::SetTagNoCopy(const StringBuffer& key, const StringBuffer& val)
 
 void MetricEvent::SetTagNoCopy(StringView key, StringView val) {
     mTags.Insert(key, val);
+    mSeriesHash.reset();
 }
 
 void MetricEvent::DelTag(StringView key) {
     mTags.Erase(key);
+    mSeriesHash.reset();
+}
+
+uint64_t MetricEvent::GetSeriesHash() {
+    if (mSeriesHash) {
+        return *mSeriesHash;
+    }
+    if (!std::is_sorted(mTags.mInner.begin(), mTags.mInner.end())) {
+        SortTags();
+    }
+    // each piece is hashed with the hash of the previous pieces as the seed, so that no buffer is needed and
+    // different splits of the same bytes, e.g. {"ab": "c"} and {"a": "bc"}, are not hashed as the same input
+    uint64_t h = XXH64(mName.data(), mName.size(), 0);
+    for (const auto& tag : mTags.mInner) {
+        h = XXH64(tag.first.data(), tag.first.size(), h);
+        h = XXH64(tag.second.data(), tag.second.size(), h);
+    }
+    mSeriesHash = h;
+    return h;
 }
 
 
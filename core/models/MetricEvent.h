@@ -17,6 +17,7 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -81,6 +82,9 @@ public:
     void SetTagNoCopy(StringView key, StringView val);
     void DelTag(StringView key);
     void SortTags() { std::sort(mTags.mInner.begin(), mTags.mInner.end()); };
+    // Hash of the name and tags, which identifies the series regardless of the order of tags. Tags are sorted if they
+    // are not yet, and the hash is cached until the name or tags are changed.
+    uint64_t GetSeriesHash();
 
     std::vector<std::pair<StringView, StringView>>::const_iterator TagsBegin() const { return mTags.mInner.begin(); }
     std::vector<std::pair<StringView, StringView>>::const_iterator TagsEnd() const { return mTags.mInner.end(); }
@@ -117,6 +121,7 @@ private:
     // Additional metadata for the metric, which should be flattened as sibling fields of name, value, labels, etc.
     // during serialization.
     SizedMap mMetadata;
+    std::optional<uint64_t> mSeriesHash;
 };
 
 } // namespace logtail
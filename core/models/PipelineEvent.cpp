@@ -63,6 +63,12 @@ shared_ptr<SourceBuffer>& PipelineEvent::GetSourceBuffer() {
     return mPipelineEventGroupPtr->GetSourceBuffer();
 }
 
+void PipelineEvent::OnDataSizeChanged(size_t oldSize, size_t newSize) {
+    if (mPipelineEventGroupPtr != nullptr) {
+        mPipelineEventGroupPtr->UpdateEventsDataSize(oldSize, newSize);
+    }
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 string PipelineEvent::ToJsonString(bool enableEventMeta) const {
     Json::Value root = ToJson(enableEventMeta);
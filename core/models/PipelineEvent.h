@@ -34,8 +34,11 @@
 namespace logtail {
 
 class PipelineEventGroup;
+class EventPool;
 
 class PipelineEvent {
+    friend class EventPool;
+
 public:
     enum class Type { NONE, LOG, METRIC, SPAN, RAW };
 
@@ -72,10 +75,15 @@ public:
 protected:
     PipelineEvent(Type type, PipelineEventGroup* ptr);
 
+    // report the change of DataSize() to the group, so that the group need not recompute its size
+    void OnDataSizeChanged(size_t oldSize, size_t newSize);
+
     Type mType = Type::NONE;
     time_t mTimestamp = 0;
     std::optional<uint32_t> mTimestampNanosecond;
     PipelineEventGroup* mPipelineEventGroupPtr = nullptr;
+    // the threaded event pool which the event is returned to, kept across Reset
+    EventPool* mOwnerEventPool = nullptr;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PipelineEventGroupUnittest;
@@ -68,9 +68,14 @@ PipelineEventGroup::PipelineEventGroup(PipelineEventGroup&& rhs) noexcept
       mTags(std::move(rhs.mTags)),
       mEvents(std::move(rhs.mEvents)),
       mSourceBuffer(std::move(rhs.mSourceBuffer)),
-      mExtraSourceBuffers(std::move(rhs.mExtraSourceBuffers)) {
+      mExtraSourceBuffers(std::move(rhs.mExtraSourceBuffers)),
+      mEventsDataSize(rhs.mEventsDataSize),
+      mIsEventsDataSizeValid(rhs.mIsEventsDataSizeValid),
+      mHasSharedEvents(rhs.mHasSharedEvents) {
     for (auto& item : mEvents) {
-        item->ResetPipelineEventGroup(this);
+        if (!item.IsShared()) {
+            item->ResetPipelineEventGroup(this);
+        }
     }
 }
 
@@ -103,8 +108,13 @@ PipelineEventGroup& PipelineEventGroup::operator=(PipelineEventGroup&& rhs) noex
         mEvents = std::move(rhs.mEvents);
         mSourceBuffer = std::move(rhs.mSourceBuffer);
         mExtraSourceBuffers = std::move(rhs.mExtraSourceBuffers);
+        mEventsDataSize = rhs.mEventsDataSize;
+        mIsEventsDataSizeValid = rhs.mIsEventsDataSizeValid;
+        mHasSharedEvents = rhs.mHasSharedEvents;
         for (auto& item : mEvents) {
-            item->ResetPipelineEventGroup(this);
+            if (!item.IsShared()) {
+                item->ResetPipelineEventGroup(this);
+            }
         }
     }
     return *this;
@@ -116,6 +126,8 @@ PipelineEventGroup PipelineEventGroup::Copy() const {
     res.mTags = mTags;
     res.mExactlyOnceCheckpoint = mExactlyOnceCheckpoint;
     res.mExtraSourceBuffers = mExtraSourceBuffers;
+    res.mEventsDataSize = mEventsDataSize;
+    res.mIsEventsDataSizeValid = mIsEventsDataSizeValid;
     for (auto& event : mEvents) {
         res.mEvents.emplace_back(event.Copy());
         res.mEvents.back()->ResetPipelineEventGroup(&res);
@@ -123,13 +135,68 @@ PipelineEventGroup PipelineEventGroup::Copy() const {
     return res;
 }
 
-unique_ptr<LogEvent> PipelineEventGroup::CreateLogEvent(bool fromPool, EventPool* pool) {
+PipelineEventGroup PipelineEventGroup::Share() {
+    ShareEvents();
+    PipelineEventGroup res(mSourceBuffer);
+    res.mMetadata = mMetadata;
+    res.mTags = mTags;
+    res.mExactlyOnceCheckpoint = mExactlyOnceCheckpoint;
+    res.mExtraSourceBuffers = mExtraSourceBuffers;
+    res.mEventsDataSize = mEventsDataSize;
+    res.mIsEventsDataSizeValid = mIsEventsDataSizeValid;
+    res.mHasSharedEvents = mHasSharedEvents;
+    res.mEvents.reserve(mEvents.size());
+    for (auto& event : mEvents) {
+        res.mEvents.emplace_back(event.Share());
+    }
+    return res;
+}
+
+void PipelineEventGroup::ShareEvents() {
+    // exclusive events are moved to a holder group, which is destroyed after all groups sharing them are destroyed, so
+    // that events can be returned to the event pool as usual
+    shared_ptr<PipelineEventGroup> holder;
+    for (auto& event : mEvents) {
+        if (!event || event.IsShared()) {
+            continue;
+        }
+        if (!holder) {
+            holder = make_shared<PipelineEventGroup>(mSourceBuffer);
+            holder->mExtraSourceBuffers = mExtraSourceBuffers;
+            holder->mEvents.reserve(mEvents.size());
+            holder->InvalidateDataSize();
+        }
+        PipelineEvent* ptr = event.operator->();
+        ptr->ResetPipelineEventGroup(holder.get());
+        holder->mEvents.emplace_back(std::move(event));
+        event = PipelineEventPtr(ptr, holder);
+        mHasSharedEvents = true;
+    }
+}
+
+void PipelineEventGroup::MakeExclusive() {
+    if (!mHasSharedEvents) {
+        return;
+    }
+    for (auto& event : mEvents) {
+        if (event.IsShared()) {
+            event = event.Copy();
+            event->ResetPipelineEventGroup(this);
+        }
+    }
+    // the source buffer is shared with other groups as well, new strings should not be allocated from it
+    mExtraSourceBuffers.insert(mSourceBuffer);
+    mSourceBuffer = make_shared<SourceBuffer>();
+    mHasSharedEvents = false;
+}
+
+unique_ptr<LogEvent> PipelineEventGroup::CreateLogEvent(bool fromPool, EventPool* pool, size_t contentsCntHint) {
     LogEvent* e = nullptr;
     if (fromPool) {
         if (pool) {
-            e = pool->AcquireLogEvent(this);
+            e = pool->AcquireLogEvent(this, contentsCntHint);
         } else {
-            e = gThreadedEventPool.AcquireLogEvent(this);
+            e = gThreadedEventPool.AcquireLogEvent(this, contentsCntHint);
         }
     } else {
         e = new LogEvent(this);
@@ -179,22 +246,25 @@ unique_ptr<RawEvent> PipelineEventGroup::CreateRawEvent(bool fromPool, EventPool
     return unique_ptr<RawEvent>(e);
 }
 
-LogEvent* PipelineEventGroup::AddLogEvent(bool fromPool, EventPool* pool) {
+LogEvent* PipelineEventGroup::AddLogEvent(bool fromPool, EventPool* pool, size_t contentsCntHint) {
+    MakeExclusive();
     LogEvent* e = nullptr;
     if (fromPool) {
         if (pool) {
-            e = pool->AcquireLogEvent(this);
+            e = pool->AcquireLogEvent(this, contentsCntHint);
         } else {
-            e = gThreadedEventPool.AcquireLogEvent(this);
+            e = gThreadedEventPool.AcquireLogEvent(this, contentsCntHint);
         }
     } else {
         e = new LogEvent(this);
     }
     mEvents.emplace_back(e, fromPool, pool);
+    UpdateEventsDataSize(0, e->DataSize());
     return e;
 }
 
 MetricEvent* PipelineEventGroup::AddMetricEvent(bool fromPool, EventPool* pool) {
+    MakeExclusive();
     MetricEvent* e = nullptr;
     if (fromPool) {
         if (pool) {
@@ -206,10 +276,12 @@ MetricEvent* PipelineEventGroup::AddMetricEvent(bool fromPool, EventPool* pool)
         e = new MetricEvent(this);
     }
     mEvents.emplace_back(e, fromPool, pool);
+    InvalidateDataSize();
     return e;
 }
 
 SpanEvent* PipelineEventGroup::AddSpanEvent(bool fromPool, EventPool* pool) {
+    MakeExclusive();
     SpanEvent* e = nullptr;
     if (fromPool) {
         if (pool) {
@@ -221,10 +293,12 @@ SpanEvent* PipelineEventGroup::AddSpanEvent(bool fromPool, EventPool* pool) {
         e = new SpanEvent(this);
     }
     mEvents.emplace_back(e, fromPool, pool);
+    InvalidateDataSize();
     return e;
 }
 
 RawEvent* PipelineEventGroup::AddRawEvent(bool fromPool, EventPool* pool) {
+    MakeExclusive();
     RawEvent* e = nullptr;
     if (fromPool) {
         if (pool) {
@@ -236,6 +310,7 @@ RawEvent* PipelineEventGroup::AddRawEvent(bool fromPool, EventPool* pool) {
         e = new RawEvent(this);
     }
     mEvents.emplace_back(e, fromPool, pool);
+    UpdateEventsDataSize(0, e->DataSize());
     return e;
 }
 
@@ -326,11 +401,17 @@ size_t PipelineEventGroup::GetTagsHash() const {
 }
 
 size_t PipelineEventGroup::DataSize() const {
-    size_t eventsSize = sizeof(decltype(mEvents));
-    for (const auto& item : mEvents) {
-        eventsSize += item->DataSize();
+    if (!mIsEventsDataSizeValid) {
+        size_t eventsSize = sizeof(decltype(mEvents));
+        for (const auto& item : mEvents) {
+            eventsSize += item->DataSize();
+        }
+        mEventsDataSize = eventsSize;
+        // events of a group are of the same type
+        mIsEventsDataSizeValid = mEvents.empty() || mEvents[0]->GetType() == PipelineEvent::Type::LOG
+            || mEvents[0]->GetType() == PipelineEvent::Type::RAW;
     }
-    return eventsSize + mTags.DataSize();
+    return mEventsDataSize + mTags.DataSize();
 }
 
 bool PipelineEventGroup::IsReplay() const {
@@ -87,19 +87,43 @@ public:
     PipelineEventGroup& operator=(PipelineEventGroup&&) noexcept;
 
     PipelineEventGroup Copy() const;
-
-    std::unique_ptr<LogEvent> CreateLogEvent(bool fromPool = false, EventPool* pool = nullptr);
+    // Return a group sharing all events with this group without copying, the shared events are read only and are
+    // released when all sharing groups are destroyed. Shared events are copied automatically before they are exposed
+    // for modification by MutableEvents, SwapEvents or AddXxxEvent.
+    PipelineEventGroup Share();
+    // copy shared events, so that they can be modified
+    void MakeExclusive();
+    bool HasSharedEvents() const { return mHasSharedEvents; }
+
+    // contentsCntHint is the expected number of contents, which helps pick a pooled event with enough capacity
+    std::unique_ptr<LogEvent>
+    CreateLogEvent(bool fromPool = false, EventPool* pool = nullptr, size_t contentsCntHint = 0);
     std::unique_ptr<MetricEvent> CreateMetricEvent(bool fromPool = false, EventPool* pool = nullptr);
     std::unique_ptr<SpanEvent> CreateSpanEvent(bool fromPool = false, EventPool* pool = nullptr);
     std::unique_ptr<RawEvent> CreateRawEvent(bool fromPool = false, EventPool* pool = nullptr);
 
     const EventsContainer& GetEvents() const { return mEvents; }
-    EventsContainer& MutableEvents() { return mEvents; }
-    LogEvent* AddLogEvent(bool fromPool = false, EventPool* pool = nullptr);
+    EventsContainer& MutableEvents() {
+        MakeExclusive();
+        InvalidateDataSize();
+        return mEvents;
+    }
+    // move all events out of the group without copying shared events, which is only for callers taking over the events
+    // without modifying them, e.g., batchers and serializers
+    EventsContainer ReleaseEvents() {
+        InvalidateDataSize();
+        mHasSharedEvents = false;
+        return std::move(mEvents);
+    }
+    LogEvent* AddLogEvent(bool fromPool = false, EventPool* pool = nullptr, size_t contentsCntHint = 0);
     MetricEvent* AddMetricEvent(bool fromPool = false, EventPool* pool = nullptr);
     SpanEvent* AddSpanEvent(bool fromPool = false, EventPool* pool = nullptr);
     RawEvent* AddRawEvent(bool fromPool = false, EventPool* pool = nullptr);
-    void SwapEvents(EventsContainer& other) { mEvents.swap(other); }
+    void SwapEvents(EventsContainer& other) {
+        MakeExclusive();
+        InvalidateDataSize();
+        mEvents.swap(other);
+    }
     void ReserveEvents(size_t size) { mEvents.reserve(size); }
 
     std::shared_ptr<SourceBuffer>& GetSourceBuffer() { return mSourceBuffer; }
@@ -133,6 +157,9 @@ public:
     RangeCheckpointPtr& GetExactlyOnceCheckpoint() { return mExactlyOnceCheckpoint; }
     bool IsReplay() const;
 
+    // The size of events is cached and kept up to date by log and raw events, which report the change of their sizes to
+    // the group. It is recomputed on next call after the events container is exposed for modification, or when the
+    // group holds metric or span events, whose inner fields can be modified without notice.
     size_t DataSize() const;
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -144,6 +171,15 @@ public:
 #endif
 
 private:
+    void ShareEvents();
+    void InvalidateDataSize() { mIsEventsDataSizeValid = false; }
+    // called by events of this group when their sizes change
+    void UpdateEventsDataSize(size_t oldSize, size_t newSize) {
+        if (mIsEventsDataSizeValid) {
+            mEventsDataSize = mEventsDataSize + newSize - oldSize;
+        }
+    }
+
     GroupMetadata mMetadata; // Used to generate tag/log. Will not output.
     SizedMap mTags; // custom tags to output
     EventsContainer mEvents;
@@ -151,6 +187,15 @@ private:
     RangeCheckpointPtr mExactlyOnceCheckpoint;
 
     SourceBufferSet mExtraSourceBuffers;
+
+    mutable size_t mEventsDataSize = sizeof(EventsContainer);
+    mutable bool mIsEventsDataSizeValid = true;
+    bool mHasSharedEvents = false;
+
+    friend class PipelineEvent;
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class PipelineEventGroupUnittest;
+#endif
 };
 
 } // namespace logtail
@@ -29,6 +29,8 @@ namespace logtail {
 class EventPool;
 
 // only movable
+// An event is either exclusively owned, or shared read-only by several event groups, in which case the event is owned
+// by a holder kept alive by all the sharing PipelineEventPtr.
 class PipelineEventPtr {
 public:
     PipelineEventPtr() = default;
@@ -36,53 +38,72 @@ public:
         : mData(std::unique_ptr<PipelineEvent>(ptr)), mFromEventPool(fromPool), mEventPool(pool) {}
     PipelineEventPtr(std::unique_ptr<PipelineEvent>&& ptr, bool fromPool, EventPool* pool)
         : mData(std::move(ptr)), mFromEventPool(fromPool), mEventPool(pool) {}
+    // holder is the owner of the event
+    PipelineEventPtr(PipelineEvent* ptr, const std::shared_ptr<const void>& holder)
+        : mSharedData(holder, ptr) {}
 
     template <typename T>
     bool Is() const {
         if (typeid(T) == typeid(LogEvent)) {
-            return mData->GetType() == PipelineEvent::Type::LOG;
+            return Data()->GetType() == PipelineEvent::Type::LOG;
         }
         if (typeid(T) == typeid(MetricEvent)) {
-            return mData->GetType() == PipelineEvent::Type::METRIC;
+            return Data()->GetType() == PipelineEvent::Type::METRIC;
         }
         if (typeid(T) == typeid(SpanEvent)) {
-            return mData->GetType() == PipelineEvent::Type::SPAN;
+            return Data()->GetType() == PipelineEvent::Type::SPAN;
         }
         if (typeid(T) == typeid(RawEvent)) {
-            return mData->GetType() == PipelineEvent::Type::RAW;
+            return Data()->GetType() == PipelineEvent::Type::RAW;
         }
         return false;
     }
     template <typename T>
     T& Cast() {
-        return *static_cast<T*>(mData.get());
+        return *static_cast<T*>(Data());
     }
     template <typename T>
     const T& Cast() const {
-        return *static_cast<const T*>(mData.get());
+        return *static_cast<const T*>(Data());
     }
     template <typename T>
     T* Get() {
-        return Is<T>() ? static_cast<T*>(mData.get()) : nullptr;
+        return Is<T>() ? static_cast<T*>(Data()) : nullptr;
     }
     template <typename T>
     const T* Get() const {
-        return Is<T>() ? static_cast<const T*>(mData.get()) : nullptr;
+        return Is<T>() ? static_cast<const T*>(Data()) : nullptr;
     }
+    // shared event cannot be released
     PipelineEvent* Release() { return mData.release(); }
 
-    operator bool() const { return static_cast<bool>(mData); }
-    PipelineEvent* operator->() { return mData.operator->(); }
-    const PipelineEvent* operator->() const { return mData.operator->(); }
+    operator bool() const { return Data() != nullptr; }
+    PipelineEvent* operator->() { return Data(); }
+    const PipelineEvent* operator->() const { return Data(); }
 
-    PipelineEventPtr Copy() const { return PipelineEventPtr(mData->Copy(), mFromEventPool, mEventPool); }
+    // the copy is always exclusively owned
+    PipelineEventPtr Copy() const {
+        return IsShared() ? PipelineEventPtr(mSharedData->Copy(), false, nullptr)
+                          : PipelineEventPtr(mData->Copy(), mFromEventPool, mEventPool);
+    }
+    // only shared event can be shared again
+    PipelineEventPtr Share() const {
+        PipelineEventPtr res;
+        res.mSharedData = mSharedData;
+        return res;
+    }
+    bool IsShared() const { return static_cast<bool>(mSharedData); }
     bool IsFromEventPool() const { return mFromEventPool; }
     EventPool* GetEventPool() const { return mEventPool; }
 
 private:
+    PipelineEvent* Data() const { return mData ? mData.get() : mSharedData.get(); }
+
     std::unique_ptr<PipelineEvent> mData;
     bool mFromEventPool = false;
     EventPool* mEventPool = nullptr; // null means using processor runner threaded pool
+    // read only event shared with other groups, which also keeps the owner of the event alive
+    std::shared_ptr<PipelineEvent> mSharedData;
 };
 
 } // namespace logtail
@@ -37,11 +37,12 @@ void RawEvent::SetContent(const std::string& content) {
 }
 
 void RawEvent::SetContentNoCopy(StringView content) {
+    OnDataSizeChanged(mContent.size(), content.size());
     mContent = content;
 }
 
 void RawEvent::SetContentNoCopy(const StringBuffer& content) {
-    mContent = StringView(content.data, content.size);
+    SetContentNoCopy(StringView(content.data, content.size));
 }
 
 size_t RawEvent::DataSize() const {
@@ -43,6 +43,7 @@
 #include "file_server/event_handler/LogInput.h"
 #include "go_pipeline/LogtailPlugin.h"
 #include "logger/Logger.h"
+#include "models/EventPool.h"
 #include "monitor/AlarmManager.h"
 #include "monitor/SelfMonitorServer.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
@@ -192,6 +193,7 @@ void LogtailMonitor::Monitor() {
                 LoongCollectorMonitor::GetInstance()->SetAgentMemory(mMemStat.mRss);
                 CalCpuStat(curCpuStat, mCpuStat);
                 LoongCollectorMonitor::GetInstance()->SetAgentCpu(mCpuStat.mCpuUsage);
+                LoongCollectorMonitor::GetInstance()->UpdateEventPoolMetrics();
                 if (CheckHardMemLimit()) {
                     LOG_ERROR(sLogger,
                               ("Resource used by program exceeds hard limit",
@@ -667,6 +669,28 @@ void LoongCollectorMonitor::Init() {
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 }
 
+void LoongCollectorMonitor::UpdateEventPoolMetrics() {
+    vector<EventPoolStatistics> stats;
+    FetchThreadedEventPoolStatistics(stats);
+    while (mEventPoolMetrics.size() < stats.size()) {
+        auto& metrics = mEventPoolMetrics.emplace_back();
+        WriteMetrics::GetInstance()->CreateMetricsRecordRef(
+            metrics.mMetricsRecordRef,
+            MetricCategory::METRIC_CATEGORY_RUNNER,
+            {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_EVENT_POOL},
+             {METRIC_LABEL_KEY_POOL_NO, ToString(mEventPoolMetrics.size() - 1)}});
+        metrics.mAcquireCnt = metrics.mMetricsRecordRef.CreateCounter(METRIC_RUNNER_EVENT_POOL_ACQUIRE_TOTAL);
+        metrics.mHitCnt = metrics.mMetricsRecordRef.CreateCounter(METRIC_RUNNER_EVENT_POOL_HIT_TOTAL);
+        metrics.mReturnedCnt = metrics.mMetricsRecordRef.CreateCounter(METRIC_RUNNER_EVENT_POOL_RETURNED_TOTAL);
+        WriteMetrics::GetInstance()->CommitMetricsRecordRef(metrics.mMetricsRecordRef);
+    }
+    for (size_t i = 0; i < stats.size(); ++i) {
+        ADD_COUNTER(mEventPoolMetrics[i].mAcquireCnt, stats[i].mAcquireCnt);
+        ADD_COUNTER(mEventPoolMetrics[i].mHitCnt, stats[i].mHitCnt);
+        ADD_COUNTER(mEventPoolMetrics[i].mReturnedCnt, stats[i].mReturnedCnt);
+    }
+}
+
 void LoongCollectorMonitor::Stop() {
     SelfMonitorServer::GetInstance()->Stop();
     LOG_INFO(sLogger, ("LoongCollector monitor", "stopped successfully"));
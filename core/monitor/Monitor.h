@@ -17,6 +17,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <deque>
 #include <future>
 #include <mutex>
 #include <string>
@@ -217,6 +218,7 @@ public:
         SET_GAUGE(mAgentHostMonitorTotal, total);
 #endif
     }
+    void UpdateEventPoolMetrics();
 
     static std::string mHostname;
     static std::string mIpAddr;
@@ -252,6 +254,15 @@ private:
     IntGaugePtr mAgentOpenFdTotal;
     IntGaugePtr mAgentConfigTotal;
     IntGaugePtr mAgentHostMonitorTotal;
+
+    // one record per threaded event pool, indexed by pool no
+    struct EventPoolMetrics {
+        MetricsRecordRef mMetricsRecordRef;
+        CounterPtr mAcquireCnt;
+        CounterPtr mHitCnt;
+        CounterPtr mReturnedCnt;
+    };
+    std::deque<EventPoolMetrics> mEventPoolMetrics;
 };
 
 } // namespace logtail
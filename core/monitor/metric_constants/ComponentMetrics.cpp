@@ -37,6 +37,7 @@ const string METRIC_LABEL_KEY_GROUP_BATCH_ENABLED = "group_batch_enabled";
 // label values
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_BATCHER = "batcher";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_COMPRESSOR = "compressor";
+const string METRIC_LABEL_VALUE_COMPONENT_NAME_MEMORY_QUOTA = "memory_quota";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_PROCESS_QUEUE = "process_queue";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_ROUTER = "router";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_SENDER_QUEUE = "sender_queue";
@@ -63,6 +64,13 @@ const string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL = "buffered_events_t
 const string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES = "buffered_size_bytes";
 const string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS = "total_add_time_ms";
 
+/**********************************************************
+ *   memory quota
+ **********************************************************/
+const string METRIC_COMPONENT_MEMORY_QUOTA_USAGE_BYTES = "memory_usage_bytes";
+const string METRIC_COMPONENT_MEMORY_QUOTA_LIMIT_BYTES = "memory_limit_bytes";
+const string METRIC_COMPONENT_MEMORY_QUOTA_EXCEEDED_TIMES_TOTAL = "memory_exceeded_times_total";
+
 /**********************************************************
  *   queue
  **********************************************************/
@@ -106,12 +106,15 @@ extern const std::string METRIC_LABEL_KEY_SERVICE_HOST;
 extern const std::string METRIC_LABEL_KEY_SERVICE_PORT;
 extern const std::string METRIC_LABEL_KEY_STATUS;
 extern const std::string METRIC_LABEL_KEY_INSTANCE;
+extern const std::string METRIC_LABEL_KEY_LE;
 
 extern const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TARGETS;
 extern const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TOTAL;
 extern const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TIME_MS;
 extern const std::string METRIC_PLUGIN_PROM_SCRAPE_TIME_MS;
 extern const std::string METRIC_PLUGIN_PROM_SCRAPE_DELAY_TOTAL;
+extern const std::string METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS;
+extern const std::string METRIC_PLUGIN_PROM_SCRAPE_INFLIGHT;
 
 /**********************************************************
  *   input_ebpf
@@ -236,6 +239,7 @@ extern const std::string METRIC_LABEL_KEY_GROUP_BATCH_ENABLED;
 // label values
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_BATCHER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_COMPRESSOR;
+extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_MEMORY_QUOTA;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_PROCESS_QUEUE;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_ROUTER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_SENDER_QUEUE;
@@ -262,6 +266,13 @@ extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES;
 extern const std::string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS;
 
+/**********************************************************
+ *   memory quota
+ **********************************************************/
+extern const std::string METRIC_COMPONENT_MEMORY_QUOTA_USAGE_BYTES;
+extern const std::string METRIC_COMPONENT_MEMORY_QUOTA_LIMIT_BYTES;
+extern const std::string METRIC_COMPONENT_MEMORY_QUOTA_EXCEEDED_TIMES_TOTAL;
+
 /**********************************************************
  *   queue
  **********************************************************/
@@ -287,9 +298,11 @@ extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_RATE_LIMITER_T
 // label keys
 extern const std::string METRIC_LABEL_KEY_RUNNER_NAME;
 extern const std::string METRIC_LABEL_KEY_THREAD_NO;
+extern const std::string METRIC_LABEL_KEY_POOL_NO;
 
 // label values
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SERVER;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_READER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FLUSHER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_HTTP_SINK;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR;
@@ -297,6 +310,7 @@ extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_K8S_METADATA;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_STATIC_FILE_SERVER;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_EVENT_POOL;
 
 // metric keys
 extern const std::string& METRIC_RUNNER_IN_EVENTS_TOTAL;
@@ -310,6 +324,9 @@ extern const std::string& METRIC_RUNNER_TOTAL_DELAY_MS;
 extern const std::string METRIC_RUNNER_CLIENT_REGISTER_STATE;
 extern const std::string METRIC_RUNNER_CLIENT_REGISTER_RETRY_TOTAL;
 extern const std::string METRIC_RUNNER_JOBS_TOTAL;
+extern const std::string METRIC_RUNNER_EVENT_POOL_ACQUIRE_TOTAL;
+extern const std::string METRIC_RUNNER_EVENT_POOL_HIT_TOTAL;
+extern const std::string METRIC_RUNNER_EVENT_POOL_RETURNED_TOTAL;
 
 /**********************************************************
  *   all sinks
@@ -337,6 +354,7 @@ extern const std::string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIG
 extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_FILE_READ_SIZE_BYTES;
 
 /**********************************************************
  *   static file server
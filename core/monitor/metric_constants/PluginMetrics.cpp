@@ -54,12 +54,15 @@ const std::string METRIC_LABEL_KEY_SERVICE_HOST = "service_host";
 const std::string METRIC_LABEL_KEY_SERVICE_PORT = "service_port";
 const std::string METRIC_LABEL_KEY_STATUS = "status";
 const std::string METRIC_LABEL_KEY_INSTANCE = "instance";
+const std::string METRIC_LABEL_KEY_LE = "le";
 
 const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TARGETS = "prom_subscribe_targets";
 const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TOTAL = "prom_subscribe_total";
 const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TIME_MS = "prom_subscribe_time_ms";
 const std::string METRIC_PLUGIN_PROM_SCRAPE_TIME_MS = "prom_scrape_time_ms";
 const std::string METRIC_PLUGIN_PROM_SCRAPE_DELAY_TOTAL = "prom_scrape_delay_total";
+const std::string METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS = "prom_scrape_start_skew_ms";
+const std::string METRIC_PLUGIN_PROM_SCRAPE_INFLIGHT = "prom_scrape_inflight";
 
 /**********************************************************
  *   input_ebpf
@@ -22,9 +22,11 @@ namespace logtail {
 // label keys
 const string METRIC_LABEL_KEY_RUNNER_NAME = "runner_name";
 const string METRIC_LABEL_KEY_THREAD_NO = "thread_no";
+const string METRIC_LABEL_KEY_POOL_NO = "pool_no";
 
 // label values
 const string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SERVER = "file_server";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_READER = "file_reader_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_FLUSHER = "flusher_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_HTTP_SINK = "http_sink";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR = "processor_runner";
@@ -32,6 +34,7 @@ const string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS = "prometheus_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER = "ebpf_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_K8S_METADATA = "k8s_metadata_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_STATIC_FILE_SERVER = "static_file_server";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_EVENT_POOL = "event_pool";
 
 // metric keys
 const string& METRIC_RUNNER_IN_EVENTS_TOTAL = METRIC_IN_EVENTS_TOTAL;
@@ -45,6 +48,9 @@ const string& METRIC_RUNNER_TOTAL_DELAY_MS = METRIC_TOTAL_DELAY_MS;
 const string METRIC_RUNNER_CLIENT_REGISTER_STATE = "client_register_state";
 const string METRIC_RUNNER_CLIENT_REGISTER_RETRY_TOTAL = "client_register_retry_total";
 const string METRIC_RUNNER_JOBS_TOTAL = "jobs_total";
+const string METRIC_RUNNER_EVENT_POOL_ACQUIRE_TOTAL = "event_pool_acquire_total";
+const string METRIC_RUNNER_EVENT_POOL_HIT_TOTAL = "event_pool_hit_total";
+const string METRIC_RUNNER_EVENT_POOL_RETURNED_TOTAL = "event_pool_returned_total";
 
 /**********************************************************
  *   all sinks
@@ -72,6 +78,7 @@ const string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG = "en
 const string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE = "polling_modify_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE = "polling_dir_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE = "polling_file_cache_size";
+const string METRIC_RUNNER_FILE_READ_SIZE_BYTES = "read_size_bytes";
 
 /**********************************************************
  *   static file server
@@ -84,7 +84,7 @@ bool FlusherFile::FlushAll() {
 bool FlusherFile::SerializeAndPush(PipelineEventGroup&& group) {
     string serializedData;
     string errorMsg;
-    BatchedEvents g(std::move(group.MutableEvents()),
+    BatchedEvents g(group.ReleaseEvents(),
                     std::move(group.GetSizedTags()),
                     std::move(group.GetSourceBuffer()),
                     group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
@@ -162,7 +162,7 @@ bool FlusherKafka::SerializeAndSend(PipelineEventGroup&& group) {
         return false;
     }
 
-    auto events = std::move(group.MutableEvents());
+    auto events = group.ReleaseEvents();
 
     const bool isDynamicTopic = mTopicFormatter.IsDynamic();
     const auto& sizedTags = group.GetSizedTags();
@@ -16,6 +16,8 @@
 
 #include <cstddef>
 
+#include <algorithm>
+
 #include "Flags.h"
 #include "app_config/AppConfig.h"
 #include "application/Application.h"
@@ -50,6 +52,8 @@ DEFINE_FLAG_INT32(send_retry_sleep_interval, "sleep microseconds when sync send
 DEFINE_FLAG_INT32(buffer_check_period, "check logtail local storage buffer period", 60);
 DEFINE_FLAG_INT32(unauthorized_wait_interval, "", 1);
 DEFINE_FLAG_INT32(send_retrytimes, "how many times should retry if PostLogStoreLogs operation fail", 3);
+DEFINE_FLAG_INT32(disk_buffer_replay_concurrency, "max count of data sent concurrently when replaying a buffer file", 8);
+DEFINE_FLAG_BOOL(enable_disk_buffer_fsync, "sync buffer file to disk each time a batch of data is written", true);
 
 DECLARE_FLAG_INT32(discard_send_fail_interval);
 
@@ -190,8 +194,8 @@ void DiskBufferWriter::BufferWriterThread() {
         }
 
         if (!res.empty()) {
+            WriteToBufferFile(res);
             for (auto itr = res.begin(); itr != res.end(); ++itr) {
-                SendToBufferFile(*itr);
                 delete *itr;
             }
             res.clear();
@@ -248,7 +252,10 @@ void DiskBufferWriter::BufferSenderThread() {
             }
         }
 #ifdef __ENTERPRISE__
-        mCandidateHostsInfos.clear();
+        {
+            lock_guard<mutex> lock(mCandidateHostsInfosMux);
+            mCandidateHostsInfos.clear();
+        }
 #endif
         // mIsSendingBuffer = false;
         lock.lock();
@@ -258,6 +265,11 @@ void DiskBufferWriter::BufferSenderThread() {
     }
 }
 
+bool DiskBufferWriter::IsSendBufferThreadRunning() const {
+    lock_guard<mutex> lock(mBufferSenderThreadRunningMux);
+    return mIsSendBufferThreadRunning;
+}
+
 void DiskBufferWriter::SetBufferFilePath(const std::string& bufferfilepath) {
     lock_guard<mutex> lock(mBufferFileLock);
     if (bufferfilepath == "") {
@@ -331,7 +343,8 @@ bool DiskBufferWriter::LoadFileToSend(time_t timeLine, std::vector<std::string>&
     return true;
 }
 
-bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
+bool DiskBufferWriter::ReadNextEncryption(FILE* fin,
+                                          int32_t& pos,
                                           const std::string& filename,
                                           std::string& encryption,
                                           EncryptionStateMeta& meta,
@@ -340,27 +353,10 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
     bufferMeta.Clear();
     readResult = false;
     encryption.clear();
-    int retryTimes = 0;
 
-    FILE* fin = NULL;
-    while (true) {
-        retryTimes++;
-        fin = FileReadOnlyOpen(filename.c_str(), "rb");
-        if (fin)
-            break;
-        if (retryTimes >= 3) {
-            string errorStr = ErrnoToString(GetErrno());
-            AlarmManager::GetInstance()->SendAlarmCritical(
-                SECONDARY_READ_WRITE_ALARM, string("open file error:") + filename + ",error:" + errorStr);
-            LOG_ERROR(sLogger, ("open file error", filename)("error", errorStr));
-            return false;
-        }
-        usleep(5000);
-    }
     fseek(fin, 0, SEEK_END);
     auto const currentSize = ftell(fin);
     if (currentSize == pos) {
-        fclose(fin);
         return false;
     }
     fseek(fin, pos, SEEK_SET);
@@ -375,7 +371,6 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
         LOG_ERROR(sLogger,
                   ("read encryption file meta error",
                    filename)("error", errorStr)("nbytes", nbytes)("pos", pos)("ftell", currentSize));
-        fclose(fin);
         return false;
     }
 
@@ -394,13 +389,11 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
         LOG_ERROR(sLogger,
                   ("meta of encryption file invalid", filename)("meta.mEncryptionSize", meta.mEncryptionSize)(
                       "meta.mEncodedInfoSize", meta.mEncodedInfoSize));
-        fclose(fin);
         return false;
     }
 
     pos += sizeof(meta) + encodedInfoSize + meta.mEncryptionSize;
     if ((time(NULL) - meta.mTimeStamp) > INT32_FLAG(log_expire_time) || meta.mHandled == 1) {
-        fclose(fin);
         if (meta.mHandled != 1) {
             LOG_WARNING(sLogger, ("timeout buffer file, meta.mTimeStamp", meta.mTimeStamp));
             AlarmManager::GetInstance()->SendAlarmCritical(DISCARD_SECONDARY_ALARM,
@@ -412,7 +405,6 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
     char* buffer = new char[encodedInfoSize + 1];
     nbytes = fread(buffer, sizeof(char), encodedInfoSize, fin);
     if (nbytes != static_cast<size_t>(encodedInfoSize)) {
-        fclose(fin);
         string errorStr = ErrnoToString(GetErrno());
         AlarmManager::GetInstance()->SendAlarmCritical(
             SECONDARY_READ_WRITE_ALARM,
@@ -428,7 +420,6 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
     delete[] buffer;
     if (pbMeta) {
         if (!bufferMeta.ParseFromString(encodedInfo)) {
-            fclose(fin);
             AlarmManager::GetInstance()->SendAlarmCritical(SECONDARY_READ_WRITE_ALARM,
                                                            string("parse buffer meta from file error:") + filename);
             LOG_ERROR(sLogger, ("parse buffer meta from file error", filename)("buffer meta", encodedInfo));
@@ -458,7 +449,6 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
     buffer = new char[meta.mEncryptionSize + 1];
     nbytes = fread(buffer, sizeof(char), meta.mEncryptionSize, fin);
     if (nbytes != static_cast<size_t>(meta.mEncryptionSize)) {
-        fclose(fin);
         string errorStr = ErrnoToString(GetErrno());
         AlarmManager::GetInstance()->SendAlarmCritical(
             SECONDARY_READ_WRITE_ALARM,
@@ -477,41 +467,88 @@ bool DiskBufferWriter::ReadNextEncryption(int32_t& pos,
     encryption = string(buffer, meta.mEncryptionSize);
     readResult = true;
     delete[] buffer;
-    fclose(fin);
     return true;
 }
 
 void DiskBufferWriter::SendEncryptionBuffer(const std::string& filename, int32_t keyVersion) {
+    FILE* fin = nullptr;
+    for (int retryTimes = 1;; ++retryTimes) {
+        fin = FileReadOnlyOpen(filename.c_str(), "rb");
+        if (fin) {
+            break;
+        }
+        if (retryTimes >= 3) {
+            string errorStr = ErrnoToString(GetErrno());
+            AlarmManager::GetInstance()->SendAlarmCritical(
+                SECONDARY_READ_WRITE_ALARM, string("open file error:") + filename + ",error:" + errorStr);
+            LOG_ERROR(sLogger, ("open file error", filename)("error", errorStr));
+            return;
+        }
+        usleep(5000);
+    }
+
+    // records in a buffer file are independent of each other, so they are sent concurrently to drain the file faster
+    BufferFileReplayContext ctx(filename, keyVersion, fin, INT32_FLAG(file_encryption_header_length));
+    vector<future<void>> workers;
+    for (int32_t i = 1; i < INT32_FLAG(disk_buffer_replay_concurrency); ++i) {
+        workers.emplace_back(async(launch::async, &DiskBufferWriter::ReplayBufferFile, this, ref(ctx)));
+    }
+    ReplayBufferFile(ctx);
+    for (auto& worker : workers) {
+        worker.get();
+    }
+    fclose(fin);
+
+    if (!ctx.mHasUnsentData) {
+        remove(filename.c_str());
+        int32_t discardCount = ctx.mDiscardCount.load();
+        if (discardCount > 0) {
+            LOG_ERROR(sLogger, ("send buffer file, discard LogGroup count", discardCount)("delete file", filename));
+            AlarmManager::GetInstance()->SendAlarmCritical(DISCARD_SECONDARY_ALARM,
+                                                           "delete buffer file: " + filename + ", discard "
+                                                               + ToString(discardCount) + " logGroups");
+        } else
+            LOG_INFO(sLogger, ("send buffer file success, delete buffer file", filename));
+    }
+}
+
+void DiskBufferWriter::ReplayBufferFile(BufferFileReplayContext& ctx) {
+    const string& filename = ctx.mFilename;
     string encryption;
     string logData;
     EncryptionStateMeta meta;
     bool readResult;
-    bool writeBack = false;
-    int32_t pos = INT32_FLAG(file_encryption_header_length);
     sls_logs::LogtailBufferMeta bufferMeta;
-    int32_t discardCount = 0;
-    while (ReadNextEncryption(pos, filename, encryption, meta, readResult, bufferMeta)) {
+    while (true) {
+        int32_t recordPos = 0;
+        {
+            lock_guard<mutex> lock(ctx.mReadMux);
+            recordPos = ctx.mPos;
+            if (!ReadNextEncryption(ctx.mFile, ctx.mPos, filename, encryption, meta, readResult, bufferMeta)) {
+                break;
+            }
+        }
         logData.clear();
         bool sendResult = false;
         if (!readResult || !CheckBufferMetaValidation(filename, bufferMeta)) {
             if (meta.mHandled == 1)
                 continue;
             sendResult = true;
-            discardCount++;
+            ++ctx.mDiscardCount;
         }
         if (!sendResult) {
             char* des = new char[meta.mLogDataSize];
             if (!FileEncryption::GetInstance()->Decrypt(
-                    encryption.c_str(), meta.mEncryptionSize, des, meta.mLogDataSize, keyVersion)) {
+                    encryption.c_str(), meta.mEncryptionSize, des, meta.mLogDataSize, ctx.mKeyVersion)) {
                 sendResult = true;
-                discardCount++;
+                ++ctx.mDiscardCount;
                 LOG_ERROR(sLogger,
-                          ("decrypt error, project_name",
-                           bufferMeta.project())("key_version", keyVersion)("meta.mLogDataSize", meta.mLogDataSize));
+                          ("decrypt error, project_name", bufferMeta.project())("key_version", ctx.mKeyVersion)(
+                              "meta.mLogDataSize", meta.mLogDataSize));
                 AlarmManager::GetInstance()->SendAlarmCritical(
                     ENCRYPT_DECRYPT_FAIL_ALARM,
                     string("decrypt error, project_name:" + bufferMeta.project() + ", key_version:"
-                           + ToString(keyVersion) + ", meta.mLogDataSize:" + ToString(meta.mLogDataSize)),
+                           + ToString(ctx.mKeyVersion) + ", meta.mLogDataSize:" + ToString(meta.mLogDataSize)),
                     bufferMeta.region(),
                     bufferMeta.project(),
                     "",
@@ -527,7 +564,7 @@ void DiskBufferWriter::SendEncryptionBuffer(const std::string& filename, int32_t
                         sendResult = true;
                         LOG_ERROR(sLogger,
                                   ("parse error from string to loggroup, projectName is", bufferMeta.project()));
-                        discardCount++;
+                        ++ctx.mDiscardCount;
                         AlarmManager::GetInstance()->SendAlarmCritical(
                             LOG_GROUP_PARSE_FAIL_ALARM,
                             string("projectName is:" + bufferMeta.project() + ", fileName is:" + filename),
@@ -538,7 +575,7 @@ void DiskBufferWriter::SendEncryptionBuffer(const std::string& filename, int32_t
                     } else if (!CompressLz4(logGroupStr, logData)) {
                         sendResult = true;
                         LOG_ERROR(sLogger, ("LZ4 compress loggroup fail, projectName is", bufferMeta.project()));
-                        discardCount++;
+                        ++ctx.mDiscardCount;
                         AlarmManager::GetInstance()->SendAlarmCritical(
                             SEND_COMPRESS_FAIL_ALARM,
                             string("projectName is:" + bufferMeta.project() + ", fileName is:" + filename),
@@ -555,82 +592,109 @@ void DiskBufferWriter::SendEncryptionBuffer(const std::string& filename, int32_t
                     }
                 }
                 if (!sendResult) {
+                    // share concurrency limiters with realtime data, so that replay backs off when sls is unhealthy
+                    auto regionLimiter = FlusherSLS::GetRegionConcurrencyLimiter(bufferMeta.region());
+                    auto projectLimiter = FlusherSLS::GetProjectConcurrencyLimiter(bufferMeta.project());
+                    auto logstoreLimiter
+                        = FlusherSLS::GetLogstoreConcurrencyLimiter(bufferMeta.project(), bufferMeta.logstore());
                     time_t beginTime = time(nullptr);
                     while (true) {
-                        string domain;
-                        string ip;
-                        bool useIPFlag = false;
-                        auto response = SendBufferFileData(bufferMeta, logData, domain, ip, useIPFlag);
-                        SendResult sendRes = SEND_OK;
-                        if (response.mStatusCode != 200) {
-                            sendRes = ConvertErrorCode(response.mErrorCode);
-                        }
-                        switch (sendRes) {
-                            case SEND_OK:
-                                sendResult = true;
-                                break;
-                            case SEND_NETWORK_ERROR:
-                            case SEND_SERVER_ERROR:
-                                if (response.mErrorMsg != kNoHostErrorMsg) {
-                                    LOG_WARNING(
-                                        sLogger,
-                                        ("send data to SLS fail", "retry later")("request id", response.mRequestId)(
-                                            "error_code", response.mErrorCode)("error_message", response.mErrorMsg)(
-                                            "domain", domain)("ip", ip)("useIPFlag", useIPFlag)("projectName",
-                                                                                                bufferMeta.project())(
-                                            "logstore", bufferMeta.logstore())("rawsize", bufferMeta.rawsize()));
-                                }
-                                usleep(INT32_FLAG(send_retry_sleep_interval));
-                                break;
-                            case SEND_QUOTA_EXCEED:
-                                AlarmManager::GetInstance()->SendAlarmError(
-                                    SEND_QUOTA_EXCEED_ALARM,
-                                    "error_code: " + response.mErrorCode + ", error_message: " + response.mErrorMsg,
-                                    bufferMeta.region(),
-                                    bufferMeta.project(),
-                                    "",
-                                    bufferMeta.logstore());
-                                // no region
-                                if (!GetProfileSender()->IsProfileData("", bufferMeta.project(), bufferMeta.logstore()))
-                                    LOG_WARNING(
-                                        sLogger,
-                                        ("send data to SLS fail", "retry later")("request id", response.mRequestId)(
-                                            "error_code", response.mErrorCode)("error_message", response.mErrorMsg)(
-                                            "domain", domain)("ip", ip)("useIPFlag", useIPFlag)("projectName",
-                                                                                                bufferMeta.project())(
-                                            "logstore", bufferMeta.logstore())("rawsize", bufferMeta.rawsize()));
-                                usleep(INT32_FLAG(quota_exceed_wait_interval));
-                                break;
-                            case SEND_UNAUTHORIZED:
-                                usleep(INT32_FLAG(unauthorized_wait_interval));
-                                break;
-                            default:
-                                sendResult = true;
-                                discardCount++;
-                                break;
+                        // each limiter is checked and taken in one step, and the taken ones are given back if any
+                        // of the others is full
+                        bool taken = false;
+                        if (regionLimiter->TryPop()) {
+                            if (!projectLimiter->TryPop()) {
+                                regionLimiter->OnSendDone();
+                            } else if (!logstoreLimiter->TryPop()) {
+                                projectLimiter->OnSendDone();
+                                regionLimiter->OnSendDone();
+                            } else {
+                                taken = true;
+                            }
                         }
+                        if (!taken) {
+                            usleep(INT32_FLAG(send_retry_sleep_interval));
+                        } else {
+                            string domain;
+                            string ip;
+                            bool useIPFlag = false;
+                            auto response = SendBufferFileData(bufferMeta, logData, domain, ip, useIPFlag);
+                            regionLimiter->OnSendDone();
+                            projectLimiter->OnSendDone();
+                            logstoreLimiter->OnSendDone();
+                            auto curSystemTime = chrono::system_clock::now();
+                            SendResult sendRes = SEND_OK;
+                            if (response.mStatusCode != 200) {
+                                sendRes = ConvertErrorCode(response.mErrorCode);
+                            }
+                            FlusherSLS::UpdateConcurrencyLimiters(sendRes,
+                                                                  response.mErrorCode,
+                                                                  *regionLimiter,
+                                                                  *projectLimiter,
+                                                                  *logstoreLimiter,
+                                                                  curSystemTime);
+                            switch (sendRes) {
+                                case SEND_OK:
+                                    sendResult = true;
+                                    break;
+                                case SEND_NETWORK_ERROR:
+                                case SEND_SERVER_ERROR:
+                                    if (response.mErrorMsg != kNoHostErrorMsg) {
+                                        LOG_WARNING(
+                                            sLogger,
+                                            ("send data to SLS fail", "retry later")("request id", response.mRequestId)(
+                                                "error_code", response.mErrorCode)("error_message",
+                                                                                   response.mErrorMsg)("domain", domain)(
+                                                "ip", ip)("useIPFlag", useIPFlag)("projectName", bufferMeta.project())(
+                                                "logstore", bufferMeta.logstore())("rawsize", bufferMeta.rawsize()));
+                                    }
+                                    usleep(INT32_FLAG(send_retry_sleep_interval));
+                                    break;
+                                case SEND_QUOTA_EXCEED:
+                                    AlarmManager::GetInstance()->SendAlarmError(
+                                        SEND_QUOTA_EXCEED_ALARM,
+                                        "error_code: " + response.mErrorCode + ", error_message: " + response.mErrorMsg,
+                                        bufferMeta.region(),
+                                        bufferMeta.project(),
+                                        "",
+                                        bufferMeta.logstore());
+                                    // no region
+                                    if (!GetProfileSender()->IsProfileData(
+                                            "", bufferMeta.project(), bufferMeta.logstore()))
+                                        LOG_WARNING(
+                                            sLogger,
+                                            ("send data to SLS fail", "retry later")("request id", response.mRequestId)(
+                                                "error_code", response.mErrorCode)("error_message",
+                                                                                   response.mErrorMsg)("domain", domain)(
+                                                "ip", ip)("useIPFlag", useIPFlag)("projectName", bufferMeta.project())(
+                                                "logstore", bufferMeta.logstore())("rawsize", bufferMeta.rawsize()));
+                                    usleep(INT32_FLAG(quota_exceed_wait_interval));
+                                    break;
+                                case SEND_UNAUTHORIZED:
+                                    usleep(INT32_FLAG(unauthorized_wait_interval));
+                                    break;
+                                default:
+                                    sendResult = true;
+                                    ++ctx.mDiscardCount;
+                                    break;
+                            }
 #ifdef __ENTERPRISE__
-                        if (sendRes != SEND_NETWORK_ERROR && sendRes != SEND_SERVER_ERROR) {
-                            bool hasAuthError = sendRes == SEND_UNAUTHORIZED && response.mErrorMsg != kAKErrorMsg;
-                            EnterpriseSLSClientManager::GetInstance()->UpdateAccessKeyStatus(bufferMeta.aliuid(),
-                                                                                             !hasAuthError);
-                            EnterpriseSLSClientManager::GetInstance()->UpdateProjectAnonymousWriteStatus(
-                                bufferMeta.project(), !hasAuthError);
-                        }
+                            if (sendRes != SEND_NETWORK_ERROR && sendRes != SEND_SERVER_ERROR) {
+                                bool hasAuthError = sendRes == SEND_UNAUTHORIZED && response.mErrorMsg != kAKErrorMsg;
+                                EnterpriseSLSClientManager::GetInstance()->UpdateAccessKeyStatus(bufferMeta.aliuid(),
+                                                                                                 !hasAuthError);
+                                EnterpriseSLSClientManager::GetInstance()->UpdateProjectAnonymousWriteStatus(
+                                    bufferMeta.project(), !hasAuthError);
+                            }
 #endif
-                        if (time(nullptr) - beginTime >= INT32_FLAG(discard_send_fail_interval)) {
+                        }
+                        if (!sendResult && time(nullptr) - beginTime >= INT32_FLAG(discard_send_fail_interval)) {
                             sendResult = true;
-                            discardCount++;
+                            ++ctx.mDiscardCount;
                         }
-                        if (sendResult) {
+                        if (sendResult || !IsSendBufferThreadRunning()) {
                             break;
                         }
-                        {
-                            lock_guard<mutex> lock(mBufferSenderThreadRunningMux);
-                            if (!mIsSendBufferThreadRunning) {
-                                break;
-                            }
-                        }
                     }
                 }
             }
@@ -641,32 +705,15 @@ void DiskBufferWriter::SendEncryptionBuffer(const std::string& filename, int32_t
         LOG_DEBUG(sLogger,
                   ("send LogGroup from local buffer file", filename)("rawsize", bufferMeta.rawsize())("sendResult",
                                                                                                       sendResult));
-        WriteBackMeta(pos - meta.mEncryptionSize - sizeof(meta)
-                          - (meta.mEncodedInfoSize > BUFFER_META_BASE_SIZE
-                                 ? (meta.mEncodedInfoSize - BUFFER_META_BASE_SIZE)
-                                 : meta.mEncodedInfoSize),
-                      (char*)&meta,
-                      sizeof(meta),
-                      filename);
+        WriteBackMeta(recordPos, (char*)&meta, sizeof(meta), filename);
         if (!sendResult)
-            writeBack = true;
-        {
-            lock_guard<mutex> lock(mBufferSenderThreadRunningMux);
-            if (!mIsSendBufferThreadRunning) {
-                return;
-            }
+            ctx.mHasUnsentData = true;
+        if (!IsSendBufferThreadRunning()) {
+            // the file is kept for the rest records to be sent after restart
+            ctx.mHasUnsentData = true;
+            return;
         }
     }
-    if (!writeBack) {
-        remove(filename.c_str());
-        if (discardCount > 0) {
-            LOG_ERROR(sLogger, ("send buffer file, discard LogGroup count", discardCount)("delete file", filename));
-            AlarmManager::GetInstance()->SendAlarmCritical(DISCARD_SECONDARY_ALARM,
-                                                           "delete buffer file: " + filename + ", discard "
-                                                               + ToString(discardCount) + " logGroups");
-        } else
-            LOG_INFO(sLogger, ("send buffer file success, delete buffer file", filename));
-    }
 }
 
 // file is not really created when call CreateNewFile(), file created happened when SendToBufferFile() first called
@@ -749,9 +796,19 @@ string DiskBufferWriter::GetBufferFileHeader() {
     return (STRING_FLAG(file_encryption_magic_number) + reserve + nullHeader);
 }
 
-bool DiskBufferWriter::SendToBufferFile(SenderQueueItem* dataPtr) {
-    auto data = static_cast<SLSSenderQueueItem*>(dataPtr);
-    auto flusher = static_cast<const FlusherSLS*>(data->mFlusher);
+bool DiskBufferWriter::WriteToBufferFile(const vector<SenderQueueItem*>& items) {
+    // all records are encoded before written, so that the whole batch is appended and synced to the file at once
+    string records;
+    for (auto item : items) {
+        EncodeBufferRecord(item, records);
+    }
+    if (records.empty()) {
+        return false;
+    }
+    // alarms are reported on the destination of the first item
+    auto first = static_cast<SLSSenderQueueItem*>(items[0]);
+    auto flusher = static_cast<const FlusherSLS*>(first->mFlusher);
+
     string bufferFileName = GetBufferFileName();
     if (bufferFileName.empty()) {
         CreateNewFile();
@@ -767,7 +824,7 @@ bool DiskBufferWriter::SendToBufferFile(SenderQueueItem* dataPtr) {
                                                        flusher->mRegion,
                                                        flusher->mProject,
                                                        "",
-                                                       data->mLogstore);
+                                                       first->mLogstore);
         LOG_ERROR(sLogger, ("open buffer file error", bufferFileName));
         return false;
     }
@@ -783,17 +840,50 @@ bool DiskBufferWriter::SendToBufferFile(SenderQueueItem* dataPtr) {
                                                            flusher->mRegion,
                                                            flusher->mProject,
                                                            "",
-                                                           data->mLogstore);
+                                                           first->mLogstore);
             LOG_ERROR(sLogger, ("error write encryption header", bufferFileName)("error", errorStr)("nbytes", nbytes));
             fclose(fout);
             return false;
         }
     }
 
+    auto nbytes = fwrite(records.data(), 1, records.size(), fout);
+    if (nbytes != records.size()) {
+        string errorStr = ErrnoToString(GetErrno());
+        AlarmManager::GetInstance()->SendAlarmCritical(SECONDARY_READ_WRITE_ALARM,
+                                                       string("write file error:") + bufferFileName
+                                                           + ", error:" + errorStr + ", nbytes:" + ToString(nbytes),
+                                                       flusher->mRegion,
+                                                       flusher->mProject,
+                                                       "",
+                                                       first->mLogstore);
+        LOG_ERROR(
+            sLogger,
+            ("write meta of buffer file", "fail")("filename", bufferFileName)("errorStr", errorStr)("nbytes", nbytes));
+        fclose(fout);
+        return false;
+    }
+    fflush(fout);
+#if defined(__linux__)
+    if (BOOL_FLAG(enable_disk_buffer_fsync) && fsync(fileno(fout)) != 0) {
+        LOG_WARNING(sLogger,
+                    ("failed to sync buffer file", bufferFileName)("error", ErrnoToString(GetErrno())));
+    }
+#endif
+    if (ftell(fout) > AppConfig::GetInstance()->GetLocalFileSize())
+        CreateNewFile();
+    fclose(fout);
+    LOG_DEBUG(sLogger, ("write buffer file", bufferFileName)("records", items.size())("bytes", records.size()));
+    return true;
+}
+
+bool DiskBufferWriter::EncodeBufferRecord(SenderQueueItem* item, string& records) {
+    auto data = static_cast<SLSSenderQueueItem*>(item);
+    auto flusher = static_cast<const FlusherSLS*>(data->mFlusher);
+
     char* des;
     int32_t desLength;
     if (!FileEncryption::GetInstance()->Encrypt(data->mData.c_str(), data->mData.size(), des, desLength)) {
-        fclose(fout);
         LOG_ERROR(sLogger, ("encrypt error, project_name", flusher->mProject));
         AlarmManager::GetInstance()->SendAlarmCritical(ENCRYPT_DECRYPT_FAIL_ALARM,
                                                        string("encrypt error, project_name:" + flusher->mProject),
@@ -831,34 +921,11 @@ bool DiskBufferWriter::SendToBufferFile(SenderQueueItem* dataPtr) {
     meta.mHandled = 0;
     meta.mRetryTime = 0;
     meta.mEncryptionSize = desLength;
-    char* buffer = new char[sizeof(meta) + encodedInfoSize + meta.mEncryptionSize];
-    memcpy(buffer, (char*)&meta, sizeof(meta));
-    memcpy(buffer + sizeof(meta), encodedInfo.c_str(), encodedInfoSize);
-    memcpy(buffer + sizeof(meta) + encodedInfoSize, des, desLength);
+    records.reserve(records.size() + sizeof(meta) + encodedInfoSize + desLength);
+    records.append(reinterpret_cast<const char*>(&meta), sizeof(meta));
+    records.append(encodedInfo);
+    records.append(des, desLength);
     delete[] des;
-    const auto bytesToWrite = sizeof(meta) + encodedInfoSize + meta.mEncryptionSize;
-    auto nbytes = fwrite(buffer, 1, bytesToWrite, fout);
-    if (nbytes != bytesToWrite) {
-        string errorStr = ErrnoToString(GetErrno());
-        AlarmManager::GetInstance()->SendAlarmCritical(SECONDARY_READ_WRITE_ALARM,
-                                                       string("write file error:") + bufferFileName
-                                                           + ", error:" + errorStr + ", nbytes:" + ToString(nbytes),
-                                                       flusher->mRegion,
-                                                       flusher->mProject,
-                                                       "",
-                                                       data->mLogstore);
-        LOG_ERROR(
-            sLogger,
-            ("write meta of buffer file", "fail")("filename", bufferFileName)("errorStr", errorStr)("nbytes", nbytes));
-        delete[] buffer;
-        fclose(fout);
-        return false;
-    }
-    delete[] buffer;
-    if (ftell(fout) > AppConfig::GetInstance()->GetLocalFileSize())
-        CreateNewFile();
-    fclose(fout);
-    LOG_DEBUG(sLogger, ("write buffer file", bufferFileName));
     return true;
 }
 
@@ -867,7 +934,15 @@ SLSResponse DiskBufferWriter::SendBufferFileData(const sls_logs::LogtailBufferMe
                                                  std::string& domain,
                                                  std::string& ip,
                                                  bool useIPFlag) {
-    RateLimiter::FlowControl(bufferMeta.rawsize(), mSendLastTime, mSendLastByte, false);
+    {
+        lock_guard<mutex> lock(mFlowControlMux);
+        RateLimiter::FlowControl(bufferMeta.rawsize(), mSendLastTime, mSendLastByte, false);
+    }
+#ifdef APSARA_UNIT_TEST_MAIN
+    if (mSendBufferFileDataMock) {
+        return mSendBufferFileDataMock(bufferMeta, logData);
+    }
+#endif
     string region = bufferMeta.region();
 #ifdef __ENTERPRISE__
     // old buffer file which record the endpoint
@@ -904,7 +979,10 @@ SLSResponse DiskBufferWriter::SendBufferFileData(const sls_logs::LogtailBufferMe
     }
     auto info = EnterpriseSLSClientManager::GetInstance()->GetCandidateHostsInfo(
         region, bufferMeta.project(), GetEndpointMode(bufferMeta.endpointmode()));
-    mCandidateHostsInfos.insert(info);
+    {
+        lock_guard<mutex> lock(mCandidateHostsInfosMux);
+        mCandidateHostsInfos.insert(info);
+    }
 
     domain = info->GetCurrentHost();
     if (domain.empty()) {
@@ -17,10 +17,14 @@
 #pragma once
 
 #include <cstdint>
+#include <cstdio>
 #include <ctime>
 
 #include <atomic>
 #include <condition_variable>
+#ifdef APSARA_UNIT_TEST_MAIN
+#include <functional>
+#endif
 #include <future>
 #include <memory>
 #include <mutex>
@@ -68,28 +72,49 @@ private:
         int32_t mRetryTime;
     };
 
+    // state shared by all workers replaying the same buffer file
+    struct BufferFileReplayContext {
+        BufferFileReplayContext(const std::string& filename, int32_t keyVersion, FILE* file, int32_t pos)
+            : mFilename(filename), mKeyVersion(keyVersion), mFile(file), mPos(pos) {}
+
+        const std::string mFilename;
+        const int32_t mKeyVersion;
+
+        // guards the read position, records are read in order while sent concurrently
+        std::mutex mReadMux;
+        FILE* mFile = nullptr;
+        int32_t mPos = 0;
+
+        std::atomic_int32_t mDiscardCount = 0;
+        std::atomic_bool mHasUnsentData = false;
+    };
+
     DiskBufferWriter() = default;
     ~DiskBufferWriter() = default;
 
     void BufferWriterThread();
     void BufferSenderThread();
+    bool IsSendBufferThreadRunning() const;
 
     SLSResponse SendBufferFileData(const sls_logs::LogtailBufferMeta& bufferMeta,
                                    const std::string& logData,
                                    std::string& domain,
                                    std::string& ip,
                                    bool useIPFlag);
-    bool SendToBufferFile(SenderQueueItem* dataPtr);
+    bool WriteToBufferFile(const std::vector<SenderQueueItem*>& items);
+    bool EncodeBufferRecord(SenderQueueItem* item, std::string& records);
     bool LoadFileToSend(time_t timeLine, std::vector<std::string>& filesToSend);
     bool CreateNewFile();
     bool WriteBackMeta(const int32_t pos, const void* buf, int32_t length, const std::string& filename);
-    bool ReadNextEncryption(int32_t& pos,
+    bool ReadNextEncryption(FILE* fin,
+                            int32_t& pos,
                             const std::string& filename,
                             std::string& encryption,
                             EncryptionStateMeta& meta,
                             bool& readResult,
                             sls_logs::LogtailBufferMeta& bufferMeta);
     void SendEncryptionBuffer(const std::string& filename, int32_t keyVersion);
+    void ReplayBufferFile(BufferFileReplayContext& ctx);
     void SetBufferFilePath(const std::string& bufferfilepath);
     std::string GetBufferFilePath();
     std::string GetBufferFileName();
@@ -121,6 +146,7 @@ private:
         }
     };
 
+    std::mutex mCandidateHostsInfosMux;
     std::unordered_set<std::shared_ptr<CandidateHostsInfo>, PointerHash, PointerEqual> mCandidateHostsInfos;
 #endif
 
@@ -131,8 +157,17 @@ private:
     volatile time_t mBufferDivideTime = 0;
     int64_t mCheckPeriod = 0;
 
+    // replay workers share the same flow control
+    std::mutex mFlowControlMux;
     int64_t mSendLastTime = 0;
     int32_t mSendLastByte = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    // stands in for the sls backend when set
+    std::function<SLSResponse(const sls_logs::LogtailBufferMeta&, const std::string&)> mSendBufferFileDataMock;
+
+    friend class DiskBufferWriterUnittest;
+#endif
 };
 
 } // namespace logtail
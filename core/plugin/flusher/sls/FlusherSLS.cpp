@@ -224,6 +224,40 @@ void FlusherSLS::ClearInvalidConcurrencyLimiters() {
     }
 }
 
+void FlusherSLS::UpdateConcurrencyLimiters(SendResult result,
+                                           const string& errorCode,
+                                           ConcurrencyLimiter& regionLimiter,
+                                           ConcurrencyLimiter& projectLimiter,
+                                           ConcurrencyLimiter& logstoreLimiter,
+                                           chrono::system_clock::time_point curTime) {
+    // a failure is only counted on the limiter of the scope it implies, and as success on the others
+    switch (result) {
+        case SEND_OK:
+            regionLimiter.OnSuccess(curTime);
+            projectLimiter.OnSuccess(curTime);
+            logstoreLimiter.OnSuccess(curTime);
+            break;
+        case SEND_NETWORK_ERROR:
+        case SEND_SERVER_ERROR:
+            regionLimiter.OnFail(curTime);
+            projectLimiter.OnSuccess(curTime);
+            logstoreLimiter.OnSuccess(curTime);
+            break;
+        case SEND_QUOTA_EXCEED:
+            regionLimiter.OnSuccess(curTime);
+            if (errorCode == LOGE_SHARD_WRITE_QUOTA_EXCEED) {
+                projectLimiter.OnSuccess(curTime);
+                logstoreLimiter.OnFail(curTime);
+            } else {
+                projectLimiter.OnFail(curTime);
+                logstoreLimiter.OnSuccess(curTime);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
 mutex FlusherSLS::sDefaultRegionLock;
 string FlusherSLS::sDefaultRegion;
 
@@ -770,15 +804,24 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
                 ToString(chrono::duration_cast<chrono::milliseconds>(curSystemTime - item->mFirstEnqueTime).count())
                     + "ms")("try cnt", data->mTryCnt)("endpoint", data->mCurrentDomain)("real ip", data->mCurrentIP)(
                 "real ip flag", data->mUseIPFlag)("is profile data", isProfileData));
-        GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curSystemTime);
-        GetProjectConcurrencyLimiter(mProject)->OnSuccess(curSystemTime);
-        GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnSuccess(curSystemTime);
+        UpdateConcurrencyLimiters(SEND_OK,
+                                  slsResponse.mErrorCode,
+                                  *GetRegionConcurrencyLimiter(mRegion),
+                                  *GetProjectConcurrencyLimiter(mProject),
+                                  *GetLogstoreConcurrencyLimiter(mProject, mLogstore),
+                                  curSystemTime);
         SenderQueueManager::GetInstance()->DecreaseConcurrencyLimiterInSendingCnt(item->mQueueKey);
         ADD_COUNTER(mSuccessCnt, 1);
         DealSenderQueueItemAfterSend(item, false);
     } else {
         OperationOnFail operation;
         sendResult = ConvertErrorCode(slsResponse.mErrorCode);
+        UpdateConcurrencyLimiters(sendResult,
+                                  slsResponse.mErrorCode,
+                                  *GetRegionConcurrencyLimiter(mRegion),
+                                  *GetProjectConcurrencyLimiter(mProject),
+                                  *GetLogstoreConcurrencyLimiter(mProject, mLogstore),
+                                  curSystemTime);
         ostringstream failDetail, suggestion;
         if (sendResult == SEND_NETWORK_ERROR || sendResult == SEND_SERVER_ERROR) {
             if (sendResult == SEND_NETWORK_ERROR) {
@@ -797,24 +840,15 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
             }
 #endif
             operation = data->mBufferOrNot ? OperationOnFail::RETRY_LATER : OperationOnFail::DISCARD;
-            GetRegionConcurrencyLimiter(mRegion)->OnFail(curSystemTime);
-            GetProjectConcurrencyLimiter(mProject)->OnSuccess(curSystemTime);
-            GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnSuccess(curSystemTime);
         } else if (sendResult == SEND_QUOTA_EXCEED) {
             if (slsResponse.mErrorCode == LOGE_SHARD_WRITE_QUOTA_EXCEED) {
                 failDetail << "shard write quota exceed";
                 suggestion << "Split logstore shards. https://help.aliyun.com/zh/sls/user-guide/expansion-of-resources";
-                GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnFail(curSystemTime);
-                GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curSystemTime);
-                GetProjectConcurrencyLimiter(mProject)->OnSuccess(curSystemTime);
                 ADD_COUNTER(mShardWriteQuotaErrorCnt, 1);
             } else {
                 failDetail << "project write quota exceed";
                 suggestion << "Submit quota modification request. "
                               "https://help.aliyun.com/zh/sls/user-guide/expansion-of-resources";
-                GetProjectConcurrencyLimiter(mProject)->OnFail(curSystemTime);
-                GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curSystemTime);
-                GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnSuccess(curSystemTime);
                 ADD_COUNTER(mProjectQuotaErrorCnt, 1);
             }
             AlarmManager::GetInstance()->SendAlarmError(SEND_QUOTA_EXCEED_ALARM,
@@ -963,6 +997,7 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
 }
 
 bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& logstore) {
+    size_t rawSize = data.size();
     string compressedData;
     if (mCompressor) {
         string errorMsg;
@@ -981,7 +1016,7 @@ bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& l
             return false;
         }
     } else {
-        compressedData = data;
+        compressedData = std::move(data);
     }
 
     QueueKey key = mQueueKey;
@@ -994,7 +1029,7 @@ bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& l
         }
     }
     return Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                data.size(),
+                                                                rawSize,
                                                                 this,
                                                                 key,
                                                                 logstore.empty() ? mLogstore : logstore,
@@ -1018,19 +1053,29 @@ void FlusherSLS::GenerateGoPlugin(const Json::Value& config, Json::Value& res) c
     }
 }
 
-bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
-    string serializedData, compressedData;
-    BatchedEvents g(std::move(group.MutableEvents()),
-                    std::move(group.GetSizedTags()),
-                    std::move(group.GetSourceBuffer()),
-                    group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
-                    std::move(group.GetExactlyOnceCheckpoint()));
-    for (const auto& extraSourceBuffer : group.GetExtraSourceBuffers()) {
-        g.mSourceBuffers.emplace_back(extraSourceBuffer);
+bool FlusherSLS::SerializeAndCompress(BatchedEvents&& g, string& output, size_t& rawSize, string& errorMsg) {
+    if (mCompressor) {
+        // the log group is compressed while being serialized, so that only the compressed data is held in memory
+        bool isCompressFailed = false;
+        if (!mGroupSerializer->DoSerializeAndCompress(
+                std::move(g), *mCompressor, output, rawSize, isCompressFailed, errorMsg)) {
+            const char* failure = isCompressFailed ? "failed to compress data" : "failed to serialize event group";
+            LOG_WARNING(mContext->GetLogger(),
+                        (failure, errorMsg)("action", "discard data")("plugin", sName)(
+                            "config", mContext->GetConfigName()));
+            mContext->GetAlarm().SendAlarmWarning(isCompressFailed ? COMPRESS_FAIL_ALARM : SERIALIZE_FAIL_ALARM,
+                                                  string(failure) + ": " + errorMsg
+                                                      + "\taction: discard data\tplugin: " + sName
+                                                      + "\tconfig: " + mContext->GetConfigName(),
+                                                  mContext->GetRegion(),
+                                                  mContext->GetProjectName(),
+                                                  mContext->GetConfigName(),
+                                                  mContext->GetLogstoreName());
+            return false;
+        }
+        return true;
     }
-    AddPackId(g);
-    string errorMsg;
-    if (!mGroupSerializer->DoSerialize(std::move(g), serializedData, errorMsg)) {
+    if (!mGroupSerializer->DoSerialize(std::move(g), output, errorMsg)) {
         LOG_WARNING(mContext->GetLogger(),
                     ("failed to serialize event group",
                      errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
@@ -1044,29 +1089,31 @@ bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
                                               mContext->GetLogstoreName());
         return false;
     }
-    if (mCompressor) {
-        if (!mCompressor->DoCompress(serializedData, compressedData, errorMsg)) {
-            LOG_WARNING(mContext->GetLogger(),
-                        ("failed to compress event group",
-                         errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
-            mContext->GetAlarm().SendAlarmWarning(COMPRESS_FAIL_ALARM,
-                                                  "failed to compress event group: " + errorMsg
-                                                      + "\taction: discard data\tplugin: " + sName
-                                                      + "\tconfig: " + mContext->GetConfigName(),
-                                                  mContext->GetRegion(),
-                                                  mContext->GetProjectName(),
-                                                  mContext->GetConfigName(),
-                                                  mContext->GetLogstoreName());
-            return false;
-        }
-    } else {
-        compressedData = serializedData;
+    rawSize = output.size();
+    return true;
+}
+
+bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
+    string compressedData;
+    BatchedEvents g(group.ReleaseEvents(),
+                    std::move(group.GetSizedTags()),
+                    std::move(group.GetSourceBuffer()),
+                    group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                    std::move(group.GetExactlyOnceCheckpoint()));
+    for (const auto& extraSourceBuffer : group.GetExtraSourceBuffers()) {
+        g.mSourceBuffers.emplace_back(extraSourceBuffer);
+    }
+    AddPackId(g);
+    string errorMsg;
+    size_t rawSize = 0;
+    if (!SerializeAndCompress(std::move(g), compressedData, rawSize, errorMsg)) {
+        return false;
     }
     // must create a tmp, because eoo checkpoint is moved in second param
     auto fbKey = g.mExactlyOnceCheckpoint->fbKey;
     return PushToQueue(fbKey,
                        make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                       serializedData.size(),
+                                                       rawSize,
                                                        this,
                                                        fbKey,
                                                        mLogstore,
@@ -1092,43 +1139,14 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
         }
         AddPackId(group);
         string errorMsg;
-        if (!mGroupSerializer->DoSerialize(std::move(group), serializedData, errorMsg)) {
-            LOG_WARNING(mContext->GetLogger(),
-                        ("failed to serialize event group",
-                         errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
-            mContext->GetAlarm().SendAlarmWarning(SERIALIZE_FAIL_ALARM,
-                                                  "failed to serialize event group: " + errorMsg
-                                                      + "\taction: discard data\tplugin: " + sName
-                                                      + "\tconfig: " + mContext->GetConfigName(),
-                                                  mContext->GetRegion(),
-                                                  mContext->GetProjectName(),
-                                                  mContext->GetConfigName(),
-                                                  mContext->GetLogstoreName());
+        size_t rawSize = 0;
+        if (!SerializeAndCompress(std::move(group), compressedData, rawSize, errorMsg)) {
             allSucceeded = false;
             continue;
         }
-        if (mCompressor) {
-            if (!mCompressor->DoCompress(serializedData, compressedData, errorMsg)) {
-                LOG_WARNING(mContext->GetLogger(),
-                            ("failed to compress event group",
-                             errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
-                mContext->GetAlarm().SendAlarmWarning(COMPRESS_FAIL_ALARM,
-                                                      "failed to compress event group: " + errorMsg
-                                                          + "\taction: discard data\tplugin: " + sName
-                                                          + "\tconfig: " + mContext->GetConfigName(),
-                                                      mContext->GetRegion(),
-                                                      mContext->GetProjectName(),
-                                                      mContext->GetConfigName(),
-                                                      mContext->GetLogstoreName());
-                allSucceeded = false;
-                continue;
-            }
-        } else {
-            compressedData = serializedData;
-        }
         if (enablePackageList) {
-            packageSize += serializedData.size();
-            compressedLogGroups.emplace_back(std::move(compressedData), serializedData.size());
+            packageSize += rawSize;
+            compressedLogGroups.emplace_back(std::move(compressedData), rawSize);
         } else {
             if (group.mExactlyOnceCheckpoint) {
                 // must create a tmp, because eoo checkpoint is moved in second param
@@ -1136,7 +1154,7 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
                 allSucceeded
                     = PushToQueue(fbKey,
                                   make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                  serializedData.size(),
+                                                                  rawSize,
                                                                   this,
                                                                   fbKey,
                                                                   mLogstore,
@@ -1147,7 +1165,7 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
                     && allSucceeded;
             } else {
                 allSucceeded = Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                                    serializedData.size(),
+                                                                                    rawSize,
                                                                                     this,
                                                                                     mQueueKey,
                                                                                     mLogstore,
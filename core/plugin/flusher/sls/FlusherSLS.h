@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -35,6 +36,7 @@
 #include "common/compression/Compressor.h"
 #include "models/PipelineEventGroup.h"
 #include "plugin/flusher/sls/SLSClientManager.h"
+#include "plugin/flusher/sls/SendResult.h"
 #include "protobuf/sls/sls_logs.pb.h"
 #ifdef __ENTERPRISE__
 #include "plugin/flusher/sls/EnterpriseSLSClientManager.h"
@@ -49,6 +51,13 @@ public:
     static std::shared_ptr<ConcurrencyLimiter> GetProjectConcurrencyLimiter(const std::string& project);
     static std::shared_ptr<ConcurrencyLimiter> GetRegionConcurrencyLimiter(const std::string& region);
     static void ClearInvalidConcurrencyLimiters();
+    // feed the result of a request back to the concurrency limiters it is sent under
+    static void UpdateConcurrencyLimiters(SendResult result,
+                                          const std::string& errorCode,
+                                          ConcurrencyLimiter& regionLimiter,
+                                          ConcurrencyLimiter& projectLimiter,
+                                          ConcurrencyLimiter& logstoreLimiter,
+                                          std::chrono::system_clock::time_point curTime);
 
     static void InitResource();
     static void RecycleResourceIfNotUsed();
@@ -124,6 +133,7 @@ private:
     bool SerializeAndPush(std::vector<BatchedEventsList>&& groupLists);
     bool SerializeAndPush(BatchedEventsList&& groupList);
     bool SerializeAndPush(PipelineEventGroup&& g); // for exactly once only
+    bool SerializeAndCompress(BatchedEvents&& g, std::string& output, size_t& rawSize, std::string& errorMsg);
     bool PushToQueue(QueueKey key, std::unique_ptr<SenderQueueItem>&& item, uint32_t retryTimes = 500);
     std::string GetShardHashKey(const BatchedEvents& g) const;
     void AddPackId(BatchedEvents& g) const;
@@ -155,7 +165,7 @@ private:
     std::string mWorkspace;
 
     Batcher<SLSEventBatchStatus> mBatcher;
-    std::unique_ptr<EventGroupSerializer> mGroupSerializer;
+    std::unique_ptr<SLSEventGroupSerializer> mGroupSerializer;
     std::unique_ptr<Serializer<std::vector<CompressedLogGroup>>> mGroupListSerializer;
 #ifdef __ENTERPRISE__
     // This may not be cached. However, this provides a simple way to control the lifetime of a CandidateHostsInfo.
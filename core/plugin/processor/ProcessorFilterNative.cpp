@@ -18,11 +18,17 @@
 
 #include <vector>
 
+#include "common/Flags.h"
 #include "common/ParamExtractor.h"
+#include "common/Re2Util.h"
 #include "logger/Logger.h"
 #include "models/LogEvent.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+DEFINE_FLAG_BOOL(enable_filter_regex_set,
+                 "match patterns on the same key of FilterKey/FilterRegex and Include with one RE2::Set",
+                 false);
+
 namespace logtail {
 
 const std::string ProcessorFilterNative::sName = "processor_filter_regex_native";
@@ -100,6 +106,9 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
             mFilterRule = std::make_shared<LogFilterRule>();
             mFilterRule->FilterKeys = filterKeys;
             mFilterRule->FilterRegs = regs;
+            if (BOOL_FLAG(enable_filter_regex_set)) {
+                BuildKeyMatchers(filterRegs, *mFilterRule);
+            }
             mFilterMode = Mode::RULE_MODE;
         }
     }
@@ -117,7 +126,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                mContext->GetLogstoreName(),
                                mContext->GetRegion());
         } else if (!mInclude.empty()) {
-            std::vector<std::string> keys;
+            std::vector<std::string> keys, regStrs;
             std::vector<boost::regex> regs;
             for (auto& include : mInclude) {
                 if (!IsRegexValid(include.second)) {
@@ -131,11 +140,15 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                        mContext->GetRegion());
                 }
                 keys.emplace_back(include.first);
+                regStrs.emplace_back(include.second);
                 regs.emplace_back(boost::regex(include.second));
             }
             mFilterRule = std::make_shared<LogFilterRule>();
             mFilterRule->FilterKeys = keys;
             mFilterRule->FilterRegs = regs;
+            if (BOOL_FLAG(enable_filter_regex_set)) {
+                BuildKeyMatchers(regStrs, *mFilterRule);
+            }
             mFilterMode = Mode::RULE_MODE;
         }
     }
@@ -256,32 +269,108 @@ bool ProcessorFilterNative::FilterFilterRule(LogEvent& sourceEvent, const LogFil
 }
 
 bool ProcessorFilterNative::IsMatched(const LogEvent& contents, const LogFilterRule& rule) {
+    if (!rule.KeyMatchers.empty()) {
+        return IsMatchedByKeyMatchers(contents, rule);
+    }
     const std::vector<std::string>& keys = rule.FilterKeys;
-    const std::vector<boost::regex> regs = rule.FilterRegs;
-    std::string exception;
+    const std::vector<boost::regex>& regs = rule.FilterRegs;
     for (uint32_t i = 0; i < keys.size(); ++i) {
         const auto& content = contents.FindContent(keys[i]);
         if (content == contents.end()) {
             return false;
         }
-        if (!BoostRegexMatch(content->second.data(), content->second.size(), regs[i], exception)) {
-            if (!exception.empty()) {
-                LOG_ERROR(GetContext().GetLogger(), ("regex_match in Filter fail", exception));
-                if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
-                    GetContext().GetAlarm().SendAlarmWarning(REGEX_MATCH_ALARM,
-                                                             "regex_match in Filter fail:" + exception,
-                                                             GetContext().GetRegion(),
-                                                             GetContext().GetProjectName(),
-                                                             GetContext().GetConfigName(),
-                                                             GetContext().GetLogstoreName());
-                }
-            }
+        if (!IsBoostRegexMatched(content->second, regs[i])) {
             return false;
         }
     }
     return true;
 }
 
+bool ProcessorFilterNative::IsMatchedByKeyMatchers(const LogEvent& contents, const LogFilterRule& rule) {
+    static thread_local std::vector<int> sMatchedIdxs;
+    for (const auto& matcher : rule.KeyMatchers) {
+        const auto& content = contents.FindContent(matcher.Key);
+        if (content == contents.end()) {
+            return false;
+        }
+        if (matcher.RegSet) {
+            // all patterns on the key should be matched
+            if (!matcher.RegSet->Match(re2::StringPiece(content->second.data(), content->second.size()),
+                                       &sMatchedIdxs)
+                || sMatchedIdxs.size() != matcher.RegSetSize) {
+                return false;
+            }
+        }
+        for (size_t idx : matcher.BoostRegIdxs) {
+            if (!IsBoostRegexMatched(content->second, rule.FilterRegs[idx])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ProcessorFilterNative::IsBoostRegexMatched(StringView value, const boost::regex& reg) {
+    std::string exception;
+    if (BoostRegexMatch(value.data(), value.size(), reg, exception)) {
+        return true;
+    }
+    if (!exception.empty()) {
+        LOG_ERROR(GetContext().GetLogger(), ("regex_match in Filter fail", exception));
+        if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
+            GetContext().GetAlarm().SendAlarmWarning(REGEX_MATCH_ALARM,
+                                                     "regex_match in Filter fail:" + exception,
+                                                     GetContext().GetRegion(),
+                                                     GetContext().GetProjectName(),
+                                                     GetContext().GetConfigName(),
+                                                     GetContext().GetLogstoreName());
+        }
+    }
+    return false;
+}
+
+void ProcessorFilterNative::BuildKeyMatchers(const std::vector<std::string>& regs, LogFilterRule& rule) const {
+    const auto& options = GetBoostCompatibleRe2Options();
+    std::unordered_map<std::string, size_t> keyIdx;
+    for (size_t i = 0; i < rule.FilterKeys.size(); ++i) {
+        const auto& key = rule.FilterKeys[i];
+        auto it = keyIdx.find(key);
+        if (it == keyIdx.end()) {
+            it = keyIdx.emplace(key, rule.KeyMatchers.size()).first;
+            rule.KeyMatchers.emplace_back();
+            rule.KeyMatchers.back().Key = key;
+        }
+        auto& matcher = rule.KeyMatchers[it->second];
+        std::string pattern = GetBoostCompatibleRe2Pattern(regs[i]);
+        if (re2::RE2(pattern, options).ok()) {
+            if (!matcher.RegSet) {
+                matcher.RegSet = std::make_unique<re2::RE2::Set>(options, re2::RE2::ANCHOR_BOTH);
+            }
+            std::string error;
+            if (matcher.RegSet->Add(pattern, &error) >= 0) {
+                ++matcher.RegSetSize;
+                continue;
+            }
+        }
+        matcher.BoostRegIdxs.emplace_back(i);
+    }
+    for (auto& matcher : rule.KeyMatchers) {
+        if (matcher.RegSet && !matcher.RegSet->Compile()) {
+            LOG_WARNING(mContext->GetLogger(),
+                        ("failed to compile regex set, fall back to boost regex", "")("key", matcher.Key)(
+                            "config", mContext->GetConfigName()));
+            matcher.RegSet.reset();
+            matcher.RegSetSize = 0;
+            matcher.BoostRegIdxs.clear();
+            for (size_t i = 0; i < rule.FilterKeys.size(); ++i) {
+                if (rule.FilterKeys[i] == matcher.Key) {
+                    matcher.BoostRegIdxs.emplace_back(i);
+                }
+            }
+        }
+    }
+}
+
 static const char UTF8_BYTE_PREFIX = 0x80;
 static const char UTF8_BYTE_MASK = 0xc0;
 
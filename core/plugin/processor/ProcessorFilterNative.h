@@ -16,7 +16,13 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "boost/regex.hpp"
+#include "re2/re2.h"
+#include "re2/set.h"
 
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/interface/Processor.h"
@@ -118,9 +124,22 @@ protected:
 private:
     enum class Mode { BYPASS_MODE, EXPRESSION_MODE, RULE_MODE };
 
+    // All patterns on the same key are compiled into one RE2::Set anchored at both ends, so that the value of each key
+    // is scanned only once no matter how many patterns there are. Patterns not supported by RE2, e.g. backreferences
+    // and lookarounds, are still matched with boost regex.
+    struct KeyMatcher {
+        std::string Key;
+        std::unique_ptr<re2::RE2::Set> RegSet;
+        size_t RegSetSize = 0;
+        // indices in FilterRegs
+        std::vector<size_t> BoostRegIdxs;
+    };
+
     struct LogFilterRule {
         std::vector<std::string> FilterKeys;
         std::vector<boost::regex> FilterRegs;
+        // only built when flag enable_filter_regex_set is on
+        std::vector<KeyMatcher> KeyMatchers;
     };
 
     bool ProcessEvent(PipelineEventPtr& e);
@@ -131,6 +150,9 @@ private:
     // Filter logs through FilterRule
     bool FilterFilterRule(LogEvent& sourceEvent, const LogFilterRule* filterRule);
     bool IsMatched(const LogEvent& contents, const LogFilterRule& rule);
+    bool IsMatchedByKeyMatchers(const LogEvent& contents, const LogFilterRule& rule);
+    void BuildKeyMatchers(const std::vector<std::string>& regs, LogFilterRule& rule) const;
+    bool IsBoostRegexMatched(StringView value, const boost::regex& reg);
 
     bool noneUtf8(StringView& strSrc, bool modify);
     bool CheckNoneUtf8(const StringView& strSrc);
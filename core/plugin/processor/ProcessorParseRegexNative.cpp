@@ -18,6 +18,7 @@
 
 #include "app_config/AppConfig.h"
 #include "common/ParamExtractor.h"
+#include "common/Re2Util.h"
 #include "constants/Constants.h"
 #include "monitor/metric_constants/MetricConstants.h"
 #include "runner/ProcessorRunner.h"
@@ -61,12 +62,46 @@ bool ProcessorParseRegexNative::Init(const Json::Value& config) {
                            mContext->GetLogstoreName(),
                            mContext->GetRegion());
     }
-    mReg.reserve(AppConfig::GetInstance()->GetProcessThreadCount());
-    for (int i = 0; i < AppConfig::GetInstance()->GetProcessThreadCount(); ++i) {
-        mReg.emplace_back(mRegex);
-    }
     mIsWholeLineMode = mRegex == "(.*)";
 
+    // RegexEngine
+    std::string regexEngine;
+    if (!GetOptionalStringParam(config, "RegexEngine", regexEngine, errorMsg)) {
+        PARAM_WARNING_DEFAULT(mContext->GetLogger(),
+                              mContext->GetAlarm(),
+                              errorMsg,
+                              "boost",
+                              sName,
+                              mContext->GetConfigName(),
+                              mContext->GetProjectName(),
+                              mContext->GetLogstoreName(),
+                              mContext->GetRegion());
+    } else if (regexEngine == "re2") {
+        mRegexEngine = RegexEngine::RE2;
+    } else if (!regexEngine.empty() && regexEngine != "boost") {
+        PARAM_WARNING_DEFAULT(mContext->GetLogger(),
+                              mContext->GetAlarm(),
+                              "string param RegexEngine is not valid",
+                              "boost",
+                              sName,
+                              mContext->GetConfigName(),
+                              mContext->GetProjectName(),
+                              mContext->GetLogstoreName(),
+                              mContext->GetRegion());
+    }
+    if (mRegexEngine == RegexEngine::RE2 && !mIsWholeLineMode && !InitRe2Reg()) {
+        LOG_WARNING(mContext->GetLogger(),
+                    ("regex is not supported by re2", "fall back to boost regex")("regex", mRegex)(
+                        "config", mContext->GetConfigName()));
+        mRegexEngine = RegexEngine::BOOST;
+    }
+    if (mRegexEngine == RegexEngine::BOOST) {
+        mReg.reserve(AppConfig::GetInstance()->GetProcessThreadCount());
+        for (int i = 0; i < AppConfig::GetInstance()->GetProcessThreadCount(); ++i) {
+            mReg.emplace_back(mRegex);
+        }
+    }
+
     // Keys
     if (!GetMandatoryListParam(config, "Keys", mKeys, errorMsg)) {
         PARAM_ERROR_RETURN(mContext->GetLogger(),
@@ -147,7 +182,7 @@ bool ProcessorParseRegexNative::ProcessEvent(const StringView& logPath,
     if (mIsWholeLineMode) {
         parseSuccess = WholeLineModeParser(sourceEvent, mKeys.empty() ? DEFAULT_CONTENT_KEY : mKeys[0]);
     } else {
-        parseSuccess = RegexLogLineParser(sourceEvent, GetReg(), mKeys, logPath);
+        parseSuccess = RegexLogLineParser(sourceEvent, mKeys, logPath);
     }
 
     if (!parseSuccess || !mSourceKeyOverwritten) {
@@ -184,14 +219,13 @@ void ProcessorParseRegexNative::AddLog(const StringView& key,
 }
 
 bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
-                                                   const boost::regex& reg,
                                                    const std::vector<std::string>& keys,
                                                    const StringView& logPath) {
-    boost::match_results<const char*> what;
+    static thread_local std::vector<StringView> sGroups;
     std::string exception;
     StringView buffer = sourceEvent.GetContent(mSourceKey);
     bool parseSuccess = true;
-    if (!BoostRegexMatch(buffer.data(), buffer.size(), reg, exception, what, boost::match_default)) {
+    if (!MatchRegex(buffer, sGroups, exception)) {
         if (!exception.empty()) {
             if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
                 if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
@@ -224,16 +258,16 @@ bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
         }
         ADD_COUNTER(mOutFailedEventsTotal, 1);
         parseSuccess = false;
-    } else if (what.size() <= keys.size()) {
+    } else if (sGroups.size() <= keys.size()) {
         if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
             if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
                 LOG_WARNING(GetContext().GetLogger(),
                             ("parse key count not match",
-                             what.size())("parse regex log fail", buffer)("project", GetContext().GetProjectName())(
+                             sGroups.size())("parse regex log fail", buffer)("project", GetContext().GetProjectName())(
                                 "logstore", GetContext().GetLogstoreName())("file", logPath));
             }
             GetContext().GetAlarm().SendAlarmWarning(REGEX_MATCH_ALARM,
-                                                     "parse key count not match" + ToString(what.size())
+                                                     "parse key count not match" + ToString(sGroups.size())
                                                          + "errorlog:" + buffer.to_string(),
                                                      GetContext().GetRegion(),
                                                      GetContext().GetProjectName(),
@@ -247,7 +281,54 @@ bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
     }
 
     for (uint32_t i = 0; i < keys.size(); i++) {
-        AddLog(keys[i], StringView(what[i + 1].begin(), what[i + 1].length()), sourceEvent);
+        AddLog(keys[i], sGroups[i + 1], sourceEvent);
+    }
+    return true;
+}
+
+bool ProcessorParseRegexNative::MatchRegex(StringView buffer,
+                                           std::vector<StringView>& groups,
+                                           std::string& exception) const {
+    groups.clear();
+    if (mRegexEngine == RegexEngine::RE2) {
+        static thread_local std::vector<re2::StringPiece> sSubmatches;
+        const re2::RE2& reg = GetRe2Reg();
+        size_t groupCnt = reg.NumberOfCapturingGroups() + 1;
+        sSubmatches.resize(groupCnt);
+        if (!reg.Match(re2::StringPiece(buffer.data(), buffer.size()),
+                       0,
+                       buffer.size(),
+                       re2::RE2::ANCHOR_BOTH,
+                       sSubmatches.data(),
+                       groupCnt)) {
+            return false;
+        }
+        for (const auto& submatch : sSubmatches) {
+            groups.emplace_back(submatch.data(), submatch.size());
+        }
+        return true;
+    }
+    boost::match_results<const char*> what;
+    if (!BoostRegexMatch(buffer.data(), buffer.size(), GetReg(), exception, what, boost::match_default)) {
+        return false;
+    }
+    for (size_t i = 0; i < what.size(); ++i) {
+        groups.emplace_back(what[i].begin(), what[i].length());
+    }
+    return true;
+}
+
+bool ProcessorParseRegexNative::InitRe2Reg() {
+    const auto& options = GetBoostCompatibleRe2Options();
+    std::string pattern = GetBoostCompatibleRe2Pattern(mRegex);
+    // RE2 is thread-safe, but each thread owns a copy to avoid contention on the lazily built DFA
+    mRe2Reg.reserve(AppConfig::GetInstance()->GetProcessThreadCount());
+    for (int i = 0; i < AppConfig::GetInstance()->GetProcessThreadCount(); ++i) {
+        mRe2Reg.emplace_back(std::make_unique<re2::RE2>(pattern, options));
+        if (!mRe2Reg.back()->ok()) {
+            mRe2Reg.clear();
+            return false;
+        }
     }
     return true;
 }
@@ -256,4 +337,8 @@ const boost::regex& ProcessorParseRegexNative::GetReg() const {
     return mReg[ProcessorRunner::GetThreadNo()];
 }
 
+const re2::RE2& ProcessorParseRegexNative::GetRe2Reg() const {
+    return *mRe2Reg[ProcessorRunner::GetThreadNo()];
+}
+
 } // namespace logtail
@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "boost/regex.hpp"
+#include "re2/re2.h"
 
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "models/LogEvent.h"
@@ -28,6 +30,8 @@ namespace logtail {
 
 class ProcessorParseRegexNative : public Processor {
 public:
+    enum class RegexEngine { BOOST, RE2 };
+
     static const std::string sName;
 
     const std::string& Name() const override { return sName; }
@@ -40,6 +44,8 @@ public:
     std::string mRegex;
     // Extracted field list.
     std::vector<std::string> mKeys;
+    // Engine to run the regex, which falls back to boost when the regex is not supported by the engine.
+    RegexEngine mRegexEngine = RegexEngine::BOOST;
     CommonParserOptions mCommonParserOptions;
 
 protected:
@@ -49,17 +55,19 @@ private:
     /// @return false if data need to be discarded
     bool ProcessEvent(const StringView& logPath, PipelineEventPtr& e, const GroupMetadata& metadata);
     bool WholeLineModeParser(LogEvent& sourceEvent, const std::string& key);
-    bool RegexLogLineParser(LogEvent& sourceEvent,
-                            const boost::regex& reg,
-                            const std::vector<std::string>& keys,
-                            const StringView& logPath);
+    bool RegexLogLineParser(LogEvent& sourceEvent, const std::vector<std::string>& keys, const StringView& logPath);
+    /// @param groups the whole match and all capture groups, which point into the buffer
+    bool MatchRegex(StringView buffer, std::vector<StringView>& groups, std::string& exception) const;
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
 
     const boost::regex& GetReg() const;
+    const re2::RE2& GetRe2Reg() const;
+    bool InitRe2Reg();
 
     bool mSourceKeyOverwritten = false;
     bool mIsWholeLineMode = false;
     std::vector<boost::regex> mReg;
+    std::vector<std::unique_ptr<re2::RE2>> mRe2Reg;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
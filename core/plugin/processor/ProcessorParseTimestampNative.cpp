@@ -18,10 +18,15 @@
 
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/Flags.h"
 #include "common/LogtailCommonFlags.h"
 #include "common/ParamExtractor.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+DEFINE_FLAG_BOOL(enable_compiled_timestamp_parser,
+                 "parse log time with the parser compiled from SourceFormat before falling back to strptime",
+                 true);
+
 namespace logtail {
 
 const std::string ProcessorParseTimestampNative::sName = "processor_parse_timestamp_native";
@@ -53,6 +58,13 @@ bool ProcessorParseTimestampNative::Init(const Json::Value& config) {
                            mContext->GetRegion());
     }
 
+    if (BOOL_FLAG(enable_compiled_timestamp_parser)) {
+        mTimestampParser.Init(mSourceFormat);
+    }
+    const char* nanosecondPos = strstr(mSourceFormat.c_str(), "%f");
+    mHasNanosecond = nanosecondPos != nullptr;
+    mEndWithNanosecond = nanosecondPos == mSourceFormat.c_str() + mSourceFormat.size() - 2;
+
     // SourceTimezone
     if (!GetOptionalStringParam(config, "SourceTimezone", mSourceTimezone, errorMsg)) {
         PARAM_WARNING_IGNORE(mContext->GetLogger(),
@@ -185,21 +197,25 @@ bool ProcessorParseTimestampNative::ParseLogTime(const StringView& curTimeStr, /
     // Second-level cache only work when:
     // 1. No %f in the time format
     // 2. The %f is at the end of the time format
-    const char* compareResult = strstr(mSourceFormat.c_str(), "%f");
-    bool haveNanosecond = compareResult != nullptr;
-    bool endWithNanosecond = compareResult == (mSourceFormat.c_str() + mSourceFormat.size() - 2);
     int nanosecondLength = -1;
     const char* strptimeResult = NULL;
-    if ((!haveNanosecond || endWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
+    if ((!mHasNanosecond || mEndWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
         bool isTimestampNanosecond = (mSourceFormat == "%s") && (curTimeStr.length() > timeStrCache.length());
-        if (endWithNanosecond || isTimestampNanosecond) {
+        if (mEndWithNanosecond || isTimestampNanosecond) {
             strptimeResult = Strptime(curTimeStr.data() + timeStrCache.length(), "%f", &logTime, nanosecondLength);
         } else {
             strptimeResult = curTimeStr.data() + timeStrCache.length();
             logTime.tv_nsec = 0;
         }
     } else {
-        strptimeResult = Strptime(curTimeStr.data(), mSourceFormat.c_str(), &logTime, nanosecondLength, mSourceYear);
+        if (mTimestampParser.IsInited()) {
+            strptimeResult = mTimestampParser.Parse(curTimeStr.data(), curTimeStr.size(), &logTime, nanosecondLength);
+        }
+        if (NULL == strptimeResult) {
+            // strings not fitting the compiled layout may still be accepted by strptime
+            strptimeResult
+                = Strptime(curTimeStr.data(), mSourceFormat.c_str(), &logTime, nanosecondLength, mSourceYear);
+        }
         if (NULL != strptimeResult) {
             timeStrCache = curTimeStr.substr(0, curTimeStr.length() - nanosecondLength);
             logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
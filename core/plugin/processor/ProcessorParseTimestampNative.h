@@ -18,6 +18,7 @@
 
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "common/TimeUtil.h"
+#include "common/TimestampParser.h"
 
 namespace logtail {
 class ProcessorParseTimestampNative : public Processor {
@@ -52,6 +53,10 @@ private:
     bool IsPrefixString(const StringView& all, const StringView& prefix);
 
     int32_t mLogTimeZoneOffsetSecond = 0;
+    // compiled from mSourceFormat, uninitialized if the format is not supported
+    TimestampParser mTimestampParser;
+    bool mHasNanosecond = false;
+    bool mEndWithNanosecond = false;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
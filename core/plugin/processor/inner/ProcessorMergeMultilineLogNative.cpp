@@ -22,6 +22,7 @@
 
 #include "app_config/AppConfig.h"
 #include "common/ParamExtractor.h"
+#include "common/RegexPrefilter.h"
 #include "logger/Logger.h"
 #include "models/LogEvent.h"
 #include "monitor/metric_constants/MetricConstants.h"
@@ -217,20 +218,13 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
         StringView sourceVal = sourceEvent->GetContent(mSourceKey);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (mMultiline.GetStartPatternReg() != nullptr) {
-                regex = *mMultiline.GetStartPatternReg();
-            } else {
-                regex = *mMultiline.GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(sourceVal.data(), sourceVal.size(), regex, exception)) {
+            if (mMultiline.GetStartPatternReg() != nullptr ? IsStartPatternMatched(sourceVal, exception)
+                                                           : IsContinuePatternMatched(sourceVal, exception)) {
                 events.emplace_back(sourceEvent);
                 begin = cur;
                 isPartialLog = true;
             } else if (mMultiline.GetEndPatternReg() != nullptr && mMultiline.GetStartPatternReg() == nullptr
-                       && mMultiline.GetContinuePatternReg() != nullptr
-                       && BoostRegexSearch(
-                           sourceVal.data(), sourceVal.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                       && mMultiline.GetContinuePatternReg() != nullptr && IsEndPatternMatched(sourceVal, exception)) {
                 // case: continue + end
                 // current line is matched against the end pattern rather than the continue pattern
                 begin = cur;
@@ -241,9 +235,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
             }
         } else {
             // case: start + continue or continue + end
-            if (mMultiline.GetContinuePatternReg() != nullptr
-                && BoostRegexSearch(
-                    sourceVal.data(), sourceVal.size(), *mMultiline.GetContinuePatternReg(), exception)) {
+            if (mMultiline.GetContinuePatternReg() != nullptr && IsContinuePatternMatched(sourceVal, exception)) {
                 events.emplace_back(sourceEvent);
                 continue;
             }
@@ -253,8 +245,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
                 if (mMultiline.GetContinuePatternReg() != nullptr) {
                     // current line is not matched against the continue pattern, so the end pattern will decide if
                     // the current log is a match or not
-                    if (BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                    if (IsEndPatternMatched(sourceVal, exception)) {
                         MergeEvents(events, true);
                         sourceEvents[newSize++] = std::move(sourceEvents[begin]);
                     } else {
@@ -264,8 +255,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                    if (IsEndPatternMatched(sourceVal, exception)) {
                         MergeEvents(events, true);
                         sourceEvents[newSize++] = std::move(sourceEvents[begin]);
                         if (mMultiline.GetStartPatternReg() != nullptr) {
@@ -281,8 +271,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
             } else {
                 if (mMultiline.GetContinuePatternReg() == nullptr) {
                     // case: start
-                    if (!BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetStartPatternReg(), exception)) {
+                    if (!IsStartPatternMatched(sourceVal, exception)) {
                         events.emplace_back(sourceEvent);
                     } else {
                         MergeEvents(events, true);
@@ -295,8 +284,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
                     // continue pattern is given, but current line is not matched against the continue pattern
                     MergeEvents(events, true);
                     sourceEvents[newSize++] = std::move(sourceEvents[begin]);
-                    if (!BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetStartPatternReg(), exception)) {
+                    if (!IsStartPatternMatched(sourceVal, exception)) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both start
                         // and continue pattern are given, and the current line is not matched against the start
                         // pattern
@@ -350,6 +338,30 @@ void ProcessorMergeMultilineLogNative::MergeEvents(std::vector<LogEvent*>& logEv
     logEvents.clear();
 }
 
+bool ProcessorMergeMultilineLogNative::IsStartPatternMatched(StringView content, std::string& exception) const {
+    return BoostRegexSearch(content.data(),
+                            content.size(),
+                            *mMultiline.GetStartPatternReg(),
+                            mMultiline.GetStartPatternPrefilter().get(),
+                            exception);
+}
+
+bool ProcessorMergeMultilineLogNative::IsContinuePatternMatched(StringView content, std::string& exception) const {
+    return BoostRegexSearch(content.data(),
+                            content.size(),
+                            *mMultiline.GetContinuePatternReg(),
+                            mMultiline.GetContinuePatternPrefilter().get(),
+                            exception);
+}
+
+bool ProcessorMergeMultilineLogNative::IsEndPatternMatched(StringView content, std::string& exception) const {
+    return BoostRegexSearch(content.data(),
+                            content.size(),
+                            *mMultiline.GetEndPatternReg(),
+                            mMultiline.GetEndPatternPrefilter().get(),
+                            exception);
+}
+
 void ProcessorMergeMultilineLogNative::HandleUnmatchLogs(
     std::vector<PipelineEventPtr>& logEvents, size_t& newSize, size_t begin, size_t end, StringView logPath) {
     ADD_COUNTER(mUnmatchedEventsTotal, end - begin + 1);
@@ -51,6 +51,10 @@ private:
 
     void MergeEvents(std::vector<LogEvent*>& logEvents, bool insertLineBreak = true);
 
+    bool IsStartPatternMatched(StringView content, std::string& exception) const;
+    bool IsContinuePatternMatched(StringView content, std::string& exception) const;
+    bool IsEndPatternMatched(StringView content, std::string& exception) const;
+
     CounterPtr mMergedEventsTotal; // 成功合并了多少条日志
     // CounterPtr mProcMergedEventsBytes; // 成功合并了多少字节的日志
     CounterPtr mUnmatchedEventsTotal; // 未成功合并的日志条数
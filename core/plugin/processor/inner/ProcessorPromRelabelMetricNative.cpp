@@ -47,6 +47,12 @@ bool ProcessorPromRelabelMetricNative::Init(const Json::Value& config) {
 
     mLoongCollectorScraper = STRING_FLAG(_pod_name_);
 
+    if (mScrapeConfigPtr->mEnableStaleMarkers || mScrapeConfigPtr->mUnchangedSampleHeartbeatSeconds > 0) {
+        mSeriesCache = std::make_unique<prom::SeriesCache>(mScrapeConfigPtr->mEnableStaleMarkers,
+                                                           mScrapeConfigPtr->mUnchangedSampleHeartbeatSeconds * 1000,
+                                                           mScrapeConfigPtr->mScrapeIntervalSeconds * 1000);
+    }
+
     return true;
 }
 
@@ -55,9 +61,11 @@ void ProcessorPromRelabelMetricNative::Process(PipelineEventGroup& metricGroup)
     auto targetTags = metricGroup.GetTags();
 
     EventsContainer& events = metricGroup.MutableEvents();
+    // all events of the group come from the same target, and usually share a small set of metric names
+    vector<RelabelMatchCache> matchCaches;
     size_t wIdx = 0;
     for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-        if (ProcessEvent(events[rIdx], targetTags)) {
+        if (ProcessEvent(events[rIdx], targetTags, &matchCaches)) {
             if (wIdx != rIdx) {
                 events[wIdx] = std::move(events[rIdx]);
             }
@@ -66,6 +74,11 @@ void ProcessorPromRelabelMetricNative::Process(PipelineEventGroup& metricGroup)
     }
     events.resize(wIdx);
 
+    // before auto metrics, which are always sent and never stale
+    if (mSeriesCache) {
+        mSeriesCache->Process(metricGroup);
+    }
+
     if (metricGroup.HasMetadata(EventGroupMetaKey::PROMETHEUS_STREAM_TOTAL)) {
         auto autoMetric = prom::AutoMetric();
         UpdateAutoMetrics(metricGroup, autoMetric);
@@ -82,7 +95,9 @@ bool ProcessorPromRelabelMetricNative::IsSupportedEvent(const PipelineEventPtr&
     return e.Is<MetricEvent>();
 }
 
-bool ProcessorPromRelabelMetricNative::ProcessEvent(PipelineEventPtr& e, const GroupTags& targetTags) {
+bool ProcessorPromRelabelMetricNative::ProcessEvent(PipelineEventPtr& e,
+                                                    const GroupTags& targetTags,
+                                                    vector<RelabelMatchCache>* matchCaches) {
     if (!IsSupportedEvent(e)) {
         return false;
     }
@@ -114,7 +129,7 @@ bool ProcessorPromRelabelMetricNative::ProcessEvent(PipelineEventPtr& e, const G
     }
 
     if (!mScrapeConfigPtr->mMetricRelabelConfigs.Empty()
-        && !mScrapeConfigPtr->mMetricRelabelConfigs.Process(sourceEvent)) {
+        && !mScrapeConfigPtr->mMetricRelabelConfigs.Process(sourceEvent, matchCaches)) {
         return false;
     }
 
@@ -138,6 +153,8 @@ bool ProcessorPromRelabelMetricNative::ProcessEvent(PipelineEventPtr& e, const G
             appendLabels(k, v, mScrapeConfigPtr->mHonorLabels);
         }
     }
+    // tags are modified in place above
+    sourceEvent.mSeriesHash.reset();
 
     return true;
 }
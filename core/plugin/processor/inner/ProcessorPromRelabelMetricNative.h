@@ -17,10 +17,13 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "models/PipelineEventGroup.h"
 #include "models/PipelineEventPtr.h"
+#include "prometheus/component/SeriesCache.h"
+#include "prometheus/labels/Relabel.h"
 #include "prometheus/schedulers/ScrapeConfig.h"
 
 namespace logtail {
@@ -50,7 +53,10 @@ protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
 
 private:
-    bool ProcessEvent(PipelineEventPtr& e, const GroupTags& targetTags);
+    // matchCaches keeps regex match results of metric relabeling for events of the same group
+    bool ProcessEvent(PipelineEventPtr& e,
+                      const GroupTags& targetTags,
+                      std::vector<RelabelMatchCache>* matchCaches = nullptr);
 
     void AddAutoMetrics(PipelineEventGroup& eGroup, const prom::AutoMetric& autoMetric) const;
     void UpdateAutoMetrics(const PipelineEventGroup& eGroup, prom::AutoMetric& autoMetric) const;
@@ -62,6 +68,8 @@ private:
                    const GroupTags& targetTags) const;
 
     std::unique_ptr<ScrapeConfig> mScrapeConfigPtr;
+    // only created when stale markers or unchanged sample dropping is enabled
+    std::unique_ptr<prom::SeriesCache> mSeriesCache;
     std::string mLoongCollectorScraper;
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -17,6 +17,7 @@
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 
 #include "common/ParamExtractor.h"
+#include "common/SimdUtil.h"
 #include "models/LogEvent.h"
 
 namespace logtail {
@@ -165,12 +166,8 @@ StringView ProcessorSplitLogStringNative::GetNextLine(StringView log, size_t beg
         return StringView();
     }
 
-    for (size_t end = begin; end < log.size(); ++end) {
-        if (log[end] == mSplitChar) {
-            return StringView(log.data() + begin, end - begin);
-        }
-    }
-    return StringView(log.data() + begin, log.size() - begin);
+    const char* end = FindChar(log.data() + begin, log.data() + log.size(), mSplitChar);
+    return StringView(log.data() + begin, end - log.data() - begin);
 }
 
 } // namespace logtail
@@ -23,6 +23,8 @@
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "common/ParamExtractor.h"
+#include "common/RegexPrefilter.h"
+#include "common/SimdUtil.h"
 #include "constants/TagConstants.h"
 #include "logger/Logger.h"
 #include "models/LogEvent.h"
@@ -175,17 +177,12 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         ++(*inputLines);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (HasStartPattern()) {
-                regex = GetStartPatternReg();
-            } else {
-                regex = GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(content.data(), content.size(), regex, exception)) {
+            if (HasStartPattern() ? IsStartPatternMatched(content, exception)
+                                  : IsContinuePatternMatched(content, exception)) {
                 multiStartIndex = content.data();
                 isPartialLog = true;
             } else if (HasEndPattern() && !HasStartPattern() && HasContinuePattern()
-                       && BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                       && IsEndPatternMatched(content, exception)) {
                 // case: continue + end
                 CreateNewEvent(content, isLastLog, sourceKey, sourceEvent, logGroup, newEvents);
                 multiStartIndex = content.data() + content.size() + 1;
@@ -196,8 +193,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
             }
         } else {
             // case: start + continue or continue + end
-            if (HasContinuePattern()
-                && BoostRegexSearch(content.data(), content.size(), GetContinuePatternReg(), exception)) {
+            if (HasContinuePattern() && IsContinuePatternMatched(content, exception)) {
                 begin += content.size() + 1;
                 continue;
             }
@@ -206,7 +202,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                 if (HasContinuePattern()) {
                     // current line is not matched against the continue pattern, so the end pattern will decide
                     // if the current log is a match or not
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (IsEndPatternMatched(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -228,7 +224,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (IsEndPatternMatched(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -249,7 +245,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
             } else {
                 if (!HasContinuePattern()) {
                     // case: start
-                    if (BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (IsStartPatternMatched(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() - 1 - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -269,7 +265,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                                    logGroup,
                                    newEvents);
                     ADD_COUNTER(mMatchedEventsTotal, 1);
-                    if (!BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (!IsStartPatternMatched(content, exception)) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both
                         // start and continue pattern are given, and the current line is not matched against the
                         // start pattern
@@ -384,12 +380,30 @@ StringView ProcessorSplitMultilineLogStringNative::GetNextLine(StringView log, s
         return StringView();
     }
 
-    for (size_t end = begin; end < log.size(); ++end) {
-        if (log[end] == '\n') {
-            return StringView(log.data() + begin, end - begin);
-        }
-    }
-    return StringView(log.data() + begin, log.size() - begin);
+    const char* end = FindChar(log.data() + begin, log.data() + log.size(), '\n');
+    return StringView(log.data() + begin, end - log.data() - begin);
+}
+
+bool ProcessorSplitMultilineLogStringNative::IsStartPatternMatched(StringView content, std::string& exception) const {
+    return BoostRegexSearch(content.data(),
+                            content.size(),
+                            GetStartPatternReg(),
+                            mMultiline.GetStartPatternPrefilter().get(),
+                            exception);
+}
+
+bool ProcessorSplitMultilineLogStringNative::IsContinuePatternMatched(StringView content,
+                                                                      std::string& exception) const {
+    return BoostRegexSearch(content.data(),
+                            content.size(),
+                            GetContinuePatternReg(),
+                            mMultiline.GetContinuePatternPrefilter().get(),
+                            exception);
+}
+
+bool ProcessorSplitMultilineLogStringNative::IsEndPatternMatched(StringView content, std::string& exception) const {
+    return BoostRegexSearch(
+        content.data(), content.size(), GetEndPatternReg(), mMultiline.GetEndPatternPrefilter().get(), exception);
 }
 
 const boost::regex& ProcessorSplitMultilineLogStringNative::GetStartPatternReg() const {
@@ -71,6 +71,9 @@ private:
     const boost::regex& GetStartPatternReg() const;
     const boost::regex& GetContinuePatternReg() const;
     const boost::regex& GetEndPatternReg() const;
+    bool IsStartPatternMatched(StringView content, std::string& exception) const;
+    bool IsContinuePatternMatched(StringView content, std::string& exception) const;
+    bool IsEndPatternMatched(StringView content, std::string& exception) const;
 
     // boost::regex object shared by multi-thread leads to performance degradation. Therefore, each thread should be
     // allocated a different copy.
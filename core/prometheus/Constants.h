@@ -10,6 +10,9 @@ namespace logtail::prometheus {
 const uint64_t PRIME64 = 1099511628211;
 const uint64_t OFFSET64 = 14695981039346656037ULL;
 const uint64_t RefeshIntervalSeconds = 5;
+// bit pattern of the NaN marking a series as stale, from
+// https://github.com/prometheus/prometheus/blob/main/model/value/value.go
+const uint64_t STALE_NAN = 0x7ff0000000000002ULL;
 const char* const META = "__meta_";
 const char* const UNDEFINED = "undefined";
 const std::string PROMETHEUS = "prometheus";
@@ -24,6 +27,9 @@ const char* const MATCH_LIST = "match_list";
 const char* const REPLACEMENT = "replacement";
 const char* const ACTION = "action";
 const char* const MODULUS = "modulus";
+const char* const HASH_ALGORITHM = "hash_algorithm";
+const char* const HASH_ALGORITHM_MD5 = "md5";
+const char* const HASH_ALGORITHM_XXHASH = "xxhash";
 const char* const NAME = "__name__";
 const std::string EXPORTED_PREFIX = "exported_";
 
@@ -82,6 +88,8 @@ const char* const HOST = "Host";
 const char* const INSECURE_SKIP_VERIFY = "insecure_skip_verify";
 const char* const EXTERNAL_LABELS = "external_labels";
 const char* const HOST_ONLY_MODE = "host_only_mode";
+const char* const ENABLE_STALE_MARKERS = "enable_stale_markers";
+const char* const UNCHANGED_SAMPLE_HEARTBEAT = "unchanged_sample_heartbeat";
 const char* const STATIC_CONFIGS = "static_configs";
 
 // scrape protocols, from https://prometheus.io/docs/prometheus/latest/configuration/configuration/#scrape_config
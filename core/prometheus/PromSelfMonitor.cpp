@@ -4,6 +4,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "common/StringTools.h"
 #include "monitor/metric_constants/MetricConstants.h"
 #include "monitor/metric_models/MetricTypes.h"
 using namespace std;
@@ -12,9 +13,9 @@ namespace logtail {
 
 void PromSelfMonitorUnsafe::InitMetricManager(const std::unordered_map<std::string, MetricType>& metricKeys,
                                               const MetricLabels& labels) {
-    auto metricLabels = std::make_shared<MetricLabels>(labels);
+    mDefaultLabels = std::make_shared<MetricLabels>(labels);
     mPluginMetricManagerPtr = std::make_shared<PluginMetricManager>(
-        metricLabels, metricKeys, MetricCategory::METRIC_CATEGORY_PLUGIN_SOURCE);
+        mDefaultLabels, metricKeys, MetricCategory::METRIC_CATEGORY_PLUGIN_SOURCE);
 }
 
 void PromSelfMonitorUnsafe::AddCounter(const std::string& metricName, uint64_t statusCode, uint64_t val) {
@@ -33,6 +34,46 @@ void PromSelfMonitorUnsafe::SetIntGauge(const std::string& metricName, uint64_t
     SET_GAUGE(mMetricsIntGaugeMap[metricName][status], value);
 }
 
+void PromSelfMonitorUnsafe::ObserveHistogram(const std::string& metricName,
+                                             const std::vector<uint64_t>& buckets,
+                                             uint64_t value) {
+    auto& counters = mMetricsHistogramMap[metricName];
+    if (counters.empty()) {
+        for (auto bound : buckets) {
+            auto record = GetOrCreateBucketMetricsRecordRef(metricName, ToString(bound));
+            counters.emplace_back(record ? record->GetCounter(metricName) : nullptr);
+        }
+        auto record = GetOrCreateBucketMetricsRecordRef(metricName, "+Inf");
+        counters.emplace_back(record ? record->GetCounter(metricName) : nullptr);
+    }
+    for (size_t i = 0; i < buckets.size() && i + 1 < counters.size(); ++i) {
+        if (value <= buckets[i]) {
+            ADD_COUNTER(counters[i], 1);
+        }
+    }
+    ADD_COUNTER(counters.back(), 1);
+}
+
+ReentrantMetricsRecordRef PromSelfMonitorUnsafe::GetOrCreateBucketMetricsRecordRef(const std::string& metricName,
+                                                                                  const std::string& le) {
+    if (mPluginMetricManagerPtr == nullptr) {
+        return nullptr;
+    }
+    // each histogram has its own records, so that buckets of different histograms with the same le are not mixed up
+    auto& manager = mHistogramMetricManagers[metricName];
+    if (manager == nullptr) {
+        manager = std::make_shared<PluginMetricManager>(
+            mDefaultLabels,
+            std::unordered_map<std::string, MetricType>{{metricName, MetricType::METRIC_TYPE_COUNTER}},
+            MetricCategory::METRIC_CATEGORY_PLUGIN_SOURCE);
+    }
+    auto& record = mPromBucketMap[metricName][le];
+    if (record == nullptr) {
+        record = manager->GetOrCreateReentrantMetricsRecordRef({{METRIC_LABEL_KEY_LE, le}});
+    }
+    return record;
+}
+
 ReentrantMetricsRecordRef PromSelfMonitorUnsafe::GetOrCreateReentrantMetricsRecordRef(const std::string& status) {
     if (mPluginMetricManagerPtr == nullptr) {
         return nullptr;
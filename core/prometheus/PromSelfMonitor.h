@@ -3,6 +3,7 @@
 #include <map>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "monitor/MetricManager.h"
 #include "monitor/metric_models/ReentrantMetricsRecord.h"
@@ -20,14 +21,22 @@ public:
 
     void SetIntGauge(const std::string& metricName, uint64_t status, uint64_t value);
 
+    // Count value into cumulative buckets labelled by le, i.e. each bucket counts the values not greater than its upper
+    // bound, and the last bucket "+Inf" counts all values. Buckets must be sorted and the same for each call.
+    void ObserveHistogram(const std::string& metricName, const std::vector<uint64_t>& buckets, uint64_t value);
+
 private:
     ReentrantMetricsRecordRef GetOrCreateReentrantMetricsRecordRef(const std::string& status);
+    ReentrantMetricsRecordRef GetOrCreateBucketMetricsRecordRef(const std::string& metricName, const std::string& le);
     std::string& StatusToString(uint64_t status);
 
     PluginMetricManagerPtr mPluginMetricManagerPtr;
     std::map<std::string, ReentrantMetricsRecordRef> mPromStatusMap;
     std::map<std::string, std::map<std::string, CounterPtr>> mMetricsCounterMap;
     std::map<std::string, std::map<std::string, IntGaugePtr>> mMetricsIntGaugeMap;
+    std::map<std::string, PluginMetricManagerPtr> mHistogramMetricManagers;
+    std::map<std::string, std::map<std::string, ReentrantMetricsRecordRef>> mPromBucketMap;
+    std::map<std::string, std::vector<CounterPtr>> mMetricsHistogramMap;
     MetricLabelsPtr mDefaultLabels;
 
 #ifdef APSARA_UNIT_TEST_MAIN
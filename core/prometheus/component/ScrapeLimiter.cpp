@@ -0,0 +1,60 @@
+#include "prometheus/component/ScrapeLimiter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+#include "common/Flags.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT32(prom_max_inflight_scrapes, "max prometheus scrapes in flight across all targets", 1024);
+DEFINE_FLAG_INT32(prom_min_inflight_scrapes, "min prometheus scrapes in flight when throttled by backpressure", 16);
+
+using namespace std;
+
+namespace logtail::prom {
+
+static const vector<uint64_t> sStartSkewBucketsMs = {10, 100, 500, 1000, 5000, 15000, 60000};
+static const vector<uint64_t> sInFlightBuckets = {1, 4, 16, 64, 256, 1024, 4096};
+
+ScrapeLimiter::ScrapeLimiter()
+    : mLimiter("prometheus scrape",
+               static_cast<uint32_t>(max(INT32_FLAG(prom_max_inflight_scrapes), 1)),
+               static_cast<uint32_t>(
+                   min(max(INT32_FLAG(prom_min_inflight_scrapes), 1), max(INT32_FLAG(prom_max_inflight_scrapes), 1)))) {
+    MetricLabels labels;
+    labels.emplace_back(METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS);
+    static const unordered_map<string, MetricType> sLimiterMetricKeys
+        = {{METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS, MetricType::METRIC_TYPE_COUNTER},
+           {METRIC_PLUGIN_PROM_SCRAPE_INFLIGHT, MetricType::METRIC_TYPE_COUNTER}};
+    mSelfMonitor.InitMetricManager(sLimiterMetricKeys, labels);
+}
+
+bool ScrapeLimiter::TryAcquire(uint64_t startSkewMs) {
+    if (!mLimiter.IsValidToPop()) {
+        return false;
+    }
+    mLimiter.PostPop();
+    auto inFlight = ++mInFlightCnt;
+
+    lock_guard<mutex> lock(mSelfMonitorMux);
+    mSelfMonitor.ObserveHistogram(METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS, sStartSkewBucketsMs, startSkewMs);
+    mSelfMonitor.ObserveHistogram(METRIC_PLUGIN_PROM_SCRAPE_INFLIGHT, sInFlightBuckets, inFlight);
+    return true;
+}
+
+void ScrapeLimiter::Release(bool success) {
+    --mInFlightCnt;
+    mLimiter.OnSendDone();
+    // a failed target says nothing about the load of this collector, so only successes adjust the limit
+    if (success) {
+        mLimiter.OnSuccess(chrono::system_clock::now());
+    }
+}
+
+void ScrapeLimiter::OnBackpressure() {
+    mLimiter.OnFail(chrono::system_clock::now());
+}
+
+} // namespace logtail::prom
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "collection_pipeline/limiter/ConcurrencyLimiter.h"
+#include "prometheus/PromSelfMonitor.h"
+
+#ifdef APSARA_UNIT_TEST_MAIN
+namespace logtail {
+class ScrapeSchedulerUnittest;
+} // namespace logtail
+#endif
+
+namespace logtail::prom {
+
+// Limits the number of scrapes in flight across all targets. The limit is lowered when scrapes are held back because
+// the process queue is full, and raised again as scrapes succeed.
+class ScrapeLimiter {
+public:
+    ScrapeLimiter(const ScrapeLimiter&) = delete;
+    ScrapeLimiter& operator=(const ScrapeLimiter&) = delete;
+
+    static ScrapeLimiter* GetInstance() {
+        static ScrapeLimiter sInstance;
+        return &sInstance;
+    }
+
+    // Returns false if the scrape should be postponed. Otherwise Release must be called once the scrape is done.
+    bool TryAcquire(uint64_t startSkewMs);
+    void Release(bool success);
+    void OnBackpressure();
+
+    uint32_t GetInFlightCount() const { return mInFlightCnt.load(); }
+
+private:
+    ScrapeLimiter();
+
+    ConcurrencyLimiter mLimiter;
+    std::atomic_uint32_t mInFlightCnt = 0;
+
+    std::mutex mSelfMonitorMux;
+    PromSelfMonitorUnsafe mSelfMonitor;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class logtail::ScrapeSchedulerUnittest;
+#endif
+};
+
+} // namespace logtail::prom
@@ -0,0 +1,139 @@
+#include "prometheus/component/SeriesCache.h"
+
+#include <cstring>
+
+#include "common/StringTools.h"
+#include "models/MetricEvent.h"
+#include "prometheus/Constants.h"
+
+using namespace std;
+
+namespace logtail::prom {
+
+// targets not scraped for so many intervals are removed, e.g. when they are no longer discovered
+static constexpr uint64_t kTargetExpireIntervals = 5;
+
+void SeriesCache::Process(PipelineEventGroup& eGroup) {
+    if (!eGroup.HasMetadata(EventGroupMetaKey::PROMETHEUS_STREAM_ID)
+        || !eGroup.HasMetadata(EventGroupMetaKey::PROMETHEUS_SCRAPE_TIMESTAMP_MILLISEC)) {
+        return;
+    }
+    uint64_t scrapeMs = 0;
+    if (!StringTo(eGroup.GetMetadata(EventGroupMetaKey::PROMETHEUS_SCRAPE_TIMESTAMP_MILLISEC), scrapeMs)) {
+        return;
+    }
+    auto target = GetOrCreateTarget(eGroup.GetMetadata(EventGroupMetaKey::PROMETHEUS_STREAM_ID).to_string(), scrapeMs);
+
+    lock_guard<mutex> lock(target->mMux);
+    if (scrapeMs < target->mScrapeMs) {
+        // a late group of an earlier scrape, whose series may have been marked stale already
+        return;
+    }
+    if (scrapeMs > target->mScrapeMs) {
+        target->mScrapeMs = scrapeMs;
+        target->mSeenStreams = 0;
+        target->mTotalStreams = 0;
+    }
+
+    EventsContainer& events = eGroup.MutableEvents();
+    size_t wIdx = 0;
+    for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
+        if (!events[rIdx].Is<MetricEvent>() || ProcessEvent(*target, events[rIdx].Cast<MetricEvent>())) {
+            if (wIdx != rIdx) {
+                events[wIdx] = std::move(events[rIdx]);
+            }
+            ++wIdx;
+        }
+    }
+    events.resize(wIdx);
+
+    ++target->mSeenStreams;
+    if (eGroup.HasMetadata(EventGroupMetaKey::PROMETHEUS_STREAM_TOTAL)) {
+        StringTo(eGroup.GetMetadata(EventGroupMetaKey::PROMETHEUS_STREAM_TOTAL), target->mTotalStreams);
+    }
+    if (target->mTotalStreams > 0 && target->mSeenStreams >= target->mTotalStreams) {
+        CompleteScrape(*target, eGroup);
+    }
+}
+
+size_t SeriesCache::TargetCount() const {
+    lock_guard<mutex> lock(mTargetsMux);
+    return mTargets.size();
+}
+
+shared_ptr<SeriesCache::TargetState> SeriesCache::GetOrCreateTarget(const string& targetId, uint64_t scrapeMs) {
+    lock_guard<mutex> lock(mTargetsMux);
+    if (scrapeMs > mLastGCScrapeMs + mScrapeIntervalMs) {
+        for (auto it = mTargets.begin(); it != mTargets.end();) {
+            uint64_t lastScrapeMs = 0;
+            {
+                lock_guard<mutex> targetLock(it->second->mMux);
+                lastScrapeMs = it->second->mScrapeMs;
+            }
+            if (lastScrapeMs + kTargetExpireIntervals * mScrapeIntervalMs < scrapeMs) {
+                it = mTargets.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        mLastGCScrapeMs = scrapeMs;
+    }
+    auto& target = mTargets[targetId];
+    if (!target) {
+        target = make_shared<TargetState>();
+    }
+    return target;
+}
+
+bool SeriesCache::ProcessEvent(TargetState& target, MetricEvent& e) const {
+    auto [it, inserted] = target.mSeries.try_emplace(e.GetSeriesHash());
+    auto& series = it->second;
+    if (inserted && mEnableStaleMarkers) {
+        series.mName = e.GetName().to_string();
+        series.mTags.reserve(distance(e.TagsBegin(), e.TagsEnd()));
+        for (auto tag = e.TagsBegin(); tag != e.TagsEnd(); ++tag) {
+            series.mTags.emplace_back(tag->first.to_string(), tag->second.to_string());
+        }
+    }
+    series.mLastSeenScrapeMs = target.mScrapeMs;
+
+    const auto* value = e.GetValue<UntypedSingleValue>();
+    if (value == nullptr) {
+        return true;
+    }
+    // compared bitwise, so that NaN equals NaN
+    if (!inserted && mUnchangedSampleHeartbeatMs > 0
+        && memcmp(&series.mLastValue, &value->mValue, sizeof(double)) == 0
+        && target.mScrapeMs < series.mLastSentScrapeMs + mUnchangedSampleHeartbeatMs) {
+        return false;
+    }
+    series.mLastValue = value->mValue;
+    series.mLastSentScrapeMs = target.mScrapeMs;
+    return true;
+}
+
+void SeriesCache::CompleteScrape(TargetState& target, PipelineEventGroup& eGroup) const {
+    double staleNaN = 0.0;
+    memcpy(&staleNaN, &prometheus::STALE_NAN, sizeof(double));
+    auto timestamp = static_cast<time_t>(target.mScrapeMs / 1000);
+    auto nanoSec = static_cast<uint32_t>(target.mScrapeMs % 1000 * 1000000);
+
+    for (auto it = target.mSeries.begin(); it != target.mSeries.end();) {
+        if (it->second.mLastSeenScrapeMs >= target.mScrapeMs) {
+            ++it;
+            continue;
+        }
+        if (mEnableStaleMarkers) {
+            auto* e = eGroup.AddMetricEvent(true);
+            e->SetName(it->second.mName);
+            e->SetValue<UntypedSingleValue>(staleNaN);
+            e->SetTimestamp(timestamp, nanoSec);
+            for (const auto& [k, v] : it->second.mTags) {
+                e->SetTag(k, v);
+            }
+        }
+        it = target.mSeries.erase(it);
+    }
+}
+
+} // namespace logtail::prom
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "models/PipelineEventGroup.h"
+
+namespace logtail::prom {
+
+// Remembers the series of each target across scrapes. Series are identified by MetricEvent::GetSeriesHash, so it must
+// be used on events whose tags are final, i.e. after relabeling.
+//
+// A scrape may be split into several event groups, which are possibly processed by different threads and out of
+// order. A scrape is complete once all of its groups, whose count is given by the last one, have been seen. Then
+// stale markers are appended to the group completing the scrape for the series which are not in the scrape.
+class SeriesCache {
+public:
+    SeriesCache(bool enableStaleMarkers, uint64_t unchangedSampleHeartbeatMs, uint64_t scrapeIntervalMs)
+        : mEnableStaleMarkers(enableStaleMarkers),
+          mUnchangedSampleHeartbeatMs(unchangedSampleHeartbeatMs),
+          mScrapeIntervalMs(scrapeIntervalMs) {}
+    SeriesCache(const SeriesCache&) = delete;
+    SeriesCache& operator=(const SeriesCache&) = delete;
+
+    // Drops the samples whose values are unchanged since the last sent sample of the series within the heartbeat, and
+    // appends stale markers if the group completes a scrape.
+    void Process(PipelineEventGroup& eGroup);
+
+    size_t TargetCount() const;
+
+private:
+    struct SeriesState {
+        // name and tags are only kept for stale markers
+        std::string mName;
+        std::vector<std::pair<std::string, std::string>> mTags;
+        double mLastValue = 0.0;
+        uint64_t mLastSeenScrapeMs = 0;
+        uint64_t mLastSentScrapeMs = 0;
+    };
+
+    struct TargetState {
+        std::mutex mMux;
+        std::unordered_map<uint64_t, SeriesState> mSeries;
+        uint64_t mScrapeMs = 0;
+        uint64_t mSeenStreams = 0;
+        uint64_t mTotalStreams = 0;
+    };
+
+    std::shared_ptr<TargetState> GetOrCreateTarget(const std::string& targetId, uint64_t scrapeMs);
+    bool ProcessEvent(TargetState& target, MetricEvent& e) const;
+    void CompleteScrape(TargetState& target, PipelineEventGroup& eGroup) const;
+
+    const bool mEnableStaleMarkers;
+    const uint64_t mUnchangedSampleHeartbeatMs;
+    const uint64_t mScrapeIntervalMs;
+
+    mutable std::mutex mTargetsMux;
+    std::unordered_map<std::string, std::shared_ptr<TargetState>> mTargets;
+    uint64_t mLastGCScrapeMs = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class SeriesCacheUnittest;
+#endif
+};
+
+} // namespace logtail::prom
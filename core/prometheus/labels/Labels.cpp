@@ -109,6 +109,8 @@ void Labels::Range(const std::function<void(const string& k, const string& v)>&
 }
 
 uint64_t Labels::Hash() {
+    // FNV-1a over the sorted labels, which is the same as the fingerprint of prometheus and identifies targets, so it
+    // should not be changed. MetricEvent::GetSeriesHash is used for series instead.
     string hash;
     uint64_t sum = prometheus::OFFSET64;
     vector<string> names;
@@ -17,11 +17,14 @@
 #include "Relabel.h"
 
 #include <openssl/md5.h>
+#include <xxhash/xxhash.h>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/regex.hpp>
+#include <cctype>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "common/ParamExtractor.h"
@@ -80,8 +83,10 @@ const std::string& ActionToString(Action action) {
     return sUndefined;
 }
 RelabelConfig::RelabelConfig() : mSeparator(";"), mReplacement("$1"), mAction(Action::REPLACE) {
-    mRegex = boost::regex("(.*)");
+    CompileRegex("(.*)");
+    mSimpleReplacement.Init(mReplacement);
 }
+
 bool RelabelConfig::Init(const Json::Value& config) {
     string errorMsg;
 
@@ -98,13 +103,14 @@ bool RelabelConfig::Init(const Json::Value& config) {
     }
 
     if (config.isMember(prometheus::REGEX) && config[prometheus::REGEX].isString()) {
-        string re = config[prometheus::REGEX].asString();
-        mRegex = boost::regex(re);
+        CompileRegex(config[prometheus::REGEX].asString());
     }
 
     if (config.isMember(prometheus::REPLACEMENT) && config[prometheus::REPLACEMENT].isString()) {
         mReplacement = config[prometheus::REPLACEMENT].asString();
     }
+    mSimpleTargetLabel.Init(mTargetLabel);
+    mSimpleReplacement.Init(mReplacement);
 
     if (config.isMember(prometheus::ACTION) && config[prometheus::ACTION].isString()) {
         string actionString = config[prometheus::ACTION].asString();
@@ -134,9 +140,135 @@ bool RelabelConfig::Init(const Json::Value& config) {
     if (config.isMember(prometheus::MODULUS) && config[prometheus::MODULUS].isUInt64()) {
         mModulus = config[prometheus::MODULUS].asUInt64();
     }
+    if (config.isMember(prometheus::HASH_ALGORITHM) && config[prometheus::HASH_ALGORITHM].isString()) {
+        string algorithm = config[prometheus::HASH_ALGORITHM].asString();
+        if (algorithm == prometheus::HASH_ALGORITHM_XXHASH) {
+            mHashModUseXXHash = true;
+        } else if (algorithm != prometheus::HASH_ALGORITHM_MD5) {
+            LOG_ERROR(sLogger, ("invalid hash_algorithm", algorithm));
+            return false;
+        }
+    }
+    return true;
+}
+
+void RelabelConfig::CompileRegex(const string& re) {
+    mRegex = boost::regex(re);
+    mRegexStr = re;
+    mIsRegexCaptureAll = re == "(.*)";
+    if (mIsRegexCaptureAll || re == ".*") {
+        mRegexType = RegexType::MATCH_ALL;
+    } else if (re.find_first_of("\\^$.|?*+()[]{}") == string::npos) {
+        mRegexType = RegexType::LITERAL;
+    } else {
+        mRegexType = RegexType::GENERAL;
+    }
+}
+
+bool RelabelConfig::Match(StringView value) const {
+    switch (mRegexType) {
+        case RegexType::MATCH_ALL:
+            return true;
+        case RegexType::LITERAL:
+            return value == mRegexStr;
+        default:
+            return boost::regex_match(value.begin(), value.end(), mRegex);
+    }
+}
+
+bool RelabelConfig::Match(StringView value, RelabelMatchCache* matchCache) const {
+    if (matchCache == nullptr || mRegexType != RegexType::GENERAL) {
+        return Match(value);
+    }
+    auto it = matchCache->find(value);
+    if (it != matchCache->end()) {
+        return it->second;
+    }
+    bool res = Match(value);
+    matchCache->emplace(value, res);
+    return res;
+}
+
+uint64_t RelabelConfig::HashMod(StringView value) const {
+    if (mHashModUseXXHash) {
+        return XXH64(value.data(), value.size(), 0) % mModulus;
+    }
+    uint8_t digest[MD5_DIGEST_LENGTH];
+    MD5((const uint8_t*)value.data(), value.size(), (uint8_t*)&digest);
+    // Use only the last 8 bytes of the hash to give the same result as earlier versions of this code.
+    uint64_t hashVal = 0;
+    for (int i = 8; i < MD5_DIGEST_LENGTH; ++i) {
+        hashVal = (hashVal << 8) | digest[i];
+    }
+    return hashVal % mModulus;
+}
+
+bool RelabelConfig::SimpleFormat::Init(const string& format) {
+    mIsValid = false;
+    mPieces.clear();
+    string literal;
+    auto addValue = [&]() {
+        if (!literal.empty()) {
+            mPieces.emplace_back(false, std::move(literal));
+            literal.clear();
+        }
+        mPieces.emplace_back(true, string());
+    };
+    for (size_t i = 0; i < format.size(); ++i) {
+        if (format[i] == '\\') {
+            return false;
+        }
+        if (format[i] != '$') {
+            literal.push_back(format[i]);
+            continue;
+        }
+        if (i + 1 == format.size()) {
+            return false;
+        }
+        char c = format[++i];
+        if (c == '$') {
+            literal.push_back('$');
+        } else if (c == '&') {
+            addValue();
+        } else if (c == '0' || c == '1') {
+            // $10 refers to group 10
+            if (i + 1 < format.size() && isdigit(static_cast<unsigned char>(format[i + 1]))) {
+                return false;
+            }
+            addValue();
+        } else if (c == '{' && i + 2 < format.size() && (format[i + 1] == '0' || format[i + 1] == '1')
+                   && format[i + 2] == '}') {
+            addValue();
+            i += 2;
+        } else {
+            return false;
+        }
+    }
+    if (!literal.empty()) {
+        mPieces.emplace_back(false, std::move(literal));
+    }
+    mIsValid = true;
     return true;
 }
 
+StringView RelabelConfig::SimpleFormat::Format(StringView value, string& buffer) const {
+    if (mPieces.empty()) {
+        return StringView();
+    }
+    if (mPieces.size() == 1) {
+        return mPieces[0].first ? value : StringView(mPieces[0].second);
+    }
+    buffer.clear();
+    for (const auto& piece : mPieces) {
+        if (piece.first) {
+            buffer.append(value.data(), value.size());
+        } else {
+            buffer.append(piece.second);
+        }
+    }
+    return StringView(buffer);
+}
+
 bool RelabelConfig::Process(Labels& l) const {
     vector<string> values;
     values.reserve(mSourceLabels.size());
@@ -146,13 +278,13 @@ bool RelabelConfig::Process(Labels& l) const {
     string val = boost::algorithm::join(values, mSeparator);
     switch (mAction) {
         case Action::DROP: {
-            if (boost::regex_match(val, mRegex)) {
+            if (Match(val)) {
                 return false;
             }
             break;
         }
         case Action::KEEP: {
-            if (!boost::regex_match(val, mRegex)) {
+            if (!Match(val)) {
                 return false;
             }
             break;
@@ -170,6 +302,17 @@ bool RelabelConfig::Process(Labels& l) const {
             break;
         }
         case Action::REPLACE: {
+            if (mIsRegexCaptureAll && mSimpleTargetLabel.mIsValid && mSimpleReplacement.mIsValid) {
+                string buffer;
+                string target = mSimpleTargetLabel.Format(val, buffer).to_string();
+                string res = mSimpleReplacement.Format(val, buffer).to_string();
+                if (res.empty()) {
+                    l.Del(target);
+                } else {
+                    l.Set(target, res);
+                }
+                break;
+            }
             bool indexes = boost::regex_search(val, mRegex);
             // If there is no match no replacement must take place.
             if (!indexes) {
@@ -193,15 +336,7 @@ bool RelabelConfig::Process(Labels& l) const {
             break;
         }
         case Action::HASHMOD: {
-            uint8_t digest[MD5_DIGEST_LENGTH];
-            MD5((uint8_t*)val.c_str(), val.length(), (uint8_t*)&digest);
-            // Use only the last 8 bytes of the hash to give the same result as earlier versions of this code.
-            uint64_t hashVal = 0;
-            for (int i = 8; i < MD5_DIGEST_LENGTH; ++i) {
-                hashVal = (hashVal << 8) | digest[i];
-            }
-            uint64_t mod = hashVal % mModulus;
-            l.Set(mTargetLabel, to_string(mod));
+            l.Set(mTargetLabel, to_string(HashMod(val)));
             break;
         }
         case Action::LABELMAP: {
@@ -217,7 +352,7 @@ bool RelabelConfig::Process(Labels& l) const {
         case Action::LABELDROP: {
             vector<string> toDel;
             l.Range([&](const string& key, const string& value) {
-                if (boost::regex_match(key, mRegex)) {
+                if (Match(key)) {
                     toDel.push_back(key);
                 }
             });
@@ -229,7 +364,7 @@ bool RelabelConfig::Process(Labels& l) const {
         case Action::LABELKEEP: {
             vector<string> toDel;
             l.Range([&](const string& key, const string& value) {
-                if (!boost::regex_match(key, mRegex)) {
+                if (!Match(key)) {
                     toDel.push_back(key);
                 }
             });
@@ -252,6 +387,140 @@ bool RelabelConfig::Process(Labels& l) const {
     return true;
 }
 
+namespace {
+
+// buffers reused by relabeling on each thread, so that no allocation is needed in most cases
+thread_local string sSourceValueBuffer;
+thread_local string sTargetLabelBuffer;
+thread_local string sReplacementBuffer;
+thread_local vector<StringView> sLabelsToDel;
+
+StringView CopyToEvent(MetricEvent& event, StringView str) {
+    auto b = event.GetSourceBuffer()->CopyString(str);
+    return StringView(b.data, b.size);
+}
+
+} // namespace
+
+bool RelabelConfig::Process(MetricEvent& event, RelabelMatchCache* matchCache) const {
+    StringView val;
+    if (mSourceLabels.size() == 1) {
+        val = event.GetTag(mSourceLabels[0]);
+    } else {
+        sSourceValueBuffer.clear();
+        for (size_t i = 0; i < mSourceLabels.size(); ++i) {
+            if (i != 0) {
+                sSourceValueBuffer.append(mSeparator);
+            }
+            auto value = event.GetTag(mSourceLabels[i]);
+            sSourceValueBuffer.append(value.data(), value.size());
+        }
+        val = StringView(sSourceValueBuffer);
+        matchCache = nullptr;
+    }
+    switch (mAction) {
+        case Action::DROP: {
+            if (Match(val, matchCache)) {
+                return false;
+            }
+            break;
+        }
+        case Action::KEEP: {
+            if (!Match(val, matchCache)) {
+                return false;
+            }
+            break;
+        }
+        case Action::DROPEQUAL: {
+            if (event.GetTag(mTargetLabel) == val) {
+                return false;
+            }
+            break;
+        }
+        case Action::KEEPEQUAL: {
+            if (event.GetTag(mTargetLabel) != val) {
+                return false;
+            }
+            break;
+        }
+        case Action::REPLACE: {
+            StringView target, res;
+            string targetStr, resStr;
+            if (mIsRegexCaptureAll && mSimpleTargetLabel.mIsValid && mSimpleReplacement.mIsValid) {
+                target = mSimpleTargetLabel.Format(val, sTargetLabelBuffer);
+                res = mSimpleReplacement.Format(val, sReplacementBuffer);
+            } else {
+                if (!boost::regex_search(val.begin(), val.end(), mRegex)) {
+                    break;
+                }
+                string valStr = val.to_string();
+                targetStr = boost::regex_replace(valStr, mRegex, mTargetLabel, boost::format_first_only);
+                resStr = boost::regex_replace(valStr, mRegex, mReplacement, boost::format_first_only);
+                target = StringView(targetStr);
+                res = StringView(resStr);
+            }
+            if (res.empty()) {
+                event.DelTag(target);
+                break;
+            }
+            event.SetTag(target, res);
+            break;
+        }
+        case Action::LOWERCASE:
+        case Action::UPPERCASE: {
+            auto b = event.GetSourceBuffer()->AllocateStringBuffer(val.size());
+            for (size_t i = 0; i < val.size(); ++i) {
+                auto c = static_cast<unsigned char>(val[i]);
+                b.data[i] = static_cast<char>(mAction == Action::LOWERCASE ? tolower(c) : toupper(c));
+            }
+            b.size = val.size();
+            event.SetTagNoCopy(CopyToEvent(event, mTargetLabel), StringView(b.data, b.size));
+            break;
+        }
+        case Action::HASHMOD: {
+            event.SetTag(mTargetLabel, to_string(HashMod(val)));
+            break;
+        }
+        case Action::LABELMAP: {
+            // labels added here are not mapped again
+            size_t size = event.TagsSize();
+            for (size_t i = 0; i < size; ++i) {
+                auto [key, value] = *(event.TagsBegin() + i);
+                if (Match(key)) {
+                    string res = boost::regex_replace(
+                        key.to_string(), mRegex, mReplacement, boost::match_default | boost::format_all);
+                    event.SetTagNoCopy(CopyToEvent(event, res), value);
+                }
+            }
+            break;
+        }
+        case Action::LABELDROP:
+        case Action::LABELKEEP: {
+            sLabelsToDel.clear();
+            for (auto it = event.TagsBegin(); it != event.TagsEnd(); ++it) {
+                if (Match(it->first) == (mAction == Action::LABELDROP)) {
+                    sLabelsToDel.push_back(it->first);
+                }
+            }
+            for (const auto& key : sLabelsToDel) {
+                event.DelTag(key);
+            }
+            break;
+        }
+        case Action::DROPMETRIC: {
+            if (mMatchList.find(std::string_view(val.data(), val.size())) != mMatchList.end()) {
+                return false;
+            }
+            break;
+        }
+        default:
+            // error
+            LOG_ERROR(sLogger, ("relabel: unknown relabel action type", ActionToString(mAction)));
+            break;
+    }
+    return true;
+}
+
 bool RelabelConfigList::Init(const Json::Value& relabelConfigs) {
     if (!relabelConfigs.isArray()) {
         return false;
@@ -276,10 +545,18 @@ bool RelabelConfigList::Process(Labels& l) const {
     return true;
 }
 
-bool RelabelConfigList::Process(MetricEvent& event) const {
-    Labels labels;
-    labels.Reset(&event);
-    return Process(labels);
+bool RelabelConfigList::Process(MetricEvent& event, vector<RelabelMatchCache>* matchCaches) const {
+    // __name__ refers to the metric name, which is removed with other meta labels after relabeling
+    event.SetTagNoCopy(StringView(prometheus::NAME), event.GetName());
+    if (matchCaches != nullptr) {
+        matchCaches->resize(mRelabelConfigs.size());
+    }
+    for (size_t i = 0; i < mRelabelConfigs.size(); ++i) {
+        if (!mRelabelConfigs[i].Process(event, matchCaches == nullptr ? nullptr : &(*matchCaches)[i])) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool RelabelConfigList::Empty() const {
@@ -18,8 +18,14 @@
 #include <json/json.h>
 
 #include <boost/regex.hpp>
+#include <functional>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "common/StringView.h"
+#include "models/MetricEvent.h"
 #include "prometheus/labels/Labels.h"
 
 namespace logtail {
@@ -43,11 +49,18 @@ enum class Action {
 const std::string& ActionToString(Action action);
 Action StringToAction(const std::string& action);
 
+// regex match results of one relabel config, keyed by the source value, which must outlive the cache
+using RelabelMatchCache = std::unordered_map<StringView, bool, StringViewHash, StringViewEqual>;
+
 class RelabelConfig {
 public:
     RelabelConfig();
     bool Init(const Json::Value&);
     bool Process(Labels&) const;
+    // Same as Process(Labels&), but reads and writes the tags of the event in place. Strings written to the event are
+    // allocated from its source buffer. matchCache is only used when there is exactly one source label, since the
+    // source value then points to the source buffer of the event and can be used as the key.
+    bool Process(MetricEvent&, RelabelMatchCache* matchCache = nullptr) const;
 
     // A list of labels from which values are taken and concatenated
     // with the configured separator in order.
@@ -58,6 +71,9 @@ public:
     boost::regex mRegex;
     // Modulus to take of the hash of concatenated values from the source labels.
     uint64_t mModulus = 0;
+    // Hash hashmod with xxhash instead of md5. md5 is the default, so that existing hashmod assignments stay the same,
+    // and all shards using the same modulus should switch together.
+    bool mHashModUseXXHash = false;
     // TargetLabel is the label to which the resulting string is written in a replacement.
     // Regexp interpolation is allowed for the replace action.
     std::string mTargetLabel;
@@ -66,15 +82,49 @@ public:
     // Action is the action to be performed for the relabeling.
     Action mAction;
 
-    std::set<std::string> mMatchList;
+    std::set<std::string, std::less<>> mMatchList;
 
 private:
+    enum class RegexType {
+        GENERAL,
+        // (.*) or .*
+        MATCH_ALL,
+        // no meta characters, so that matching is the same as comparing
+        LITERAL
+    };
+
+    // A format string which only refers to the whole matched value, i.e. $0, $1, ${1} and $& when the regex is
+    // (.*), so that it can be formatted without boost.
+    struct SimpleFormat {
+        bool mIsValid = false;
+        // literals and the whole value in order, an empty optional piece stands for the whole value
+        std::vector<std::pair<bool, std::string>> mPieces;
+
+        bool Init(const std::string& format);
+        StringView Format(StringView value, std::string& buffer) const;
+    };
+
+    void CompileRegex(const std::string& re);
+    uint64_t HashMod(StringView value) const;
+    bool Match(StringView value) const;
+    bool Match(StringView value, RelabelMatchCache* matchCache) const;
+
+    std::string mRegexStr;
+    RegexType mRegexType = RegexType::MATCH_ALL;
+    bool mIsRegexCaptureAll = true;
+    SimpleFormat mSimpleTargetLabel;
+    SimpleFormat mSimpleReplacement;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class RelabelConfigUnittest;
+#endif
 };
 
 class RelabelConfigList {
 public:
     bool Init(const Json::Value& relabelConfigs);
-    bool Process(MetricEvent&) const;
+    // matchCaches holds one cache for each relabel config, which can be shared by events of the same group
+    bool Process(MetricEvent&, std::vector<RelabelMatchCache>* matchCaches = nullptr) const;
     bool Process(Labels&) const;
 
     [[nodiscard]] bool Empty() const;
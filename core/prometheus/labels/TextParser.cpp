@@ -17,9 +17,11 @@
 #include "prometheus/labels/TextParser.h"
 
 #include <cmath>
+#include <cstring>
 
 #include <string>
 
+#include "common/SimdUtil.h"
 #include "common/StringTools.h"
 #include "common/StringView.h"
 #include "logger/Logger.h"
@@ -31,13 +33,90 @@ using namespace std;
 
 namespace logtail {
 
-bool IsValidNumberChar(char c) {
-    static const unordered_set<char> sValidChars
-        = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '.', '-', '+', 'e', 'E', 'I',
-           'N', 'F', 'T', 'Y', 'i', 'n', 'f', 't', 'y', 'X', 'x', 'N', 'n', 'A', 'a'};
-    return sValidChars.count(c);
+namespace {
+
+struct NumberCharTable {
+    bool mValid[256] = {};
+    constexpr NumberCharTable() {
+        for (unsigned char c : "0123456789.-+eEINFTYinftyXxAa") {
+            mValid[c] = true;
+        }
+        mValid[0] = false;
+    }
 };
 
+constexpr NumberCharTable kNumberCharTable;
+
+constexpr double kExactPowersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Parse plain decimals like "-12.5e+3" whose digits fit into the 53-bit mantissa and whose decimal exponent is within
+// [-22, 22]. Both the mantissa and the power of 10 are then exact doubles, so one multiplication or division gives the
+// correctly rounded result, the same as strtod. Return false for everything else, e.g. Inf, NaN, hex or long digits.
+bool ParseSimpleDouble(const char* first, const char* last, double& val) {
+    const char* p = first;
+    bool negative = false;
+    if (p < last && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    uint64_t mantissa = 0;
+    int digitCnt = 0;
+    int exponent = 0;
+    for (; p < last && static_cast<unsigned char>(*p - '0') < 10; ++p, ++digitCnt) {
+        mantissa = mantissa * 10 + (*p - '0');
+    }
+    if (p < last && *p == '.') {
+        ++p;
+        for (; p < last && static_cast<unsigned char>(*p - '0') < 10; ++p, ++digitCnt, --exponent) {
+            mantissa = mantissa * 10 + (*p - '0');
+        }
+    }
+    // more than 19 digits may overflow the mantissa
+    if (digitCnt == 0 || digitCnt > 19) {
+        return false;
+    }
+    if (p < last && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < last && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        int exp = 0;
+        const char* expFirst = p;
+        for (; p < last && static_cast<unsigned char>(*p - '0') < 10 && p - expFirst < 4; ++p) {
+            exp = exp * 10 + (*p - '0');
+        }
+        if (p == expFirst) {
+            return false;
+        }
+        exponent += negativeExponent ? -exp : exp;
+    }
+    if (p != last || mantissa > (1ULL << 53) || exponent < -22 || exponent > 22) {
+        return false;
+    }
+    double res = static_cast<double>(mantissa);
+    res = exponent < 0 ? res / kExactPowersOf10[-exponent] : res * kExactPowersOf10[exponent];
+    val = negative ? -res : res;
+    return true;
+}
+
+bool ParseDouble(StringView str, double& val, std::string& buffer) {
+    if (ParseSimpleDouble(str.data(), str.data() + str.size(), val)) {
+        return true;
+    }
+    // strtod needs a null-terminated string
+    buffer.assign(str.data(), str.size());
+    return StringTo(buffer, val);
+}
+
+} // namespace
+
+bool IsValidNumberChar(char c) {
+    return kNumberCharTable.mValid[static_cast<unsigned char>(c)];
+}
+
 TextParser::TextParser(bool honorTimestamps) : mHonorTimestamps(honorTimestamps) {
 }
 
@@ -49,11 +128,10 @@ void TextParser::SetDefaultTimestamp(uint64_t defaultTimestamp, uint32_t default
 PipelineEventGroup TextParser::Parse(const string& content, uint64_t defaultTimestamp, uint32_t defaultNanoSec) {
     SetDefaultTimestamp(defaultTimestamp, defaultNanoSec);
     auto eGroup = PipelineEventGroup(make_shared<SourceBuffer>());
-    vector<StringView> lines;
-    // pre-reserve vector size by 1024 which is experience value per line
-    lines.reserve(content.size() / 1024);
-    SplitStringView(content, '\n', lines);
-    for (const auto& line : lines) {
+    const char* end = content.data() + content.size();
+    for (const char* begin = content.data(), *lineEnd = begin; lineEnd != end; begin = lineEnd + 1) {
+        lineEnd = FindChar(begin, end, '\n');
+        StringView line(begin, lineEnd - begin);
         if (!IsValidMetric(line)) {
             continue;
         }
@@ -158,59 +236,21 @@ void TextParser::HandleEqualSign(MetricEvent& metricEvent) {
 // parse:v1", k2="v2" } 9.9410452992e+10 1715829785083 # exemplarsxxx
 void TextParser::HandleLabelValue(MetricEvent& metricEvent) {
     // left quote has been consumed
-    // LableValue supports escape char
-    bool escaped = false;
-    auto lPos = mPos;
-    while (mPos < mLine.size() && mLine[mPos] != '"') {
-        if (mLine[mPos] != '\\') {
-            if (escaped) {
-                mEscapedLabelValue.push_back(mLine[mPos]);
-            }
-            ++mPos;
-            ++mTokenLength;
-        } else {
-            if (escaped == false) {
-                // first meet escape char
-                escaped = true;
-                mEscapedLabelValue = mLine.substr(lPos, mPos - lPos).to_string();
-            }
-            if (mPos + 1 < mLine.size()) {
-                // check next char, if it is valid escape char, we can consume two chars and push one escaped char
-                // if not, we need to push the two chars
-                // valid escape char: \", \\, \n
-                switch (mLine[lPos + 1]) {
-                    case '\\':
-                    case '\"':
-                        mEscapedLabelValue.push_back(mLine[mPos + 1]);
-                        break;
-                    case 'n':
-                        mEscapedLabelValue.push_back('\n');
-                        break;
-                    default:
-                        mEscapedLabelValue.push_back('\\');
-                        mEscapedLabelValue.push_back(mLine[mPos + 1]);
-                        break;
-                }
-                mPos += 2;
-            } else {
-                mEscapedLabelValue.push_back(mLine[mPos + 1]);
-                ++mPos;
-            }
+    const char* begin = mLine.data() + mPos;
+    const char* end = mLine.data() + mLine.size();
+    const char* quote = FindChar(begin, end, '"');
+    if (memchr(begin, '\\', quote - begin) == nullptr) {
+        // most label values have no escape char, which can be referenced directly
+        if (quote == end) {
+            HandleError("unexpected end of input in label value");
+            return;
         }
-    }
-
-    if (mPos == mLine.size()) {
+        metricEvent.SetTagNoCopy(mLabelName, StringView(begin, quote - begin));
+        mPos = quote - mLine.data();
+    } else if (!HandleEscapedLabelValue(metricEvent)) {
         HandleError("unexpected end of input in label value");
         return;
     }
-
-    if (!escaped) {
-        metricEvent.SetTagNoCopy(mLabelName, mLine.substr(mPos - mTokenLength, mTokenLength));
-    } else {
-        metricEvent.SetTag(mLabelName.to_string(), mEscapedLabelValue);
-        mEscapedLabelValue.clear();
-    }
-    mTokenLength = 0;
     ++mPos;
     SkipLeadingWhitespace();
     if (mPos < mLine.size() && (mLine[mPos] == ',' || mLine[mPos] == '}')) {
@@ -220,6 +260,42 @@ void TextParser::HandleLabelValue(MetricEvent& metricEvent) {
     }
 }
 
+// LabelValue supports escape char: \", \\ and \n. Other backslashes are kept as they are, which is a real-world case.
+// The unescaped value is written to the source buffer of the event directly.
+bool TextParser::HandleEscapedLabelValue(MetricEvent& metricEvent) {
+    size_t rPos = mPos;
+    while (rPos < mLine.size() && mLine[rPos] != '"') {
+        rPos += mLine[rPos] == '\\' ? 2 : 1;
+    }
+    if (rPos >= mLine.size()) {
+        return false;
+    }
+    // the unescaped value is never longer than the raw one
+    StringBuffer value = metricEvent.GetSourceBuffer()->AllocateStringBuffer(rPos - mPos);
+    for (; mPos < rPos; ++mPos) {
+        char c = mLine[mPos];
+        if (c == '\\') {
+            switch (mLine[++mPos]) {
+                case '\\':
+                case '"':
+                    c = mLine[mPos];
+                    break;
+                case 'n':
+                    c = '\n';
+                    break;
+                default:
+                    value.data[value.size++] = '\\';
+                    c = mLine[mPos];
+                    break;
+            }
+        }
+        value.data[value.size++] = c;
+    }
+    value.data[value.size] = '\0';
+    metricEvent.SetTagNoCopy(mLabelName, StringView(value.data, value.size));
+    return true;
+}
+
 // parse:, k2="v2" } 9.9410452992e+10 1715829785083 # exemplarsxxx
 // or parse:} 9.9410452992e+10 1715829785083 # exemplarsxxx
 void TextParser::HandleCommaOrCloseBrace(MetricEvent& metricEvent) {
@@ -250,14 +326,11 @@ void TextParser::HandleSampleValue(MetricEvent& metricEvent) {
     }
 
     auto tmpSampleValue = mLine.substr(mPos - mTokenLength, mTokenLength);
-    mDoubleStr = tmpSampleValue.to_string();
-
-    if (!StringTo(mDoubleStr, mSampleValue)) {
+    if (!ParseDouble(tmpSampleValue, mSampleValue, mDoubleStr)) {
         HandleError("invalid sample value");
         mTokenLength = 0;
         return;
     }
-    mDoubleStr.clear();
 
     metricEvent.SetValue<UntypedSingleValue>(mSampleValue);
     mTokenLength = 0;
@@ -288,14 +361,12 @@ void TextParser::HandleTimestamp(MetricEvent& metricEvent) {
         mState = TextState::Done;
         return;
     }
-    mDoubleStr = tmpTimestamp.to_string();
     double milliTimestamp = 0;
-    if (!StringTo(mDoubleStr, milliTimestamp)) {
+    if (!ParseDouble(tmpTimestamp, milliTimestamp, mDoubleStr)) {
         HandleError("invalid timestamp");
         mTokenLength = 0;
         return;
     }
-    mDoubleStr.clear();
 
     if (milliTimestamp > 1ULL << 63) {
         HandleError("timestamp overflow");
@@ -45,6 +45,7 @@ private:
     void HandleLabelName(MetricEvent& metricEvent);
     void HandleEqualSign(MetricEvent& metricEvent);
     void HandleLabelValue(MetricEvent& metricEvent);
+    bool HandleEscapedLabelValue(MetricEvent& metricEvent);
     void HandleCommaOrCloseBrace(MetricEvent& metricEvent);
     void HandleSampleValue(MetricEvent& metricEvent);
     void HandleTimestamp(MetricEvent& metricEvent);
@@ -57,9 +58,9 @@ private:
     std::size_t mPos{0};
 
     StringView mLabelName;
-    std::string mEscapedLabelValue;
     double mSampleValue{0.0};
     std::size_t mTokenLength{0};
+    // only used when the number cannot be parsed in place
     std::string mDoubleStr;
 
     bool mHonorTimestamps{true};
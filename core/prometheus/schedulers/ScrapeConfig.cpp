@@ -29,7 +29,9 @@ ScrapeConfig::ScrapeConfig()
       mEnableTLS(false),
       mMaxScrapeSizeBytes(0),
       mSampleLimit(0),
-      mSeriesLimit(0) {
+      mSeriesLimit(0),
+      mEnableStaleMarkers(false),
+      mUnchangedSampleHeartbeatSeconds(0) {
 }
 
 bool ScrapeConfig::Init(const Json::Value& scrapeConfig) {
@@ -194,6 +196,20 @@ bool ScrapeConfig::InitStaticConfig(const Json::Value& scrapeConfig) {
         }
     }
 
+    if (scrapeConfig.isMember(prometheus::ENABLE_STALE_MARKERS)
+        && scrapeConfig[prometheus::ENABLE_STALE_MARKERS].isBool()) {
+        mEnableStaleMarkers = scrapeConfig[prometheus::ENABLE_STALE_MARKERS].asBool();
+    }
+    if (scrapeConfig.isMember(prometheus::UNCHANGED_SAMPLE_HEARTBEAT)
+        && scrapeConfig[prometheus::UNCHANGED_SAMPLE_HEARTBEAT].isString()) {
+        string tmpHeartbeatString = scrapeConfig[prometheus::UNCHANGED_SAMPLE_HEARTBEAT].asString();
+        mUnchangedSampleHeartbeatSeconds = DurationToSecond(tmpHeartbeatString);
+        if (mUnchangedSampleHeartbeatSeconds == 0) {
+            LOG_ERROR(sLogger, ("unchanged sample heartbeat is invalid", tmpHeartbeatString));
+            return false;
+        }
+    }
+
     if (scrapeConfig.isMember(prometheus::HOST_ONLY_MODE) && scrapeConfig[prometheus::HOST_ONLY_MODE].isBool()) {
         mHostOnlyMode = scrapeConfig[prometheus::HOST_ONLY_MODE].asBool();
     }
@@ -56,6 +56,11 @@ public:
     std::string mQueryString;
 
     std::vector<std::pair<std::string, std::string>> mExternalLabels;
+
+    // emit stale markers for series vanished from the target
+    bool mEnableStaleMarkers;
+    // drop samples whose values are unchanged since the last sent one of the series within the heartbeat, 0 to disable
+    uint64_t mUnchangedSampleHeartbeatSeconds;
     std::chrono::system_clock::time_point mLastUpdateTime;
 
     ScrapeConfig();
@@ -34,6 +34,7 @@
 #include "prometheus/Utils.h"
 #include "prometheus/async/PromFuture.h"
 #include "prometheus/async/PromHttpRequest.h"
+#include "prometheus/component/ScrapeLimiter.h"
 #include "prometheus/component/StreamScraper.h"
 
 using namespace std;
@@ -127,6 +128,8 @@ void ScrapeScheduler::ScheduleNext() {
     auto future = std::make_shared<PromFuture<HttpResponse&, uint64_t>>();
     auto isContextValidFuture = std::make_shared<PromFuture<>>();
     future->AddDoneCallback([this](HttpResponse& response, uint64_t timestampMilliSec) {
+        this->ReleaseScrape(response.GetNetworkStatus().mCode == NetworkCode::Ok
+                            && response.GetStatusCode() == 200);
         if (response.GetStatusCode() == 401) {
             auto duration
                 = chrono::duration_cast<chrono::seconds>(mLatestScrapeTime - mScrapeConfigPtr->mLastUpdateTime).count();
@@ -143,7 +146,11 @@ void ScrapeScheduler::ScheduleNext() {
     });
     isContextValidFuture->AddDoneCallback([this]() -> bool {
         if (ProcessQueueManager::GetInstance()->IsValidToPush(mQueueKey)) {
-            return true;
+            if (this->TryAcquireScrape()) {
+                return true;
+            }
+        } else {
+            prom::ScrapeLimiter::GetInstance()->OnBackpressure();
         }
         this->DelayExecTime(1);
         this->mExecDelayCount++;
@@ -210,7 +217,26 @@ std::unique_ptr<TimerEvent> ScrapeScheduler::BuildScrapeTimerEvent(std::chrono::
     return timerEvent;
 }
 
+bool ScrapeScheduler::TryAcquireScrape() {
+    // the skew is measured against the spread schedule, so that delays by backpressure and throttling are included
+    auto scheduledExecTime = mFirstExecTime + chrono::seconds(mExecCount * mInterval);
+    auto skew = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - scheduledExecTime).count();
+    if (!prom::ScrapeLimiter::GetInstance()->TryAcquire(skew > 0 ? skew : 0)) {
+        return false;
+    }
+    mScrapeInFlight = true;
+    return true;
+}
+
+void ScrapeScheduler::ReleaseScrape(bool success) {
+    if (mScrapeInFlight.exchange(false)) {
+        prom::ScrapeLimiter::GetInstance()->Release(success);
+    }
+}
+
 void ScrapeScheduler::Cancel() {
+    // the result of a cancelled scrape is never delivered, so its slot is given back here
+    ReleaseScrape(false);
     if (mFuture != nullptr) {
         mFuture->Cancel();
     }
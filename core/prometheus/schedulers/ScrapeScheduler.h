@@ -72,9 +72,13 @@ public:
 
 private:
     std::unique_ptr<TimerEvent> BuildScrapeTimerEvent(std::chrono::steady_clock::time_point execTime);
+    bool TryAcquireScrape();
+    void ReleaseScrape(bool success);
 
     std::shared_ptr<ScrapeConfig> mScrapeConfigPtr;
     std::atomic_int mExecDelayCount = 0;
+    // whether this target holds a slot of the global scrape limiter
+    std::atomic_bool mScrapeInFlight = false;
     std::string mHost;
     int32_t mPort;
     PromTargetInfo mTargetInfo;
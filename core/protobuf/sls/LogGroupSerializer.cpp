@@ -98,11 +98,42 @@ static inline void fixed32_pack(uint32_t value, string& output) {
 }
 
 void LogGroupSerializer::Prepare(size_t size) {
+    mWriter = nullptr;
     mRes.clear();
     mRes.reserve(size);
 }
 
+void LogGroupSerializer::PrepareStreaming(const ChunkWriter& writer, size_t chunkSize) {
+    mWriter = &writer;
+    mChunkSize = chunkSize;
+    mWriterFailed = false;
+    // a large log may have enlarged the buffer last time
+    if (mRes.capacity() > chunkSize * 4) {
+        string().swap(mRes);
+    }
+    mRes.clear();
+    mRes.reserve(chunkSize * 2);
+}
+
+bool LogGroupSerializer::Finish() {
+    if (mWriter != nullptr) {
+        Flush();
+        mWriter = nullptr;
+    }
+    return !mWriterFailed;
+}
+
+void LogGroupSerializer::Flush() {
+    if (!mRes.empty() && !mWriterFailed) {
+        mWriterFailed = !(*mWriter)(mRes.data(), mRes.size());
+    }
+    mRes.clear();
+}
+
 void LogGroupSerializer::StartToAddLog(size_t size) {
+    if (mWriter != nullptr && mRes.size() >= mChunkSize) {
+        Flush();
+    }
     // field = 1, wire_type = 2
     mRes.push_back(0x0A);
     uint32_pack(size, mRes);
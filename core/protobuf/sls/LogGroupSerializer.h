@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <functional>
 #include <string>
 
 #include "common/StringView.h"
@@ -36,7 +37,14 @@ extern const std::string METRIC_LABELS_KEY_VALUE_SEPARATOR;
 // see for detail: https://protobuf.dev/programming-guides/encoding/
 class LogGroupSerializer {
 public:
+    using ChunkWriter = std::function<bool(const char* data, size_t size)>;
+
     void Prepare(size_t size);
+    // In streaming mode, the serialized data is handed to @writer and cleared once it reaches @chunkSize at the
+    // beginning of a log, so that only about one chunk is buffered. Finish must be called to hand over the rest.
+    void PrepareStreaming(const ChunkWriter& writer, size_t chunkSize);
+    // returns false if the writer fails
+    bool Finish();
     void StartToAddLog(size_t size);
     void AddLogTime(uint32_t logTime);
     void AddLogContent(StringView key, StringView value);
@@ -52,8 +60,12 @@ public:
 
 private:
     void AddString(StringView value);
+    void Flush();
 
     std::string mRes;
+    const ChunkWriter* mWriter = nullptr;
+    size_t mChunkSize = 0;
+    bool mWriterFailed = false;
 };
 
 size_t GetLogContentSize(size_t keySZ, size_t valueSZ);
@@ -31,6 +31,10 @@
 #include "runner/sink/http/HttpSink.h"
 
 DEFINE_FLAG_INT32(flusher_runner_exit_timeout_sec, "", 60);
+DEFINE_FLAG_INT32(flusher_runner_dispatch_thread_count,
+                  "number of threads to build and send requests, 0 means requests are dispatched by flusher runner "
+                  "thread",
+                  0);
 
 DECLARE_FLAG_INT32(discard_send_fail_interval);
 
@@ -58,6 +62,7 @@ bool FlusherRunner::Init() {
     mWaitingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 
+    StartDispatchers();
     mThreadRes = async(launch::async, &FlusherRunner::Run, this);
     mLastCheckSendClientTime = time(nullptr);
     mIsFlush = false;
@@ -109,26 +114,71 @@ void FlusherRunner::Stop() {
     }
 }
 
+void FlusherRunner::StartDispatchers() {
+    if (!mDispatchers.empty() || INT32_FLAG(flusher_runner_dispatch_thread_count) <= 0) {
+        return;
+    }
+    mIsDispatcherStopped = false;
+    for (int32_t i = 0; i < INT32_FLAG(flusher_runner_dispatch_thread_count); ++i) {
+        mDispatchers.emplace_back(make_unique<Dispatcher>());
+    }
+    for (uint32_t i = 0; i < mDispatchers.size(); ++i) {
+        mDispatchers[i]->mThreadRes = async(launch::async, &FlusherRunner::RunDispatcher, this, i);
+    }
+    LOG_INFO(sLogger, ("flusher runner dispatchers", "started")("thread count", mDispatchers.size()));
+}
+
+void FlusherRunner::StopDispatchers() {
+    if (mDispatchers.empty()) {
+        return;
+    }
+    mIsDispatcherStopped = true;
+    for (auto& dispatcher : mDispatchers) {
+        {
+            lock_guard<mutex> lock(dispatcher->mMux);
+        }
+        dispatcher->mCV.notify_all();
+    }
+    for (auto& dispatcher : mDispatchers) {
+        if (dispatcher->mThreadRes.valid()) {
+            dispatcher->mThreadRes.get();
+        }
+    }
+    mDispatchers.clear();
+    LOG_INFO(sLogger, ("flusher runner dispatchers", "stopped"));
+}
+
 void FlusherRunner::DecreaseHttpSendingCnt() {
-    --mHttpSendingCnt;
+    {
+        lock_guard<mutex> lock(mHttpSendingCntMux);
+        --mHttpSendingCnt;
+    }
+    mHttpSendingCntCV.notify_one();
     SenderQueueManager::GetInstance()->Trigger();
 }
 
 bool FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
-    // TODO: use semaphore instead
-    while (withLimit && !Application::GetInstance()->IsExiting()
-           && GetSendingBufferCount() >= AppConfig::GetInstance()->GetSendRequestGlobalConcurrency()) {
-        this_thread::sleep_for(chrono::milliseconds(10));
+    {
+        // the sending slot is taken before building the request, so that concurrent dispatchers cannot exceed the limit
+        unique_lock<mutex> lock(mHttpSendingCntMux);
+        if (withLimit) {
+            // wake up periodically, since exiting and concurrency change are not notified
+            while (!Application::GetInstance()->IsExiting()
+                   && GetSendingBufferCount() >= AppConfig::GetInstance()->GetSendRequestGlobalConcurrency()) {
+                mHttpSendingCntCV.wait_for(lock, chrono::milliseconds(500));
+            }
+        }
+        ++mHttpSendingCnt;
     }
 
     unique_ptr<HttpSinkRequest> req;
     bool keepItem = false;
     string errMsg;
     if (!static_cast<HttpFlusher*>(item->mFlusher)->BuildRequest(item, req, &keepItem, &errMsg)) {
+        DecreaseHttpSendingCnt();
         if (keepItem
             && chrono::duration_cast<chrono::seconds>(chrono::system_clock::now() - item->mFirstEnqueTime).count()
                 < INT32_FLAG(discard_send_fail_interval)) {
-            item->mStatus = SendingStatus::IDLE;
             ++item->mTryCnt;
             // 计算指数回退延迟：初始100ms，最大10秒，每次重试延迟翻倍
             // 第一次失败(mTryCnt=2)：延迟100ms；第二次失败(mTryCnt=3)：延迟200ms；以此类推
@@ -144,6 +194,8 @@ bool FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
                           "config-flusher-dst", QueueKeyManager::GetInstance()->GetName(item->mQueueKey))(
                           "errMsg", errMsg)("tryCnt", item->mTryCnt)("backoffMs", backoffMs));
             SenderQueueManager::GetInstance()->DecreaseConcurrencyLimiterInSendingCnt(item->mQueueKey);
+            // the item may be picked up by another dispatcher once it is idle, so the status is published last
+            item->mStatus = SendingStatus::IDLE;
         } else {
             LOG_WARNING(
                 sLogger,
@@ -159,9 +211,8 @@ bool FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
     LOG_TRACE(sLogger,
               ("send item to http sink, item address", item)("config-flusher-dst",
                                                              QueueKeyManager::GetInstance()->GetName(item->mQueueKey))(
-                  "sending cnt", ToString(mHttpSendingCnt.load() + 1)));
+                  "sending cnt", ToString(mHttpSendingCnt.load())));
     HttpSink::GetInstance()->AddRequest(std::move(req));
-    ++mHttpSendingCnt;
     return true;
 }
 
@@ -185,10 +236,8 @@ void FlusherRunner::Run() {
         }
 
         for (auto itr = items.begin(); itr != items.end(); ++itr) {
-            auto rawSize = (*itr)->mRawSize;
-            auto dataSize = (*itr)->mData.size();
-            ADD_COUNTER(mInItemDataSizeBytes, dataSize);
-            ADD_COUNTER(mInItemRawDataSizeBytes, rawSize);
+            ADD_COUNTER(mInItemDataSizeBytes, (*itr)->mData.size());
+            ADD_COUNTER(mInItemRawDataSizeBytes, (*itr)->mRawSize);
             LOG_TRACE(
                 sLogger,
                 ("got item from sender queue, item address",
@@ -197,23 +246,60 @@ void FlusherRunner::Run() {
                     ToString(chrono::duration_cast<chrono::milliseconds>(curTime - (*itr)->mFirstEnqueTime).count())
                         + "ms")("try cnt", ToString((*itr)->mTryCnt)));
 
-            if (Dispatch(*itr)) {
-                // TODO: use rate limiter instead
-                if (!Application::GetInstance()->IsExiting() && mEnableRateLimiter) {
-                    RateLimiter::FlowControl(rawSize, mSendLastTime, mSendLastByte, true);
+            if (mDispatchers.empty()) {
+                HandleItem(*itr, curTime);
+            } else {
+                auto& dispatcher = mDispatchers[(*itr)->mQueueKey % mDispatchers.size()];
+                {
+                    lock_guard<mutex> lock(dispatcher->mMux);
+                    dispatcher->mTasks.emplace_back(*itr, curTime);
                 }
-                ADD_COUNTER(mOutItemsTotal, 1);
-                ADD_COUNTER(mOutItemDataSizeBytes, dataSize);
-                ADD_COUNTER(mOutItemRawDataSizeBytes, rawSize);
+                dispatcher->mCV.notify_one();
             }
-            SUB_GAUGE(mWaitingItemsTotal, 1);
-            ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - curTime);
         }
 
         if (mIsFlush && SenderQueueManager::GetInstance()->IsAllQueueEmpty()) {
             break;
         }
     }
+    StopDispatchers();
+}
+
+void FlusherRunner::RunDispatcher(uint32_t dispatcherNo) {
+    LOG_INFO(sLogger, ("flusher runner dispatcher", "started")("thread no", dispatcherNo));
+    auto& dispatcher = mDispatchers[dispatcherNo];
+    while (true) {
+        unique_lock<mutex> lock(dispatcher->mMux);
+        dispatcher->mCV.wait(lock,
+                             [this, &dispatcher]() { return mIsDispatcherStopped || !dispatcher->mTasks.empty(); });
+        if (dispatcher->mTasks.empty()) {
+            break;
+        }
+        DispatchTask task = dispatcher->mTasks.front();
+        dispatcher->mTasks.pop_front();
+        lock.unlock();
+
+        HandleItem(task.mItem, task.mFetchTime);
+    }
+    LOG_INFO(sLogger, ("flusher runner dispatcher", "stopped")("thread no", dispatcherNo));
+}
+
+void FlusherRunner::HandleItem(SenderQueueItem* item, chrono::system_clock::time_point fetchTime) {
+    // item may be released once dispatched
+    auto rawSize = item->mRawSize;
+    auto dataSize = item->mData.size();
+    if (Dispatch(item)) {
+        // TODO: use rate limiter instead
+        if (!Application::GetInstance()->IsExiting() && mEnableRateLimiter) {
+            lock_guard<mutex> lock(mRateLimiterMux);
+            RateLimiter::FlowControl(rawSize, mSendLastTime, mSendLastByte, true);
+        }
+        ADD_COUNTER(mOutItemsTotal, 1);
+        ADD_COUNTER(mOutItemDataSizeBytes, dataSize);
+        ADD_COUNTER(mOutItemRawDataSizeBytes, rawSize);
+    }
+    SUB_GAUGE(mWaitingItemsTotal, 1);
+    ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - fetchTime);
 }
 
 bool FlusherRunner::Dispatch(SenderQueueItem* item) {
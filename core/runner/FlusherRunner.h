@@ -19,7 +19,13 @@
 #include <cstdint>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "collection_pipeline/plugin/interface/Flusher.h"
 #include "collection_pipeline/queue/SenderQueueItem.h"
@@ -49,10 +55,31 @@ public:
     int32_t GetSendingBufferCount() { return mHttpSendingCnt.load(); }
 
 private:
+    struct DispatchTask {
+        SenderQueueItem* mItem;
+        std::chrono::system_clock::time_point mFetchTime;
+
+        DispatchTask(SenderQueueItem* item, std::chrono::system_clock::time_point fetchTime)
+            : mItem(item), mFetchTime(fetchTime) {}
+    };
+
+    // Items from the same sender queue are always handled by the same dispatcher, so that the sending order within
+    // each queue is kept.
+    struct Dispatcher {
+        std::mutex mMux;
+        std::condition_variable mCV;
+        std::deque<DispatchTask> mTasks;
+        std::future<void> mThreadRes;
+    };
+
     FlusherRunner() = default;
     ~FlusherRunner() = default;
 
     void Run();
+    void RunDispatcher(uint32_t dispatcherNo);
+    void StartDispatchers();
+    void StopDispatchers();
+    void HandleItem(SenderQueueItem* item, std::chrono::system_clock::time_point fetchTime);
     bool Dispatch(SenderQueueItem* item);
     bool LoadModuleConfig(bool isInit);
     void UpdateSendFlowControl();
@@ -62,10 +89,17 @@ private:
     std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
 
+    std::vector<std::unique_ptr<Dispatcher>> mDispatchers;
+    std::atomic_bool mIsDispatcherStopped = false;
+
     std::atomic_int32_t mHttpSendingCnt{0};
+    // used to wake up threads waiting for sending concurrency
+    std::mutex mHttpSendingCntMux;
+    std::condition_variable mHttpSendingCntCV;
 
     // TODO: temporarily here
     int32_t mLastCheckSendClientTime = 0;
+    std::mutex mRateLimiterMux;
     int64_t mSendLastTime = 0;
     int32_t mSendLastByte = 0;
 
@@ -25,7 +25,6 @@
 #include "queue/ProcessQueueManager.h"
 #include "queue/QueueKeyManager.h"
 
-DEFINE_FLAG_INT32(default_flush_merged_buffer_interval, "default flush merged buffer, seconds", 1);
 DEFINE_FLAG_INT32(processor_runner_exit_timeout_sec, "", 60);
 
 DECLARE_FLAG_INT32(max_send_log_group_size);
@@ -50,6 +49,7 @@ void ProcessorRunner::Init() {
         mThreadRes[threadNo] = async(launch::async, &ProcessorRunner::Run, this, threadNo);
     }
     mIsFlush = false;
+    TimeoutFlushManager::GetInstance()->Init();
 }
 
 void ProcessorRunner::Stop() {
@@ -66,6 +66,8 @@ void ProcessorRunner::Stop() {
             LOG_WARNING(sLogger, ("processor runner", "forced to stopped")("threadNo", threadNo));
         }
     }
+    // remaining batches are flushed by CollectionPipelineManager::FlushAllBatch afterwards
+    TimeoutFlushManager::GetInstance()->Stop();
 }
 
 bool ProcessorRunner::PushQueue(QueueKey key, size_t inputIndex, PipelineEventGroup&& group, uint32_t retryTimes) {
@@ -102,14 +104,8 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     sLastRunTime = sMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(sMetricsRecordRef);
 
-    static int32_t lastFlushBatchTime = 0;
     while (true) {
         int32_t curTime = time(nullptr);
-        if (threadNo == 0 && curTime - lastFlushBatchTime >= INT32_FLAG(default_flush_merged_buffer_interval)) {
-            TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
-            lastFlushBatchTime = curTime;
-        }
-
         SET_GAUGE(sLastRunTime, curTime);
         unique_ptr<ProcessQueueItem> item;
         string configName;
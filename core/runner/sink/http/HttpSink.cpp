@@ -14,12 +14,22 @@
 
 #include "runner/sink/http/HttpSink.h"
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+
 #include <optional>
+#include <vector>
 
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/interface/HttpFlusher.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "collection_pipeline/queue/SenderQueueItem.h"
+#include "common/ErrorUtil.h"
 #include "common/Flags.h"
 #include "common/StringTools.h"
 #include "common/http/Curl.h"
@@ -31,6 +41,11 @@
 #endif
 
 DEFINE_FLAG_INT32(http_sink_exit_timeout_sec, "", 5);
+DEFINE_FLAG_BOOL(enable_http_sink_epoll,
+                 "drive http sink by epoll and curl_multi_socket_action instead of select, only valid on linux",
+                 false);
+
+DECLARE_FLAG_INT32(ilogtail_epoll_wait_events);
 
 using namespace std;
 
@@ -51,6 +66,11 @@ bool HttpSink::Init() {
         LOG_ERROR(sLogger, ("failed to init http sink", "failed to init curl multi client"));
         return false;
     }
+#ifdef __linux__
+    if (BOOL_FLAG(enable_http_sink_epoll) && !InitEpoll()) {
+        LOG_WARNING(sLogger, ("failed to init epoll for http sink", "use select instead"));
+    }
+#endif
 
     WriteMetrics::GetInstance()->CreateMetricsRecordRef(
         mMetricsRecordRef,
@@ -88,6 +108,19 @@ void HttpSink::Stop() {
     }
 }
 
+bool HttpSink::AddRequest(unique_ptr<HttpSinkRequest>&& request) {
+    mQueue.Push(std::move(request));
+#ifdef __linux__
+    if (mWakeUpFd >= 0) {
+        uint64_t val = 1;
+        if (write(mWakeUpFd, &val, sizeof(val)) < 0) {
+            // counter overflow is impossible, and the request will be found in next loop anyway
+        }
+    }
+#endif
+    return true;
+}
+
 void HttpSink::Run() {
     LOG_INFO(sLogger, ("http sink", "started"));
     while (true) {
@@ -112,8 +145,17 @@ void HttpSink::Run() {
         } else {
             continue;
         }
+#ifdef __linux__
+        if (mEpollFd >= 0) {
+            DoRunWithEpoll();
+            continue;
+        }
+#endif
         DoRun();
     }
+#ifdef __linux__
+    CleanupEpoll();
+#endif
     auto mc = curl_multi_cleanup(mClient);
     if (mc != CURLM_OK) {
         LOG_ERROR(sLogger, ("failed to cleanup curl multi handle", "exit anyway")("errMsg", curl_multi_strerror(mc)));
@@ -248,6 +290,152 @@ void HttpSink::DoRun() {
     }
 }
 
+#ifdef __linux__
+bool HttpSink::InitEpoll() {
+    mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (mEpollFd < 0) {
+        LOG_ERROR(sLogger, ("failed to create epoll fd", ErrnoToString(errno)));
+        return false;
+    }
+    mWakeUpFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (mWakeUpFd < 0) {
+        LOG_ERROR(sLogger, ("failed to create event fd", ErrnoToString(errno)));
+        CleanupEpoll();
+        return false;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = mWakeUpFd;
+    if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mWakeUpFd, &ev) != 0) {
+        LOG_ERROR(sLogger, ("failed to add event fd to epoll", ErrnoToString(errno)));
+        CleanupEpoll();
+        return false;
+    }
+    curl_multi_setopt(mClient, CURLMOPT_SOCKETFUNCTION, OnSocketUpdate);
+    curl_multi_setopt(mClient, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(mClient, CURLMOPT_TIMERFUNCTION, OnTimerUpdate);
+    curl_multi_setopt(mClient, CURLMOPT_TIMERDATA, this);
+    LOG_INFO(sLogger, ("http sink", "use epoll"));
+    return true;
+}
+
+void HttpSink::CleanupEpoll() {
+    if (mWakeUpFd >= 0) {
+        close(mWakeUpFd);
+        mWakeUpFd = -1;
+    }
+    if (mEpollFd >= 0) {
+        close(mEpollFd);
+        mEpollFd = -1;
+    }
+}
+
+int HttpSink::OnSocketUpdate(
+    [[maybe_unused]] CURL* handler, curl_socket_t sock, int what, void* userp, [[maybe_unused]] void* socketp) {
+    auto sink = static_cast<HttpSink*>(userp);
+    if (what == CURL_POLL_REMOVE) {
+        // the socket may have been closed already, in which case it is removed from epoll automatically
+        epoll_ctl(sink->mEpollFd, EPOLL_CTL_DEL, sock, nullptr);
+        return 0;
+    }
+    epoll_event ev{};
+    ev.data.fd = sock;
+    if (what & CURL_POLL_IN) {
+        ev.events |= EPOLLIN;
+    }
+    if (what & CURL_POLL_OUT) {
+        ev.events |= EPOLLOUT;
+    }
+    if (epoll_ctl(sink->mEpollFd, EPOLL_CTL_MOD, sock, &ev) != 0) {
+        if (errno != ENOENT || epoll_ctl(sink->mEpollFd, EPOLL_CTL_ADD, sock, &ev) != 0) {
+            LOG_ERROR(sLogger, ("failed to watch socket by epoll", ErrnoToString(errno))("socket", sock));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int HttpSink::OnTimerUpdate([[maybe_unused]] CURLM* client, long timeoutMs, void* userp) {
+    auto sink = static_cast<HttpSink*>(userp);
+    if (timeoutMs < 0) {
+        sink->mCurlTimeoutDeadline.reset();
+    } else {
+        sink->mCurlTimeoutDeadline = chrono::steady_clock::now() + chrono::milliseconds(timeoutMs);
+    }
+    return 0;
+}
+
+void HttpSink::DoRunWithEpoll() {
+    CURLMcode mc;
+    int runningHandlers = 1;
+    vector<epoll_event> events(INT32_FLAG(ilogtail_epoll_wait_events));
+    while (runningHandlers) {
+        auto curTime = chrono::system_clock::now();
+        SET_GAUGE(mLastRunTime, chrono::duration_cast<chrono::seconds>(curTime.time_since_epoch()).count());
+
+        unique_ptr<HttpSinkRequest> request;
+        while (mQueue.TryPop(request)) {
+            ADD_COUNTER(mInItemsTotal, 1);
+            LOG_TRACE(sLogger,
+                      ("got item from flusher runner, item address", request->mItem)(
+                          "config-flusher-dst", QueueKeyManager::GetInstance()->GetName(request->mItem->mQueueKey))(
+                          "wait time",
+                          ToString(chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now()
+                                                                               - request->mEnqueTime)
+                                       .count()))("try cnt", ToString(request->mTryCnt)));
+            if (AddRequestToClient(std::move(request))) {
+                ADD_GAUGE(mSendingItemsTotal, 1);
+            }
+        }
+
+        // wait at most 1s, so that last run time is updated in time
+        int waitMs = 1000;
+        if (mCurlTimeoutDeadline) {
+            auto leftMs = chrono::duration_cast<chrono::milliseconds>(*mCurlTimeoutDeadline - chrono::steady_clock::now())
+                              .count();
+            waitMs = static_cast<int>(max<int64_t>(0, min<int64_t>(leftMs, waitMs)));
+        }
+        int n = waitMs > 0 ? epoll_wait(mEpollFd, events.data(), events.size(), waitMs) : 0;
+        if (n < 0 && errno != EINTR) {
+            LOG_ERROR(sLogger, ("failed to call epoll_wait", "sleep 100ms and retry")("errMsg", ErrnoToString(errno)));
+            this_thread::sleep_for(chrono::milliseconds(100));
+        }
+        for (int i = 0; i < n; ++i) {
+            if (events[i].data.fd == mWakeUpFd) {
+                uint64_t val = 0;
+                while (read(mWakeUpFd, &val, sizeof(val)) > 0) {
+                }
+                continue;
+            }
+            int mask = 0;
+            if (events[i].events & EPOLLIN) {
+                mask |= CURL_CSELECT_IN;
+            }
+            if (events[i].events & EPOLLOUT) {
+                mask |= CURL_CSELECT_OUT;
+            }
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                mask |= CURL_CSELECT_ERR;
+            }
+            if ((mc = curl_multi_socket_action(mClient, events[i].data.fd, mask, &runningHandlers)) != CURLM_OK) {
+                LOG_ERROR(sLogger,
+                          ("failed to call curl_multi_socket_action", "retry later")("errMsg",
+                                                                                    curl_multi_strerror(mc)));
+            }
+        }
+        if (mCurlTimeoutDeadline && *mCurlTimeoutDeadline <= chrono::steady_clock::now()) {
+            mCurlTimeoutDeadline.reset();
+            if ((mc = curl_multi_socket_action(mClient, CURL_SOCKET_TIMEOUT, 0, &runningHandlers)) != CURLM_OK) {
+                LOG_ERROR(sLogger,
+                          ("failed to call curl_multi_socket_action", "retry later")("errMsg",
+                                                                                    curl_multi_strerror(mc)));
+            }
+        }
+        HandleCompletedRequests(runningHandlers);
+    }
+}
+#endif
+
 void HttpSink::HandleCompletedRequests(int& runningHandlers) {
     int msgsLeft = 0;
     CURLMsg* msg = curl_multi_info_read(mClient, &msgsLeft);
@@ -17,9 +17,11 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <future>
 #include <mutex>
+#include <optional>
 
 #include "curl/multi.h"
 
@@ -39,6 +41,8 @@ public:
     bool Init() override;
     void Stop() override;
 
+    bool AddRequest(std::unique_ptr<HttpSinkRequest>&& request);
+
 private:
     HttpSink() = default;
     ~HttpSink() = default;
@@ -48,6 +52,21 @@ private:
     void DoRun();
     void HandleCompletedRequests(int& runningHandlers);
 
+#ifdef __linux__
+    bool InitEpoll();
+    void CleanupEpoll();
+    void DoRunWithEpoll();
+    static int OnSocketUpdate(CURL* handler, curl_socket_t sock, int what, void* userp, void* socketp);
+    static int OnTimerUpdate(CURLM* client, long timeoutMs, void* userp);
+
+    // when enabled, sockets are watched by epoll and driven by curl_multi_socket_action, so that neither the number of
+    // sockets is limited by FD_SETSIZE nor all handles are scanned in each loop
+    int mEpollFd = -1;
+    // used to wake up epoll_wait when new requests arrive
+    int mWakeUpFd = -1;
+    std::optional<std::chrono::steady_clock::time_point> mCurlTimeoutDeadline;
+#endif
+
     CURLM* mClient = nullptr;
 
     std::future<void> mThreadRes;
@@ -66,6 +85,8 @@ private:
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class FlusherRunnerUnittest;
     friend class HttpSinkMock;
+    friend class HttpSinkBenchmark;
+    friend class HttpSinkUnittest;
 #endif
 };
 
@@ -0,0 +1,112 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "collection_pipeline/batch/Batcher.h"
+#include "common/TimeUtil.h"
+#include "unittest/plugin/PluginMock.h"
+
+DECLARE_FLAG_INT32(process_thread_count);
+
+using namespace std;
+
+namespace logtail {
+
+class BatcherBenchmark {
+public:
+    BatcherBenchmark() {
+        mCtx.SetConfigName("test_config");
+        mFlusher.SetContext(mCtx);
+        mFlusher.CreateMetricsRecordRef(FlusherMock::sName, "1");
+        mFlusher.CommitMetricsRecordRef();
+        mFlusher.SetPluginID("1");
+    }
+
+    // all processor threads feed the same flusher
+    void TestContention(bool enableShardedBatch);
+
+private:
+    static PipelineEventGroup CreateEventGroup(size_t tagIdx);
+
+    CollectionPipelineContext mCtx;
+    FlusherMock mFlusher;
+    static const size_t kThreadCnt = 16;
+    static const size_t kGroupCntPerThread = 100000;
+    // groups from a handful of sources, e.g. files of the same config
+    static const size_t kTagCnt = 8;
+};
+
+PipelineEventGroup BatcherBenchmark::CreateEventGroup(size_t tagIdx) {
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(string("__path__"), "/var/log/app-" + to_string(tagIdx) + ".log");
+    for (size_t i = 0; i < 10; ++i) {
+        auto* e = group.AddLogEvent();
+        e->SetContent(string("content"), string("request handled, method=GET, status=200"));
+        e->SetTimestamp(time(nullptr));
+    }
+    return group;
+}
+
+void BatcherBenchmark::TestContention(bool enableShardedBatch) {
+    INT32_FLAG(process_thread_count) = kThreadCnt;
+    DefaultFlushStrategyOptions strategy{5 * 1024 * 1024, 256 * 1024, 4000, 3};
+    Json::Value config;
+    config["EnableShardedBatch"] = enableShardedBatch;
+    Batcher<> batcher;
+    batcher.Init(config, &mFlusher, strategy);
+
+    vector<thread> threads;
+    vector<size_t> outCnts(kThreadCnt);
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (size_t t = 0; t < kThreadCnt; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < kGroupCntPerThread; ++i) {
+                vector<BatchedEventsList> res;
+                batcher.Add(CreateEventGroup((t + i) % kTagCnt), res);
+                outCnts[t] += res.size();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    vector<BatchedEventsList> res;
+    batcher.FlushAll(res);
+    size_t outCnt = res.size();
+    for (auto cnt : outCnts) {
+        outCnt += cnt;
+    }
+    printf("%s %s: %zu threads, %zu groups, %zu batches, costs %lums\n",
+           __func__,
+           enableShardedBatch ? "sharded" : "unsharded",
+           kThreadCnt,
+           kThreadCnt * kGroupCntPerThread,
+           outCnt,
+           timeelapsed);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::BatcherBenchmark benchmark;
+    benchmark.TestContention(false);
+    benchmark.TestContention(true);
+    return 0;
+}
@@ -12,11 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
 #include "collection_pipeline/batch/Batcher.h"
 #include "common/JsonUtil.h"
 #include "unittest/Unittest.h"
 #include "unittest/plugin/PluginMock.h"
 
+DECLARE_FLAG_INT32(process_thread_count);
+
 using namespace std;
 
 namespace logtail {
@@ -34,6 +38,7 @@ public:
     void TestFlushGroupQueue();
     void TestFlushAllWithoutGroupBatch();
     void TestFlushAllWithGroupBatch();
+    void TestShardedBatch();
     void TestMetric();
 
 protected:
@@ -164,7 +169,7 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     TimeoutRecord& record = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key));
-    time_t updateTime = record.mUpdateTime;
+    uint64_t updateTime = record.mUpdateTimeMs;
     APSARA_TEST_EQUAL(3U, record.mTimeoutSecs);
     APSARA_TEST_EQUAL(sFlusher.get(), record.mFlusher);
     APSARA_TEST_EQUAL(key, record.mKey);
@@ -187,7 +192,7 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[1].get());
     APSARA_TEST_EQUAL(eoo1, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 
     // flush by time then by size
@@ -209,7 +214,7 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo2, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
     APSARA_TEST_EQUAL(1U, res[1].size());
     APSARA_TEST_EQUAL(1U, res[1][0].mEvents.size());
@@ -219,7 +224,7 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(buffer3, res[1][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo3, res[1][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[1][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 }
 
@@ -245,7 +250,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     TimeoutRecord& record = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key));
-    time_t updateTime = record.mUpdateTime;
+    uint64_t updateTime = record.mUpdateTimeMs;
     APSARA_TEST_EQUAL(2U, record.mTimeoutSecs);
     APSARA_TEST_EQUAL(sFlusher.get(), record.mFlusher);
     APSARA_TEST_EQUAL(key, record.mKey);
@@ -268,7 +273,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[1].get());
     APSARA_TEST_EQUAL(eoo1, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 
     // flush by time to group batch
@@ -299,7 +304,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo2, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 
     // flush by time to group batch, and then group flush by size
@@ -321,7 +326,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer3, res[0][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo3, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
     APSARA_TEST_EQUAL(1U, res[0][1].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0][1].mTags.mInner.size());
@@ -330,7 +335,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer4, res[0][1].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo4, res[0][1].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][1].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 
     // flush by size
@@ -356,7 +361,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer7, res[0][0].mSourceBuffers[2].get());
     APSARA_TEST_EQUAL(eoo5, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 }
 
@@ -445,7 +450,7 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(2U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     TimeoutRecord& record = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, 0));
-    time_t updateTime = record.mUpdateTime;
+    uint64_t updateTime = record.mUpdateTimeMs;
     APSARA_TEST_EQUAL(1U, record.mTimeoutSecs);
     APSARA_TEST_EQUAL(sFlusher.get(), record.mFlusher);
     APSARA_TEST_EQUAL(0U, record.mKey);
@@ -599,6 +604,85 @@ void BatcherUnittest::TestFlushAllWithGroupBatch() {
     APSARA_TEST_STREQ("pack_id", res[1][0].mPackIdPrefix.data());
 }
 
+void BatcherUnittest::TestShardedBatch() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMinCnt = 3;
+    strategy.mMinSizeBytes = 1000;
+    strategy.mTimeoutSecs = 3;
+
+    Json::Value configJson;
+    configJson["EnableShardedBatch"] = true;
+    {
+        // no need to shard with only one processor thread
+        Batcher<> batch;
+        batch.Init(configJson, sFlusher.get(), strategy);
+        APSARA_TEST_FALSE(batch.IsSharded());
+    }
+
+    int32_t threadCnt = INT32_FLAG(process_thread_count);
+    INT32_FLAG(process_thread_count) = 4;
+    Batcher<> batch;
+    batch.Init(configJson, sFlusher.get(), strategy);
+    APSARA_TEST_TRUE(batch.IsSharded());
+    APSARA_TEST_EQUAL(4U, batch.mShards.size());
+
+    // groups with the same tags added by different threads are batched separately
+    PipelineEventGroup group1 = CreateEventGroup(2);
+    size_t key = group1.GetTagsHash();
+    SourceBuffer* buffer1 = group1.GetSourceBuffer().get();
+    vector<BatchedEventsList> res;
+    batch.Add(std::move(group1), res);
+    thread t([&]() {
+        vector<BatchedEventsList> tmp;
+        batch.Add(CreateEventGroup(2), tmp);
+    });
+    t.join();
+    APSARA_TEST_TRUE(res.empty());
+    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    size_t nonEmptyShardCnt = 0;
+    for (const auto& shard : batch.mShards) {
+        if (!shard->mEventQueueMap.empty()) {
+            ++nonEmptyShardCnt;
+        }
+    }
+    APSARA_TEST_EQUAL(2U, nonEmptyShardCnt);
+    APSARA_TEST_EQUAL(2U, batch.mEventBatchItemsTotal->GetValue());
+
+    // each shard has its own timeout record
+    auto& records = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"];
+    APSARA_TEST_EQUAL(2U, records.size());
+    size_t mainKey = Batcher<>::ToShardKey(key, Batcher<>::GetThreadShardSeq() % batch.mShards.size());
+    size_t otherKey = 0;
+    for (const auto& record : records) {
+        if (record.second.mKey != mainKey) {
+            otherKey = record.second.mKey;
+        }
+    }
+    APSARA_TEST_NOT_EQUAL(0U, otherKey);
+    APSARA_TEST_EQUAL(1U, records.count(make_pair(0, mainKey)));
+
+    // flushed independently
+    BatchedEventsList flushed;
+    batch.FlushQueue(otherKey, flushed);
+    APSARA_TEST_EQUAL(1U, flushed.size());
+    APSARA_TEST_EQUAL(2U, flushed[0].mEvents.size());
+    APSARA_TEST_STREQ("val", flushed[0].mTags.mInner["key"].data());
+    APSARA_TEST_NOT_EQUAL(buffer1, flushed[0].mSourceBuffers[0].get());
+    APSARA_TEST_EQUAL(1U, batch.mEventBatchItemsTotal->GetValue());
+
+    // the same thread always adds to the same shard, where the min count is reached now
+    batch.Add(CreateEventGroup(1), res);
+    APSARA_TEST_EQUAL(1U, res.size());
+    APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
+    APSARA_TEST_EQUAL(buffer1, res[0][0].mSourceBuffers[0].get());
+
+    vector<BatchedEventsList> all;
+    batch.FlushAll(all);
+    APSARA_TEST_TRUE(all.empty());
+    APSARA_TEST_EQUAL(0U, batch.mEventBatchItemsTotal->GetValue());
+    INT32_FLAG(process_thread_count) = threadCnt;
+}
+
 void BatcherUnittest::TestMetric() {
     {
         DefaultFlushStrategyOptions strategy;
@@ -680,6 +764,7 @@ UNIT_TEST_CASE(BatcherUnittest, TestFlushEventQueueWithGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushGroupQueue)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithoutGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithGroupBatch)
+UNIT_TEST_CASE(BatcherUnittest, TestShardedBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestMetric)
 
 } // namespace logtail
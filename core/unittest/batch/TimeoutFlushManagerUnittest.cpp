@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <thread>
+
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 #include "unittest/Unittest.h"
 #include "unittest/plugin/PluginMock.h"
@@ -25,6 +28,8 @@ public:
     void TestUpdateRecord();
     void TestFlushTimeoutBatch();
     void TestUnregisterFlushers();
+    void TestSubSecondTimeout();
+    void TestFlushThread();
 
 protected:
     static void SetUpTestCase() {
@@ -35,7 +40,10 @@ protected:
         sFlusher->CommitMetricsRecordRef();
     }
 
-    void TearDown() override { TimeoutFlushManager::GetInstance()->mTimeoutRecords.clear(); }
+    void TearDown() override {
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords.clear();
+        sFlusher->mFlushedQueues.clear();
+    }
 
 private:
     static unique_ptr<FlusherMock> sFlusher;
@@ -54,10 +62,10 @@ void TimeoutFlushManagerUnittest::TestUpdateRecord() {
     APSARA_TEST_EQUAL(1U, record1.mKey);
     APSARA_TEST_EQUAL(3U, record1.mTimeoutSecs);
     APSARA_TEST_EQUAL(sFlusher.get(), record1.mFlusher);
-    APSARA_TEST_GT(record1.mUpdateTime, 0);
+    APSARA_TEST_GT(record1.mUpdateTimeMs, 0U);
 
     // existed batch queue
-    time_t lastTime = record1.mUpdateTime;
+    uint64_t lastTime = record1.mUpdateTimeMs;
     TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3, sFlusher.get());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -65,7 +73,7 @@ void TimeoutFlushManagerUnittest::TestUpdateRecord() {
     APSARA_TEST_EQUAL(1U, record2.mKey);
     APSARA_TEST_EQUAL(3U, record2.mTimeoutSecs);
     APSARA_TEST_EQUAL(sFlusher.get(), record2.mFlusher);
-    APSARA_TEST_GT(record2.mUpdateTime, lastTime - 1);
+    APSARA_TEST_GT(record2.mUpdateTimeMs, lastTime - 1);
 }
 
 void TimeoutFlushManagerUnittest::TestFlushTimeoutBatch() {
@@ -98,9 +106,42 @@ void TimeoutFlushManagerUnittest::TestUnregisterFlushers() {
     APSARA_TEST_TRUE(TimeoutFlushManager::GetInstance()->mTimeoutRecords.empty());
 }
 
+void TimeoutFlushManagerUnittest::TestSubSecondTimeout() {
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 1, sFlusher.get());
+    this_thread::sleep_for(chrono::milliseconds(500));
+    TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
+    APSARA_TEST_TRUE(sFlusher->mFlushedQueues.empty());
+
+    // the deadline is postponed by 500ms
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 1, sFlusher.get());
+    this_thread::sleep_for(chrono::milliseconds(700));
+    TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
+    APSARA_TEST_TRUE(sFlusher->mFlushedQueues.empty());
+    APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
+
+    this_thread::sleep_for(chrono::milliseconds(600));
+    TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
+    APSARA_TEST_EQUAL(1U, sFlusher->mFlushedQueues.size());
+    APSARA_TEST_TRUE(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].empty());
+}
+
+void TimeoutFlushManagerUnittest::TestFlushThread() {
+    TimeoutFlushManager::GetInstance()->Init();
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 0, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 2, 3, sFlusher.get());
+    this_thread::sleep_for(chrono::milliseconds(500));
+    TimeoutFlushManager::GetInstance()->Stop();
+
+    APSARA_TEST_EQUAL(1U, sFlusher->mFlushedQueues.size());
+    APSARA_TEST_EQUAL(1U, sFlusher->mFlushedQueues[0]);
+    APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
+}
+
 UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestUpdateRecord)
 UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestFlushTimeoutBatch)
 UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestUnregisterFlushers)
+UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestSubSecondTimeout)
+UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestFlushThread)
 
 } // namespace logtail
 
@@ -0,0 +1,84 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include "boost/regex.hpp"
+
+#include "common/Re2Util.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class Re2UtilUnittest : public ::testing::Test {
+public:
+    void TestSameAsBoost();
+    void TestDifferentFromBoost();
+    void TestFallback();
+
+private:
+    static bool Re2Match(const string& regex, const string& str) {
+        re2::RE2 reg(GetBoostCompatibleRe2Pattern(regex), GetBoostCompatibleRe2Options());
+        return reg.ok() && re2::RE2::FullMatch(str, reg);
+    }
+    static bool BoostMatch(const string& regex, const string& str) {
+        return boost::regex_match(str, boost::regex(regex));
+    }
+};
+
+void Re2UtilUnittest::TestSameAsBoost() {
+    // regex, string
+    const vector<pair<string, string>> cases = {
+        // bytes instead of utf-8 characters are matched
+        {R"(.{2})", "\xc3\xa9"},
+        // '.' matches newline
+        {R"(a.b)", "a\nb"},
+        // ^ and $ match at line boundaries
+        {R"(a$\n^b)", "a\nb"},
+        {R"(\d+\s\w+)", "123 abc"},
+        {R"(\d+\s\w+)", "123\tabc"},
+        {R"(\d+\s\w+)", "123abc"},
+    };
+    for (const auto& item : cases) {
+        APSARA_TEST_EQUAL_DESC(BoostMatch(item.first, item.second), Re2Match(item.first, item.second), item.first);
+    }
+}
+
+void Re2UtilUnittest::TestDifferentFromBoost() {
+    // \s does not match \v in RE2
+    APSARA_TEST_TRUE(BoostMatch(R"(a\sb)", "a\vb"));
+    APSARA_TEST_FALSE(Re2Match(R"(a\sb)", "a\vb"));
+    // but \v itself is matched by both
+    APSARA_TEST_TRUE(BoostMatch(R"(a\x0bb)", "a\vb"));
+    APSARA_TEST_TRUE(Re2Match(R"(a\x0bb)", "a\vb"));
+}
+
+void Re2UtilUnittest::TestFallback() {
+    // patterns not supported by RE2 fail to compile, so that callers fall back to boost regex
+    for (const auto& regex : {R"((\w+)-\1)", R"(a(?=b)\w)", R"(a(?!b)\w)", R"((?<=a)b)", R"((?>a+)b)", R"(a++b)"}) {
+        re2::RE2 reg(GetBoostCompatibleRe2Pattern(regex), GetBoostCompatibleRe2Options());
+        APSARA_TEST_FALSE_DESC(reg.ok(), regex);
+    }
+    APSARA_TEST_TRUE(BoostMatch(R"((\w+)-\1)", "abc-abc"));
+}
+
+UNIT_TEST_CASE(Re2UtilUnittest, TestSameAsBoost)
+UNIT_TEST_CASE(Re2UtilUnittest, TestDifferentFromBoost)
+UNIT_TEST_CASE(Re2UtilUnittest, TestFallback)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,144 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "boost/regex.hpp"
+
+#include "common/RegexPrefilter.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class RegexPrefilterUnittest : public ::testing::Test {
+public:
+    void TestCreate();
+    void TestMayMatch();
+    void TestNoFalseNegative();
+};
+
+void RegexPrefilterUnittest::TestCreate() {
+    {
+        auto prefilter = RegexPrefilter::Create(R"(^\d{4}-\d{2}-\d{2}\s\d+:\d+:\d+)");
+        APSARA_TEST_NOT_EQUAL(nullptr, prefilter);
+        APSARA_TEST_EQUAL(12U, prefilter->GetShapeSize());
+        APSARA_TEST_EQUAL("-", prefilter->GetLiteral());
+    }
+    {
+        auto prefilter = RegexPrefilter::Create(R"(\w+Exception:)");
+        APSARA_TEST_NOT_EQUAL(nullptr, prefilter);
+        APSARA_TEST_EQUAL(0U, prefilter->GetShapeSize());
+        APSARA_TEST_EQUAL("Exception:", prefilter->GetLiteral());
+    }
+    {
+        auto prefilter = RegexPrefilter::Create(R"(^\s+at\s)");
+        APSARA_TEST_NOT_EQUAL(nullptr, prefilter);
+        APSARA_TEST_EQUAL(1U, prefilter->GetShapeSize());
+        APSARA_TEST_EQUAL("at", prefilter->GetLiteral());
+    }
+    {
+        // literals in optional parts are not required
+        auto prefilter = RegexPrefilter::Create(R"(^ab?c{2,}d)");
+        APSARA_TEST_NOT_EQUAL(nullptr, prefilter);
+        APSARA_TEST_EQUAL(1U, prefilter->GetShapeSize());
+        APSARA_TEST_EQUAL("cc", prefilter->GetLiteral());
+    }
+    // patterns which cannot be analyzed
+    APSARA_TEST_EQUAL(nullptr, RegexPrefilter::Create(R"(abc|def)"));
+    APSARA_TEST_EQUAL(nullptr, RegexPrefilter::Create(R"((?i)abc)"));
+    APSARA_TEST_EQUAL(nullptr, RegexPrefilter::Create(R"(^(a)\1)"));
+    APSARA_TEST_EQUAL(nullptr, RegexPrefilter::Create(R"(\x41)"));
+    APSARA_TEST_EQUAL(nullptr, RegexPrefilter::Create(R"((abc)"));
+    // no useful check
+    APSARA_TEST_EQUAL(nullptr, RegexPrefilter::Create(R"(\s+)"));
+    APSARA_TEST_EQUAL(nullptr, RegexPrefilter::Create(R"((abc)+)"));
+}
+
+void RegexPrefilterUnittest::TestMayMatch() {
+    auto prefilter = RegexPrefilter::Create(R"(^\[\d+-\d+-\d+\s\d+:\d+:\d+\]\s\[ERROR\])");
+    APSARA_TEST_NOT_EQUAL(nullptr, prefilter);
+    string line = "[2024-01-01 00:00:00] [ERROR] failed";
+    APSARA_TEST_TRUE(prefilter->MayMatch(line.data(), line.size()));
+    line = "[2024-01-01 00:00:00] [INFO] succeeded";
+    APSARA_TEST_FALSE(prefilter->MayMatch(line.data(), line.size()));
+    line = "    at com.example.Main.main(Main.java:10)";
+    APSARA_TEST_FALSE(prefilter->MayMatch(line.data(), line.size()));
+    line = "[";
+    APSARA_TEST_FALSE(prefilter->MayMatch(line.data(), line.size()));
+    // ^ also matches after line separators
+    line = "    at Main\n[2024-01-01 00:00:00] [ERROR] failed";
+    APSARA_TEST_TRUE(prefilter->MayMatch(line.data(), line.size()));
+
+    string exception;
+    boost::regex reg(R"(^\[\d+-\d+-\d+\s\d+:\d+:\d+\]\s\[ERROR\])");
+    line = "[2024-01-01 00:00:00] [ERROR] failed";
+    APSARA_TEST_TRUE(BoostRegexSearch(line.data(), line.size(), reg, prefilter.get(), exception));
+    APSARA_TEST_TRUE(BoostRegexSearch(line.data(), line.size(), reg, nullptr, exception));
+    line = "[2024-01-01 00:00:00] [INFO] failed";
+    APSARA_TEST_FALSE(BoostRegexSearch(line.data(), line.size(), reg, prefilter.get(), exception));
+    APSARA_TEST_FALSE(BoostRegexSearch(line.data(), line.size(), reg, nullptr, exception));
+}
+
+void RegexPrefilterUnittest::TestNoFalseNegative() {
+    const vector<string> patterns = {R"(^\d{4}-\d{2}-\d{2}.*)",
+                                     R"(^\[\d+-\d+-\w+:\d+:\d+,\d+\]\s\[\w+\]\s.*)",
+                                     R"(^\s+at .*)",
+                                     R"(\w+Exception:)",
+                                     R"(^Caused by: .*)",
+                                     R"(^[^\s].*)",
+                                     R"(^(\d+|x)abc)",
+                                     R"(^ab{2,3}cd)",
+                                     R"(^[a-c\d]{2}x)",
+                                     R"(^[^a-c]x+y)",
+                                     R"(\bfoo\b)",
+                                     R"(^foo$)",
+                                     R"(^[[:digit:]]{2}z)",
+                                     R"(^.{3}q)",
+                                     R"(^a*?b)",
+                                     R"(^x{3}yy)",
+                                     R"(^[]a]b)",
+                                     R"(^[\]\-]c)",
+                                     R"(^\d\D\w\W\s\S)",
+                                     R"(^(?=ab)abc)"};
+    const string alphabet = "abcdxyzq0123456789-:[], .\t\n\r\fABCEFImnt\\*$_\xe4\x85";
+    mt19937 rng(0);
+    for (const auto& pattern : patterns) {
+        boost::regex reg(pattern);
+        auto prefilter = RegexPrefilter::Create(pattern);
+        APSARA_TEST_NOT_EQUAL(nullptr, prefilter);
+        for (size_t round = 0; round < 20000; ++round) {
+            string line;
+            size_t len = rng() % 16;
+            for (size_t i = 0; i < len; ++i) {
+                // chars from the pattern make matches more likely
+                line += rng() % 3 == 0 ? pattern[rng() % pattern.size()] : alphabet[rng() % alphabet.size()];
+            }
+            if (boost::regex_search(line.data(), line.data() + line.size(), reg)) {
+                APSARA_TEST_TRUE_DESC(prefilter->MayMatch(line.data(), line.size()), pattern + " on " + line);
+            }
+        }
+    }
+}
+
+UNIT_TEST_CASE(RegexPrefilterUnittest, TestCreate)
+UNIT_TEST_CASE(RegexPrefilterUnittest, TestMayMatch)
+UNIT_TEST_CASE(RegexPrefilterUnittest, TestNoFalseNegative)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,75 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+
+#include "common/SimdUtil.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class SimdUtilUnittest : public ::testing::Test {
+public:
+    void TestFindChar();
+    void TestFindCharRandomly();
+};
+
+void SimdUtilUnittest::TestFindChar() {
+    for (auto find : {FindCharScalar, FindCharSse2, FindCharAvx2, FindChar}) {
+        string s;
+        APSARA_TEST_EQUAL(s.data(), find(s.data(), s.data(), '\n'));
+
+        // the char locates in each position of the blocks and the tail
+        s = string(100, 'a');
+        for (size_t i = 0; i < s.size(); ++i) {
+            s[i] = '\n';
+            APSARA_TEST_EQUAL(s.data() + i, find(s.data(), s.data() + s.size(), '\n'));
+            s[i] = 'a';
+        }
+        APSARA_TEST_EQUAL(s.data() + s.size(), find(s.data(), s.data() + s.size(), '\n'));
+
+        // chars with the highest bit set
+        s[70] = '\xe4';
+        APSARA_TEST_EQUAL(s.data() + 70, find(s.data(), s.data() + s.size(), '\xe4'));
+
+        // chars out of the range should not be found
+        s[80] = '\n';
+        APSARA_TEST_EQUAL(s.data() + 50, find(s.data() + 10, s.data() + 50, '\n'));
+    }
+}
+
+void SimdUtilUnittest::TestFindCharRandomly() {
+    mt19937 rng(0);
+    for (size_t round = 0; round < 10000; ++round) {
+        string s(rng() % 300, 'a');
+        for (auto& c : s) {
+            c = rng() % 50 == 0 ? '\n' : static_cast<char>(rng() % 256);
+        }
+        size_t begin = s.empty() ? 0 : rng() % s.size();
+        const char* expected = FindCharScalar(s.data() + begin, s.data() + s.size(), '\n');
+        APSARA_TEST_EQUAL(expected, FindCharSse2(s.data() + begin, s.data() + s.size(), '\n'));
+        APSARA_TEST_EQUAL(expected, FindCharAvx2(s.data() + begin, s.data() + s.size(), '\n'));
+        APSARA_TEST_EQUAL(expected, FindChar(s.data() + begin, s.data() + s.size(), '\n'));
+    }
+}
+
+UNIT_TEST_CASE(SimdUtilUnittest, TestFindChar)
+UNIT_TEST_CASE(SimdUtilUnittest, TestFindCharRandomly)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
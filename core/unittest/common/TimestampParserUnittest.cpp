@@ -0,0 +1,181 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ctime>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "common/TimestampParser.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class TimestampParserUnittest : public ::testing::Test {
+public:
+    void TestInit();
+    void TestParse();
+    void TestSameAsStrptime();
+    void TestLocalTimeToEpoch();
+
+private:
+    // the same as Strptime, which ignores daylight saving time
+    static time_t MakeTime(int year, int mon, int mday, int hour, int min, int sec) {
+        struct tm timeInfo = {};
+        timeInfo.tm_year = year - 1900;
+        timeInfo.tm_mon = mon - 1;
+        timeInfo.tm_mday = mday;
+        timeInfo.tm_hour = hour;
+        timeInfo.tm_min = min;
+        timeInfo.tm_sec = sec;
+        return mktime(&timeInfo);
+    }
+};
+
+void TimestampParserUnittest::TestInit() {
+    TimestampParser parser;
+    APSARA_TEST_TRUE(parser.Init("%Y-%m-%d %H:%M:%S"));
+    APSARA_TEST_TRUE(parser.IsInited());
+    APSARA_TEST_TRUE(parser.Init("%Y-%m-%dT%H:%M:%S.%f%z"));
+    APSARA_TEST_TRUE(parser.Init("%d/%b/%Y:%H:%M:%S %z"));
+    APSARA_TEST_TRUE(parser.Init("[%F %T]"));
+    // unsupported conversions
+    APSARA_TEST_FALSE(parser.Init("%s"));
+    APSARA_TEST_FALSE(parser.IsInited());
+    APSARA_TEST_FALSE(parser.Init("%y-%m-%d"));
+    APSARA_TEST_FALSE(parser.Init("%Y-%j"));
+    APSARA_TEST_FALSE(parser.Init("%Y-%m-%d %"));
+    // the year is absent
+    APSARA_TEST_FALSE(parser.Init("%b %d %H:%M:%S"));
+}
+
+void TimestampParserUnittest::TestParse() {
+    TimestampParser parser;
+    LogtailTime ts = {0, 0};
+    int nanosecondLength = -1;
+    {
+        APSARA_TEST_TRUE(parser.Init("%Y-%m-%d %H:%M:%S.%f"));
+        string s = "2024-02-29 23:59:58.123 rest";
+        const char* res = parser.Parse(s.data(), s.size(), &ts, nanosecondLength);
+        APSARA_TEST_EQUAL(s.data() + 23, res);
+        APSARA_TEST_EQUAL(123000000L, ts.tv_nsec);
+        APSARA_TEST_EQUAL(3, nanosecondLength);
+        APSARA_TEST_EQUAL(MakeTime(2024, 2, 29, 23, 59, 58), ts.tv_sec);
+
+        s = "2024-02-29 23:59:58.123456789";
+        APSARA_TEST_NOT_EQUAL(nullptr, parser.Parse(s.data(), s.size(), &ts, nanosecondLength));
+        APSARA_TEST_EQUAL(123456789L, ts.tv_nsec);
+        APSARA_TEST_EQUAL(9, nanosecondLength);
+
+        // not fitting the layout
+        s = "2024-2-29 23:59:58.123";
+        APSARA_TEST_EQUAL(nullptr, parser.Parse(s.data(), s.size(), &ts, nanosecondLength));
+        s = "2024-13-29 23:59:58.123";
+        APSARA_TEST_EQUAL(nullptr, parser.Parse(s.data(), s.size(), &ts, nanosecondLength));
+        s = "2024-02-29 23:59:58.";
+        APSARA_TEST_EQUAL(nullptr, parser.Parse(s.data(), s.size(), &ts, nanosecondLength));
+        s = "2024-02-29";
+        APSARA_TEST_EQUAL(nullptr, parser.Parse(s.data(), s.size(), &ts, nanosecondLength));
+    }
+    {
+        APSARA_TEST_TRUE(parser.Init("%d/%b/%Y:%H:%M:%S %z"));
+        string s = "10/jan/2017:14:57:51 +0800";
+        APSARA_TEST_EQUAL(s.data() + s.size(), parser.Parse(s.data(), s.size(), &ts, nanosecondLength));
+        APSARA_TEST_EQUAL(MakeTime(2017, 1, 10, 14, 57, 51), ts.tv_sec);
+        APSARA_TEST_EQUAL(0L, ts.tv_nsec);
+        s = "10/January/2017:14:57:51 -05:30";
+        APSARA_TEST_EQUAL(s.data() + s.size(), parser.Parse(s.data(), s.size(), &ts, nanosecondLength));
+        APSARA_TEST_EQUAL(MakeTime(2017, 1, 10, 14, 57, 51), ts.tv_sec);
+        s = "10/Agu/2017:14:57:51 +0800";
+        APSARA_TEST_EQUAL(nullptr, parser.Parse(s.data(), s.size(), &ts, nanosecondLength));
+    }
+}
+
+void TimestampParserUnittest::TestSameAsStrptime() {
+    const vector<string> formats = {"%Y-%m-%d %H:%M:%S",
+                                    "%Y-%m-%d %H:%M:%S.%f",
+                                    "%Y-%m-%dT%H:%M:%S.%f%z",
+                                    "%d/%b/%Y:%H:%M:%S %z",
+                                    "%Y%m%d%H%M%S",
+                                    "[%F %R]"};
+    mt19937 rng(0);
+    char buf[128];
+    for (const auto& format : formats) {
+        TimestampParser parser;
+        APSARA_TEST_TRUE_FATAL(parser.Init(format));
+        for (size_t round = 0; round < 10000; ++round) {
+            time_t t = 1000000000 + rng() % 1000000000;
+            struct tm timeInfo;
+            localtime_r(&t, &timeInfo);
+            string layout = format;
+            size_t pos = 0;
+            if ((pos = layout.find("%f")) != string::npos) {
+                layout.replace(pos, 2, to_string(rng() % 1000000000).substr(0, 1 + rng() % 9));
+            }
+            if ((pos = layout.find("%z")) != string::npos) {
+                layout.replace(pos, 2, rng() % 2 == 0 ? "Z" : "+08:00");
+            }
+            string s(buf, strftime(buf, sizeof(buf), layout.c_str(), &timeInfo));
+            // broken strings
+            if (rng() % 4 == 0) {
+                s[rng() % s.size()] = "0123456789 :-/x"[rng() % 15];
+            }
+
+            LogtailTime expected = {0, 0}, actual = {0, 0};
+            int expectedLength = -1, actualLength = -1;
+            const char* expectedRes = Strptime(s.c_str(), format.c_str(), &expected, expectedLength);
+            const char* actualRes = parser.Parse(s.data(), s.size(), &actual, actualLength);
+            if (actualRes == nullptr) {
+                continue;
+            }
+            APSARA_TEST_EQUAL_DESC(expectedRes, actualRes, s);
+            APSARA_TEST_EQUAL_DESC(expected.tv_sec, actual.tv_sec, s);
+            APSARA_TEST_EQUAL_DESC(expected.tv_nsec, actual.tv_nsec, s);
+            APSARA_TEST_EQUAL_DESC(expectedLength, actualLength, s);
+        }
+    }
+}
+
+void TimestampParserUnittest::TestLocalTimeToEpoch() {
+    mt19937 rng(0);
+    for (size_t round = 0; round < 100000; ++round) {
+        struct tm timeInfo = {};
+        timeInfo.tm_year = 70 + rng() % 100;
+        timeInfo.tm_mon = rng() % 12;
+        timeInfo.tm_mday = 1 + rng() % 31;
+        timeInfo.tm_hour = rng() % 24;
+        timeInfo.tm_min = rng() % 60;
+        timeInfo.tm_sec = rng() % 62;
+        time_t actual = LocalTimeToEpoch(timeInfo.tm_year + 1900,
+                                         timeInfo.tm_mon,
+                                         timeInfo.tm_mday,
+                                         timeInfo.tm_hour,
+                                         timeInfo.tm_min,
+                                         timeInfo.tm_sec);
+        APSARA_TEST_EQUAL(mktime(&timeInfo), actual);
+    }
+}
+
+UNIT_TEST_CASE(TimestampParserUnittest, TestInit)
+UNIT_TEST_CASE(TimestampParserUnittest, TestParse)
+UNIT_TEST_CASE(TimestampParserUnittest, TestSameAsStrptime)
+UNIT_TEST_CASE(TimestampParserUnittest, TestLocalTimeToEpoch)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,114 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "common/timer/TimingWheel.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class TimingWheelUnittest : public ::testing::Test {
+public:
+    void TestAdvance();
+    void TestCascade();
+    void TestExpiredWhenAdded();
+    void TestJump();
+};
+
+void TimingWheelUnittest::TestAdvance() {
+    TimingWheel<int> wheel(100, 1000);
+    wheel.Add(1250, 1);
+    wheel.Add(1500, 2);
+    wheel.Add(1500, 3);
+    APSARA_TEST_EQUAL(3U, wheel.Size());
+
+    vector<int> res;
+    wheel.Advance(1199, res);
+    APSARA_TEST_TRUE(res.empty());
+    // expired at most one tick earlier
+    wheel.Advance(1200, res);
+    APSARA_TEST_EQUAL(vector<int>({1}), res);
+
+    res.clear();
+    wheel.Advance(1499, res);
+    APSARA_TEST_TRUE(res.empty());
+    wheel.Advance(1500, res);
+    APSARA_TEST_EQUAL(vector<int>({2, 3}), res);
+    APSARA_TEST_TRUE(wheel.Empty());
+}
+
+void TimingWheelUnittest::TestCascade() {
+    TimingWheel<uint64_t> wheel(1, 0);
+    // one entry for each level
+    vector<uint64_t> expireTimes = {10, 63, 64, 100, 4095, 4096, 5000, 262143, 262144, 300000, 16777215};
+    for (auto t : expireTimes) {
+        wheel.Add(t, uint64_t(t));
+    }
+
+    vector<uint64_t> res;
+    for (uint64_t now = 0; now <= 16777215; ++now) {
+        wheel.Advance(now, res);
+        for (auto t : res) {
+            APSARA_TEST_EQUAL(now, t);
+        }
+        res.clear();
+        if (wheel.Empty()) {
+            break;
+        }
+    }
+    APSARA_TEST_TRUE(wheel.Empty());
+}
+
+void TimingWheelUnittest::TestExpiredWhenAdded() {
+    TimingWheel<int> wheel(100, 1000);
+    wheel.Add(500, 1);
+    wheel.Add(1050, 2);
+
+    vector<int> res;
+    wheel.Advance(1000, res);
+    APSARA_TEST_EQUAL(vector<int>({1, 2}), res);
+}
+
+void TimingWheelUnittest::TestJump() {
+    TimingWheel<int> wheel(100, 0);
+    wheel.Add(10000, 1);
+    wheel.Add(5000000, 2);
+
+    vector<int> res;
+    wheel.Advance(20000, res);
+    APSARA_TEST_EQUAL(vector<int>({1}), res);
+    res.clear();
+    wheel.Advance(6000000, res);
+    APSARA_TEST_EQUAL(vector<int>({2}), res);
+
+    // time moves on while the wheel is empty
+    wheel.Add(6000100, 3);
+    res.clear();
+    wheel.Advance(6000099, res);
+    APSARA_TEST_TRUE(res.empty());
+    wheel.Advance(6000100, res);
+    APSARA_TEST_EQUAL(vector<int>({3}), res);
+}
+
+UNIT_TEST_CASE(TimingWheelUnittest, TestAdvance)
+UNIT_TEST_CASE(TimingWheelUnittest, TestCascade)
+UNIT_TEST_CASE(TimingWheelUnittest, TestExpiredWhenAdded)
+UNIT_TEST_CASE(TimingWheelUnittest, TestJump)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
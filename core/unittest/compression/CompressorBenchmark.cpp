@@ -0,0 +1,150 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+
+#include <string>
+#include <vector>
+
+#include "lz4/lz4.h"
+#include "zstd/zstd.h"
+
+#include "common/TimeUtil.h"
+#include "common/compression/LZ4Compressor.h"
+#include "common/compression/ZstdCompressor.h"
+
+using namespace std;
+
+namespace logtail {
+
+class CompressorBenchmark {
+public:
+    CompressorBenchmark();
+
+    void TestZstdOneShot();
+    void TestZstdReusedContext();
+    void TestLZ4OneShot();
+    void TestLZ4ReusedState();
+
+private:
+    void PrintResult(const char* name, uint64_t timeelapsed, size_t compressedSize) const;
+
+    vector<string> mBatches;
+    size_t mRawSize = 0;
+    static const size_t kRoundCnt = 20;
+};
+
+CompressorBenchmark::CompressorBenchmark() {
+    // small batches of repetitive logs, which is the common case for flushers
+    for (size_t i = 0; i < 2000; ++i) {
+        string batch;
+        for (size_t j = 0; j < 10; ++j) {
+            size_t n = i * 10 + j;
+            batch += "2024-01-01 00:00:" + to_string(n % 60) + " [INFO] [handler.cpp:" + to_string(n % 100)
+                + "] request handled, method=GET, path=/api/v1/items/" + to_string(n) + ", status=200, latency="
+                + to_string(n % 37) + "ms\n";
+        }
+        mRawSize += batch.size();
+        mBatches.emplace_back(std::move(batch));
+    }
+}
+
+void CompressorBenchmark::PrintResult(const char* name, uint64_t timeelapsed, size_t compressedSize) const {
+    printf("%s costs %lums, %.1fMB/s, ratio %.2f\n",
+           name,
+           timeelapsed,
+           timeelapsed == 0 ? 0.0 : mRawSize * kRoundCnt / 1024.0 / 1024.0 * 1000 / timeelapsed,
+           compressedSize == 0 ? 0.0 : double(mRawSize) / compressedSize);
+}
+
+// the way compressors worked before: a new context and a zero-filled output string for each batch
+void CompressorBenchmark::TestZstdOneShot() {
+    size_t compressedSize = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        compressedSize = 0;
+        for (const auto& batch : mBatches) {
+            string output;
+            output.resize(ZSTD_compressBound(batch.size()));
+            size_t size = ZSTD_compress(const_cast<char*>(output.data()), output.size(), batch.data(), batch.size(), 1);
+            output.resize(size);
+            compressedSize += size;
+        }
+    }
+    PrintResult(__func__, GetCurrentTimeInMilliSeconds() - starttime, compressedSize);
+}
+
+void CompressorBenchmark::TestZstdReusedContext() {
+    ZstdCompressor compressor(CompressType::ZSTD);
+    vector<char> buffer;
+    string errorMsg;
+    size_t compressedSize = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        compressedSize = 0;
+        for (const auto& batch : mBatches) {
+            buffer.resize(compressor.GetCompressBound(batch.size()));
+            size_t size = buffer.size();
+            compressor.DoCompress(batch.data(), batch.size(), buffer.data(), size, errorMsg);
+            compressedSize += size;
+        }
+    }
+    PrintResult(__func__, GetCurrentTimeInMilliSeconds() - starttime, compressedSize);
+}
+
+void CompressorBenchmark::TestLZ4OneShot() {
+    size_t compressedSize = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        compressedSize = 0;
+        for (const auto& batch : mBatches) {
+            string output;
+            output.resize(LZ4_compressBound(batch.size()));
+            int size
+                = LZ4_compress_default(batch.data(), const_cast<char*>(output.data()), batch.size(), output.size());
+            output.resize(size);
+            compressedSize += size;
+        }
+    }
+    PrintResult(__func__, GetCurrentTimeInMilliSeconds() - starttime, compressedSize);
+}
+
+void CompressorBenchmark::TestLZ4ReusedState() {
+    LZ4Compressor compressor(CompressType::LZ4);
+    vector<char> buffer;
+    string errorMsg;
+    size_t compressedSize = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        compressedSize = 0;
+        for (const auto& batch : mBatches) {
+            buffer.resize(compressor.GetCompressBound(batch.size()));
+            size_t size = buffer.size();
+            compressor.DoCompress(batch.data(), batch.size(), buffer.data(), size, errorMsg);
+            compressedSize += size;
+        }
+    }
+    PrintResult(__func__, GetCurrentTimeInMilliSeconds() - starttime, compressedSize);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::CompressorBenchmark benchmark;
+    benchmark.TestZstdOneShot();
+    benchmark.TestZstdReusedContext();
+    benchmark.TestLZ4OneShot();
+    benchmark.TestLZ4ReusedState();
+    return 0;
+}
@@ -39,6 +39,7 @@ private:
 class CompressorUnittest : public ::testing::Test {
 public:
     void TestMetric();
+    void TestCompressStream();
 };
 
 void CompressorUnittest::TestMetric() {
@@ -72,7 +73,28 @@ void CompressorUnittest::TestMetric() {
     }
 }
 
+void CompressorUnittest::TestCompressStream() {
+    // compressors without streaming support gather the chunks first
+    CompressorMock compressor(CompressType::MOCK);
+    compressor.SetMetricRecordRef({});
+    string input = "hello world";
+    string output;
+    string errorMsg;
+    APSARA_TEST_TRUE(compressor.DoCompressStream(
+        input.size(),
+        [&input](const Compressor::ChunkWriter& writer) {
+            return writer(input.data(), 5) && writer(input.data() + 5, input.size() - 5);
+        },
+        output,
+        errorMsg));
+    APSARA_TEST_EQUAL("hello", output);
+    APSARA_TEST_EQUAL(1U, compressor.mInItemsTotal->GetValue());
+    APSARA_TEST_EQUAL(input.size(), compressor.mInItemSizeBytes->GetValue());
+    APSARA_TEST_EQUAL(output.size(), compressor.mOutItemSizeBytes->GetValue());
+}
+
 UNIT_TEST_CASE(CompressorUnittest, TestMetric)
+UNIT_TEST_CASE(CompressorUnittest, TestCompressStream)
 
 } // namespace logtail
 
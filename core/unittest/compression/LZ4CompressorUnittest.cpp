@@ -22,6 +22,7 @@ namespace logtail {
 class LZ4CompressorUnittest : public ::testing::Test {
 public:
     void TestCompress();
+    void TestCompressToBuffer();
 };
 
 void LZ4CompressorUnittest::TestCompress() {
@@ -36,7 +37,29 @@ void LZ4CompressorUnittest::TestCompress() {
     APSARA_TEST_EQUAL(input, decompressed);
 }
 
+void LZ4CompressorUnittest::TestCompressToBuffer() {
+    LZ4Compressor compressor(CompressType::LZ4);
+    string input = "hello world";
+    string errorMsg;
+    {
+        vector<char> buffer(compressor.GetCompressBound(input.size()));
+        size_t size = buffer.size();
+        APSARA_TEST_TRUE(compressor.DoCompress(input.data(), input.size(), buffer.data(), size, errorMsg));
+        string decompressed;
+        decompressed.resize(input.size());
+        APSARA_TEST_TRUE(compressor.UnCompress(string(buffer.data(), size), decompressed, errorMsg));
+        APSARA_TEST_EQUAL(input, decompressed);
+    }
+    {
+        // buffer too small
+        char buffer[1];
+        size_t size = sizeof(buffer);
+        APSARA_TEST_FALSE(compressor.DoCompress(input.data(), input.size(), buffer, size, errorMsg));
+    }
+}
+
 UNIT_TEST_CASE(LZ4CompressorUnittest, TestCompress)
+UNIT_TEST_CASE(LZ4CompressorUnittest, TestCompressToBuffer)
 
 } // namespace logtail
 
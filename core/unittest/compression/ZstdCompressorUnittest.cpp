@@ -22,6 +22,8 @@ namespace logtail {
 class ZstdCompressorUnittest : public ::testing::Test {
 public:
     void TestCompress();
+    void TestCompressToBuffer();
+    void TestCompressStream();
 };
 
 void ZstdCompressorUnittest::TestCompress() {
@@ -36,7 +38,75 @@ void ZstdCompressorUnittest::TestCompress() {
     APSARA_TEST_EQUAL(input, decompressed);
 }
 
+void ZstdCompressorUnittest::TestCompressToBuffer() {
+    ZstdCompressor compressor(CompressType::ZSTD);
+    string input = "hello world";
+    string errorMsg;
+    {
+        vector<char> buffer(compressor.GetCompressBound(input.size()));
+        size_t size = buffer.size();
+        APSARA_TEST_TRUE(compressor.DoCompress(input.data(), input.size(), buffer.data(), size, errorMsg));
+        string decompressed;
+        decompressed.resize(input.size());
+        APSARA_TEST_TRUE(compressor.UnCompress(string(buffer.data(), size), decompressed, errorMsg));
+        APSARA_TEST_EQUAL(input, decompressed);
+    }
+    {
+        // buffer too small
+        char buffer[1];
+        size_t size = sizeof(buffer);
+        APSARA_TEST_FALSE(compressor.DoCompress(input.data(), input.size(), buffer, size, errorMsg));
+    }
+}
+
+void ZstdCompressorUnittest::TestCompressStream() {
+    ZstdCompressor compressor(CompressType::ZSTD);
+    string input;
+    for (size_t i = 0; i < 100000; ++i) {
+        input += "hello world " + to_string(i);
+    }
+    string errorMsg;
+    {
+        // fed in chunks
+        string output;
+        APSARA_TEST_TRUE(compressor.DoCompressStream(
+            input.size(),
+            [&input](const Compressor::ChunkWriter& writer) {
+                for (size_t pos = 0; pos < input.size(); pos += 4096) {
+                    if (!writer(input.data() + pos, min<size_t>(4096, input.size() - pos))) {
+                        return false;
+                    }
+                }
+                return true;
+            },
+            output,
+            errorMsg));
+        APSARA_TEST_LT(output.size(), input.size());
+        string decompressed;
+        decompressed.resize(input.size());
+        APSARA_TEST_TRUE(compressor.UnCompress(output, decompressed, errorMsg));
+        APSARA_TEST_EQUAL(input, decompressed);
+    }
+    {
+        // input size mismatch
+        string output;
+        APSARA_TEST_FALSE(compressor.DoCompressStream(
+            input.size() + 1,
+            [&input](const Compressor::ChunkWriter& writer) { return writer(input.data(), input.size()); },
+            output,
+            errorMsg));
+    }
+    {
+        // producer fails
+        string output;
+        APSARA_TEST_FALSE(compressor.DoCompressStream(
+            input.size(), [](const Compressor::ChunkWriter& writer) { return false; }, output, errorMsg));
+    }
+}
+
 UNIT_TEST_CASE(ZstdCompressorUnittest, TestCompress)
+UNIT_TEST_CASE(ZstdCompressorUnittest, TestCompressToBuffer)
+UNIT_TEST_CASE(ZstdCompressorUnittest, TestCompressStream)
 
 } // namespace logtail
 
@@ -34,6 +34,7 @@
 #include "file_server/FileServer.h"
 #include "file_server/event/Event.h"
 #include "file_server/event_handler/EventHandler.h"
+#include "file_server/event_handler/LogReaderPool.h"
 #include "file_server/reader/LogFileReader.h"
 #include "unittest/Unittest.h"
 #include "unittest/UnittestHelper.h"
@@ -42,6 +43,7 @@ using namespace std;
 
 DECLARE_FLAG_STRING(ilogtail_config);
 DECLARE_FLAG_INT32(default_tail_limit_kb);
+DECLARE_FLAG_INT32(log_reader_thread_count);
 
 namespace logtail {
 class ModifyHandlerUnittest : public ::testing::Test {
@@ -60,6 +62,9 @@ public:
     void TestHandleModifyEventWhenContainerRestartCase6();
     void TestHandleModifyEvnetWhenContainerStopTwice();
     void TestClearReaderWhenFileDeleted();
+    void TestHandleModifyEventWithReaderPool();
+    void TestParkEventWhenReaderIsReading();
+    void TestReadResultOfRemovedReader();
 
 protected:
     static void SetUpTestCase() {
@@ -165,6 +170,17 @@ protected:
         ProcessQueueManager::GetInstance()->Clear();
     }
 
+    void startReaderPool() {
+        INT32_FLAG(log_reader_thread_count) = 2;
+        LogReaderPool::GetInstance()->Start();
+    }
+
+    void stopReaderPool() {
+        LogReaderPool::GetInstance()->Stop();
+        LogReaderPool::GetInstance()->mShards.clear();
+        INT32_FLAG(log_reader_thread_count) = 0;
+    }
+
     static std::string gRootDir;
     static std::string gLogName;
 
@@ -239,6 +255,9 @@ UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEvnetWhenContainerStopTwic
 #ifndef _MSC_VER
 UNIT_TEST_CASE(ModifyHandlerUnittest, TestClearReaderWhenFileDeleted);
 #endif
+UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEventWithReaderPool);
+UNIT_TEST_CASE(ModifyHandlerUnittest, TestParkEventWhenReaderIsReading);
+UNIT_TEST_CASE(ModifyHandlerUnittest, TestReadResultOfRemovedReader);
 
 void ModifyHandlerUnittest::TestHandleContainerStoppedEventWhenReadToEnd() {
     LOG_INFO(sLogger, ("TestHandleContainerStoppedEventWhenReadToEnd() begin", time(NULL)));
@@ -840,6 +859,103 @@ void ModifyHandlerUnittest::TestClearReaderWhenFileDeleted() {
     LOG_INFO(sLogger, ("TestClearReaderWhenFileDeleted() end", time(NULL)));
 }
 
+void ModifyHandlerUnittest::TestHandleModifyEventWithReaderPool() {
+    LOG_INFO(sLogger, ("TestHandleModifyEventWithReaderPool() begin", time(NULL)));
+    startReaderPool();
+    APSARA_TEST_TRUE_FATAL(ProcessQueueManager::GetInstance()->IsAllQueueEmpty());
+
+    Event event(gRootDir, gLogName, EVENT_MODIFY, 0, 0, mReaderPtr->mDevInode.dev, mReaderPtr->mDevInode.inode);
+    mHandlerPtr->Handle(event);
+
+    // the file is read by the pool, and the event is handed back after reading
+    vector<Event*> finishedEvents;
+    for (size_t i = 0; i < 500 && finishedEvents.empty(); ++i) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+        LogReaderPool::GetInstance()->GetFinishedEvents(finishedEvents);
+    }
+    APSARA_TEST_EQUAL_FATAL(1U, finishedEvents.size());
+    APSARA_TEST_EQUAL(mConfigName, finishedEvents[0]->GetConfigName());
+    APSARA_TEST_TRUE(mReaderPtr->IsReadToEnd());
+    APSARA_TEST_FALSE(ProcessQueueManager::GetInstance()->IsAllQueueEmpty());
+    APSARA_TEST_TRUE(LogReaderPool::GetInstance()->IsAllTaskFinished());
+
+    // the read result is consumed by the handed back event
+    mHandlerPtr->Handle(*finishedEvents[0]);
+    LogReadResult result;
+    APSARA_TEST_FALSE(LogReaderPool::GetInstance()->PopReadResult(mReaderPtr, result));
+    APSARA_TEST_TRUE(mReaderPtr->mLogFileOp.IsOpen());
+    delete finishedEvents[0];
+
+    stopReaderPool();
+    LOG_INFO(sLogger, ("TestHandleModifyEventWithReaderPool() end", time(NULL)));
+}
+
+void ModifyHandlerUnittest::TestParkEventWhenReaderIsReading() {
+    LOG_INFO(sLogger, ("TestParkEventWhenReaderIsReading() begin", time(NULL)));
+    startReaderPool();
+    // pretend the reader is being read
+    LogReaderPool::GetInstance()->mReadingReaders[mReaderPtr.get()];
+    APSARA_TEST_TRUE(LogReaderPool::GetInstance()->IsReading(mReaderPtr));
+
+    Event event1(gRootDir, gLogName, EVENT_MODIFY, 0, 0, mReaderPtr->mDevInode.dev, mReaderPtr->mDevInode.inode);
+    mHandlerPtr->Handle(event1);
+    Event event2(gRootDir, gLogName, EVENT_DELETE, 0);
+    mHandlerPtr->Handle(event2);
+
+    // nothing is read, and the reader is untouched
+    APSARA_TEST_FALSE(mReaderPtr->IsReadToEnd());
+    APSARA_TEST_FALSE(mReaderPtr->IsFileDeleted());
+    APSARA_TEST_TRUE(ProcessQueueManager::GetInstance()->IsAllQueueEmpty());
+    auto& parkedEvents = LogReaderPool::GetInstance()->mReadingReaders[mReaderPtr.get()];
+    APSARA_TEST_EQUAL_FATAL(2U, parkedEvents.size());
+    APSARA_TEST_TRUE(parkedEvents[0]->IsModify());
+    APSARA_TEST_TRUE(parkedEvents[1]->IsDeleted());
+    APSARA_TEST_EQUAL(mConfigName, parkedEvents[1]->GetConfigName());
+
+    stopReaderPool();
+    LOG_INFO(sLogger, ("TestParkEventWhenReaderIsReading() end", time(NULL)));
+}
+
+void ModifyHandlerUnittest::TestReadResultOfRemovedReader() {
+    LOG_INFO(sLogger, ("TestReadResultOfRemovedReader() begin", time(NULL)));
+    startReaderPool();
+    auto pool = LogReaderPool::GetInstance();
+    auto reader = std::make_shared<LogFileReader>(gRootDir,
+                                                  gLogName,
+                                                  DevInode(),
+                                                  std::make_pair(&readerOpts, &ctx),
+                                                  std::make_pair(&multilineOpts, &ctx),
+                                                  std::make_pair(&tagOpts, &ctx));
+    Event event(gRootDir, gLogName, EVENT_MODIFY, 0);
+    {
+        LogReaderPool::ReadTask task1(reader, event, 0);
+        pool->OnTaskFinished(task1, LogReadResult::NO_MORE_DATA);
+        LogReaderPool::ReadTask task2(mReaderPtr, event, 0);
+        pool->OnTaskFinished(task2, LogReadResult::QUEUE_BLOCKED);
+    }
+    APSARA_TEST_EQUAL(2U, pool->mReadResults.size());
+
+    // the pending result does not keep a removed reader alive
+    std::weak_ptr<LogFileReader> removed = reader;
+    reader.reset();
+    APSARA_TEST_TRUE(removed.expired());
+
+    // and is purged when finished events are fetched, while results of live readers are kept
+    vector<Event*> finishedEvents;
+    pool->GetFinishedEvents(finishedEvents);
+    APSARA_TEST_EQUAL(2U, finishedEvents.size());
+    APSARA_TEST_EQUAL(1U, pool->mReadResults.size());
+    LogReadResult result;
+    APSARA_TEST_TRUE(pool->PopReadResult(mReaderPtr, result));
+    APSARA_TEST_TRUE(LogReadResult::QUEUE_BLOCKED == result);
+    for (auto ev : finishedEvents) {
+        delete ev;
+    }
+
+    stopReaderPool();
+    LOG_INFO(sLogger, ("TestReadResultOfRemovedReader() end", time(NULL)));
+}
+
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
@@ -0,0 +1,174 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "collection_pipeline/queue/SLSSenderQueueItem.h"
+#include "common/FileEncryption.h"
+#include "common/FileSystemUtil.h"
+#include "plugin/flusher/sls/DiskBufferWriter.h"
+#include "plugin/flusher/sls/FlusherSLS.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(disk_buffer_replay_concurrency);
+
+using namespace std;
+
+namespace logtail {
+
+class DiskBufferWriterUnittest : public testing::Test {
+public:
+    void TestWriteAndReplay();
+    void TestReplayStopped();
+    void TestDrainThroughput();
+
+protected:
+    void SetUp() override {
+        mBufferDir = (filesystem::current_path() / "disk_buffer_test").string() + PATH_SEPARATOR;
+        filesystem::create_directories(mBufferDir);
+        mWriter = DiskBufferWriter::GetInstance();
+        mWriter->SetBufferFilePath(mBufferDir);
+        mWriter->mIsSendBufferThreadRunning = true;
+
+        mFlusher.mProject = "test_project";
+        mFlusher.mRegion = "test_region";
+        mFlusher.mLogstore = "test_logstore";
+    }
+
+    void TearDown() override {
+        mWriter->mSendBufferFileDataMock = nullptr;
+        error_code ec;
+        filesystem::remove_all(mBufferDir, ec);
+    }
+
+private:
+    // writes cnt items to buffer files in batches of batchSize, and returns names of the buffer files
+    vector<string> WriteItems(size_t cnt, size_t batchSize) {
+        vector<SenderQueueItem*> items;
+        for (size_t i = 0; i < cnt; ++i) {
+            string data = "data_" + to_string(i);
+            size_t size = data.size();
+            items.push_back(new SLSSenderQueueItem(std::move(data), size, &mFlusher, 0, mFlusher.mLogstore));
+            if (items.size() == batchSize || i + 1 == cnt) {
+                APSARA_TEST_TRUE(mWriter->WriteToBufferFile(items));
+                for (auto item : items) {
+                    delete item;
+                }
+                items.clear();
+            }
+        }
+        vector<string> files;
+        APSARA_TEST_TRUE(mWriter->LoadFileToSend(time(nullptr) + 1, files));
+        return files;
+    }
+
+    // stands in for the sls backend, which responds after latency
+    void MockBackend(chrono::milliseconds latency) {
+        mWriter->mSendBufferFileDataMock = [this, latency](const sls_logs::LogtailBufferMeta& bufferMeta,
+                                                           const string& logData) {
+            this_thread::sleep_for(latency);
+            {
+                lock_guard<mutex> lock(mMux);
+                mReceived.insert(logData);
+            }
+            SLSResponse response;
+            response.mStatusCode = 200;
+            return response;
+        };
+    }
+
+    string mBufferDir;
+    DiskBufferWriter* mWriter = nullptr;
+    FlusherSLS mFlusher;
+
+    mutex mMux;
+    multiset<string> mReceived;
+};
+
+void DiskBufferWriterUnittest::TestWriteAndReplay() {
+    auto files = WriteItems(25, 10);
+    APSARA_TEST_EQUAL(1U, files.size());
+
+    MockBackend(chrono::milliseconds(0));
+    string filename = mBufferDir + files[0];
+    mWriter->SendEncryptionBuffer(filename, FileEncryption::GetInstance()->GetDefaultKeyVersion());
+
+    APSARA_TEST_EQUAL(25U, mReceived.size());
+    for (size_t i = 0; i < 25; ++i) {
+        APSARA_TEST_EQUAL(1U, mReceived.count("data_" + to_string(i)));
+    }
+    APSARA_TEST_FALSE(CheckExistance(filename));
+}
+
+void DiskBufferWriterUnittest::TestReplayStopped() {
+    auto files = WriteItems(10, 10);
+    APSARA_TEST_EQUAL(1U, files.size());
+
+    // stops after the first response
+    mWriter->mSendBufferFileDataMock = [this](const sls_logs::LogtailBufferMeta& bufferMeta, const string& logData) {
+        {
+            lock_guard<mutex> lock(mWriter->mBufferSenderThreadRunningMux);
+            mWriter->mIsSendBufferThreadRunning = false;
+        }
+        SLSResponse response;
+        response.mStatusCode = 200;
+        return response;
+    };
+    string filename = mBufferDir + files[0];
+    mWriter->SendEncryptionBuffer(filename, FileEncryption::GetInstance()->GetDefaultKeyVersion());
+    APSARA_TEST_TRUE(CheckExistance(filename));
+
+    // sent data is marked as handled and not sent again
+    mWriter->mIsSendBufferThreadRunning = true;
+    MockBackend(chrono::milliseconds(0));
+    mWriter->SendEncryptionBuffer(filename, FileEncryption::GetInstance()->GetDefaultKeyVersion());
+    APSARA_TEST_GT(10U, mReceived.size());
+    APSARA_TEST_FALSE(CheckExistance(filename));
+}
+
+void DiskBufferWriterUnittest::TestDrainThroughput() {
+    const size_t cnt = 200;
+    const auto latency = chrono::milliseconds(10);
+    auto files = WriteItems(cnt, 20);
+    APSARA_TEST_EQUAL(1U, files.size());
+
+    MockBackend(latency);
+    string filename = mBufferDir + files[0];
+    auto start = chrono::steady_clock::now();
+    mWriter->SendEncryptionBuffer(filename, FileEncryption::GetInstance()->GetDefaultKeyVersion());
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+
+    APSARA_TEST_EQUAL(cnt, mReceived.size());
+    APSARA_TEST_FALSE(CheckExistance(filename));
+    LOG_INFO(sLogger,
+             ("disk buffer drain throughput", cnt * 1000.0 / max<int64_t>(elapsed.count(), 1))(
+                 "concurrency", INT32_FLAG(disk_buffer_replay_concurrency))("elapsed ms", elapsed.count()));
+    // replaying one by one takes cnt * latency at least
+    APSARA_TEST_LT(elapsed.count(), static_cast<int64_t>(cnt * latency.count() / 2));
+}
+
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestWriteAndReplay)
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestReplayStopped)
+UNIT_TEST_CASE(DiskBufferWriterUnittest, TestDrainThroughput)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -35,6 +35,7 @@ class EventGroupBenchmark {
 public:
     void TestEraseInLoop();
     void TestWriteIndexInLoop();
+    void TestDataSize(bool cached);
 };
 
 void EraseInLoop(PipelineEventGroup& logGroup) {
@@ -102,12 +103,42 @@ void EventGroupBenchmark::TestWriteIndexInLoop() {
     printf("%s costs %lums\n", __func__, timeelapsed);
 }
 
+// DataSize is called several times for each group along the pipeline, i.e. by queues, processors and flushers
+void EventGroupBenchmark::TestDataSize(bool cached) {
+    // SetUp
+    std::vector<PipelineEventGroup> eventGroups;
+    for (int i = 0; i < 100; ++i) {
+        eventGroups.emplace_back(std::make_shared<SourceBuffer>());
+    }
+    for (auto& group : eventGroups) {
+        for (int i = 0; i < 10000; ++i) {
+            group.AddLogEvent()->SetContent(std::string("content"), std::string("value") + std::to_string(i));
+        }
+    }
+    // Test
+    size_t totalSize = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (auto& group : eventGroups) {
+        for (int i = 0; i < 100; ++i) {
+            if (!cached) {
+                // drop the cache, so that the size is recomputed as before
+                group.MutableEvents();
+            }
+            totalSize += group.DataSize();
+        }
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s %s costs %lums, total size %zu\n", __func__, cached ? "cached" : "uncached", timeelapsed, totalSize);
+}
+
 } // namespace logtail
 
 int main(int argc, char* argv[]) {
     logtail::EventGroupBenchmark benchmark;
     benchmark.TestEraseInLoop();
     benchmark.TestWriteIndexInLoop();
+    benchmark.TestDataSize(false);
+    benchmark.TestDataSize(true);
     /* Result:
        TestEraseInLoop costs 453ms
        TestWriteIndexInLoop costs 22ms
@@ -12,10 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
+#include "common/Flags.h"
 #include "models/EventPool.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_INT32(event_pool_max_pending_returned_events);
+
 using namespace std;
 
 namespace logtail {
@@ -25,6 +30,11 @@ public:
     void TestNoLock();
     void TestLock();
     void TestGC();
+    void TestReturnToOwner();
+    void TestReturnToExitedThread();
+    void TestLogEventSizeClass();
+    void TestStatistics();
+    void TestThreadedStatistics();
 
 protected:
     void SetUp() override { mGroup.reset(new PipelineEventGroup(make_shared<SourceBuffer>())); }
@@ -238,9 +248,162 @@ void EventPoolUnittest::TestGC() {
     }
 }
 
+void EventPoolUnittest::TestReturnToOwner() {
+    EventPool owner(false);
+    EventPool other(false);
+    auto e = owner.AcquireMetricEvent(mGroup.get());
+    thread([&]() { other.Release({e}); }).join();
+    APSARA_TEST_EQUAL(0U, other.mMetricEventPool.size());
+    APSARA_TEST_EQUAL(0U, owner.mMetricEventPool.size());
+    APSARA_TEST_EQUAL(1U, owner.mPendingReturnedCnt.load());
+
+    // the return list is drained once the pool runs out
+    APSARA_TEST_EQUAL(e, owner.AcquireMetricEvent(mGroup.get()));
+    APSARA_TEST_EQUAL(0U, owner.mPendingReturnedCnt.load());
+
+    // events not created by any threaded pool are kept by the releasing pool
+    auto e1 = EventPool().AcquireMetricEvent(mGroup.get());
+    other.Release({e1});
+    APSARA_TEST_EQUAL(1U, other.mMetricEventPool.size());
+
+    // too many events not taken by the owner
+    INT32_FLAG(event_pool_max_pending_returned_events) = 1;
+    auto e2 = owner.AcquireMetricEvent(mGroup.get());
+    other.Release(vector<MetricEvent*>{e, e2});
+    APSARA_TEST_EQUAL(3U, other.mMetricEventPool.size());
+    APSARA_TEST_EQUAL(0U, owner.mPendingReturnedCnt.load());
+    INT32_FLAG(event_pool_max_pending_returned_events) = 100000;
+
+    // events of different owners in one release
+    auto e3 = owner.AcquireLogEvent(mGroup.get());
+    auto e4 = other.AcquireLogEvent(mGroup.get());
+    auto e5 = owner.AcquireLogEvent(mGroup.get());
+    other.Release(vector<LogEvent*>{e3, e4, e5});
+    APSARA_TEST_EQUAL(1U, other.mLogEventPool.size());
+    APSARA_TEST_EQUAL(e4, other.mLogEventPool[0]);
+    APSARA_TEST_EQUAL(2U, owner.mPendingReturnedCnt.load());
+    owner.CheckGC();
+    APSARA_TEST_EQUAL(0U, owner.mPendingReturnedCnt.load());
+
+    owner.Clear();
+    other.Clear();
+}
+
+void EventPoolUnittest::TestReturnToExitedThread() {
+    unique_ptr<PipelineEventGroup> group;
+    EventPool* ownerPool = nullptr;
+    LogEvent* e = nullptr;
+    thread([&]() {
+        group = make_unique<PipelineEventGroup>(make_shared<SourceBuffer>());
+        e = group->AddLogEvent(true);
+        ownerPool = &gThreadedEventPool;
+    }).join();
+    APSARA_TEST_NOT_EQUAL(ownerPool, &gThreadedEventPool);
+
+    group.reset();
+    APSARA_TEST_EQUAL(1U, ownerPool->mPendingReturnedCnt.load());
+
+    // the pool of the exited thread is taken over by a new thread, together with the returned events
+    EventPool* newPool = nullptr;
+    LogEvent* newEvent = nullptr;
+    thread([&]() {
+        newPool = &gThreadedEventPool;
+        newEvent = gThreadedEventPool.AcquireLogEvent(mGroup.get());
+        gThreadedEventPool.Release({newEvent});
+    }).join();
+    APSARA_TEST_EQUAL(ownerPool, newPool);
+    APSARA_TEST_EQUAL(e, newEvent);
+}
+
+void EventPoolUnittest::TestLogEventSizeClass() {
+    EventPool pool(false);
+    auto small = pool.AcquireLogEvent(mGroup.get());
+    auto large = pool.AcquireLogEvent(mGroup.get());
+    for (size_t i = 0; i < 20; ++i) {
+        large->SetContent("key" + to_string(i), string("value"));
+    }
+    auto huge = pool.AcquireLogEvent(mGroup.get());
+    for (size_t i = 0; i < 300; ++i) {
+        huge->SetContent("key" + to_string(i), string("value"));
+    }
+    small->Reset();
+    large->Reset();
+    huge->Reset();
+    pool.Release(vector<LogEvent*>{small, large, huge});
+    APSARA_TEST_EQUAL(2U, pool.mLogEventPool.size());
+    APSARA_TEST_EQUAL(1U, pool.mLargeLogEventPool.size());
+    APSARA_TEST_EQUAL(large, pool.mLargeLogEventPool[0]);
+    // huge events are pooled as small ones with their contents freed
+    APSARA_TEST_EQUAL(huge, pool.mLogEventPool[1]);
+
+    // large events are taken first if many contents are expected
+    APSARA_TEST_EQUAL(large, pool.AcquireLogEvent(mGroup.get(), 32));
+    APSARA_TEST_EQUAL(huge, pool.AcquireLogEvent(mGroup.get()));
+    pool.Release({large});
+    APSARA_TEST_EQUAL(small, pool.AcquireLogEvent(mGroup.get()));
+    // and otherwise taken only if no small ones are left
+    APSARA_TEST_EQUAL(large, pool.AcquireLogEvent(mGroup.get()));
+
+    delete small;
+    delete large;
+    delete huge;
+}
+
+void EventPoolUnittest::TestStatistics() {
+    EventPool pool(false);
+    EventPool other(false);
+    auto e = pool.AcquireRawEvent(mGroup.get());
+    pool.Release({e});
+    e = pool.AcquireRawEvent(mGroup.get());
+    other.Release({e});
+
+    uint64_t acquireCnt = 0, hitCnt = 0, returnedCnt = 0;
+    pool.FetchStatistics(acquireCnt, hitCnt, returnedCnt);
+    APSARA_TEST_EQUAL(2U, acquireCnt);
+    APSARA_TEST_EQUAL(1U, hitCnt);
+    APSARA_TEST_EQUAL(1U, returnedCnt);
+
+    pool.FetchStatistics(acquireCnt, hitCnt, returnedCnt);
+    APSARA_TEST_EQUAL(0U, acquireCnt);
+    APSARA_TEST_EQUAL(0U, hitCnt);
+    APSARA_TEST_EQUAL(0U, returnedCnt);
+    pool.Clear();
+}
+
+void EventPoolUnittest::TestThreadedStatistics() {
+    vector<EventPoolStatistics> stats;
+    FetchThreadedEventPoolStatistics(stats);
+
+    // pools of threads other than the caller are reported as well
+    thread t([this]() {
+        auto e1 = gThreadedEventPool.AcquireRawEvent(mGroup.get());
+        auto e2 = gThreadedEventPool.AcquireRawEvent(mGroup.get());
+        gThreadedEventPool.Release(vector<RawEvent*>{e1, e2});
+    });
+    t.join();
+
+    FetchThreadedEventPoolStatistics(stats);
+    APSARA_TEST_FALSE(stats.empty());
+    uint64_t acquireCnt = 0;
+    for (const auto& stat : stats) {
+        acquireCnt += stat.mAcquireCnt;
+    }
+    APSARA_TEST_EQUAL(2U, acquireCnt);
+
+    FetchThreadedEventPoolStatistics(stats);
+    for (const auto& stat : stats) {
+        APSARA_TEST_EQUAL(0U, stat.mAcquireCnt);
+    }
+}
+
 UNIT_TEST_CASE(EventPoolUnittest, TestNoLock)
 UNIT_TEST_CASE(EventPoolUnittest, TestLock)
 UNIT_TEST_CASE(EventPoolUnittest, TestGC)
+UNIT_TEST_CASE(EventPoolUnittest, TestReturnToOwner)
+UNIT_TEST_CASE(EventPoolUnittest, TestReturnToExitedThread)
+UNIT_TEST_CASE(EventPoolUnittest, TestLogEventSizeClass)
+UNIT_TEST_CASE(EventPoolUnittest, TestStatistics)
+UNIT_TEST_CASE(EventPoolUnittest, TestThreadedStatistics)
 
 } // namespace logtail
 
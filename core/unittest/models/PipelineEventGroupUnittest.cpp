@@ -31,11 +31,16 @@ public:
     void TestSwapEvents();
     void TestReserveEvents();
     void TestCopy();
+    void TestShare();
+    void TestMakeExclusive();
+    void TestCopyOnWrite();
+    void TestAddLogEventWithContentsHint();
     void TestDestructor();
     void TestSetMetadata();
     void TestDelMetadata();
     void TestFromJsonToJson();
     void TestTagsHash();
+    void TestDataSize();
 
 protected:
     void SetUp() override {
@@ -216,6 +221,91 @@ void PipelineEventGroupUnittest::TestCopy() {
     APSARA_TEST_EQUAL(3U, res.GetSourceBuffer().use_count());
 }
 
+void PipelineEventGroupUnittest::TestShare() {
+    LogEvent* log = nullptr;
+    {
+        auto g = make_unique<PipelineEventGroup>(make_shared<SourceBuffer>());
+        log = g->AddLogEvent(true);
+        log->SetTimestamp(1234567890);
+        g->SetTag(string("key"), string("value"));
+        auto res1 = g->Share();
+        auto res2 = g->Share();
+        APSARA_TEST_EQUAL(1U, res1.GetEvents().size());
+        APSARA_TEST_TRUE(g->GetEvents()[0].IsShared());
+        APSARA_TEST_TRUE(res1.GetEvents()[0].IsShared());
+        APSARA_TEST_EQUAL(log, &res1.GetEvents()[0].Cast<LogEvent>());
+        APSARA_TEST_EQUAL(log, &res2.GetEvents()[0].Cast<LogEvent>());
+        APSARA_TEST_STREQ("value", res1.GetTag("key").data());
+        APSARA_TEST_EQUAL(g->GetSourceBuffer().get(), res1.GetSourceBuffer().get());
+
+        // event is released only after all sharing groups are destroyed
+        g.reset();
+        { auto tmp = std::move(res1); }
+        APSARA_TEST_EQUAL(0U, gThreadedEventPool.mLogEventPool.size());
+        APSARA_TEST_EQUAL(1234567890, res2.GetEvents()[0]->GetTimestamp());
+    }
+    APSARA_TEST_EQUAL(1U, gThreadedEventPool.mLogEventPool.size());
+    APSARA_TEST_EQUAL(log, gThreadedEventPool.mLogEventPool.back());
+}
+
+void PipelineEventGroupUnittest::TestMakeExclusive() {
+    auto log = mEventGroup->AddLogEvent();
+    log->SetContent(string("key"), string("value"));
+    auto res = mEventGroup->Share();
+    res.MakeExclusive();
+    APSARA_TEST_FALSE(res.GetEvents()[0].IsShared());
+    APSARA_TEST_NOT_EQUAL(log, &res.GetEvents()[0].Cast<LogEvent>());
+    APSARA_TEST_EQUAL(&res, res.GetEvents()[0]->mPipelineEventGroupPtr);
+    APSARA_TEST_NOT_EQUAL(mSourceBuffer.get(), res.GetSourceBuffer().get());
+    APSARA_TEST_EQUAL(1U, res.GetExtraSourceBuffers().count(mSourceBuffer));
+
+    res.MutableEvents()[0].Cast<LogEvent>().SetContent(string("key"), string("new_value"));
+    APSARA_TEST_EQUAL("new_value", res.GetEvents()[0].Cast<LogEvent>().GetContent("key").to_string());
+    APSARA_TEST_EQUAL("value", mEventGroup->GetEvents()[0].Cast<LogEvent>().GetContent("key").to_string());
+}
+
+void PipelineEventGroupUnittest::TestCopyOnWrite() {
+    auto log = mEventGroup->AddLogEvent();
+    log->SetContent(string("key"), string("value"));
+    auto res1 = mEventGroup->Share();
+    auto res2 = mEventGroup->Share();
+    APSARA_TEST_TRUE(res1.HasSharedEvents());
+
+    // events are copied before being exposed for modification
+    res1.MutableEvents()[0].Cast<LogEvent>().SetContent(string("key"), string("new_value"));
+    APSARA_TEST_FALSE(res1.HasSharedEvents());
+    APSARA_TEST_FALSE(res1.GetEvents()[0].IsShared());
+    APSARA_TEST_EQUAL("value", mEventGroup->GetEvents()[0].Cast<LogEvent>().GetContent("key").to_string());
+
+    // adding events to a group with shared events should not allocate from the shared source buffer
+    res2.AddLogEvent();
+    APSARA_TEST_FALSE(res2.HasSharedEvents());
+    APSARA_TEST_NOT_EQUAL(mSourceBuffer.get(), res2.GetSourceBuffer().get());
+
+    // releasing events does not copy them
+    auto events = mEventGroup->ReleaseEvents();
+    APSARA_TEST_EQUAL(1U, events.size());
+    APSARA_TEST_TRUE(events[0].IsShared());
+    APSARA_TEST_EQUAL(log, &events[0].Cast<LogEvent>());
+    APSARA_TEST_TRUE(mEventGroup->GetEvents().empty());
+}
+
+void PipelineEventGroupUnittest::TestAddLogEventWithContentsHint() {
+    LogEvent* small = nullptr;
+    LogEvent* large = nullptr;
+    {
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        small = g.AddLogEvent(true, &mPool);
+        large = g.AddLogEvent(true, &mPool);
+        for (size_t i = 0; i < 20; ++i) {
+            large->SetContent("key" + to_string(i), string("value"));
+        }
+    }
+    PipelineEventGroup g(make_shared<SourceBuffer>());
+    APSARA_TEST_EQUAL(large, g.AddLogEvent(true, &mPool, 32));
+    APSARA_TEST_EQUAL(small, g.AddLogEvent(true, &mPool));
+}
+
 void PipelineEventGroupUnittest::TestSetMetadata() {
     { // string copy, let kv out of scope
         mEventGroup->SetMetadata(EventGroupMetaKey::LOG_FORMAT, std::string("value1"));
@@ -311,16 +401,91 @@ void PipelineEventGroupUnittest::TestTagsHash() {
     APSARA_TEST_NOT_EQUAL(g1.GetTagsHash(), g3.GetTagsHash());
 }
 
+void PipelineEventGroupUnittest::TestDataSize() {
+    auto recompute = [](const PipelineEventGroup& group) {
+        size_t res = sizeof(EventsContainer);
+        for (const auto& e : group.GetEvents()) {
+            res += e->DataSize();
+        }
+        return res + group.mTags.DataSize();
+    };
+    {
+        // log events report their changes to the group
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        APSARA_TEST_EQUAL(recompute(group), group.DataSize());
+        auto e1 = group.AddLogEvent();
+        e1->SetContent(string("key1"), string("value1"));
+        auto e2 = group.AddLogEvent(true, &mPool);
+        e2->SetContent(string("key2"), string("value2"));
+        group.SetTag(string("tag"), string("value"));
+        APSARA_TEST_EQUAL(recompute(group), group.DataSize());
+        APSARA_TEST_TRUE(group.mIsEventsDataSizeValid);
+
+        e1->SetContent(string("key1"), string("longer value1"));
+        e2->DelContent("key2");
+        e2->SetContent(string("key3"), string("value3"));
+        APSARA_TEST_TRUE(group.mIsEventsDataSizeValid);
+        APSARA_TEST_EQUAL(recompute(group), group.DataSize());
+
+        // events container may be modified without notice
+        group.MutableEvents().pop_back();
+        APSARA_TEST_FALSE(group.mIsEventsDataSizeValid);
+        APSARA_TEST_EQUAL(recompute(group), group.DataSize());
+        APSARA_TEST_TRUE(group.mIsEventsDataSizeValid);
+
+        EventsContainer events;
+        auto e3 = group.CreateLogEvent();
+        LogEvent* e3Ptr = e3.get();
+        events.emplace_back(std::move(e3), false, nullptr);
+        group.SwapEvents(events);
+        APSARA_TEST_FALSE(group.mIsEventsDataSizeValid);
+        APSARA_TEST_EQUAL(recompute(group), group.DataSize());
+
+        // moved and copied groups keep the cache
+        PipelineEventGroup copied = group.Copy();
+        APSARA_TEST_EQUAL(group.DataSize(), copied.DataSize());
+        PipelineEventGroup moved(std::move(group));
+        e3Ptr->SetContent(string("key"), string("value"));
+        APSARA_TEST_TRUE(moved.mIsEventsDataSizeValid);
+        APSARA_TEST_EQUAL(recompute(moved), moved.DataSize());
+        APSARA_TEST_EQUAL(copied.DataSize(), recompute(copied));
+    }
+    {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        auto e = group.AddRawEvent();
+        e->SetContent(string("content"));
+        APSARA_TEST_EQUAL(recompute(group), group.DataSize());
+        e->SetContent(string("longer content"));
+        APSARA_TEST_TRUE(group.mIsEventsDataSizeValid);
+        APSARA_TEST_EQUAL(recompute(group), group.DataSize());
+    }
+    {
+        // metric events can be modified without notice, so the size is always recomputed
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        auto e = group.AddMetricEvent();
+        e->SetName("name");
+        APSARA_TEST_EQUAL(recompute(group), group.DataSize());
+        APSARA_TEST_FALSE(group.mIsEventsDataSizeValid);
+        e->SetTag(string("key"), string("value"));
+        APSARA_TEST_EQUAL(recompute(group), group.DataSize());
+    }
+}
+
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestCreateEvent)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestAddEvent)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSwapEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestReserveEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestCopy)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestShare)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestMakeExclusive)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestCopyOnWrite)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestAddLogEventWithContentsHint)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDestructor)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSetMetadata)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDelMetadata)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestFromJsonToJson)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestTagsHash)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDataSize)
 
 } // namespace logtail
 
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "collection_pipeline/limiter/ConcurrencyLimiter.h"
 #include "unittest/Unittest.h"
 
@@ -25,6 +29,7 @@ public:
     void TestTimeFallback() const;
     void TestNoTimeFallback() const;
     void TestExponentialBackoffWithMaxDuration() const;
+    void TestTryPop() const;
 };
 
 void ConcurrencyLimiterUnittest::TestLimiter() const {
@@ -403,10 +408,36 @@ void ConcurrencyLimiterUnittest::TestExponentialBackoffWithMaxDuration() const {
     APSARA_TEST_TRUE(limiter->IsValidToPop()); // Should work after 1s (reset to initial)
 }
 
+void ConcurrencyLimiterUnittest::TestTryPop() const {
+    ConcurrencyLimiter limiter("", 10, 1);
+    atomic_uint32_t popped = 0;
+    vector<thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 100; ++j) {
+                if (limiter.TryPop()) {
+                    ++popped;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    APSARA_TEST_EQUAL(10U, popped.load());
+    APSARA_TEST_EQUAL(10U, limiter.GetInSendingCount());
+    APSARA_TEST_FALSE(limiter.TryPop());
+
+    limiter.OnSendDone();
+    APSARA_TEST_TRUE(limiter.TryPop());
+    APSARA_TEST_EQUAL(10U, limiter.GetInSendingCount());
+}
+
 UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestLimiter)
 UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestTimeFallback)
 UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestNoTimeFallback)
 UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestExponentialBackoffWithMaxDuration)
+UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestTryPop)
 
 } // namespace logtail
 
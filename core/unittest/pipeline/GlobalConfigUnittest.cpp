@@ -49,6 +49,7 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(GlobalConfig::TopicType::NONE, config->mTopicType);
     APSARA_TEST_EQUAL("", config->mTopicFormat);
     APSARA_TEST_EQUAL(1U, config->mPriority);
+    APSARA_TEST_EQUAL(0U, config->mMaxMemoryMB);
     APSARA_TEST_FALSE(config->mEnableTimestampNanosecond);
     APSARA_TEST_FALSE(config->mUsingOldContentTag);
 
@@ -58,6 +59,7 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
             "TopicType": "custom",
             "TopicFormat": "test_topic",
             "Priority": 1,
+            "MaxMemoryMB": 100,
             "EnableTimestampNanosecond": true,
             "UsingOldContentTag": true
         }
@@ -69,6 +71,7 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(GlobalConfig::TopicType::CUSTOM, config->mTopicType);
     APSARA_TEST_EQUAL("test_topic", config->mTopicFormat);
     APSARA_TEST_EQUAL(1U, config->mPriority);
+    APSARA_TEST_EQUAL(100U, config->mMaxMemoryMB);
     APSARA_TEST_TRUE(config->mEnableTimestampNanosecond);
     APSARA_TEST_TRUE(config->mUsingOldContentTag);
 
@@ -78,6 +81,7 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
             "TopicType": true,
             "TopicFormat": true,
             "Priority": "1",
+            "MaxMemoryMB": "100",
             "EnableTimestampNanosecond": "true",
             "UsingOldContentTag": "true"
         }
@@ -89,6 +93,7 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(GlobalConfig::TopicType::NONE, config->mTopicType);
     APSARA_TEST_EQUAL("", config->mTopicFormat);
     APSARA_TEST_EQUAL(1U, config->mPriority);
+    APSARA_TEST_EQUAL(0U, config->mMaxMemoryMB);
     APSARA_TEST_FALSE(config->mEnableTimestampNanosecond);
     APSARA_TEST_FALSE(config->mUsingOldContentTag);
 
@@ -0,0 +1,190 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "collection_pipeline/limiter/MemoryGovernor.h"
+#include "collection_pipeline/limiter/MemoryQuota.h"
+#include "collection_pipeline/queue/BoundedProcessQueue.h"
+#include "models/PipelineEventGroup.h"
+#include "unittest/Unittest.h"
+#include "unittest/queue/FeedbackInterfaceMock.h"
+
+using namespace std;
+
+namespace logtail {
+
+class MemoryQuotaUnittest : public testing::Test {
+public:
+    void TestChargeAndRelease() const;
+    void TestIsExceeded() const;
+    void TestWait() const;
+    void TestPipelineQuota() const;
+    void TestBoundedProcessQueue() const;
+};
+
+void MemoryQuotaUnittest::TestChargeAndRelease() const {
+    auto parent = make_shared<MemoryQuota>("", 0);
+    MemoryQuota child1("test_config_1", 0, parent);
+    MemoryQuota child2("test_config_2", 0, parent);
+
+    child1.Charge(100);
+    child2.Charge(50);
+    APSARA_TEST_EQUAL(100, child1.GetUsage());
+    APSARA_TEST_EQUAL(50, child2.GetUsage());
+    APSARA_TEST_EQUAL(150, parent->GetUsage());
+    APSARA_TEST_EQUAL(100, child1.mUsageBytes->GetValue());
+    APSARA_TEST_EQUAL(150, parent->mUsageBytes->GetValue());
+
+    child1.Release(60);
+    APSARA_TEST_EQUAL(40, child1.GetUsage());
+    APSARA_TEST_EQUAL(90, parent->GetUsage());
+}
+
+void MemoryQuotaUnittest::TestIsExceeded() const {
+    auto parent = make_shared<MemoryQuota>("", 100);
+    MemoryQuota child1("test_config_1", 50, parent);
+    MemoryQuota child2("test_config_2", 0, parent);
+
+    child1.Charge(50);
+    APSARA_TEST_TRUE(child1.IsExceeded());
+    APSARA_TEST_FALSE(child2.IsExceeded());
+    APSARA_TEST_FALSE(parent->IsExceeded());
+
+    // the global quota is exceeded
+    child2.Charge(60);
+    APSARA_TEST_TRUE(child2.IsExceeded());
+    APSARA_TEST_TRUE(parent->IsExceeded());
+
+    child2.Release(60);
+    APSARA_TEST_FALSE(child2.IsExceeded());
+
+    // unlimited
+    child1.SetLimit(0);
+    APSARA_TEST_FALSE(child1.IsExceeded());
+    APSARA_TEST_EQUAL(0, child1.mLimitBytes->GetValue());
+}
+
+void MemoryQuotaUnittest::TestWait() const {
+    auto parent = make_shared<MemoryQuota>("", 100);
+    MemoryQuota child("test_config", 50, parent);
+    FeedbackInterfaceMock feedback;
+
+    // not exceeded
+    APSARA_TEST_FALSE(child.Wait(&feedback, 1));
+    APSARA_TEST_TRUE(child.mWaiters.empty());
+
+    // exceeded by itself
+    child.Charge(50);
+    APSARA_TEST_TRUE(child.Wait(&feedback, 1));
+    APSARA_TEST_EQUAL(1U, child.mWaiters.size());
+    APSARA_TEST_EQUAL(1U, child.mExceededTimesTotal->GetValue());
+    // polling again is not counted
+    APSARA_TEST_TRUE(child.Wait(&feedback, 1));
+    APSARA_TEST_EQUAL(1U, child.mWaiters.size());
+    APSARA_TEST_EQUAL(1U, child.mExceededTimesTotal->GetValue());
+    // still above the low watermark
+    child.Release(5);
+    APSARA_TEST_FALSE(feedback.HasFeedback(1));
+    child.Release(10);
+    APSARA_TEST_TRUE(feedback.HasFeedback(1));
+    APSARA_TEST_TRUE(child.mWaiters.empty());
+    feedback.Clear();
+
+    // exceeded by the parent
+    parent->Charge(65);
+    APSARA_TEST_TRUE(child.Wait(&feedback, 2));
+    APSARA_TEST_TRUE(child.mWaiters.empty());
+    APSARA_TEST_EQUAL(1U, parent->mWaiters.size());
+    child.Release(35);
+    APSARA_TEST_TRUE(feedback.HasFeedback(2));
+    feedback.Clear();
+    parent->Release(65);
+
+    // raising the limit wakes up waiters as well
+    child.Charge(50);
+    APSARA_TEST_TRUE(child.Wait(&feedback, 3));
+    APSARA_TEST_EQUAL(2U, child.mExceededTimesTotal->GetValue());
+    child.SetLimit(100);
+    APSARA_TEST_TRUE(feedback.HasFeedback(3));
+}
+
+void MemoryQuotaUnittest::TestPipelineQuota() const {
+    auto governor = MemoryGovernor::GetInstance();
+    auto quota = governor->GetPipelineQuota("test_config");
+    APSARA_TEST_EQUAL(quota.get(), governor->GetPipelineQuota("test_config").get());
+    APSARA_TEST_EQUAL(0, quota->GetLimit());
+
+    governor->UpdatePipelineQuota("test_config", 1024);
+    APSARA_TEST_EQUAL(1024, quota->GetLimit());
+
+    quota->Charge(100);
+    APSARA_TEST_EQUAL(100, governor->GetGlobalQuota().GetUsage());
+    quota->Release(100);
+
+    // the quota is still held, e.g., by a sender queue waiting for gc, which may be reused by a new pipeline
+    governor->RemovePipelineQuota("test_config");
+    APSARA_TEST_EQUAL(quota.get(), governor->GetPipelineQuota("test_config").get());
+
+    // a new quota is created once the old one is released
+    governor->RemovePipelineQuota("test_config");
+    quota.reset();
+    APSARA_TEST_TRUE(governor->mRemovedPipelineQuotas["test_config"].expired());
+    quota = governor->GetPipelineQuota("test_config");
+    APSARA_TEST_EQUAL(0, quota->GetLimit());
+    APSARA_TEST_TRUE(governor->mRemovedPipelineQuotas.empty());
+    governor->RemovePipelineQuota("test_config");
+}
+
+void MemoryQuotaUnittest::TestBoundedProcessQueue() const {
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config");
+    auto quota = MemoryGovernor::GetInstance()->GetPipelineQuota("test_config");
+
+    BoundedProcessQueue queue(10, 2, 8, 0, 1, ctx);
+    FeedbackInterfaceMock feedback;
+    queue.SetUpStreamFeedbacks(vector<FeedbackInterface*>{&feedback});
+    queue.EnablePop();
+
+    PipelineEventGroup g(make_shared<SourceBuffer>());
+    auto e = g.AddLogEvent();
+    e->SetContent(string("key"), string("value"));
+    size_t size = g.DataSize();
+    APSARA_TEST_TRUE(queue.Push(make_unique<ProcessQueueItem>(std::move(g), 0)));
+    APSARA_TEST_EQUAL(static_cast<int64_t>(size), quota->GetUsage());
+
+    // push is forbidden once the quota is exceeded
+    quota->SetLimit(size);
+    APSARA_TEST_FALSE(queue.IsValidToPush());
+    APSARA_TEST_FALSE(queue.Push(make_unique<ProcessQueueItem>(PipelineEventGroup(make_shared<SourceBuffer>()), 0)));
+
+    // upstream is notified once the item is popped
+    unique_ptr<ProcessQueueItem> item;
+    APSARA_TEST_TRUE(queue.Pop(item));
+    APSARA_TEST_EQUAL(0, quota->GetUsage());
+    APSARA_TEST_TRUE(feedback.HasFeedback(0));
+    APSARA_TEST_TRUE(queue.IsValidToPush());
+
+    MemoryGovernor::GetInstance()->RemovePipelineQuota("test_config");
+}
+
+UNIT_TEST_CASE(MemoryQuotaUnittest, TestChargeAndRelease)
+UNIT_TEST_CASE(MemoryQuotaUnittest, TestIsExceeded)
+UNIT_TEST_CASE(MemoryQuotaUnittest, TestWait)
+UNIT_TEST_CASE(MemoryQuotaUnittest, TestPipelineQuota)
+UNIT_TEST_CASE(MemoryQuotaUnittest, TestBoundedProcessQueue)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -215,11 +215,12 @@ private:
         {
             auto manager = ProcessQueueManager::GetInstance();
             manager->CreateOrUpdateBoundedQueue(key, 0, CollectionPipelineContext{});
-            lock_guard<mutex> lock(manager->mQueueMux);
+            lock_guard<shared_mutex> lock(manager->mQueueMux);
             auto iter = manager->mQueues.find(key);
             APSARA_TEST_NOT_EQUAL(iter, manager->mQueues.end());
             static_cast<BoundedProcessQueue*>((*iter->second.first).get())->mValidToPush = true;
             APSARA_TEST_TRUE_FATAL((*iter->second.first)->Push(std::move(item)));
+            (*iter->second.first)->UpdateMayHaveItem();
         }
     };
 
@@ -15,12 +15,16 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 
 #include "boost/regex.hpp"
 
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "models/PipelineEventGroup.h"
+#include "plugin/processor/ProcessorParseRegexNative.h"
 #include "unittest/Unittest.h"
 
 
@@ -97,6 +101,48 @@ static void BM_Regex_Search(int size, int batchSize) {
     }
 }
 
+static void BM_Parse_Regex_Engines(const std::string& regStr,
+                                   const std::vector<std::string>& keys,
+                                   const std::string& content,
+                                   int batchSize) {
+    for (const std::string engine : {"boost", "re2"}) {
+        Json::Value config;
+        config["SourceKey"] = "content";
+        config["Regex"] = regStr;
+        config["RegexEngine"] = engine;
+        for (const auto& key : keys) {
+            config["Keys"].append(key);
+        }
+        CollectionPipelineContext ctx;
+        ctx.SetConfigName("project##config_0");
+        ProcessorParseRegexNative& processor = *(new ProcessorParseRegexNative);
+        ProcessorInstance processorInstance(&processor, PluginInstance::PluginMeta("1"));
+        if (!processorInstance.Init(config, ctx)) {
+            std::cout << "failed to init processor" << std::endl;
+            return;
+        }
+
+        std::vector<PipelineEventGroup> eventGroupList;
+        for (int i = 0; i < batchSize; i++) {
+            PipelineEventGroup eventGroup(std::make_shared<SourceBuffer>());
+            for (int j = 0; j < 100; j++) {
+                eventGroup.AddLogEvent()->SetContent(std::string("content"), content);
+            }
+            eventGroupList.emplace_back(std::move(eventGroup));
+        }
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        processorInstance.Process(eventGroupList);
+        uint64_t durationTime = std::max<uint64_t>(GetCurrentTimeInMicroSeconds() - startTime, 1);
+        // the engine falls back to boost if the regex is not supported
+        bool isRe2Used = processor.mRegexEngine == ProcessorParseRegexNative::RegexEngine::RE2;
+        std::cout << engine << '\t' << (isRe2Used ? "re2" : "boost") << " used\t"
+                  << "durationTime: " << durationTime << "\tprocess: "
+                  << formatSize(content.size() * (uint64_t)batchSize * 100 * 1000000 / durationTime)
+                  << std::endl;
+    }
+}
+
 int main(int argc, char** argv) {
     logtail::Logger::Instance().InitGlobalLoggers();
 #ifdef NDEBUG
@@ -108,5 +154,19 @@ int main(int argc, char** argv) {
     BM_Regex_Match(100, 10000);
     std::cout << "BM_Regex_Search" << std::endl;
     BM_Regex_Search(100, 10000);
+    std::cout << "BM_Parse_Regex_Engines: nginx access log" << std::endl;
+    BM_Parse_Regex_Engines(
+        R"x((\S+)\s-\s(\S+)\s\[([^]]+)]\s"(\w+)\s(\S+)\s([^"]+)"\s(\d+)\s(\d+)\s"([^"]*)"\s"([^"]*)".*)x",
+        {"remote_addr", "remote_user", "time_local", "method", "url", "protocol", "status", "body_bytes_sent",
+         "http_referer", "http_user_agent"},
+        R"(127.0.0.1 - - [10/Aug/2017:14:57:51 +0800] "POST /PutData?Category=YunOsAccountOpLog HTTP/1.1" )"
+        R"(200 18204 "-" "aliyun-sdk-java")",
+        1000);
+    std::cout << "BM_Parse_Regex_Engines: log with level and message" << std::endl;
+    BM_Parse_Regex_Engines(R"(\[([^]]+)]\s\[(\w+)]\s(.*))",
+                           {"time", "level", "msg"},
+                           "[2024-01-01 00:00:00.123] [INFO] request handled, method=GET, path=/api/v1/items/1, "
+                           "status=200, latency=12ms",
+                           1000);
     return 0;
 }
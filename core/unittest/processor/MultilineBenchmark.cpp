@@ -0,0 +1,117 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+
+#include <string>
+#include <vector>
+
+#include "common/Flags.h"
+#include "common/TimeUtil.h"
+#include "constants/Constants.h"
+#include "models/PipelineEventGroup.h"
+#include "plugin/processor/inner/ProcessorSplitMultilineLogStringNative.h"
+
+DECLARE_FLAG_BOOL(enable_multiline_regex_prefilter);
+
+using namespace std;
+
+namespace logtail {
+
+class MultilineBenchmark {
+public:
+    MultilineBenchmark();
+
+    void TestSplit(const string& startPattern, bool enablePrefilter);
+
+private:
+    string mContent;
+    size_t mLineCnt = 0;
+    static const size_t kLogCnt = 200;
+    static const size_t kGroupCnt = 200;
+};
+
+MultilineBenchmark::MultilineBenchmark() {
+    // java exception logs, where most lines are stack frames which do not match the start pattern
+    for (size_t i = 0; i < kLogCnt; ++i) {
+        mContent += "2024-01-01 00:00:" + string(i % 60 < 10 ? "0" : "") + to_string(i % 60)
+            + ".123 [ERROR] [main] com.example.Server - failed to handle request " + to_string(i) + "\n";
+        mContent += "java.lang.IllegalStateException: invalid state " + to_string(i) + "\n";
+        for (size_t j = 0; j < 30; ++j) {
+            mContent += "\tat com.example.service.Handler" + to_string(j) + ".handle(Handler" + to_string(j)
+                + ".java:" + to_string(100 + j) + ")\n";
+        }
+        mContent += "Caused by: java.io.IOException: connection reset\n";
+        for (size_t j = 0; j < 10; ++j) {
+            mContent += "\tat java.net.SocketInputStream.read(SocketInputStream.java:" + to_string(200 + j) + ")\n";
+        }
+        mContent += "\t... 20 more\n";
+        mLineCnt += 44;
+    }
+    mContent.pop_back();
+}
+
+void MultilineBenchmark::TestSplit(const string& startPattern, bool enablePrefilter) {
+    // SetUp
+    BOOL_FLAG(enable_multiline_regex_prefilter) = enablePrefilter;
+    Json::Value config;
+    config["StartPattern"] = startPattern;
+    config["UnmatchedContentTreatment"] = "single_line";
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    ProcessorSplitMultilineLogStringNative processor;
+    processor.SetContext(ctx);
+    processor.CreateMetricsRecordRef(ProcessorSplitMultilineLogStringNative::sName, "1");
+    processor.Init(config);
+    processor.CommitMetricsRecordRef();
+
+    vector<PipelineEventGroup> groups;
+    for (size_t i = 0; i < kGroupCnt; ++i) {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        group.AddLogEvent()->SetContent(DEFAULT_CONTENT_KEY, mContent);
+        groups.emplace_back(std::move(group));
+    }
+
+    // Test
+    size_t eventCnt = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (auto& group : groups) {
+        processor.Process(group);
+        eventCnt += group.GetEvents().size();
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s with pattern %s and %s costs %lums, %.0f lines/ms, %zu events\n",
+           __func__,
+           startPattern.c_str(),
+           enablePrefilter ? "prefilter" : "boost regex only",
+           timeelapsed,
+           timeelapsed == 0 ? 0.0 : double(mLineCnt * kGroupCnt) / timeelapsed,
+           eventCnt);
+
+    // TearDown
+    BOOL_FLAG(enable_multiline_regex_prefilter) = false;
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::MultilineBenchmark benchmark;
+    // anchored pattern, rejected by the shape of the first chars
+    benchmark.TestSplit(R"(^\d{4}-\d{2}-\d{2} \d{2}:\d{2}:\d{2}\.\d{3} \[\w+\].*)", false);
+    benchmark.TestSplit(R"(^\d{4}-\d{2}-\d{2} \d{2}:\d{2}:\d{2}\.\d{3} \[\w+\].*)", true);
+    // unanchored pattern, rejected by the required literal
+    benchmark.TestSplit(R"(\d+:\d+:\d+\.\d+ \[\w+\] \[main\].*)", false);
+    benchmark.TestSplit(R"(\d+:\d+:\d+\.\d+ \[\w+\] \[main\].*)", true);
+    return 0;
+}
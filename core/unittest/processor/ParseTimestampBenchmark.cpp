@@ -0,0 +1,105 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <ctime>
+
+#include <string>
+#include <vector>
+
+#include "common/Flags.h"
+#include "common/LogtailCommonFlags.h"
+#include "common/TimeUtil.h"
+#include "models/PipelineEventGroup.h"
+#include "plugin/processor/ProcessorParseTimestampNative.h"
+
+DECLARE_FLAG_BOOL(enable_compiled_timestamp_parser);
+
+using namespace std;
+
+namespace logtail {
+
+class ParseTimestampBenchmark {
+public:
+    void TestParse(const string& format, bool enableCompiledParser);
+
+private:
+    static const size_t kEventCnt = 100000;
+    static const size_t kRoundCnt = 10;
+};
+
+void ParseTimestampBenchmark::TestParse(const string& format, bool enableCompiledParser) {
+    // SetUp
+    Json::Value config;
+    config["SourceKey"] = "time";
+    config["SourceFormat"] = format;
+    config["SourceTimezone"] = "GMT+08:00";
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    BOOL_FLAG(enable_compiled_timestamp_parser) = enableCompiledParser;
+    ProcessorParseTimestampNative processor;
+    processor.SetContext(ctx);
+    processor.CreateMetricsRecordRef(ProcessorParseTimestampNative::sName, "1");
+    processor.Init(config);
+    processor.CommitMetricsRecordRef();
+
+    // each event has a different second, so the second-level cache never hits, as when old logs are collected
+    vector<string> times;
+    time_t now = time(nullptr);
+    char buf[128];
+    string layout = format;
+    size_t pos = 0;
+    if ((pos = layout.find("%f")) != string::npos) {
+        layout.replace(pos, 2, "123456");
+    }
+    for (size_t i = 0; i < kEventCnt; ++i) {
+        time_t t = now - kEventCnt + i;
+        struct tm timeInfo;
+        localtime_r(&t, &timeInfo);
+        times.emplace_back(buf, strftime(buf, sizeof(buf), layout.c_str(), &timeInfo));
+    }
+
+    // Test
+    uint64_t timeelapsed = 0;
+    size_t successCnt = 0;
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        for (const auto& t : times) {
+            group.AddLogEvent()->SetContentNoCopy(StringView("time"), StringView(t));
+        }
+        uint64_t starttime = GetCurrentTimeInMicroSeconds();
+        processor.Process(group);
+        timeelapsed += GetCurrentTimeInMicroSeconds() - starttime;
+        successCnt += group.GetEvents().size();
+    }
+    printf("%s for %s with %s costs %lums, %.0f parses/s, %zu events parsed\n",
+           __func__,
+           format.c_str(),
+           enableCompiledParser ? "compiled parser" : "strptime",
+           timeelapsed / 1000,
+           timeelapsed == 0 ? 0.0 : kEventCnt * kRoundCnt * 1000000.0 / timeelapsed,
+           successCnt);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    BOOL_FLAG(ilogtail_discard_old_data) = false;
+    logtail::ParseTimestampBenchmark benchmark;
+    for (const char* format : {"%Y-%m-%d %H:%M:%S", "%Y-%m-%dT%H:%M:%S.%f", "%d/%b/%Y:%H:%M:%S %z"}) {
+        benchmark.TestParse(format, false);
+        benchmark.TestParse(format, true);
+    }
+    return 0;
+}
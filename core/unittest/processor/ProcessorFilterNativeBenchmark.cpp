@@ -0,0 +1,93 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+
+#include <string>
+
+#include "common/Flags.h"
+#include "common/TimeUtil.h"
+#include "models/PipelineEventGroup.h"
+#include "plugin/processor/ProcessorFilterNative.h"
+
+DECLARE_FLAG_BOOL(enable_filter_regex_set);
+
+using namespace std;
+
+namespace logtail {
+
+class ProcessorFilterNativeBenchmark {
+public:
+    void TestFilter(bool enableRegexSet);
+
+private:
+    static const size_t kKeyCnt = 20;
+    static const size_t kEventCnt = 10000;
+    static const size_t kRoundCnt = 10;
+};
+
+void ProcessorFilterNativeBenchmark::TestFilter(bool enableRegexSet) {
+    // SetUp
+    Json::Value config;
+    for (size_t i = 0; i < kKeyCnt; ++i) {
+        config["FilterKey"].append("key" + to_string(i));
+        // typical patterns: a known prefix or a set of alternatives
+        config["FilterRegex"].append(i % 2 == 0 ? "value" + to_string(i) + "_\\d+.*" : "(GET|POST|PUT)\\s/api/.*");
+    }
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    BOOL_FLAG(enable_filter_regex_set) = enableRegexSet;
+    ProcessorFilterNative processor;
+    processor.SetContext(ctx);
+    processor.CreateMetricsRecordRef(ProcessorFilterNative::sName, "1");
+    processor.Init(config);
+    processor.CommitMetricsRecordRef();
+
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    for (size_t i = 0; i < kEventCnt; ++i) {
+        auto e = group.AddLogEvent();
+        for (size_t j = 0; j < kKeyCnt; ++j) {
+            e->SetContent("key" + to_string(j),
+                          j % 2 == 0 ? "value" + to_string(j) + "_" + to_string(i) + " request handled successfully"
+                                     : "POST /api/v1/items/" + to_string(i) + "?page=1&size=100 HTTP/1.1");
+        }
+    }
+
+    // Test
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        // all events are matched, so the group can be processed again
+        processor.Process(group);
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s with %s costs %lums for %zu events with %zu keys, %zu events left\n",
+           __func__,
+           enableRegexSet ? "regex set" : "boost regex",
+           timeelapsed,
+           kEventCnt * kRoundCnt,
+           kKeyCnt,
+           group.GetEvents().size());
+
+    // TearDown
+    BOOL_FLAG(enable_filter_regex_set) = false;
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::ProcessorFilterNativeBenchmark benchmark;
+    benchmark.TestFilter(false);
+    benchmark.TestFilter(true);
+    return 0;
+}
@@ -13,10 +13,13 @@
 // limitations under the License.
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "common/ExceptionBase.h"
+#include "common/Flags.h"
 #include "common/JsonUtil.h"
 #include "plugin/processor/ProcessorFilterNative.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_BOOL(enable_filter_regex_set);
+
 using boost::regex;
 using namespace std;
 
@@ -31,6 +34,7 @@ public:
     void TestLogFilterRule();
     void TestBaseFilter();
     void TestFilterNoneUtf8();
+    void TestKeyMatchers();
 
     CollectionPipelineContext mContext;
 };
@@ -40,6 +44,7 @@ UNIT_TEST_CASE(ProcessorFilterNativeUnittest, OnFailedInit)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestLogFilterRule)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestBaseFilter)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestFilterNoneUtf8)
+UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestKeyMatchers)
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -1111,6 +1116,74 @@ void ProcessorFilterNativeUnittest::TestFilterNoneUtf8() {
     }
 } // end of case
 
+void ProcessorFilterNativeUnittest::TestKeyMatchers() {
+    Json::Value configJson;
+    string configStr, errorMsg;
+    configStr = R"(
+        {
+            "Type": "processor_filter_regex_native",
+            "FilterKey": [
+                "key1",
+                "key2",
+                "key1",
+                "key3"
+            ],
+            "FilterRegex": [
+                "value.*",
+                "^(\\w+)-\\1$",
+                ".*1",
+                "a.c"
+            ]
+        }
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+
+    auto createProcessor = [&](bool enableRegexSet) {
+        BOOL_FLAG(enable_filter_regex_set) = enableRegexSet;
+        auto processor = make_unique<ProcessorFilterNative>();
+        processor->SetContext(mContext);
+        processor->CreateMetricsRecordRef(ProcessorFilterNative::sName, "1");
+        APSARA_TEST_TRUE(processor->Init(configJson));
+        processor->CommitMetricsRecordRef();
+        BOOL_FLAG(enable_filter_regex_set) = false;
+        return processor;
+    };
+    auto boostProcessor = createProcessor(false);
+    APSARA_TEST_TRUE(boostProcessor->mFilterRule->KeyMatchers.empty());
+    auto setProcessor = createProcessor(true);
+    const auto& matchers = setProcessor->mFilterRule->KeyMatchers;
+    APSARA_TEST_EQUAL(3U, matchers.size());
+    APSARA_TEST_EQUAL("key1", matchers[0].Key);
+    APSARA_TEST_EQUAL(2U, matchers[0].RegSetSize);
+    APSARA_TEST_TRUE(matchers[0].BoostRegIdxs.empty());
+    // backreference is not supported by RE2
+    APSARA_TEST_EQUAL("key2", matchers[1].Key);
+    APSARA_TEST_EQUAL(nullptr, matchers[1].RegSet);
+    APSARA_TEST_EQUAL(vector<size_t>({1}), matchers[1].BoostRegIdxs);
+    APSARA_TEST_EQUAL("key3", matchers[2].Key);
+    APSARA_TEST_EQUAL(1U, matchers[2].RegSetSize);
+
+    vector<vector<pair<string, string>>> cases = {
+        {{"key1", "value1"}, {"key2", "abc-abc"}, {"key3", "abc"}},
+        {{"key1", "value1"}, {"key2", "abc-abd"}, {"key3", "abc"}},
+        {{"key1", "value2"}, {"key2", "abc-abc"}, {"key3", "abc"}},
+        {{"key1", "xvalue1"}, {"key2", "abc-abc"}, {"key3", "abc"}},
+        {{"key1", "value\n1"}, {"key2", "abc-abc"}, {"key3", "a\nc"}},
+        {{"key1", "value1"}, {"key2", "abc-abc"}},
+        {{"key1", "value1"}, {"key2", "abc-abc"}, {"key3", "abcd"}},
+    };
+    vector<bool> expected = {true, false, false, false, true, false, false};
+    for (size_t i = 0; i < cases.size(); ++i) {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        auto event = group.AddLogEvent();
+        for (const auto& kv : cases[i]) {
+            event->SetContent(kv.first, kv.second);
+        }
+        APSARA_TEST_EQUAL(expected[i], boostProcessor->IsMatched(*event, *boostProcessor->mFilterRule));
+        APSARA_TEST_EQUAL(expected[i], setProcessor->IsMatched(*event, *setProcessor->mFilterRule));
+    }
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -35,6 +35,7 @@ public:
     void TestProcessEventKeyCountUnmatch();
     void TestProcessRegexRaw();
     void TestProcessRegexContent();
+    void TestRegexEngine();
 
 protected:
     void SetUp() override { ctx.SetConfigName("test_config"); }
@@ -652,6 +653,109 @@ void ProcessorParseRegexNativeUnittest::TestProcessEventKeyCountUnmatch() {
     APSARA_TEST_EQUAL_FATAL(0, processor.mOutFailedEventsTotal->GetValue());
 }
 
+void ProcessorParseRegexNativeUnittest::TestRegexEngine() {
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Keys"] = Json::arrayValue;
+    config["Keys"].append("key1");
+    config["Keys"].append("key2");
+    config["Keys"].append("key3");
+    config["KeepingSourceWhenParseFail"] = true;
+    config["KeepingSourceWhenParseSucceed"] = false;
+    config["RenamedSourceKey"] = "rawLog";
+    {
+        // re2 gives the same result as boost
+        config["Regex"] = R"((\w+)\t(\w+)?.*\n(.*))";
+        config["RegexEngine"] = "re2";
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        std::string inJson = R"({
+            "events" :
+            [
+                {
+                    "contents" :
+                    {
+                        "content" : "value1\t\tvalue2\nvalue3"
+                    },
+                    "timestamp" : 12345678901,
+                    "type" : 1
+                },
+                {
+                    "contents" :
+                    {
+                        "content" : "value4 value5"
+                    },
+                    "timestamp" : 12345678901,
+                    "type" : 1
+                }
+            ]
+        })";
+        eventGroup.FromJsonString(inJson);
+        ProcessorParseRegexNative& processor = *(new ProcessorParseRegexNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, ctx));
+        APSARA_TEST_TRUE(ProcessorParseRegexNative::RegexEngine::RE2 == processor.mRegexEngine);
+        std::vector<PipelineEventGroup> eventGroupList;
+        eventGroupList.emplace_back(std::move(eventGroup));
+        processorInstance.Process(eventGroupList);
+
+        std::string expectJson = R"({
+            "events" :
+            [
+                {
+                    "contents" :
+                    {
+                        "key1" : "value1",
+                        "key2" : "",
+                        "key3" : "value3"
+                    },
+                    "timestamp" : 12345678901,
+                    "type" : 1
+                },
+                {
+                    "contents" :
+                    {
+                        "rawLog" : "value4 value5"
+                    },
+                    "timestamp" : 12345678901,
+                    "type" : 1
+                }
+            ]
+        })";
+        std::string outJson = eventGroupList[0].ToJsonString();
+        APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
+    }
+    {
+        // backreference is not supported by re2
+        config["Regex"] = R"((\w+)\t(\1)\t(\w+))";
+        config["RegexEngine"] = "re2";
+        ProcessorParseRegexNative& processor = *(new ProcessorParseRegexNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, ctx));
+        APSARA_TEST_TRUE(ProcessorParseRegexNative::RegexEngine::BOOST == processor.mRegexEngine);
+
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        auto e = eventGroup.AddLogEvent();
+        e->SetContent(std::string("content"), std::string("value1\tvalue1\tvalue2"));
+        std::vector<PipelineEventGroup> eventGroupList;
+        eventGroupList.emplace_back(std::move(eventGroup));
+        processorInstance.Process(eventGroupList);
+        const auto& event = eventGroupList[0].GetEvents()[0].Cast<LogEvent>();
+        APSARA_TEST_EQUAL("value1", event.GetContent("key2").to_string());
+        APSARA_TEST_EQUAL("value2", event.GetContent("key3").to_string());
+    }
+    {
+        // unknown engine
+        config["Regex"] = R"((\w+)\t(\w+)\t(\w+))";
+        config["RegexEngine"] = "unknown";
+        ProcessorParseRegexNative& processor = *(new ProcessorParseRegexNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, ctx));
+        APSARA_TEST_TRUE(ProcessorParseRegexNative::RegexEngine::BOOST == processor.mRegexEngine);
+    }
+}
+
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestInit)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, OnSuccessfulInit)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessWholeLine)
@@ -662,6 +766,7 @@ UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessEventDiscardUnmatch
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessEventKeyCountUnmatch)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessRegexRaw)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessRegexContent)
+UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestRegexEngine)
 
 } // namespace logtail
 
@@ -0,0 +1,136 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+
+#include <random>
+#include <string>
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/SimdUtil.h"
+#include "common/TimeUtil.h"
+#include "constants/Constants.h"
+#include "models/LogEvent.h"
+#include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
+
+using namespace std;
+
+namespace logtail {
+
+class SplitLogStringBenchmark {
+public:
+    SplitLogStringBenchmark();
+
+    void TestFindChar(const char* name, const char* (*find)(const char*, const char*, char));
+    void TestProcessor();
+
+private:
+    string mData;
+    size_t mLineCnt = 0;
+    // 64MB * 16 = 1GB
+    static const size_t kDataSize = 64 * 1024 * 1024;
+    static const size_t kRoundCnt = 16;
+};
+
+SplitLogStringBenchmark::SplitLogStringBenchmark() {
+    // mixed-length lines: mostly short access logs, with some long lines like stack traces or json
+    mt19937 rng(0);
+    mData.reserve(kDataSize + 8192);
+    while (mData.size() < kDataSize) {
+        size_t len = 0;
+        switch (rng() % 10) {
+            case 0:
+                len = 1024 + rng() % 4096;
+                break;
+            case 1:
+            case 2:
+                len = 16 + rng() % 48;
+                break;
+            default:
+                len = 100 + rng() % 200;
+                break;
+        }
+        for (size_t i = 0; i < len; ++i) {
+            mData.push_back(static_cast<char>(' ' + rng() % 95));
+        }
+        mData.push_back('\n');
+        ++mLineCnt;
+    }
+}
+
+void SplitLogStringBenchmark::TestFindChar(const char* name, const char* (*find)(const char*, const char*, char)) {
+    size_t lineCnt = 0;
+    uint64_t starttime = GetCurrentTimeInMicroSeconds();
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        const char* begin = mData.data();
+        const char* end = mData.data() + mData.size();
+        while (begin < end) {
+            begin = find(begin, end, '\n') + 1;
+            ++lineCnt;
+        }
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMicroSeconds() - starttime;
+    printf("%s with %s costs %lums, %.2fGB/s, %zu lines\n",
+           __func__,
+           name,
+           timeelapsed / 1000,
+           timeelapsed == 0 ? 0.0 : mData.size() * kRoundCnt / 1024.0 / 1024.0 / 1024.0 * 1000000 / timeelapsed,
+           lineCnt);
+}
+
+void SplitLogStringBenchmark::TestProcessor() {
+    // SetUp
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    ProcessorSplitLogStringNative processor;
+    processor.SetContext(ctx);
+    processor.CreateMetricsRecordRef(ProcessorSplitLogStringNative::sName, "1");
+    processor.Init(Json::Value(Json::objectValue));
+    processor.CommitMetricsRecordRef();
+
+    // Test
+    uint64_t timeelapsed = 0;
+    size_t eventCnt = 0;
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        auto sourceBuffer = make_shared<SourceBuffer>();
+        PipelineEventGroup group(sourceBuffer);
+        auto e = group.AddLogEvent();
+        e->SetContentNoCopy(DEFAULT_CONTENT_KEY, StringView(mData.data(), mData.size()));
+        e->SetPosition(0, mData.size());
+        uint64_t starttime = GetCurrentTimeInMicroSeconds();
+        processor.Process(group);
+        timeelapsed += GetCurrentTimeInMicroSeconds() - starttime;
+        eventCnt += group.GetEvents().size();
+    }
+    printf("%s with %s costs %lums, %.2fGB/s, %zu events\n",
+           __func__,
+           SimdLevelToString(GetSimdLevel()),
+           timeelapsed / 1000,
+           timeelapsed == 0 ? 0.0 : mData.size() * kRoundCnt / 1024.0 / 1024.0 / 1024.0 * 1000000 / timeelapsed,
+           eventCnt);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::SplitLogStringBenchmark benchmark;
+    benchmark.TestFindChar("scalar", logtail::FindCharScalar);
+    benchmark.TestFindChar("sse2", logtail::FindCharSse2);
+    if (logtail::GetSimdLevel() == logtail::SimdLevel::AVX2) {
+        benchmark.TestFindChar("avx2", logtail::FindCharAvx2);
+    }
+    benchmark.TestFindChar("dispatched", logtail::FindChar);
+    benchmark.TestProcessor();
+    return 0;
+}
@@ -18,6 +18,7 @@
 
 #include <string>
 
+#include "models/PipelineEventGroup.h"
 #include "prometheus/Constants.h"
 #include "prometheus/labels/Labels.h"
 #include "unittest/Unittest.h"
@@ -93,10 +94,48 @@ void LabelsUnittest::TestRange() {
     APSARA_TEST_EQUAL(testMap, resMap);
 }
 
+void LabelsUnittest::TestHash() {
+    Labels labels1;
+    labels1.Set("host", "172.17.0.3:9100");
+    labels1.Set("ip", "172.17.0.3");
+    Labels labels2;
+    labels2.Set("ip", "172.17.0.3");
+    labels2.Set("host", "172.17.0.3:9100");
+    APSARA_TEST_EQUAL(labels1.Hash(), labels2.Hash());
+    // same as the fingerprint of prometheus, which identifies targets and should not change
+    APSARA_TEST_EQUAL(3141800852447314420ULL, labels1.Hash());
+
+    labels2.Set("ip", "172.17.0.4");
+    APSARA_TEST_NOT_EQUAL(labels1.Hash(), labels2.Hash());
+
+    // pieces are not simply concatenated
+    Labels labels3;
+    labels3.Set("ab", "c");
+    Labels labels4;
+    labels4.Set("a", "bc");
+    APSARA_TEST_NOT_EQUAL(labels3.Hash(), labels4.Hash());
+
+    // labels over a metric event are hashed the same way, regardless of the order of tags
+    PipelineEventGroup eventGroup(make_shared<SourceBuffer>());
+    auto* e1 = eventGroup.AddMetricEvent();
+    e1->SetName("up");
+    e1->SetTag(string("job"), string("node"));
+    e1->SetTag(string("instance"), string("localhost"));
+    auto* e2 = eventGroup.AddMetricEvent();
+    e2->SetName("up");
+    e2->SetTag(string("instance"), string("localhost"));
+    e2->SetTag(string("job"), string("node"));
+    Labels labels5;
+    labels5.Reset(e1);
+    Labels labels6;
+    labels6.Reset(e2);
+    APSARA_TEST_EQUAL(labels5.Hash(), labels6.Hash());
+}
 
 UNIT_TEST_CASE(LabelsUnittest, TestGet)
 UNIT_TEST_CASE(LabelsUnittest, TestSet)
 UNIT_TEST_CASE(LabelsUnittest, TestRange)
+UNIT_TEST_CASE(LabelsUnittest, TestHash)
 UNIT_TEST_CASE(LabelsUnittest, TestRemoveMetaLabels)
 
 
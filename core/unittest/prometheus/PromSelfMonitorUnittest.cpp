@@ -10,6 +10,7 @@ class PromSelfMonitorUnittest : public ::testing::Test {
 public:
     void TestCounterAdd();
     void TestIntGaugeSet();
+    void TestObserveHistogram();
 };
 
 void PromSelfMonitorUnittest::TestCounterAdd() {
@@ -47,9 +48,46 @@ void PromSelfMonitorUnittest::TestIntGaugeSet() {
     APSARA_TEST_EQUAL(0ULL, metric->GetValue());
 }
 
+void PromSelfMonitorUnittest::TestObserveHistogram() {
+    auto selfMonitor = std::make_shared<PromSelfMonitorUnsafe>();
+    std::unordered_map<std::string, MetricType> testMetricKeys = {
+        {METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS, MetricType::METRIC_TYPE_COUNTER},
+        {METRIC_PLUGIN_PROM_SCRAPE_INFLIGHT, MetricType::METRIC_TYPE_COUNTER},
+    };
+    selfMonitor->InitMetricManager(testMetricKeys, MetricLabels{});
+
+    std::vector<uint64_t> buckets = {10, 100};
+    selfMonitor->ObserveHistogram(METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS, buckets, 5);
+    selfMonitor->ObserveHistogram(METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS, buckets, 10);
+    selfMonitor->ObserveHistogram(METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS, buckets, 50);
+    selfMonitor->ObserveHistogram(METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS, buckets, 1000);
+
+    // check result
+    auto& skewBuckets = selfMonitor->mPromBucketMap[METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS];
+    APSARA_TEST_EQUAL(3UL, skewBuckets.size());
+    auto metric = skewBuckets["10"]->GetCounter(METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS);
+    APSARA_TEST_EQUAL("prom_scrape_start_skew_ms", metric->GetName());
+    APSARA_TEST_EQUAL(2ULL, metric->GetValue());
+    metric = skewBuckets["100"]->GetCounter(METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS);
+    APSARA_TEST_EQUAL(3ULL, metric->GetValue());
+    metric = skewBuckets["+Inf"]->GetCounter(METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS);
+    APSARA_TEST_EQUAL(4ULL, metric->GetValue());
+
+    // buckets with the same le of another histogram are kept apart
+    selfMonitor->ObserveHistogram(METRIC_PLUGIN_PROM_SCRAPE_INFLIGHT, {10}, 1);
+    auto& inFlightBuckets = selfMonitor->mPromBucketMap[METRIC_PLUGIN_PROM_SCRAPE_INFLIGHT];
+    APSARA_TEST_EQUAL(2UL, inFlightBuckets.size());
+    APSARA_TEST_NOT_EQUAL(skewBuckets["10"].get(), inFlightBuckets["10"].get());
+    APSARA_TEST_NOT_EQUAL(skewBuckets["+Inf"].get(), inFlightBuckets["+Inf"].get());
+    metric = inFlightBuckets["+Inf"]->GetCounter(METRIC_PLUGIN_PROM_SCRAPE_INFLIGHT);
+    APSARA_TEST_EQUAL(1ULL, metric->GetValue());
+    APSARA_TEST_EQUAL(4ULL, skewBuckets["+Inf"]->GetCounter(METRIC_PLUGIN_PROM_SCRAPE_START_SKEW_MS)->GetValue());
+}
+
 
 UNIT_TEST_CASE(PromSelfMonitorUnittest, TestCounterAdd)
 UNIT_TEST_CASE(PromSelfMonitorUnittest, TestIntGaugeSet)
+UNIT_TEST_CASE(PromSelfMonitorUnittest, TestObserveHistogram)
 
 } // namespace logtail
 
@@ -15,11 +15,17 @@
  */
 
 #include <json/json.h>
+#include <xxhash/xxhash.h>
 
+#include <algorithm>
 #include <boost/regex.hpp>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "common/JsonUtil.h"
+#include "common/StringTools.h"
+#include "models/PipelineEventGroup.h"
 #include "prometheus/labels/Relabel.h"
 #include "unittest/Unittest.h"
 
@@ -49,6 +55,9 @@ public:
     void TestLowerCase();
     void TestUpperCase();
     void TestMultiRelabel();
+    void TestSimpleFormat();
+    void TestProcessMetricEvent();
+    void TestMatchCache();
 };
 
 
@@ -375,6 +384,42 @@ void RelabelConfigUnittest::TestHashMod() {
     configList.Process(result);
     APSARA_TEST_EQUAL((size_t)4, result.Size());
     APSARA_TEST_TRUE(!result.Get("hash_val").empty());
+
+    // md5 is the default, which keeps the assignments of earlier versions
+    configStr = R"(
+        {
+            "action": "hashmod",
+            "source_labels": ["pod_ip"],
+            "target_label": "hash_val",
+            "modulus": 1000
+        }
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    RelabelConfig md5Config;
+    APSARA_TEST_TRUE(md5Config.Init(configJson));
+    APSARA_TEST_FALSE(md5Config.mHashModUseXXHash);
+    result = hashmodLabels;
+    md5Config.Process(result);
+    APSARA_TEST_EQUAL("472", result.Get("hash_val"));
+
+    configJson["hash_algorithm"] = "xxhash";
+    RelabelConfig xxhashConfig;
+    APSARA_TEST_TRUE(xxhashConfig.Init(configJson));
+    APSARA_TEST_TRUE(xxhashConfig.mHashModUseXXHash);
+    result = hashmodLabels;
+    xxhashConfig.Process(result);
+    APSARA_TEST_EQUAL(ToString(XXH64("172.17.0.3", 10, 0) % 1000), result.Get("hash_val"));
+
+    // labels and events give the same assignment
+    PipelineEventGroup eventGroup(make_shared<SourceBuffer>());
+    auto* event = eventGroup.AddMetricEvent();
+    event->SetTag(string("pod_ip"), string("172.17.0.3"));
+    xxhashConfig.Process(*event);
+    APSARA_TEST_EQUAL(result.Get("hash_val"), event->GetTag("hash_val").to_string());
+
+    configJson["hash_algorithm"] = "unknown";
+    RelabelConfig invalidConfig;
+    APSARA_TEST_FALSE(invalidConfig.Init(configJson));
 }
 
 void RelabelConfigUnittest::TestLabelMap() {
@@ -511,6 +556,139 @@ void RelabelConfigUnittest::TestMultiRelabel() {
     APSARA_TEST_TRUE(configList.Process(result));
 }
 
+void RelabelConfigUnittest::TestSimpleFormat() {
+    RelabelConfig config;
+    APSARA_TEST_EQUAL(RelabelConfig::RegexType::MATCH_ALL, config.mRegexType);
+    APSARA_TEST_TRUE(config.mIsRegexCaptureAll);
+    APSARA_TEST_TRUE(config.mSimpleReplacement.mIsValid);
+
+    vector<pair<string, bool>> formats = {{"$1", true},
+                                          {"${1}:9100", true},
+                                          {"a$0b$&c", true},
+                                          {"$$1", true},
+                                          {"", true},
+                                          {"literal", true},
+                                          {"$10", false},
+                                          {"$2", false},
+                                          {"${name}", false},
+                                          {"a\\nb", false},
+                                          {"$`", false},
+                                          {"$", false}};
+    boost::regex regex("(.*)");
+    for (const auto& [format, isValid] : formats) {
+        RelabelConfig::SimpleFormat simpleFormat;
+        APSARA_TEST_EQUAL_DESC(isValid, simpleFormat.Init(format), format);
+        if (!isValid) {
+            continue;
+        }
+        for (const string value : {"", "172.17.0.3", "a\nb"}) {
+            string buffer;
+            APSARA_TEST_EQUAL_DESC(boost::regex_replace(value, regex, format, boost::format_first_only),
+                                   simpleFormat.Format(value, buffer).to_string(),
+                                   format + " " + value);
+        }
+    }
+
+    Json::Value configJson;
+    string errorMsg;
+    APSARA_TEST_TRUE(ParseJsonTable(R"({"action": "keep", "regex": "node-exporter"})", configJson, errorMsg));
+    APSARA_TEST_TRUE(config.Init(configJson));
+    APSARA_TEST_EQUAL(RelabelConfig::RegexType::LITERAL, config.mRegexType);
+    APSARA_TEST_TRUE(ParseJsonTable(R"({"action": "keep", "regex": "node.*"})", configJson, errorMsg));
+    APSARA_TEST_TRUE(config.Init(configJson));
+    APSARA_TEST_EQUAL(RelabelConfig::RegexType::GENERAL, config.mRegexType);
+    APSARA_TEST_FALSE(config.mIsRegexCaptureAll);
+}
+
+void RelabelConfigUnittest::TestProcessMetricEvent() {
+    // each config is processed by both Labels and MetricEvent, and the results should be the same
+    vector<string> configStrs = {
+        R"x([{"action": "replace", "source_labels": ["ip"], "target_label": "__address__",
+            "replacement": "${1}:9100"}])x",
+        R"x([{"action": "replace", "source_labels": ["ip", "app"], "target_label": "t_$1", "separator": "-"}])x",
+        R"x([{"action": "replace", "source_labels": ["ip"], "target_label": "x", "regex": "(\\d+)\\.(\\d+).*",
+            "replacement": "$2-$1"}])x",
+        R"x([{"action": "replace", "source_labels": ["ip"], "target_label": "x", "regex": "none(.*)"}])x",
+        R"x([{"action": "replace", "source_labels": ["missing"], "target_label": "app"}])x",
+        R"x([{"action": "keep", "source_labels": ["app"], "regex": "node-exporter"}])x",
+        R"x([{"action": "keep", "source_labels": ["app"], "regex": "node"}])x",
+        R"x([{"action": "drop", "source_labels": ["__name__"], "regex": "http_.*"}])x",
+        R"x([{"action": "drop", "source_labels": ["__name__"], "regex": "go_.*"}])x",
+        R"x([{"action": "keep", "source_labels": ["app", "ip"], "regex": "node-exporter;172.*"}])x",
+        R"x([{"action": "keepequal", "source_labels": ["ip"], "target_label": "pod_ip"}])x",
+        R"x([{"action": "dropequal", "source_labels": ["ip"], "target_label": "pod_ip"}])x",
+        R"x([{"action": "lowercase", "source_labels": ["mixed"], "target_label": "lower"}])x",
+        R"x([{"action": "uppercase", "source_labels": ["mixed", "app"], "target_label": "upper"}])x",
+        R"x([{"action": "hashmod", "source_labels": ["ip"], "target_label": "shard", "modulus": 7}])x",
+        R"x([{"action": "labelmap", "regex": "meta_(.+)", "replacement": "mapped_$1"}])x",
+        R"x([{"action": "labeldrop", "regex": "meta_.*"}])x",
+        R"x([{"action": "labelkeep", "regex": "ip|app|__name__"}])x",
+        R"x([{"action": "labeldrop", "regex": "mixed"}])x",
+        R"x([{"action": "dropmetric", "match_list": ["http_requests_total"]}])x",
+        R"x([{"action": "dropmetric", "match_list": ["go_goroutines"]}])x",
+        R"x([{"action": "replace", "source_labels": ["app"], "target_label": "job"},
+            {"action": "labeldrop", "regex": "meta_a"},
+            {"action": "keep", "source_labels": ["job"], "regex": "node-.*"}])x"};
+    vector<pair<string, string>> tags = {{"ip", "172.17.0.3"},
+                                         {"pod_ip", "172.17.0.3"},
+                                         {"app", "node-exporter"},
+                                         {"mixed", "MiXeD"},
+                                         {"meta_a", "a"},
+                                         {"meta_b", "b"}};
+    for (const auto& configStr : configStrs) {
+        Json::Value configJson;
+        string errorMsg;
+        APSARA_TEST_TRUE_FATAL(ParseJsonTable(configStr, configJson, errorMsg));
+        RelabelConfigList configList;
+        APSARA_TEST_TRUE_FATAL(configList.Init(configJson));
+
+        Labels labels;
+        labels.Set("__name__", "http_requests_total");
+        for (const auto& [k, v] : tags) {
+            labels.Set(k, v);
+        }
+        bool expectedRes = configList.Process(labels);
+        vector<pair<string, string>> expected;
+        labels.Range([&expected](const string& k, const string& v) { expected.emplace_back(k, v); });
+
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        auto event = group.AddMetricEvent();
+        event->SetName("http_requests_total");
+        for (const auto& [k, v] : tags) {
+            event->SetTag(k, v);
+        }
+        APSARA_TEST_EQUAL_DESC(expectedRes, configList.Process(*event), configStr);
+        if (!expectedRes) {
+            continue;
+        }
+        vector<pair<string, string>> actual;
+        for (auto it = event->TagsBegin(); it != event->TagsEnd(); ++it) {
+            actual.emplace_back(it->first.to_string(), it->second.to_string());
+        }
+        sort(actual.begin(), actual.end());
+        APSARA_TEST_TRUE_DESC(expected == actual, configStr);
+    }
+}
+
+void RelabelConfigUnittest::TestMatchCache() {
+    Json::Value configJson;
+    string errorMsg;
+    APSARA_TEST_TRUE(ParseJsonTable(
+        R"([{"action": "drop", "source_labels": ["__name__"], "regex": "go_.*"}])", configJson, errorMsg));
+    RelabelConfigList configList;
+    APSARA_TEST_TRUE(configList.Init(configJson));
+
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    vector<RelabelMatchCache> matchCaches;
+    for (const auto& name : {"go_goroutines", "http_requests_total", "go_goroutines", "go_threads"}) {
+        auto event = group.AddMetricEvent();
+        event->SetName(name);
+        APSARA_TEST_EQUAL_DESC(name[0] != 'g', configList.Process(*event, &matchCaches), name);
+    }
+    APSARA_TEST_EQUAL(1U, matchCaches.size());
+    APSARA_TEST_EQUAL(3U, matchCaches[0].size());
+}
+
 UNIT_TEST_CASE(ActionConverterUnittest, TestStringToAction)
 UNIT_TEST_CASE(ActionConverterUnittest, TestActionToString)
 
@@ -528,6 +706,9 @@ UNIT_TEST_CASE(RelabelConfigUnittest, TestKeepEqual)
 UNIT_TEST_CASE(RelabelConfigUnittest, TestLowerCase)
 UNIT_TEST_CASE(RelabelConfigUnittest, TestUpperCase)
 UNIT_TEST_CASE(RelabelConfigUnittest, TestMultiRelabel)
+UNIT_TEST_CASE(RelabelConfigUnittest, TestSimpleFormat)
+UNIT_TEST_CASE(RelabelConfigUnittest, TestProcessMetricEvent)
+UNIT_TEST_CASE(RelabelConfigUnittest, TestMatchCache)
 
 } // namespace logtail
 
@@ -27,6 +27,7 @@
 #include "models/RawEvent.h"
 #include "prometheus/Constants.h"
 #include "prometheus/async/PromFuture.h"
+#include "prometheus/component/ScrapeLimiter.h"
 #include "prometheus/component/StreamScraper.h"
 #include "prometheus/labels/Labels.h"
 #include "prometheus/schedulers/ScrapeConfig.h"
@@ -47,6 +48,7 @@ public:
     void TestTokenUpdate();
     void TestQueueIsFull();
     void TestExactlyScrape();
+    void TestScrapeLimit();
 
 protected:
     void SetUp() override {
@@ -352,6 +354,34 @@ void ScrapeSchedulerUnittest::TestExactlyScrape() {
                       std::chrono::seconds(mScrapeConfig->mScrapeIntervalSeconds * 3));
 }
 
+void ScrapeSchedulerUnittest::TestScrapeLimit() {
+    auto* limiter = prom::ScrapeLimiter::GetInstance();
+    limiter->mLimiter.SetCurrentLimit(1);
+    APSARA_TEST_TRUE(limiter->TryAcquire(0));
+    APSARA_TEST_FALSE(limiter->TryAcquire(0));
+    APSARA_TEST_EQUAL(1U, limiter->GetInFlightCount());
+    limiter->Release(true);
+    APSARA_TEST_EQUAL(0U, limiter->GetInFlightCount());
+
+    Labels labels;
+    labels.Set(prometheus::ADDRESS_LABEL_NAME, "localhost:8080");
+    PromTargetInfo targetInfo;
+    targetInfo.mLabels = labels;
+    targetInfo.mHash = "test_hash";
+    ScrapeScheduler event(mScrapeConfig, "localhost", 8080, "http", "/metrics", 15, 15, 0, 0, targetInfo);
+    event.CalculateFirstExecTime(chrono::steady_clock::now(), chrono::system_clock::now());
+    APSARA_TEST_TRUE(event.TryAcquireScrape());
+    APSARA_TEST_FALSE(event.TryAcquireScrape());
+    APSARA_TEST_EQUAL(1U, limiter->GetInFlightCount());
+
+    // the slot is given back only once, either when the scrape is done or when the target is cancelled
+    event.ReleaseScrape(true);
+    APSARA_TEST_EQUAL(0U, limiter->GetInFlightCount());
+    event.Cancel();
+    APSARA_TEST_EQUAL(0U, limiter->GetInFlightCount());
+    APSARA_TEST_EQUAL(0U, limiter->mLimiter.GetInSendingCount());
+}
+
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestInitscrapeScheduler)
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestProcess)
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestStreamMetricWriteCallback)
@@ -359,6 +389,7 @@ UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestScheduler)
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestQueueIsFull)
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestExactlyScrape)
 UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestTokenUpdate)
+UNIT_TEST_CASE(ScrapeSchedulerUnittest, TestScrapeLimit)
 
 
 } // namespace logtail
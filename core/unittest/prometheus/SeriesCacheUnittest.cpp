@@ -0,0 +1,172 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstring>
+
+#include <memory>
+#include <string>
+
+#include "common/StringTools.h"
+#include "models/MetricEvent.h"
+#include "models/PipelineEventGroup.h"
+#include "prometheus/Constants.h"
+#include "prometheus/component/SeriesCache.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail::prom {
+class SeriesCacheUnittest : public testing::Test {
+public:
+    void TestStaleMarkers();
+    void TestStreamsOutOfOrder();
+    void TestUnchangedSampleHeartbeat();
+    void TestExpireTargets();
+
+private:
+    PipelineEventGroup MakeGroup(const string& target,
+                                 uint64_t scrapeMs,
+                                 const vector<pair<string, double>>& samples,
+                                 uint64_t streamTotal = 1) const;
+};
+
+PipelineEventGroup SeriesCacheUnittest::MakeGroup(const string& target,
+                                                  uint64_t scrapeMs,
+                                                  const vector<pair<string, double>>& samples,
+                                                  uint64_t streamTotal) const {
+    PipelineEventGroup eGroup(make_shared<SourceBuffer>());
+    eGroup.SetMetadata(EventGroupMetaKey::PROMETHEUS_STREAM_ID, target);
+    eGroup.SetMetadata(EventGroupMetaKey::PROMETHEUS_SCRAPE_TIMESTAMP_MILLISEC, ToString(scrapeMs));
+    if (streamTotal > 0) {
+        eGroup.SetMetadata(EventGroupMetaKey::PROMETHEUS_STREAM_TOTAL, ToString(streamTotal));
+    }
+    for (const auto& [name, value] : samples) {
+        auto* e = eGroup.AddMetricEvent();
+        e->SetName(name);
+        e->SetValue<UntypedSingleValue>(value);
+        e->SetTimestamp(scrapeMs / 1000);
+        e->SetTag(string("instance"), target);
+    }
+    return eGroup;
+}
+
+static bool IsStaleNaN(const MetricEvent& e) {
+    uint64_t bits = 0;
+    double value = e.GetValue<UntypedSingleValue>()->mValue;
+    memcpy(&bits, &value, sizeof(double));
+    return bits == prometheus::STALE_NAN;
+}
+
+void SeriesCacheUnittest::TestStaleMarkers() {
+    SeriesCache cache(true, 0, 15000);
+    auto eGroup = MakeGroup("t1", 15000, {{"a", 1}, {"b", 2}});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(2U, eGroup.GetEvents().size());
+
+    // b vanishes
+    eGroup = MakeGroup("t1", 30000, {{"a", 1}});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(2U, eGroup.GetEvents().size());
+    const auto& stale = eGroup.GetEvents()[1].Cast<MetricEvent>();
+    APSARA_TEST_EQUAL("b", stale.GetName().to_string());
+    APSARA_TEST_EQUAL("t1", stale.GetTag("instance").to_string());
+    APSARA_TEST_EQUAL(30, stale.GetTimestamp());
+    APSARA_TEST_TRUE(std::isnan(stale.GetValue<UntypedSingleValue>()->mValue));
+    APSARA_TEST_TRUE(IsStaleNaN(stale));
+
+    // marked only once
+    eGroup = MakeGroup("t1", 45000, {{"a", 1}});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(1U, eGroup.GetEvents().size());
+
+    // a failed scrape marks all series stale
+    eGroup = MakeGroup("t1", 60000, {});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(1U, eGroup.GetEvents().size());
+    APSARA_TEST_TRUE(IsStaleNaN(eGroup.GetEvents()[0].Cast<MetricEvent>()));
+
+    // late group of an earlier scrape is passed through
+    eGroup = MakeGroup("t1", 45000, {{"c", 1}});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(1U, eGroup.GetEvents().size());
+    APSARA_TEST_EQUAL(0U, cache.mTargets["t1"]->mSeries.size());
+}
+
+void SeriesCacheUnittest::TestStreamsOutOfOrder() {
+    SeriesCache cache(true, 0, 15000);
+    auto eGroup = MakeGroup("t1", 15000, {{"a", 1}, {"b", 2}});
+    cache.Process(eGroup);
+
+    // the last stream is processed first, so the scrape is not complete yet
+    auto last = MakeGroup("t1", 30000, {}, 2);
+    cache.Process(last);
+    APSARA_TEST_EQUAL(0U, last.GetEvents().size());
+    auto first = MakeGroup("t1", 30000, {{"a", 1}}, 0);
+    cache.Process(first);
+    APSARA_TEST_EQUAL(2U, first.GetEvents().size());
+    APSARA_TEST_EQUAL("b", first.GetEvents()[1].Cast<MetricEvent>().GetName().to_string());
+    APSARA_TEST_TRUE(IsStaleNaN(first.GetEvents()[1].Cast<MetricEvent>()));
+}
+
+void SeriesCacheUnittest::TestUnchangedSampleHeartbeat() {
+    SeriesCache cache(false, 30000, 15000);
+    auto eGroup = MakeGroup("t1", 15000, {{"a", 1}, {"b", 2}});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(2U, eGroup.GetEvents().size());
+
+    eGroup = MakeGroup("t1", 30000, {{"a", 1}, {"b", 3}});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(1U, eGroup.GetEvents().size());
+    APSARA_TEST_EQUAL("b", eGroup.GetEvents()[0].Cast<MetricEvent>().GetName().to_string());
+
+    // heartbeat of a is due
+    eGroup = MakeGroup("t1", 45000, {{"a", 1}, {"b", 3}});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(1U, eGroup.GetEvents().size());
+    APSARA_TEST_EQUAL("a", eGroup.GetEvents()[0].Cast<MetricEvent>().GetName().to_string());
+
+    // no stale markers, but vanished series are forgotten
+    eGroup = MakeGroup("t1", 60000, {{"b", 3}});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(1U, eGroup.GetEvents().size());
+    APSARA_TEST_EQUAL("b", eGroup.GetEvents()[0].Cast<MetricEvent>().GetName().to_string());
+    APSARA_TEST_EQUAL(1U, cache.mTargets["t1"]->mSeries.size());
+    APSARA_TEST_TRUE(cache.mTargets["t1"]->mSeries.begin()->second.mName.empty());
+}
+
+void SeriesCacheUnittest::TestExpireTargets() {
+    SeriesCache cache(true, 0, 15000);
+    auto eGroup = MakeGroup("t1", 15000, {{"a", 1}});
+    cache.Process(eGroup);
+    eGroup = MakeGroup("t2", 15000, {{"a", 1}});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(2U, cache.TargetCount());
+
+    eGroup = MakeGroup("t2", 15000 + 15000 * 6, {{"a", 1}});
+    cache.Process(eGroup);
+    APSARA_TEST_EQUAL(1U, cache.TargetCount());
+    APSARA_TEST_TRUE(cache.mTargets.find("t2") != cache.mTargets.end());
+}
+
+UNIT_TEST_CASE(SeriesCacheUnittest, TestStaleMarkers)
+UNIT_TEST_CASE(SeriesCacheUnittest, TestStreamsOutOfOrder)
+UNIT_TEST_CASE(SeriesCacheUnittest, TestUnchangedSampleHeartbeat)
+UNIT_TEST_CASE(SeriesCacheUnittest, TestExpireTargets)
+
+} // namespace logtail::prom
+
+UNIT_TEST_MAIN
@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
+#include <cstring>
+
 #include <string>
+#include <vector>
 
 #include "MetricEvent.h"
 #include "models/PipelineEventGroup.h"
@@ -35,6 +39,8 @@ public:
     void TestParseMetricWithTagsAndTimestamp() const;
     void TestParseMetricWithManyTags() const;
     void TestParseUnicodeLabelValue();
+    void TestParseEscapedLabelValue();
+    void TestParseSampleValue();
 
     void TestParseFaliure();
     void TestParseSuccess();
@@ -388,6 +394,64 @@ void TextParserUnittest::TestParseUnicodeLabelValue() {
 
 UNIT_TEST_CASE(TextParserUnittest, TestParseUnicodeLabelValue)
 
+void TextParserUnittest::TestParseEscapedLabelValue() {
+    TextParser parser;
+    string rawData = R"(foo{a="x\ny",b="line1\nline2",c="\"quoted\"",d="back\\slash",e="win\path",f="end\\"} 1)";
+    auto res = parser.Parse(rawData, 0, 0);
+    APSARA_TEST_EQUAL(1UL, res.GetEvents().size());
+    const auto& metric = res.GetEvents().back().Cast<MetricEvent>();
+    APSARA_TEST_EQUAL("x\ny", metric.GetTag("a").to_string());
+    APSARA_TEST_EQUAL("line1\nline2", metric.GetTag("b").to_string());
+    APSARA_TEST_EQUAL("\"quoted\"", metric.GetTag("c").to_string());
+    APSARA_TEST_EQUAL("back\\slash", metric.GetTag("d").to_string());
+    APSARA_TEST_EQUAL("win\\path", metric.GetTag("e").to_string());
+    APSARA_TEST_EQUAL("end\\", metric.GetTag("f").to_string());
+
+    // escaped quote is not the end of label value
+    rawData = R"(foo{a="x\"} 1)";
+    res = parser.Parse(rawData, 0, 0);
+    APSARA_TEST_EQUAL(0UL, res.GetEvents().size());
+}
+
+UNIT_TEST_CASE(TextParserUnittest, TestParseEscapedLabelValue)
+
+void TextParserUnittest::TestParseSampleValue() {
+    TextParser parser;
+    // parsed in place or by strtod, the results should be the same
+    vector<string> values = {"0",
+                             "-0",
+                             "+1",
+                             "1.",
+                             ".5",
+                             "123.456",
+                             "-1.5e-3",
+                             "9.9410452992e+10",
+                             "1E22",
+                             "1e23",
+                             "12345678901234567890",
+                             "0.1000000000000000055511151231257827",
+                             "1.7976931348623157e308",
+                             "0x10",
+                             "NaN"};
+    for (const auto& value : values) {
+        string rawData = "foo " + value;
+        auto res = parser.Parse(rawData, 0, 0);
+        APSARA_TEST_EQUAL_DESC(1UL, res.GetEvents().size(), value);
+        if (res.GetEvents().empty()) {
+            continue;
+        }
+        double expected = strtod(value.c_str(), nullptr);
+        double actual = res.GetEvents().back().Cast<MetricEvent>().GetValue<UntypedSingleValue>()->mValue;
+        APSARA_TEST_EQUAL_DESC(0, memcmp(&expected, &actual, sizeof(double)), value);
+    }
+    for (const auto& value : {"", "1e", "1.2.3", "--1", "1e400", "e5"}) {
+        string rawData = string("foo ") + value;
+        APSARA_TEST_EQUAL_DESC(0UL, parser.Parse(rawData, 0, 0).GetEvents().size(), value);
+    }
+}
+
+UNIT_TEST_CASE(TextParserUnittest, TestParseSampleValue)
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -0,0 +1,115 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "common/TimeUtil.h"
+#include "models/PipelineEventGroup.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ProcessQueueManagerBenchmark {
+public:
+    void TestPopItem(size_t queueCnt, size_t pushThreadCnt, size_t popThreadCnt, size_t itemCntPerQueue);
+};
+
+void ProcessQueueManagerBenchmark::TestPopItem(size_t queueCnt,
+                                               size_t pushThreadCnt,
+                                               size_t popThreadCnt,
+                                               size_t itemCntPerQueue) {
+    // SetUp
+    auto manager = ProcessQueueManager::GetInstance();
+    vector<QueueKey> keys;
+    for (size_t i = 0; i < queueCnt; ++i) {
+        string configName = "benchmark_config_" + to_string(i);
+        QueueKey key = QueueKeyManager::GetInstance()->GetKey(configName);
+        CollectionPipelineContext ctx;
+        ctx.SetConfigName(configName);
+        ctx.SetProcessQueueKey(key);
+        manager->CreateOrUpdateBoundedQueue(key, 0, ctx);
+        manager->EnablePop(configName);
+        keys.push_back(key);
+    }
+    const size_t total = queueCnt * itemCntPerQueue;
+    atomic_size_t poppedCnt = 0;
+
+    // Test
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    vector<future<void>> pushers;
+    for (size_t t = 0; t < pushThreadCnt; ++t) {
+        pushers.emplace_back(async(launch::async, [&, t]() {
+            for (size_t n = 0; n < itemCntPerQueue; ++n) {
+                for (size_t i = t; i < keys.size(); i += pushThreadCnt) {
+                    auto item = make_unique<ProcessQueueItem>(PipelineEventGroup(make_shared<SourceBuffer>()), 0);
+                    while (manager->PushQueue(keys[i], std::move(item)) != QueueStatus::OK) {
+                        item = make_unique<ProcessQueueItem>(PipelineEventGroup(make_shared<SourceBuffer>()), 0);
+                        this_thread::yield();
+                    }
+                }
+            }
+        }));
+    }
+    vector<future<void>> poppers;
+    for (size_t t = 0; t < popThreadCnt; ++t) {
+        poppers.emplace_back(async(launch::async, [&, t]() {
+            unique_ptr<ProcessQueueItem> item;
+            string configName;
+            while (poppedCnt.load() < total) {
+                if (manager->PopItem(t, item, configName)) {
+                    ++poppedCnt;
+                    item.reset();
+                } else {
+                    this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (auto& f : pushers) {
+        f.get();
+    }
+    for (auto& f : poppers) {
+        f.get();
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s with %zu queues, %zu push threads and %zu pop threads costs %lums, %.0f items/s\n",
+           __func__,
+           queueCnt,
+           pushThreadCnt,
+           popThreadCnt,
+           timeelapsed,
+           timeelapsed == 0 ? 0.0 : total * 1000.0 / timeelapsed);
+
+    // TearDown
+    manager->Clear();
+    QueueKeyManager::GetInstance()->Clear();
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::ProcessQueueManagerBenchmark benchmark;
+    benchmark.TestPopItem(500, 4, 1, 2000);
+    benchmark.TestPopItem(500, 4, 16, 2000);
+    return 0;
+}
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <future>
 #include <memory>
 
 #include "collection_pipeline/CollectionPipelineManager.h"
@@ -34,6 +36,8 @@ public:
     void TestSetQueueUpstreamAndDownStream();
     void TestPushQueue();
     void TestPopItem();
+    void TestConcurrentPopItem();
+    void TestPopItemTrigger();
     void TestIsAllQueueEmpty();
     void OnPipelineUpdate();
 
@@ -323,6 +327,70 @@ void ProcessQueueManagerUnittest::TestPopItem() {
     APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key1].first);
 }
 
+void ProcessQueueManagerUnittest::TestConcurrentPopItem() {
+    const size_t queueCnt = 10, itemCntPerQueue = 5, threadCnt = 4;
+    for (size_t i = 0; i < queueCnt; ++i) {
+        string configName = "test_config_" + to_string(i);
+        QueueKey key = QueueKeyManager::GetInstance()->GetKey(configName);
+        CollectionPipelineContext ctx;
+        ctx.SetConfigName(configName);
+        sProcessQueueManager->CreateOrUpdateBoundedQueue(key, i % 2, ctx);
+        sProcessQueueManager->EnablePop(configName);
+        for (size_t j = 0; j < itemCntPerQueue; ++j) {
+            APSARA_TEST_EQUAL(QueueStatus::OK, sProcessQueueManager->PushQueue(key, GenerateItem()));
+        }
+    }
+
+    atomic_size_t poppedCnt = 0;
+    vector<future<void>> res;
+    for (size_t t = 0; t < threadCnt; ++t) {
+        res.emplace_back(async(launch::async, [&, t]() {
+            unique_ptr<ProcessQueueItem> item;
+            string configName;
+            while (poppedCnt.load() < queueCnt * itemCntPerQueue) {
+                if (sProcessQueueManager->PopItem(t, item, configName)) {
+                    ++poppedCnt;
+                }
+            }
+        }));
+    }
+    for (auto& r : res) {
+        r.get();
+    }
+    APSARA_TEST_EQUAL(queueCnt * itemCntPerQueue, poppedCnt.load());
+    APSARA_TEST_TRUE(sProcessQueueManager->IsAllQueueEmpty());
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(0, item, configName));
+}
+
+void ProcessQueueManagerUnittest::TestPopItemTrigger() {
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config_1");
+    QueueKey key = QueueKeyManager::GetInstance()->GetKey("test_config_1");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key, 0, ctx);
+    sProcessQueueManager->EnablePop("test_config_1");
+    sProcessQueueManager->PushQueue(key, GenerateItem());
+    sProcessQueueManager->PushQueue(key, GenerateItem());
+    sProcessQueueManager->Wait(0);
+
+    // items left in the queue after popping, other threads should be woken up
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_TRUE(sProcessQueueManager->mValidToPop);
+    sProcessQueueManager->Wait(0);
+
+    // no items left
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_FALSE(sProcessQueueManager->mValidToPop);
+
+    // a failed pop clears the flag, so that idle threads do not spin
+    sProcessQueueManager->Trigger();
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_FALSE(sProcessQueueManager->mValidToPop);
+}
+
 void ProcessQueueManagerUnittest::TestIsAllQueueEmpty() {
     CollectionPipelineContext ctx;
     ctx.SetConfigName("test_config_1");
@@ -448,6 +516,8 @@ UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestDeleteQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestSetQueueUpstreamAndDownStream)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPushQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItem)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestConcurrentPopItem)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItemTrigger)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestIsAllQueueEmpty)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, OnPipelineUpdate)
 
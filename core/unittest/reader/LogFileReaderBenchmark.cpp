@@ -0,0 +1,112 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+
+#include <fstream>
+#include <string>
+
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "common/RuntimeUtil.h"
+#include "common/TimeUtil.h"
+#include "file_server/reader/LogFileReader.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_zero_copy_read);
+
+namespace logtail {
+
+class LogFileReaderBenchmark {
+public:
+    LogFileReaderBenchmark() {
+        mLogPathDir = GetProcessExecutionDir();
+        if (PATH_SEPARATOR[0] == mLogPathDir.back()) {
+            mLogPathDir.resize(mLogPathDir.size() - 1);
+        }
+    }
+
+    // each line is a json of lineSize bytes, so that most reads end with an unfinished line
+    void PrepareFile(size_t lineSize, size_t fileSize) {
+        std::string line = "{\"time\":\"2025-01-01T00:00:00.000000000Z\",\"content\":\"";
+        line.append(lineSize - line.size() - 3, 'a');
+        line.append("\"}\n");
+        std::ofstream out(mLogPathDir + PATH_SEPARATOR + mLogFile, std::ios::trunc | std::ios::binary);
+        for (size_t written = 0; written < fileSize; written += line.size()) {
+            out << line;
+        }
+    }
+
+    void RemoveFile() { remove((mLogPathDir + PATH_SEPARATOR + mLogFile).c_str()); }
+
+    void TestReadUTF8(bool zeroCopy, int rounds);
+
+private:
+    std::string mLogPathDir;
+    std::string mLogFile = "LogFileReaderBenchmark.log";
+    MultilineOptions mMultilineOpts;
+    FileReaderOptions mReaderOpts;
+    FileTagOptions mFileTagOpts;
+    CollectionPipelineContext mCtx;
+};
+
+void LogFileReaderBenchmark::TestReadUTF8(bool zeroCopy, int rounds) {
+    BOOL_FLAG(enable_zero_copy_read) = zeroCopy;
+    mReaderOpts.mInputType = FileReaderOptions::InputType::InputFile;
+    uint64_t totalBytes = 0;
+    uint64_t durationTime = 0;
+    for (int i = 0; i < rounds; ++i) {
+        LogFileReader reader(mLogPathDir,
+                             mLogFile,
+                             DevInode(),
+                             std::make_pair(&mReaderOpts, &mCtx),
+                             std::make_pair(&mMultilineOpts, &mCtx),
+                             std::make_pair(&mFileTagOpts, &mCtx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        reader.CheckFileSignatureAndOffset(true);
+        int64_t fileSize = reader.mLogFileOp.GetFileSize();
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        bool moreData = true;
+        while (moreData) {
+            LogBuffer logBuffer;
+            reader.ReadUTF8(logBuffer, fileSize, moreData);
+            totalBytes += logBuffer.readLength;
+        }
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    printf("%s zero copy: %d, read %lu bytes, costs %luus, %.1f MB/s\n",
+           __func__,
+           zeroCopy,
+           totalBytes,
+           durationTime,
+           totalBytes / 1024.0 / 1024.0 * 1000000 / (durationTime ? durationTime : 1));
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+    logtail::LogFileReaderBenchmark benchmark;
+    for (size_t lineSize : {256, 4096, 64 * 1024}) {
+        printf("line size: %lu\n", lineSize);
+        benchmark.PrepareFile(lineSize, 256 * 1024 * 1024);
+        // warm up page cache
+        benchmark.TestReadUTF8(false, 1);
+        benchmark.TestReadUTF8(false, 5);
+        benchmark.TestReadUTF8(true, 5);
+    }
+    benchmark.RemoveFile();
+    return 0;
+}
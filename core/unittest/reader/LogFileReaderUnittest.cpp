@@ -25,6 +25,7 @@
 #include "unittest/Unittest.h"
 
 DECLARE_FLAG_INT32(force_release_deleted_file_fd_timeout);
+DECLARE_FLAG_BOOL(enable_zero_copy_read);
 
 namespace logtail {
 
@@ -65,10 +66,12 @@ public:
     }
     void TearDown() override {
         LogFileReader::BUFFER_SIZE = 1024 * 512;
+        BOOL_FLAG(enable_zero_copy_read) = false;
         FileServer::GetInstance()->RemoveFileDiscoveryConfig("");
     }
     void TestReadGBK();
     void TestReadUTF8();
+    void TestReadUTF8ZeroCopy();
 
     std::unique_ptr<char[]> expectedContent;
     static std::string logPathDir;
@@ -84,6 +87,7 @@ protected:
 
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadGBK);
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8);
+UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8ZeroCopy);
 
 std::string LogFileReaderUnittest::logPathDir;
 std::string LogFileReaderUnittest::gbkFile;
@@ -576,6 +580,90 @@ void LogFileReaderUnittest::TestReadUTF8() {
     }
 }
 
+void LogFileReaderUnittest::TestReadUTF8ZeroCopy() {
+    BOOL_FLAG(enable_zero_copy_read) = true;
+    { // read twice, singleline, the tail is kept in place
+        MultilineOptions multilineOpts;
+        FileReaderOptions readerOpts;
+        readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        LogFileReader reader(logPathDir,
+                             utf8File,
+                             DevInode(),
+                             std::make_pair(&readerOpts, &ctx),
+                             std::make_pair(&multilineOpts, &ctx),
+                             std::make_pair(&fileTagOpts, &ctx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        int64_t fileSize = reader.mLogFileOp.GetFileSize();
+        reader.CheckFileSignatureAndOffset(true);
+        LogFileReader::BUFFER_SIZE = fileSize - 13;
+        bool moreData = false;
+        // first read
+        std::unique_ptr<LogBuffer> logBuffer1(new LogBuffer());
+        reader.ReadUTF8(*logBuffer1, fileSize, moreData);
+        APSARA_TEST_TRUE_FATAL(moreData);
+        std::string expectedPart(expectedContent.get());
+        expectedPart.resize(expectedPart.rfind("iLogtail") - 1);
+        APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer1->rawBuffer.data());
+        APSARA_TEST_EQUAL_FATAL(0UL, reader.mCache.size());
+        APSARA_TEST_TRUE_FATAL(reader.mReadChunkTailSize > 0);
+        APSARA_TEST_EQUAL_FATAL(reader.mLastFilePos + reader.mReadChunkTailSize, reader.GetLastReadPos());
+        const char* tail = reader.mReadChunk.get() + reader.mReadChunkTailOffset;
+        // second read, the tail is not moved
+        LogBuffer logBuffer2;
+        reader.ReadUTF8(logBuffer2, fileSize, moreData);
+        APSARA_TEST_FALSE_FATAL(moreData);
+        expectedPart = expectedContent.get();
+        expectedPart = expectedPart.substr(expectedPart.rfind("iLogtail"));
+        APSARA_TEST_EQUAL_FATAL(tail, logBuffer2.rawBuffer.data());
+        APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer2.rawBuffer.data());
+        APSARA_TEST_EQUAL_FATAL(0UL, reader.GetCacheSize());
+        APSARA_TEST_EQUAL_FATAL(nullptr, reader.mReadChunk.get());
+        // the chunk is still valid after the reader and the first buffer release it
+        logBuffer1.reset();
+        APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer2.rawBuffer.data());
+    }
+    { // read twice, multiline, and force read the tail after the file is closed
+        Json::Value config;
+        config["StartPattern"] = "iLogtail.*";
+        MultilineOptions multilineOpts;
+        multilineOpts.Init(config, ctx, "");
+        FileReaderOptions readerOpts;
+        readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        LogFileReader reader(logPathDir,
+                             utf8File,
+                             DevInode(),
+                             std::make_pair(&readerOpts, &ctx),
+                             std::make_pair(&multilineOpts, &ctx),
+                             std::make_pair(&fileTagOpts, &ctx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        int64_t fileSize = reader.mLogFileOp.GetFileSize();
+        reader.CheckFileSignatureAndOffset(true);
+        LogBuffer logBuffer;
+        bool moreData = false;
+        reader.ReadUTF8(logBuffer, fileSize, moreData);
+        APSARA_TEST_FALSE_FATAL(moreData);
+        std::string expectedPart(expectedContent.get());
+        expectedPart.resize(expectedPart.rfind("iLogtail") - 1);
+        APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
+        size_t tailSize = reader.mReadChunkTailSize;
+        APSARA_TEST_TRUE_FATAL(tailSize > 0);
+        APSARA_TEST_EQUAL_FATAL(fileSize, reader.GetLastReadPos());
+        // the tail is moved to cache when the file is closed
+        reader.CloseFilePtr();
+        APSARA_TEST_EQUAL_FATAL(nullptr, reader.mReadChunk.get());
+        APSARA_TEST_EQUAL_FATAL(tailSize, reader.mCache.size());
+        LogBuffer logBuffer2;
+        reader.ReadUTF8(logBuffer2, fileSize, moreData);
+        expectedPart = expectedContent.get();
+        expectedPart = expectedPart.substr(expectedPart.rfind("iLogtail"));
+        APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer2.rawBuffer.data());
+        APSARA_TEST_EQUAL_FATAL(0UL, reader.GetCacheSize());
+        APSARA_TEST_EQUAL_FATAL(fileSize, reader.mLastFilePos);
+    }
+}
+
 class LogMultiBytesUnittest : public ::testing::Test {
 public:
     static void SetUpTestCase() {
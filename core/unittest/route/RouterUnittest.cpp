@@ -127,6 +127,9 @@ void RouterUnittest::TestRoute() {
         APSARA_TEST_EQUAL(1U, res[0].second.GetEvents().size());
         APSARA_TEST_EQUAL(0U, res[1].first);
         APSARA_TEST_EQUAL(1U, res[0].second.GetEvents().size());
+        // events are shared instead of copied
+        APSARA_TEST_TRUE(res[0].second.GetEvents()[0].IsShared());
+        APSARA_TEST_EQUAL(res[0].second.GetEvents()[0].operator->(), res[1].second.GetEvents()[0].operator->());
     }
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
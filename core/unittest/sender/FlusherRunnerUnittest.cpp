@@ -21,6 +21,7 @@
 #include "unittest/plugin/PluginMock.h"
 
 DECLARE_FLAG_INT32(discard_send_fail_interval);
+DECLARE_FLAG_INT32(flusher_runner_dispatch_thread_count);
 
 using namespace std;
 
@@ -30,6 +31,8 @@ class FlusherRunnerUnittest : public ::testing::Test {
 public:
     void TestDispatch();
     void TestPushToHttpSink();
+    void TestPushToHttpSinkWithLimit();
+    void TestDispatchers();
 
 protected:
     static void SetUpTestCase() { AppConfig::GetInstance()->mSendRequestGlobalConcurrency = 10; }
@@ -37,6 +40,7 @@ protected:
     void TearDown() override {
         SenderQueueManager::GetInstance()->Clear();
         HttpSink::GetInstance()->mQueue.Clear();
+        FlusherRunner::GetInstance()->mHttpSendingCnt = 0;
     }
 };
 
@@ -142,8 +146,82 @@ void FlusherRunnerUnittest::TestPushToHttpSink() {
     }
 }
 
+void FlusherRunnerUnittest::TestPushToHttpSinkWithLimit() {
+    auto flusher = make_unique<FlusherHttpMock>();
+    Json::Value tmp;
+    CollectionPipelineContext ctx;
+    flusher->SetContext(ctx);
+    flusher->CreateMetricsRecordRef("name", "1");
+    flusher->Init(Json::Value(), tmp);
+    flusher->CommitMetricsRecordRef();
+
+    auto item = make_unique<SenderQueueItem>("content", 10, flusher.get(), flusher->GetQueueKey());
+    auto realItem = item.get();
+    flusher->PushToQueue(std::move(item));
+
+    FlusherRunner::GetInstance()->mHttpSendingCnt = AppConfig::GetInstance()->GetSendRequestGlobalConcurrency();
+    auto res = async(launch::async, [realItem]() { return FlusherRunner::GetInstance()->PushToHttpSink(realItem); });
+    APSARA_TEST_EQUAL(future_status::timeout, res.wait_for(chrono::milliseconds(100)));
+    APSARA_TEST_TRUE(HttpSink::GetInstance()->mQueue.Empty());
+
+    // the waiting thread should be woken up once the sending count is decreased
+    FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
+    APSARA_TEST_EQUAL(future_status::ready, res.wait_for(chrono::milliseconds(100)));
+    APSARA_TEST_TRUE(res.get());
+    APSARA_TEST_FALSE(HttpSink::GetInstance()->mQueue.Empty());
+    APSARA_TEST_EQUAL(AppConfig::GetInstance()->GetSendRequestGlobalConcurrency(),
+                      FlusherRunner::GetInstance()->GetSendingBufferCount());
+}
+
+void FlusherRunnerUnittest::TestDispatchers() {
+    auto flusher = make_unique<FlusherHttpMock>();
+    Json::Value tmp;
+    CollectionPipelineContext ctx;
+    flusher->SetContext(ctx);
+    flusher->CreateMetricsRecordRef("name", "1");
+    flusher->Init(Json::Value(), tmp);
+    flusher->CommitMetricsRecordRef();
+
+    INT32_FLAG(flusher_runner_dispatch_thread_count) = 2;
+    auto runner = FlusherRunner::GetInstance();
+    runner->StartDispatchers();
+    APSARA_TEST_EQUAL(2U, runner->mDispatchers.size());
+
+    vector<SenderQueueItem*> realItems;
+    for (size_t i = 0; i < 5; ++i) {
+        auto item = make_unique<SenderQueueItem>("content", 10, flusher.get(), flusher->GetQueueKey());
+        realItems.push_back(item.get());
+        flusher->PushToQueue(std::move(item));
+    }
+    vector<SenderQueueItem*> items;
+    SenderQueueManager::GetInstance()->GetAvailableItems(items, -1);
+    APSARA_TEST_FALSE(items.empty());
+    // items from the same queue are dispatched by the same dispatcher
+    auto& dispatcher = runner->mDispatchers[flusher->GetQueueKey() % runner->mDispatchers.size()];
+    {
+        lock_guard<mutex> lock(dispatcher->mMux);
+        for (auto item : items) {
+            dispatcher->mTasks.emplace_back(item, chrono::system_clock::now());
+        }
+    }
+    dispatcher->mCV.notify_one();
+    // remaining tasks are handled before dispatchers exit
+    runner->StopDispatchers();
+    APSARA_TEST_TRUE(runner->mDispatchers.empty());
+
+    for (auto item : items) {
+        unique_ptr<HttpSinkRequest> req;
+        APSARA_TEST_TRUE(HttpSink::GetInstance()->mQueue.TryPop(req));
+        APSARA_TEST_EQUAL(item, req->mItem);
+    }
+    APSARA_TEST_TRUE(HttpSink::GetInstance()->mQueue.Empty());
+    INT32_FLAG(flusher_runner_dispatch_thread_count) = 0;
+}
+
 UNIT_TEST_CASE(FlusherRunnerUnittest, TestDispatch)
 UNIT_TEST_CASE(FlusherRunnerUnittest, TestPushToHttpSink)
+UNIT_TEST_CASE(FlusherRunnerUnittest, TestPushToHttpSinkWithLimit)
+UNIT_TEST_CASE(FlusherRunnerUnittest, TestDispatchers)
 
 } // namespace logtail
 
@@ -0,0 +1,150 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/resource.h>
+
+#include <cstdio>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "collection_pipeline/plugin/interface/HttpFlusher.h"
+#include "collection_pipeline/queue/SenderQueueItem.h"
+#include "common/Flags.h"
+#include "common/TimeUtil.h"
+#include "runner/sink/http/HttpSink.h"
+#include "unittest/sender/LocalHttpServer.h"
+
+DECLARE_FLAG_BOOL(enable_http_sink_epoll);
+
+using namespace std;
+
+namespace logtail {
+
+class FlusherHttpBenchmark : public HttpFlusher {
+public:
+    static const string sName;
+
+    const string& Name() const override { return sName; }
+    bool Init([[maybe_unused]] const Json::Value& config, [[maybe_unused]] Json::Value& optionalGoPipeline) override {
+        return true;
+    }
+    bool Send([[maybe_unused]] PipelineEventGroup&& g) override { return true; }
+    bool Flush([[maybe_unused]] size_t key) override { return true; }
+    bool FlushAll() override { return true; }
+    bool BuildRequest([[maybe_unused]] SenderQueueItem* item,
+                      [[maybe_unused]] unique_ptr<HttpSinkRequest>& req,
+                      [[maybe_unused]] bool* keepItem,
+                      [[maybe_unused]] string* errMsg) override {
+        return false;
+    }
+    // called by http sink thread only
+    void OnSendDone(const HttpResponse& response, [[maybe_unused]] SenderQueueItem* item) override {
+        if (response.GetStatusCode() != 200) {
+            ++mFailedCnt;
+        }
+        mResponseTimeMs.push_back(response.GetResponseTime().count());
+        ++mDoneCnt;
+    }
+
+    vector<int64_t> mResponseTimeMs;
+    atomic_size_t mDoneCnt = 0;
+    size_t mFailedCnt = 0;
+};
+
+const string FlusherHttpBenchmark::sName = "flusher_http_benchmark";
+
+class HttpSinkBenchmark {
+public:
+    void TestSend(bool enableEpoll, size_t concurrency, size_t roundCnt);
+};
+
+void HttpSinkBenchmark::TestSend(bool enableEpoll, size_t concurrency, size_t roundCnt) {
+    // SetUp
+    LocalHttpServer server;
+    if (!server.Start()) {
+        printf("failed to start local http server\n");
+        return;
+    }
+    BOOL_FLAG(enable_http_sink_epoll) = enableEpoll;
+    HttpSink sink;
+    sink.Init();
+
+    FlusherHttpBenchmark flusher;
+    vector<unique_ptr<SenderQueueItem>> items;
+    for (size_t i = 0; i < concurrency; ++i) {
+        items.emplace_back(make_unique<SenderQueueItem>("", 0, &flusher, 0));
+    }
+
+    // Test
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (size_t round = 0; round < roundCnt; ++round) {
+        size_t target = (round + 1) * concurrency;
+        for (auto& item : items) {
+            sink.AddRequest(make_unique<HttpSinkRequest>(
+                "GET", false, "127.0.0.1", server.GetPort(), "/", "", map<string, string>(), "", item.get()));
+        }
+        while (flusher.mDoneCnt.load() < target) {
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+
+    // TearDown
+    sink.Stop();
+    server.Stop();
+
+    auto& latency = flusher.mResponseTimeMs;
+    sort(latency.begin(), latency.end());
+    auto percentile = [&latency](double p) { return latency[min(latency.size() - 1, size_t(latency.size() * p))]; };
+    printf("%s with %s and %zu concurrent handles costs %lums, %.0f requests/s, failed %zu, latency p50 %ldms p99 "
+           "%ldms p999 %ldms\n",
+           __func__,
+           enableEpoll ? "epoll" : "select",
+           concurrency,
+           timeelapsed,
+           timeelapsed == 0 ? 0.0 : latency.size() * 1000.0 / timeelapsed,
+           flusher.mFailedCnt,
+           percentile(0.5),
+           percentile(0.99),
+           percentile(0.999));
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    // each handle takes 2 fds in this process, one for the client and one for the server
+    rlimit limit{};
+    getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+
+    logtail::HttpSinkBenchmark benchmark;
+    // select cannot watch fds larger than FD_SETSIZE
+    benchmark.TestSend(false, 400, 10);
+    benchmark.TestSend(true, 400, 10);
+    for (size_t concurrency : {1000, 5000, 10000}) {
+        if (limit.rlim_cur < 2 * concurrency + 100) {
+            printf("open files limit %lu is too small for %zu concurrent handles, skip\n",
+                   (unsigned long)limit.rlim_cur,
+                   concurrency);
+            continue;
+        }
+        benchmark.TestSend(true, concurrency, 10);
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "collection_pipeline/plugin/interface/HttpFlusher.h"
+#include "collection_pipeline/queue/SenderQueueItem.h"
+#include "common/Flags.h"
+#include "runner/sink/http/HttpSink.h"
+#include "unittest/Unittest.h"
+#include "unittest/sender/LocalHttpServer.h"
+
+DECLARE_FLAG_BOOL(enable_http_sink_epoll);
+
+using namespace std;
+
+namespace logtail {
+
+class FlusherHttpRecorder : public HttpFlusher {
+public:
+    static const string sName;
+
+    const string& Name() const override { return sName; }
+    bool Init([[maybe_unused]] const Json::Value& config, [[maybe_unused]] Json::Value& optionalGoPipeline) override {
+        return true;
+    }
+    bool Send([[maybe_unused]] PipelineEventGroup&& g) override { return true; }
+    bool Flush([[maybe_unused]] size_t key) override { return true; }
+    bool FlushAll() override { return true; }
+    bool BuildRequest([[maybe_unused]] SenderQueueItem* item,
+                      [[maybe_unused]] unique_ptr<HttpSinkRequest>& req,
+                      [[maybe_unused]] bool* keepItem,
+                      [[maybe_unused]] string* errMsg) override {
+        return false;
+    }
+    void OnSendDone(const HttpResponse& response, [[maybe_unused]] SenderQueueItem* item) override {
+        lock_guard<mutex> lock(mMux);
+        mResults.emplace_back(response.GetNetworkStatus().mCode, response.GetStatusCode());
+        ++mDoneCnt;
+    }
+
+    // waits until cnt requests are done, or timeout
+    bool WaitForDone(size_t cnt, chrono::seconds timeout) const {
+        auto deadline = chrono::steady_clock::now() + timeout;
+        while (mDoneCnt.load() < cnt) {
+            if (chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        return true;
+    }
+
+    mutex mMux;
+    // network code and status code of each request
+    vector<pair<NetworkCode, int32_t>> mResults;
+    atomic_size_t mDoneCnt = 0;
+};
+
+const string FlusherHttpRecorder::sName = "flusher_http_recorder";
+
+class HttpSinkUnittest : public ::testing::Test {
+public:
+    void TestSendWithEpoll();
+    void TestTimeoutWithEpoll();
+
+protected:
+    void SetUp() override { BOOL_FLAG(enable_http_sink_epoll) = true; }
+    void TearDown() override { BOOL_FLAG(enable_http_sink_epoll) = false; }
+};
+
+void HttpSinkUnittest::TestSendWithEpoll() {
+    LocalHttpServer server;
+    APSARA_TEST_TRUE(server.Start());
+    HttpSink sink;
+    APSARA_TEST_TRUE(sink.Init());
+    APSARA_TEST_TRUE(sink.mEpollFd >= 0);
+
+    FlusherHttpRecorder flusher;
+    vector<unique_ptr<SenderQueueItem>> items;
+    for (size_t i = 0; i < 10; ++i) {
+        items.emplace_back(make_unique<SenderQueueItem>("", 0, &flusher, 0));
+    }
+    for (auto& item : items) {
+        sink.AddRequest(make_unique<HttpSinkRequest>(
+            "GET", false, "127.0.0.1", server.GetPort(), "/", "", map<string, string>(), "", item.get()));
+    }
+    APSARA_TEST_TRUE(flusher.WaitForDone(10, chrono::seconds(5)));
+
+    // requests added after the sink becomes idle are sent as well
+    this_thread::sleep_for(chrono::milliseconds(600));
+    for (auto& item : items) {
+        sink.AddRequest(make_unique<HttpSinkRequest>(
+            "GET", false, "127.0.0.1", server.GetPort(), "/", "", map<string, string>(), "", item.get()));
+    }
+    APSARA_TEST_TRUE(flusher.WaitForDone(20, chrono::seconds(5)));
+
+    sink.Stop();
+    server.Stop();
+
+    APSARA_TEST_EQUAL(20U, server.GetRequestCnt());
+    for (const auto& result : flusher.mResults) {
+        APSARA_TEST_EQUAL(NetworkCode::Ok, result.first);
+        APSARA_TEST_EQUAL(200, result.second);
+    }
+    APSARA_TEST_EQUAL(20U, sink.mOutSuccessfulItemsTotal->GetValue());
+    APSARA_TEST_EQUAL(0U, sink.mOutFailedItemsTotal->GetValue());
+    APSARA_TEST_EQUAL(0, sink.mSendingItemsTotal->GetValue());
+}
+
+void HttpSinkUnittest::TestTimeoutWithEpoll() {
+    // the request is received but never answered, so it can only be finished by the curl timer
+    LocalHttpServer server;
+    APSARA_TEST_TRUE(server.Start(false));
+    HttpSink sink;
+    APSARA_TEST_TRUE(sink.Init());
+    APSARA_TEST_TRUE(sink.mEpollFd >= 0);
+
+    FlusherHttpRecorder flusher;
+    SenderQueueItem item("", 0, &flusher, 0);
+    auto start = chrono::steady_clock::now();
+    sink.AddRequest(make_unique<HttpSinkRequest>(
+        "GET", false, "127.0.0.1", server.GetPort(), "/", "", map<string, string>(), "", &item, 1, 0));
+    APSARA_TEST_TRUE(flusher.WaitForDone(1, chrono::seconds(5)));
+    auto elapsed = chrono::steady_clock::now() - start;
+
+    sink.Stop();
+    server.Stop();
+
+    APSARA_TEST_EQUAL(1U, server.GetRequestCnt());
+    APSARA_TEST_EQUAL(1U, flusher.mResults.size());
+    APSARA_TEST_EQUAL(NetworkCode::Timeout, flusher.mResults[0].first);
+    APSARA_TEST_TRUE(elapsed >= chrono::seconds(1));
+    APSARA_TEST_EQUAL(0U, sink.mOutSuccessfulItemsTotal->GetValue());
+    APSARA_TEST_EQUAL(1U, sink.mOutFailedItemsTotal->GetValue());
+    APSARA_TEST_EQUAL(0, sink.mSendingItemsTotal->GetValue());
+}
+
+UNIT_TEST_CASE(HttpSinkUnittest, TestSendWithEpoll)
+UNIT_TEST_CASE(HttpSinkUnittest, TestTimeoutWithEpoll)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
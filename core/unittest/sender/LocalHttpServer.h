@@ -0,0 +1,125 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace logtail {
+
+// A minimal keep-alive http server on the loopback interface, which replies 200 to every request without body. If
+// reply is disabled, requests are read but never answered, so that clients time out.
+class LocalHttpServer {
+public:
+    bool Start(bool reply = true) {
+        mReply = reply;
+        mListenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        int opt = 1;
+        setsockopt(mListenFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        if (bind(mListenFd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(mListenFd, SOMAXCONN) != 0) {
+            return false;
+        }
+        socklen_t len = sizeof(addr);
+        getsockname(mListenFd, (sockaddr*)&addr, &len);
+        mPort = ntohs(addr.sin_port);
+        mEpollFd = epoll_create1(0);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = mListenFd;
+        epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mListenFd, &ev);
+        mThreadRes = std::async(std::launch::async, &LocalHttpServer::Run, this);
+        return true;
+    }
+
+    void Stop() {
+        mIsStopped = true;
+        mThreadRes.get();
+        for (auto& item : mBuffers) {
+            close(item.first);
+        }
+        close(mEpollFd);
+        close(mListenFd);
+    }
+
+    int32_t GetPort() const { return mPort; }
+    size_t GetRequestCnt() const { return mRequestCnt.load(); }
+
+private:
+    void Run() {
+        static const std::string sResponse = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+        std::vector<epoll_event> events(1024);
+        char buf[4096];
+        while (!mIsStopped) {
+            int n = epoll_wait(mEpollFd, events.data(), events.size(), 100);
+            for (int i = 0; i < n; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == mListenFd) {
+                    int conn = 0;
+                    while ((conn = accept4(mListenFd, nullptr, nullptr, SOCK_NONBLOCK)) >= 0) {
+                        epoll_event ev{};
+                        ev.events = EPOLLIN;
+                        ev.data.fd = conn;
+                        epoll_ctl(mEpollFd, EPOLL_CTL_ADD, conn, &ev);
+                        mBuffers[conn];
+                    }
+                    continue;
+                }
+                ssize_t size = read(fd, buf, sizeof(buf));
+                if (size <= 0) {
+                    epoll_ctl(mEpollFd, EPOLL_CTL_DEL, fd, nullptr);
+                    mBuffers.erase(fd);
+                    close(fd);
+                    continue;
+                }
+                auto& data = mBuffers[fd];
+                data.append(buf, size);
+                size_t pos = 0;
+                while ((pos = data.find("\r\n\r\n")) != std::string::npos) {
+                    data.erase(0, pos + 4);
+                    ++mRequestCnt;
+                    if (mReply && write(fd, sResponse.data(), sResponse.size()) < 0) {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    int mListenFd = -1;
+    int mEpollFd = -1;
+    int32_t mPort = 0;
+    bool mReply = true;
+    std::unordered_map<int, std::string> mBuffers;
+    std::atomic_size_t mRequestCnt = 0;
+    std::atomic_bool mIsStopped = false;
+    std::future<void> mThreadRes;
+};
+
+} // namespace logtail
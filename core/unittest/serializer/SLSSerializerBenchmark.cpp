@@ -0,0 +1,149 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <malloc.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "collection_pipeline/batch/BatchedEvents.h"
+#include "collection_pipeline/serializer/SLSSerializer.h"
+#include "common/TimeUtil.h"
+#include "common/compression/LZ4Compressor.h"
+#include "common/compression/ZstdCompressor.h"
+#include "models/PipelineEventGroup.h"
+#include "plugin/flusher/sls/FlusherSLS.h"
+
+using namespace std;
+
+namespace logtail {
+
+// bytes allocated by malloc and not freed yet
+static size_t GetAllocatedBytes() {
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+    return mallinfo2().uordblks;
+#else
+    return static_cast<size_t>(mallinfo().uordblks);
+#endif
+}
+
+class SLSSerializerBenchmark {
+public:
+    SLSSerializerBenchmark() {
+        mFlusher.SetContext(mCtx);
+        mFlusher.CreateMetricsRecordRef(FlusherSLS::sName, "1");
+        mFlusher.CommitMetricsRecordRef();
+    }
+
+    // serialize into a string and then compress it, which is what the flusher did before
+    void TestSerializeThenCompress(Compressor& compressor, const char* name);
+    // compress while serializing
+    void TestSerializeAndCompress(Compressor& compressor, const char* name);
+
+private:
+    BatchedEvents CreateBatch() const;
+
+    CollectionPipelineContext mCtx;
+    FlusherSLS mFlusher;
+    static const size_t kRoundCnt = 20;
+    // about 8MB when serialized, which is close to the size limit of a log group
+    static const size_t kEventCnt = 40000;
+};
+
+BatchedEvents SLSSerializerBenchmark::CreateBatch() const {
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(LOG_RESERVED_KEY_TOPIC, "topic");
+    group.SetTag(LOG_RESERVED_KEY_SOURCE, "172.16.0.1");
+    for (size_t i = 0; i < kEventCnt; ++i) {
+        LogEvent* e = group.AddLogEvent();
+        e->SetContent(string("time"), "2024-01-01 00:00:" + to_string(i % 60));
+        e->SetContent(string("level"), string("INFO"));
+        e->SetContent(string("file"), "handler.cpp:" + to_string(i % 100));
+        e->SetContent(string("content"),
+                      "request handled, method=GET, path=/api/v1/items/" + to_string(i)
+                          + ", status=200, latency=" + to_string(i % 37) + "ms, user_agent=Mozilla/5.0 (X11; Linux "
+                          + "x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36");
+        e->SetTimestamp(1704067200 + i % 60);
+    }
+    return BatchedEvents(std::move(group.MutableEvents()),
+                         std::move(group.GetSizedTags()),
+                         std::move(group.GetSourceBuffer()),
+                         StringView(),
+                         RangeCheckpointPtr());
+}
+
+void SLSSerializerBenchmark::TestSerializeThenCompress(Compressor& compressor, const char* name) {
+    SLSEventGroupSerializer serializer(&mFlusher);
+    uint64_t timeelapsed = 0;
+    size_t held = 0, rawSize = 0, compressedSize = 0;
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        auto batch = CreateBatch();
+        string serializedData, compressedData, errorMsg;
+        size_t allocatedBefore = GetAllocatedBytes();
+        uint64_t starttime = GetCurrentTimeInMilliSeconds();
+        serializer.DoSerialize(std::move(batch), serializedData, errorMsg);
+        compressor.DoCompress(serializedData, compressedData, errorMsg);
+        timeelapsed += GetCurrentTimeInMilliSeconds() - starttime;
+        // both buffers are alive until the compressed data is pushed to the sender queue
+        held = GetAllocatedBytes() - allocatedBefore;
+        rawSize = serializedData.size();
+        compressedSize = compressedData.size();
+    }
+    printf("%s %s: raw %zuKB, compressed %zuKB, %zuKB held per batch, costs %lums\n",
+           __func__,
+           name,
+           rawSize / 1024,
+           compressedSize / 1024,
+           held / 1024,
+           timeelapsed);
+}
+
+void SLSSerializerBenchmark::TestSerializeAndCompress(Compressor& compressor, const char* name) {
+    SLSEventGroupSerializer serializer(&mFlusher);
+    uint64_t timeelapsed = 0;
+    size_t held = 0, rawSize = 0, compressedSize = 0;
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        auto batch = CreateBatch();
+        string compressedData, errorMsg;
+        size_t allocatedBefore = GetAllocatedBytes();
+        uint64_t starttime = GetCurrentTimeInMilliSeconds();
+        bool isCompressFailed = false;
+        serializer.DoSerializeAndCompress(
+            std::move(batch), compressor, compressedData, rawSize, isCompressFailed, errorMsg);
+        timeelapsed += GetCurrentTimeInMilliSeconds() - starttime;
+        held = GetAllocatedBytes() - allocatedBefore;
+        compressedSize = compressedData.size();
+    }
+    printf("%s %s: raw %zuKB, compressed %zuKB, %zuKB held per batch, costs %lums\n",
+           __func__,
+           name,
+           rawSize / 1024,
+           compressedSize / 1024,
+           held / 1024,
+           timeelapsed);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::SLSSerializerBenchmark benchmark;
+    logtail::ZstdCompressor zstdCompressor(logtail::CompressType::ZSTD);
+    logtail::LZ4Compressor lz4Compressor(logtail::CompressType::LZ4);
+    benchmark.TestSerializeThenCompress(zstdCompressor, "zstd");
+    benchmark.TestSerializeAndCompress(zstdCompressor, "zstd");
+    benchmark.TestSerializeThenCompress(lz4Compressor, "lz4");
+    benchmark.TestSerializeAndCompress(lz4Compressor, "lz4");
+    return 0;
+}
@@ -16,6 +16,8 @@
 
 #include "collection_pipeline/serializer/SLSSerializer.h"
 #include "common/JsonUtil.h"
+#include "common/compression/LZ4Compressor.h"
+#include "common/compression/ZstdCompressor.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "unittest/Unittest.h"
 
@@ -30,10 +32,24 @@ void SerializeSpanLinksToString(const SpanEvent& event, std::string& result);
 void SerializeSpanEventsToString(const SpanEvent& event, std::string& result);
 void SerializeSpanAttributesToString(const SpanEvent& event, std::string& result);
 
+class FailedCompressorMock : public Compressor {
+public:
+    explicit FailedCompressorMock(CompressType type) : Compressor(type) {}
+
+    bool UnCompress(const std::string& input, std::string& output, std::string& errorMsg) override { return false; }
+
+private:
+    bool Compress(const std::string& input, std::string& output, std::string& errorMsg) override {
+        errorMsg = "mock failure";
+        return false;
+    }
+};
+
 class SLSSerializerUnittest : public ::testing::Test {
 public:
     void TestSerializeEventGroup();
     void TestSerializeEventGroupList();
+    void TestSerializeAndCompress();
     void TestSerializeSpanLinksToString();
     void TestSerializeSpanEventsToString();
     void TestSerializeSpanAttributesToString();
@@ -68,6 +84,7 @@ private:
     BatchedEvents
     CreateBatchedRawEvents(bool enableNanosecond, bool withEmptyContent = false, bool withNonEmptyContent = true);
     BatchedEvents CreateBatchedSpanEvents();
+    BatchedEvents CreateLargeBatchedLogEvents(size_t eventCnt);
 
     static unique_ptr<FlusherSLS> sFlusher;
 
@@ -768,6 +785,57 @@ void SLSSerializerUnittest::TestSerializeEventGroupList() {
     APSARA_TEST_EQUAL(sls_logs::SlsCompressType::SLS_CMP_NONE, logPackageList.packages(0).compress_type());
 }
 
+void SLSSerializerUnittest::TestSerializeAndCompress() {
+    SLSEventGroupSerializer serializer(sFlusher.get());
+    ZstdCompressor zstdCompressor(CompressType::ZSTD);
+    LZ4Compressor lz4Compressor(CompressType::LZ4);
+    for (Compressor* compressor : initializer_list<Compressor*>{&zstdCompressor, &lz4Compressor}) {
+        // a small group fits in one chunk, while a large one is compressed in several chunks
+        for (size_t eventCnt : {1U, 10000U}) {
+            string expected, errorMsg;
+            APSARA_TEST_TRUE(serializer.DoSerialize(CreateLargeBatchedLogEvents(eventCnt), expected, errorMsg));
+
+            string res;
+            size_t rawSize = 0;
+            bool isCompressFailed = false;
+            APSARA_TEST_TRUE(serializer.DoSerializeAndCompress(
+                CreateLargeBatchedLogEvents(eventCnt), *compressor, res, rawSize, isCompressFailed, errorMsg));
+            APSARA_TEST_EQUAL(expected.size(), rawSize);
+            APSARA_TEST_TRUE(res.size() < rawSize);
+            string decompressed;
+            decompressed.resize(rawSize);
+            APSARA_TEST_TRUE(compressor->UnCompress(res, decompressed, errorMsg));
+            APSARA_TEST_EQUAL(expected, decompressed);
+        }
+    }
+    {
+        // the serializer can still be used in non-streaming mode afterwards
+        string res, errorMsg;
+        APSARA_TEST_TRUE(serializer.DoSerialize(CreateLargeBatchedLogEvents(10), res, errorMsg));
+        sls_logs::LogGroup logGroup;
+        APSARA_TEST_TRUE(logGroup.ParseFromString(res));
+        APSARA_TEST_EQUAL(10, logGroup.logs_size());
+    }
+    {
+        // invalid group
+        string res, errorMsg;
+        size_t rawSize = 0;
+        bool isCompressFailed = true;
+        APSARA_TEST_FALSE(serializer.DoSerializeAndCompress(
+            CreateBatchedLogEvents(false, true, false), zstdCompressor, res, rawSize, isCompressFailed, errorMsg));
+        APSARA_TEST_FALSE(isCompressFailed);
+    }
+    {
+        // compressor failure
+        FailedCompressorMock failedCompressor(CompressType::ZSTD);
+        string res, errorMsg;
+        size_t rawSize = 0;
+        bool isCompressFailed = false;
+        APSARA_TEST_FALSE(serializer.DoSerializeAndCompress(
+            CreateLargeBatchedLogEvents(10), failedCompressor, res, rawSize, isCompressFailed, errorMsg));
+        APSARA_TEST_TRUE(isCompressFailed);
+    }
+}
 
 BatchedEvents
 SLSSerializerUnittest::CreateBatchedLogEvents(bool enableNanosecond, bool withEmptyContent, bool withNonEmptyContent) {
@@ -976,6 +1044,23 @@ BatchedEvents SLSSerializerUnittest::CreateBatchedSpanEvents() {
     return batch;
 }
 
+BatchedEvents SLSSerializerUnittest::CreateLargeBatchedLogEvents(size_t eventCnt) {
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(LOG_RESERVED_KEY_TOPIC, "topic");
+    group.SetTag(LOG_RESERVED_KEY_SOURCE, "source");
+    for (size_t i = 0; i < eventCnt; ++i) {
+        LogEvent* e = group.AddLogEvent();
+        e->SetContent(string("key"), "value_" + to_string(i) + string(100, 'a' + i % 26));
+        e->SetTimestamp(1234567890 + i);
+    }
+    BatchedEvents batch(std::move(group.MutableEvents()),
+                        std::move(group.GetSizedTags()),
+                        std::move(group.GetSourceBuffer()),
+                        StringView(),
+                        RangeCheckpointPtr());
+    return batch;
+}
+
 void SLSSerializerUnittest::TestSerializeSpanLinksToString() {
     PipelineEventGroup group(make_shared<SourceBuffer>());
     SpanEvent* spanEvent = group.AddSpanEvent();
@@ -1189,6 +1274,7 @@ void SLSSerializerUnittest::TestSerializeSpanAttributesToString() {
 
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroup)
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroupList)
+UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeAndCompress)
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeSpanLinksToString)
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeSpanEventsToString)
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeSpanAttributesToString)